@@ -196,13 +196,18 @@ public:
     /**
      * Speichert Original-Audio für Delta-Vergleich
      */
-    void captureOriginal(const juce::AudioBuffer<float>& buffer)
+    template <typename SampleType>
+    void captureOriginal(const juce::AudioBuffer<SampleType>& buffer)
     {
         if (buffer.getNumChannels() >= 2 && buffer.getNumSamples() <= originalBuffer.getNumSamples())
         {
             for (int ch = 0; ch < juce::jmin(2, buffer.getNumChannels()); ++ch)
             {
-                originalBuffer.copyFrom(ch, 0, buffer, ch, 0, buffer.getNumSamples());
+                const SampleType* source = buffer.getReadPointer(ch);
+                double* orig = originalBuffer.getWritePointer(ch);
+                
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    orig[i] = static_cast<double>(source[i]);
             }
         }
     }
@@ -212,7 +217,8 @@ public:
      * @param processedBuffer Das verarbeitete Signal
      * @param originalCaptured True wenn captureOriginal aufgerufen wurde
      */
-    void processCompare(juce::AudioBuffer<float>& processedBuffer, bool originalCaptured = true)
+    template <typename SampleType>
+    void processCompare(juce::AudioBuffer<SampleType>& processedBuffer, bool originalCaptured = true)
     {
         switch (currentMode)
         {
@@ -226,9 +232,12 @@ public:
                 {
                     for (int ch = 0; ch < juce::jmin(2, processedBuffer.getNumChannels()); ++ch)
                     {
-                        processedBuffer.copyFrom(ch, 0, originalBuffer, ch, 0, 
-                                                  juce::jmin(processedBuffer.getNumSamples(), 
-                                                             originalBuffer.getNumSamples()));
+                        SampleType* proc = processedBuffer.getWritePointer(ch);
+                        const double* orig = originalBuffer.getReadPointer(ch);
+                        
+                        for (int i = 0; i < juce::jmin(processedBuffer.getNumSamples(), 
+                                                       originalBuffer.getNumSamples()); ++i)
+                            proc[i] = static_cast<SampleType>(orig[i]);
                     }
                 }
                 break;
@@ -239,13 +248,13 @@ public:
                 {
                     for (int ch = 0; ch < juce::jmin(2, processedBuffer.getNumChannels()); ++ch)
                     {
-                        float* proc = processedBuffer.getWritePointer(ch);
-                        const float* orig = originalBuffer.getReadPointer(ch);
+                        SampleType* proc = processedBuffer.getWritePointer(ch);
+                        const double* orig = originalBuffer.getReadPointer(ch);
                         
                         for (int i = 0; i < juce::jmin(processedBuffer.getNumSamples(), 
                                                        originalBuffer.getNumSamples()); ++i)
                         {
-                            proc[i] = proc[i] - orig[i];
+                            proc[i] = static_cast<SampleType>(proc[i] - orig[i]);
                             
                             // Delta-Boost für bessere Hörbarkeit
                             proc[i] *= deltaBoost;
@@ -344,7 +353,7 @@ private:
     std::deque<Snapshot> history;
     size_t historyIndex = 0;
     
-    juce::AudioBuffer<float> originalBuffer;
+    juce::AudioBuffer<double> originalBuffer;  // double: verlustfrei für beide Host-Pfade
     
     bool autoGainMatch = true;
     float deltaBoost = 6.0f;  // Delta um 6dB boosten für Hörbarkeit
@@ -355,7 +364,8 @@ private:
     // Hilfsfunktionen
     //==========================================================================
     
-    void applyGainMatch(juce::AudioBuffer<float>& buffer)
+    template <typename SampleType>
+    void applyGainMatch(juce::AudioBuffer<SampleType>& buffer)
     {
         // RMS des Buffers berechnen
         float rms = 0.0f;
@@ -363,10 +373,10 @@ private:
         
         for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
         {
-            const float* data = buffer.getReadPointer(ch);
+            const SampleType* data = buffer.getReadPointer(ch);
             for (int i = 0; i < buffer.getNumSamples(); ++i)
             {
-                rms += data[i] * data[i];
+                rms += static_cast<float>(data[i] * data[i]);
                 ++totalSamples;
             }
         }
@@ -382,7 +392,7 @@ private:
             
             float gainLinear = std::pow(10.0f, gainDb / 20.0f);
             
-            buffer.applyGain(gainLinear);
+            buffer.applyGain(static_cast<SampleType>(gainLinear));
         }
     }
 };
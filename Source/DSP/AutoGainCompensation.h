@@ -48,7 +48,8 @@ public:
     /**
      * Misst Input-Level (vor EQ)
      */
-    void measureInput(const juce::AudioBuffer<float>& buffer)
+    template <typename SampleType>
+    void measureInput(const juce::AudioBuffer<SampleType>& buffer)
     {
         if (!enabled)
             return;
@@ -58,10 +59,10 @@ public:
         
         for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
         {
-            const float* data = buffer.getReadPointer(ch);
+            const SampleType* data = buffer.getReadPointer(ch);
             for (int i = 0; i < buffer.getNumSamples(); ++i)
             {
-                rms += data[i] * data[i];
+                rms += static_cast<float>(data[i] * data[i]);
                 ++totalSamples;
             }
         }
@@ -76,7 +77,8 @@ public:
     /**
      * Misst Output-Level (nach EQ) und berechnet Kompensation
      */
-    void measureOutputAndCompensate(juce::AudioBuffer<float>& buffer)
+    template <typename SampleType>
+    void measureOutputAndCompensate(juce::AudioBuffer<SampleType>& buffer)
     {
         if (!enabled)
             return;
@@ -86,10 +88,10 @@ public:
         
         for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
         {
-            const float* data = buffer.getReadPointer(ch);
+            const SampleType* data = buffer.getReadPointer(ch);
             for (int i = 0; i < buffer.getNumSamples(); ++i)
             {
-                rms += data[i] * data[i];
+                rms += static_cast<float>(data[i] * data[i]);
                 ++totalSamples;
             }
         }
@@ -235,13 +237,14 @@ private:
         }
     }
     
-    void applyGain(juce::AudioBuffer<float>& buffer)
+    template <typename SampleType>
+    void applyGain(juce::AudioBuffer<SampleType>& buffer)
     {
         const int numCh = buffer.getNumChannels();
         const int numSamples = buffer.getNumSamples();
         
         // Channel-Pointer einmalig cachen (statt numSamples*numChannels mal getWritePointer)
-        float* channelPtrs[16];
+        SampleType* channelPtrs[16];
         const int maxCh = std::min(numCh, 16);
         for (int ch = 0; ch < maxCh; ++ch)
             channelPtrs[ch] = buffer.getWritePointer(ch);
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Parameters/ParameterIDs.h"
+#include <array>
+#include <atomic>
+
+/**
+ * BandModulation: Lock-freie Band-Modulation direkt im Audio-Pfad.
+ *
+ * - Ein Modulator (LiveSmartEQ im SmartAnalysisWorker) schreibt Frequenz, Gain,
+ *   Q und Kanal eines Bands direkt in diesen Block — ohne APVTS, Listener oder
+ *   Message-Thread (funktioniert damit auch ohne offenen Editor / headless)
+ * - Der Audio-Thread holt geänderte Bänder am Blockanfang mit drainChanges() ab
+ *   (Dirty-Maske wie im ParameterRouter). Die Koeffizienten-Interpolation
+ *   übernehmen BiquadFilter/BiquadCascade bzw. die FusedEQChain
+ * - Solange ein Band übernommen ist (Active/Inactive), ignoriert der Processor die
+ *   APVTS-Werte dieses Bands. Der APVTS wird nur verzögert für Anzeige und
+ *   Automation nachgezogen
+ * - Freigegeben wird erst, wenn der APVTS den Stand des Modulators erreicht hat
+ *   (release() im Message-Thread über den Timer des Processors, unabhängig vom
+ *   Editor). Die Generation verhindert, dass eine veraltete Freigabe ein
+ *   inzwischen neu übernommenes Band zurücksetzt
+ */
+class BandModulation
+{
+public:
+    enum class State : int
+    {
+        Released = 0,  // Band folgt dem APVTS
+        Active,        // Band läuft mit den Modulationswerten
+        Inactive       // Band übernommen, aber aus (APVTS noch nicht nachgezogen)
+    };
+
+    struct Values
+    {
+        float frequency = 1000.0f;
+        float gainDb = 0.0f;
+        float q = ParameterIDs::DEFAULT_Q;
+        int channelMode = 0;
+    };
+
+    static constexpr int NUM_BANDS = ParameterIDs::MAX_BANDS;
+    static_assert(NUM_BANDS <= 32, "Dirty-Maske der Bänder ist 32 Bit breit");
+
+    using Generations = std::array<uint32_t, NUM_BANDS>;
+
+    //==========================================================================
+    // Modulator (Worker-Thread)
+    //==========================================================================
+
+    /** Band übernehmen (oder Werte eines bereits aktiven Bands komplett setzen). */
+    void engage(int bandIndex, const Values& values)
+    {
+        auto& slot = slots[static_cast<size_t>(bandIndex)];
+        storeValues(slot, values);
+        slot.channelMode.store(values.channelMode, std::memory_order_relaxed);
+
+        if (slot.state.load(std::memory_order_relaxed) != static_cast<int>(State::Active))
+        {
+            slot.generation.fetch_add(1, std::memory_order_relaxed);
+            slot.state.store(static_cast<int>(State::Active), std::memory_order_release);
+        }
+
+        markDirty(bandIndex);
+    }
+
+    /** Frequenz/Gain/Q eines aktiven Bands aktualisieren (Kanal bleibt). */
+    void update(int bandIndex, const Values& values)
+    {
+        auto& slot = slots[static_cast<size_t>(bandIndex)];
+        if (slot.state.load(std::memory_order_acquire) != static_cast<int>(State::Active))
+            return;
+
+        storeValues(slot, values);
+        markDirty(bandIndex);
+    }
+
+    /** Aktives Band ausschalten, bleibt aber übernommen. */
+    void disengage(int bandIndex)
+    {
+        auto& slot = slots[static_cast<size_t>(bandIndex)];
+        int expected = static_cast<int>(State::Active);
+        if (slot.state.compare_exchange_strong(expected, static_cast<int>(State::Inactive),
+                                               std::memory_order_acq_rel))
+            markDirty(bandIndex);
+    }
+
+    /** Aktive Bänder auf 0 dB ziehen (transparent, Übergang über das Koeffizienten-Smoothing). */
+    void neutraliseAll()
+    {
+        for (int i = 0; i < NUM_BANDS; ++i)
+        {
+            auto& slot = slots[static_cast<size_t>(i)];
+            if (slot.state.load(std::memory_order_acquire) == static_cast<int>(State::Active))
+            {
+                slot.gainDb.store(0.0f, std::memory_order_relaxed);
+                markDirty(i);
+            }
+        }
+    }
+
+    //==========================================================================
+    // Message-Thread (nachdem der APVTS nachgezogen wurde)
+    //==========================================================================
+
+    /** Inactive → Released, nur wenn das Band seit `generation` nicht neu übernommen wurde. */
+    bool release(int bandIndex, uint32_t generation)
+    {
+        auto& slot = slots[static_cast<size_t>(bandIndex)];
+        if (slot.generation.load(std::memory_order_acquire) != generation)
+            return false;
+
+        int expected = static_cast<int>(State::Inactive);
+        if (!slot.state.compare_exchange_strong(expected, static_cast<int>(State::Released),
+                                                std::memory_order_acq_rel))
+            return false;
+
+        markDirty(bandIndex);
+        return true;
+    }
+
+    /**
+     * Alle Bänder freigeben (nach einem kompletten APVTS-Reset), außer denen, die
+     * seit `generations` (Stand bei der Reset-Anfrage) neu übernommen wurden.
+     */
+    void releaseAll(const Generations& generations)
+    {
+        for (int i = 0; i < NUM_BANDS; ++i)
+        {
+            auto& slot = slots[static_cast<size_t>(i)];
+            if (slot.generation.load(std::memory_order_acquire) != generations[static_cast<size_t>(i)])
+                continue;
+
+            int observed = slot.state.load(std::memory_order_acquire);
+            while (observed != static_cast<int>(State::Released)
+                   && !slot.state.compare_exchange_weak(observed, static_cast<int>(State::Released),
+                                                        std::memory_order_acq_rel))
+            {
+            }
+
+            if (observed != static_cast<int>(State::Released))
+                markDirty(i);
+        }
+    }
+
+    //==========================================================================
+    // Lesen (beliebiger Thread)
+    //==========================================================================
+    State getState(int bandIndex) const
+    {
+        return static_cast<State>(slots[static_cast<size_t>(bandIndex)].state.load(std::memory_order_acquire));
+    }
+
+    bool isEngaged(int bandIndex) const { return getState(bandIndex) != State::Released; }
+
+    uint32_t getGeneration(int bandIndex) const
+    {
+        return slots[static_cast<size_t>(bandIndex)].generation.load(std::memory_order_acquire);
+    }
+
+    Generations getGenerations() const
+    {
+        Generations generations {};
+        for (int i = 0; i < NUM_BANDS; ++i)
+            generations[static_cast<size_t>(i)] = getGeneration(i);
+        return generations;
+    }
+
+    Values getValues(int bandIndex) const
+    {
+        const auto& slot = slots[static_cast<size_t>(bandIndex)];
+        Values values;
+        values.frequency = slot.frequency.load(std::memory_order_relaxed);
+        values.gainDb = slot.gainDb.load(std::memory_order_relaxed);
+        values.q = slot.q.load(std::memory_order_relaxed);
+        values.channelMode = slot.channelMode.load(std::memory_order_relaxed);
+        return values;
+    }
+
+    /**
+     * Audio-Thread: ruft applyBand(bandIndex) für jedes geänderte Band auf.
+     * RT-safe, keine Allokation. Änderungen während des Anwendens landen im
+     * nächsten Block.
+     */
+    template <typename ApplyFn>
+    void drainChanges(ApplyFn&& applyBand)
+    {
+        uint32_t bands = dirtyBands.exchange(0, std::memory_order_acquire);
+
+        for (int i = 0; bands != 0; ++i, bands >>= 1)
+        {
+            if ((bands & 1u) != 0u)
+                applyBand(i);
+        }
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<float> frequency { 1000.0f };
+        std::atomic<float> gainDb { 0.0f };
+        std::atomic<float> q { ParameterIDs::DEFAULT_Q };
+        std::atomic<int> channelMode { 0 };
+        std::atomic<int> state { static_cast<int>(State::Released) };
+        std::atomic<uint32_t> generation { 0 };
+    };
+
+    static void storeValues(Slot& slot, const Values& values)
+    {
+        slot.frequency.store(values.frequency, std::memory_order_relaxed);
+        slot.gainDb.store(values.gainDb, std::memory_order_relaxed);
+        slot.q.store(values.q, std::memory_order_relaxed);
+    }
+
+    void markDirty(int bandIndex)
+    {
+        dirtyBands.fetch_or(1u << static_cast<uint32_t>(bandIndex), std::memory_order_release);
+    }
+
+    std::array<Slot, NUM_BANDS> slots;
+    std::atomic<uint32_t> dirtyBands { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BandModulation)
+};
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "BiquadFilter.h"
+#include "../Parameters/ParameterIDs.h"
+
+/**
+ * BiquadCascade: Vektorisierte Kaskade aus bis zu MAX_STAGES Biquads (TDF-II)
+ * für ein komplettes EQ-Band.
+ *
+ * Unterschiede zum klassischen Pfad (BiquadFilter::processBlock pro Stufe/Kanal):
+ * - L/R bzw. Mid/Side liegen in zwei Lanes eines SIMDRegister<double>,
+ *   beide Kanäle werden mit denselben Instruktionen gerechnet
+ * - Alle aktiven Stufen laufen in EINER Sample-Schleife (ein Lese- und ein
+ *   Schreibzugriff auf den Host-Buffer statt 2 x numStages Passes)
+ * - Koeffizienten-Smoothing pro Chunk (CHUNK_SIZE Samples) statt pro Sample:
+ *   gleicher exponentieller Verlauf wie BiquadFilter (0.999 pro Sample),
+ *   aber ohne Verzweigung im inneren Loop
+ *
+ * Die Koeffizienten stammen aus BiquadFilter::getCoefficients(), der Frequenzgang
+ * ist daher identisch zum skalaren Pfad (A/B-Vergleich innerhalb Rundungstoleranz).
+ */
+class BiquadCascade
+{
+public:
+    static constexpr int MAX_STAGES = 8;
+    static constexpr int CHUNK_SIZE = 32;  // Samples pro Koeffizienten-Schritt
+
+    BiquadCascade()
+    {
+        reset();
+    }
+
+    /** Setzt die Filter-Zustände zurück und übernimmt die Ziel-Koeffizienten sofort. */
+    void reset() noexcept
+    {
+        for (int s = 0; s < MAX_STAGES; ++s)
+        {
+            state1[s] = Vec::expand(0.0);
+            state2[s] = Vec::expand(0.0);
+            current[s] = target[s];
+        }
+        needsSmoothing = false;
+    }
+
+    void setNumStages(int stages) noexcept
+    {
+        numStages = juce::jlimit(1, MAX_STAGES, stages);
+    }
+
+    int getNumStages() const noexcept { return numStages; }
+
+    /** Neue Ziel-Koeffizienten für eine Stufe (werden pro Chunk eingeblendet). */
+    void setStageCoefficients(int stage, const BiquadFilter::Coefficients& coeffs) noexcept
+    {
+        if (stage < 0 || stage >= MAX_STAGES)
+            return;
+
+        target[stage] = coeffs;
+
+        if (!isConverged(current[stage], coeffs))
+            needsSmoothing = true;
+    }
+
+    /**
+     * Verarbeitet einen Block in-place.
+     * @param left   Kanal 0 (bzw. Mono)
+     * @param right  Kanal 1 oder nullptr für Mono (Lane 1 läuft dann mit Stille)
+     * @param mode   Kanal-Routing des Bands (Stereo, L, R, Mid, Side)
+     */
+    template <typename SampleType>
+    void process(SampleType* left, SampleType* right, int numSamples, ParameterIDs::ChannelMode mode) noexcept
+    {
+        Vec frames[CHUNK_SIZE];
+
+        for (int start = 0; start < numSamples; start += CHUNK_SIZE)
+        {
+            const int chunk = juce::jmin(CHUNK_SIZE, numSamples - start);
+            SampleType* l = left + start;
+            SampleType* r = (right != nullptr) ? right + start : nullptr;
+
+            if (needsSmoothing)
+                advanceSmoothing(chunk);
+
+            loadFrames(frames, l, r, chunk, mode);
+            processFrames(frames, chunk);
+            storeFrames(frames, l, r, chunk, mode);
+        }
+
+        flushDenormals();
+    }
+
+private:
+    using Vec = juce::dsp::SIMDRegister<double>;
+    static_assert(Vec::SIMDNumElements >= 2, "BiquadCascade benötigt mindestens 2 double-Lanes");
+
+    static constexpr double smoothingCoeff = 0.999;    // identisch zu BiquadFilter
+    static constexpr double smoothingEpsilon = 1e-8;
+
+    //==========================================================================
+    // Laden/Speichern mit Kanal-Routing (M/S-Encoding direkt im selben Pass)
+    //==========================================================================
+    template <typename SampleType>
+    static void loadFrames(Vec* frames, const SampleType* l, const SampleType* r, int n,
+                           ParameterIDs::ChannelMode mode) noexcept
+    {
+        const bool midSide = (r != nullptr) && (mode == ParameterIDs::ChannelMode::Mid
+                                             || mode == ParameterIDs::ChannelMode::Side);
+
+        for (int i = 0; i < n; ++i)
+        {
+            Vec v = Vec::expand(0.0);
+
+            if (r == nullptr)
+            {
+                v.set(0, l[i]);
+            }
+            else if (midSide)
+            {
+                v.set(0, (static_cast<double>(l[i]) + r[i]) * 0.5);
+                v.set(1, (static_cast<double>(l[i]) - r[i]) * 0.5);
+            }
+            else
+            {
+                v.set(0, l[i]);
+                v.set(1, r[i]);
+            }
+
+            frames[i] = v;
+        }
+    }
+
+    template <typename SampleType>
+    static void storeFrames(const Vec* frames, SampleType* l, SampleType* r, int n,
+                            ParameterIDs::ChannelMode mode) noexcept
+    {
+        // Mono: immer Lane 0 (wie der skalare Pfad, Kanal-Modus wird ignoriert)
+        if (r == nullptr)
+        {
+            for (int i = 0; i < n; ++i)
+                l[i] = static_cast<SampleType>(frames[i].get(0));
+            return;
+        }
+
+        switch (mode)
+        {
+            case ParameterIDs::ChannelMode::Stereo:
+                for (int i = 0; i < n; ++i)
+                {
+                    l[i] = static_cast<SampleType>(frames[i].get(0));
+                    r[i] = static_cast<SampleType>(frames[i].get(1));
+                }
+                break;
+
+            case ParameterIDs::ChannelMode::Left:
+                for (int i = 0; i < n; ++i)
+                    l[i] = static_cast<SampleType>(frames[i].get(0));
+                break;
+
+            case ParameterIDs::ChannelMode::Right:
+                for (int i = 0; i < n; ++i)
+                    r[i] = static_cast<SampleType>(frames[i].get(1));
+                break;
+
+            case ParameterIDs::ChannelMode::Mid:
+                for (int i = 0; i < n; ++i)
+                {
+                    const SampleType mid = static_cast<SampleType>(frames[i].get(0));
+                    const SampleType side = (l[i] - r[i]) * static_cast<SampleType>(0.5);
+                    l[i] = mid + side;
+                    r[i] = mid - side;
+                }
+                break;
+
+            case ParameterIDs::ChannelMode::Side:
+                for (int i = 0; i < n; ++i)
+                {
+                    const SampleType mid = (l[i] + r[i]) * static_cast<SampleType>(0.5);
+                    const SampleType side = static_cast<SampleType>(frames[i].get(1));
+                    l[i] = mid + side;
+                    r[i] = mid - side;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    //==========================================================================
+    // Kaskade: Stufenzahl als Template-Parameter → Zustände bleiben in Registern
+    //==========================================================================
+    void processFrames(Vec* frames, int n) noexcept
+    {
+        switch (numStages)
+        {
+            case 1: processFramesImpl<1>(frames, n); break;
+            case 2: processFramesImpl<2>(frames, n); break;
+            case 3: processFramesImpl<3>(frames, n); break;
+            case 4: processFramesImpl<4>(frames, n); break;
+            case 5: processFramesImpl<5>(frames, n); break;
+            case 6: processFramesImpl<6>(frames, n); break;
+            case 7: processFramesImpl<7>(frames, n); break;
+            default: processFramesImpl<8>(frames, n); break;
+        }
+    }
+
+    template <int NumStages>
+    void processFramesImpl(Vec* frames, int n) noexcept
+    {
+        Vec b0[NumStages], b1[NumStages], b2[NumStages], a1[NumStages], a2[NumStages];
+        Vec z1[NumStages], z2[NumStages];
+
+        for (int s = 0; s < NumStages; ++s)
+        {
+            b0[s] = Vec::expand(current[s].b0);
+            b1[s] = Vec::expand(current[s].b1);
+            b2[s] = Vec::expand(current[s].b2);
+            a1[s] = Vec::expand(current[s].a1);
+            a2[s] = Vec::expand(current[s].a2);
+            z1[s] = state1[s];
+            z2[s] = state2[s];
+        }
+
+        for (int i = 0; i < n; ++i)
+        {
+            Vec x = frames[i];
+
+            for (int s = 0; s < NumStages; ++s)
+            {
+                // Transposed Direct Form II (identisch zu BiquadFilter::processSample)
+                const Vec y = b0[s] * x + z1[s];
+                z1[s] = b1[s] * x - a1[s] * y + z2[s];
+                z2[s] = b2[s] * x - a2[s] * y;
+                x = y;
+            }
+
+            frames[i] = x;
+        }
+
+        for (int s = 0; s < NumStages; ++s)
+        {
+            state1[s] = z1[s];
+            state2[s] = z2[s];
+        }
+    }
+
+    //==========================================================================
+    // Smoothing: exponentieller Verlauf, ausgewertet einmal pro Chunk
+    // current_n = target + (current_0 - target) * 0.999^n
+    //==========================================================================
+    void advanceSmoothing(int numSamplesInChunk) noexcept
+    {
+        const double decay = (numSamplesInChunk == CHUNK_SIZE)
+                           ? chunkDecay
+                           : std::pow(smoothingCoeff, static_cast<double>(numSamplesInChunk));
+
+        bool stillSmoothing = false;
+
+        for (int s = 0; s < MAX_STAGES; ++s)
+        {
+            auto& c = current[s];
+            const auto& t = target[s];
+
+            c.b0 = t.b0 + (c.b0 - t.b0) * decay;
+            c.b1 = t.b1 + (c.b1 - t.b1) * decay;
+            c.b2 = t.b2 + (c.b2 - t.b2) * decay;
+            c.a1 = t.a1 + (c.a1 - t.a1) * decay;
+            c.a2 = t.a2 + (c.a2 - t.a2) * decay;
+
+            if (isConverged(c, t))
+                c = t;  // Exakte Werte setzen
+            else
+                stillSmoothing = true;
+        }
+
+        needsSmoothing = stillSmoothing;
+    }
+
+    static bool isConverged(const BiquadFilter::Coefficients& a, const BiquadFilter::Coefficients& b) noexcept
+    {
+        return std::abs(a.b0 - b.b0) < smoothingEpsilon
+            && std::abs(a.b1 - b.b1) < smoothingEpsilon
+            && std::abs(a.b2 - b.b2) < smoothingEpsilon
+            && std::abs(a.a1 - b.a1) < smoothingEpsilon
+            && std::abs(a.a2 - b.a2) < smoothingEpsilon;
+    }
+
+    // Anti-Denormal einmal pro Block statt pro Sample
+    void flushDenormals() noexcept
+    {
+        for (int s = 0; s < numStages; ++s)
+        {
+            for (size_t lane = 0; lane < 2; ++lane)
+            {
+                if (std::abs(state1[s].get(lane)) < ANTI_DENORMAL) state1[s].set(lane, 0.0);
+                if (std::abs(state2[s].get(lane)) < ANTI_DENORMAL) state2[s].set(lane, 0.0);
+            }
+        }
+    }
+
+    //==========================================================================
+    // Member
+    //==========================================================================
+    std::array<BiquadFilter::Coefficients, MAX_STAGES> target {};
+    std::array<BiquadFilter::Coefficients, MAX_STAGES> current {};
+
+    // Delay-Elemente pro Stufe, Lane 0 = L/Mid, Lane 1 = R/Side
+    Vec state1[MAX_STAGES];
+    Vec state2[MAX_STAGES];
+
+    int numStages = 1;
+    bool needsSmoothing = false;
+
+    const double chunkDecay = std::pow(smoothingCoeff, static_cast<double>(CHUNK_SIZE));
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BiquadCascade)
+};
@@ -1,5 +1,6 @@
 #include "BiquadFilter.h"
 #include <cmath>
+#include <complex>
 
 BiquadFilter::BiquadFilter()
 {
@@ -42,6 +43,13 @@ void BiquadFilter::updateCoefficients(ParameterIDs::FilterType type,
     frequency = juce::jlimit(20.0f, static_cast<float>(sampleRate * 0.499), frequency);
     Q = juce::jlimit(0.1f, 18.0f, Q);
 
+    if (designMode == DesignMode::AnalogMatched && supportsAnalogMatched(type)
+        && calculateMatchedCoefficients(type, frequency, gainDB, Q))
+    {
+        normalizeCoefficients();
+        return;
+    }
+
     switch (type)
     {
         case ParameterIDs::FilterType::Bell:
@@ -84,7 +92,8 @@ void BiquadFilter::updateCoefficients(ParameterIDs::FilterType type,
     normalizeCoefficients();
 }
 
-float BiquadFilter::processSample(float input) noexcept
+template <typename SampleType>
+SampleType BiquadFilter::processSample(SampleType input) noexcept
 {
     // OPTIMIERUNG: Conditional Smoothing - nur wenn Koeffizienten sich ändern
     if (needsSmoothing)
@@ -121,10 +130,11 @@ float BiquadFilter::processSample(float input) noexcept
     if (std::abs(z1) < ANTI_DENORMAL) z1 = 0.0;
     if (std::abs(z2) < ANTI_DENORMAL) z2 = 0.0;
     
-    return static_cast<float>(output);
+    return static_cast<SampleType>(output);
 }
 
-void BiquadFilter::processBlock(float* data, int numSamples) noexcept
+template <typename SampleType>
+void BiquadFilter::processBlock(SampleType* data, int numSamples) noexcept
 {
     for (int i = 0; i < numSamples; ++i)
     {
@@ -132,6 +142,11 @@ void BiquadFilter::processBlock(float* data, int numSamples) noexcept
     }
 }
 
+template float BiquadFilter::processSample<float>(float) noexcept;
+template double BiquadFilter::processSample<double>(double) noexcept;
+template void BiquadFilter::processBlock<float>(float*, int) noexcept;
+template void BiquadFilter::processBlock<double>(double*, int) noexcept;
+
 float BiquadFilter::getMagnitudeForFrequency(float frequency) const noexcept
 {
     // H(z) = (b0 + b1*z^-1 + b2*z^-2) / (a0 + a1*z^-1 + a2*z^-2)
@@ -412,3 +427,140 @@ void BiquadFilter::calculateFlatTiltCoefficients(float frequency, float gainDB)
     a1 = sqrtA * t - 1.0;
     a2 = 0.0;
 }
+
+// ============================================================================
+// Analog-Matched-Design (Vicanek, "Matched Second Order Digital Filters", 2016)
+// ============================================================================
+
+bool BiquadFilter::supportsAnalogMatched(ParameterIDs::FilterType type) noexcept
+{
+    return type == ParameterIDs::FilterType::Bell
+        || type == ParameterIDs::FilterType::LowShelf
+        || type == ParameterIDs::FilterType::HighShelf
+        || type == ParameterIDs::FilterType::BandPass
+        || type == ParameterIDs::FilterType::Notch;
+}
+
+double BiquadFilter::getAnalogMagnitude(ParameterIDs::FilterType type, double centreFrequency,
+                                        double gainDB, double Q, double frequency) noexcept
+{
+    // Prototypen des Cookbooks, s normiert auf die Mittenfrequenz
+    const std::complex<double> s(0.0, frequency / centreFrequency);
+    const double A = std::pow(10.0, gainDB / 40.0);
+    const double sqrtA = std::sqrt(A);
+
+    switch (type)
+    {
+        case ParameterIDs::FilterType::Bell:
+            return std::abs((s * s + s * (A / Q) + 1.0) / (s * s + s / (A * Q) + 1.0));
+        case ParameterIDs::FilterType::LowShelf:
+            return A * std::abs((s * s + s * (sqrtA / Q) + A) / (A * s * s + s * (sqrtA / Q) + 1.0));
+        case ParameterIDs::FilterType::HighShelf:
+            return A * std::abs((A * s * s + s * (sqrtA / Q) + 1.0) / (s * s + s * (sqrtA / Q) + A));
+        case ParameterIDs::FilterType::BandPass:
+            return std::abs((s / Q) / (s * s + s / Q + 1.0));
+        case ParameterIDs::FilterType::Notch:
+            return std::abs((s * s + 1.0) / (s * s + s / Q + 1.0));
+        default:
+            jassertfalse;  // kein Prototyp hinterlegt
+            return 1.0;
+    }
+}
+
+bool BiquadFilter::calculateMatchedCoefficients(ParameterIDs::FilterType type, float frequency, float gainDB, float Q)
+{
+    // Impulsinvarianz trifft tiefe, schmale Wurzelpaare am besten → dieses Paar als
+    // Pole entwerfen. Bell-/Low-Shelf-Cut und High-Shelf-Boost sind die Inversen
+    // des Filters mit negiertem Gain (Cookbook-Prototypen sind darin symmetrisch)
+    const bool invert = (type == ParameterIDs::FilterType::HighShelf) ? gainDB > 0.0f
+                      : (type == ParameterIDs::FilterType::Bell || type == ParameterIDs::FilterType::LowShelf) && gainDB < 0.0f;
+
+    if (invert)
+    {
+        if (!calculateMatchedCoefficients(type, frequency, -gainDB, Q))
+            return false;
+
+        std::swap(b0, a0);
+        std::swap(b1, a1);
+        std::swap(b2, a2);
+
+        // Minimalphasige Nullstellen → stabile Pole; Grenzfälle (Nullstelle auf
+        // dem Einheitskreis) fallen auf das Cookbook-Design zurück
+        const double stableA1 = a1 / a0;
+        const double stableA2 = a2 / a0;
+        return std::isfinite(stableA1) && std::isfinite(stableA2)
+            && std::abs(stableA2) < 1.0 && std::abs(stableA1) < 1.0 + stableA2;
+    }
+
+    const double pi = juce::MathConstants<double>::pi;
+    const double w0 = 2.0 * pi * frequency / sampleRate;
+    const double A = std::pow(10.0, gainDB / 40.0);
+
+    // Pole des Analog-Nenners (Eigenfrequenz relativ zu f0, Dämpfung)
+    double poleScale = 1.0;
+    double zeta = 1.0 / (2.0 * Q);
+
+    if (type == ParameterIDs::FilterType::Bell)
+        zeta = 1.0 / (2.0 * A * Q);
+    else if (type == ParameterIDs::FilterType::LowShelf)
+        poleScale = 1.0 / std::sqrt(A);
+    else if (type == ParameterIDs::FilterType::HighShelf)
+        poleScale = std::sqrt(A);
+
+    // Impulsinvariante Pole; Eigenfrequenz unter Nyquist halten (High-Shelf-Boost
+    // nahe fs/2), die Betragsanpassung unten gleicht den Rest aus
+    const double wp = std::min(w0 * poleScale, 0.9 * pi);
+    const double decay = std::exp(-zeta * wp);
+
+    a0 = 1.0;
+    a1 = zeta <= 1.0 ? -2.0 * decay * std::cos(std::sqrt(1.0 - zeta * zeta) * wp)
+                     : -2.0 * decay * std::cosh(std::sqrt(zeta * zeta - 1.0) * wp);
+    a2 = decay * decay;
+
+    // Notch: Nullstellen exakt auf dem Einheitskreis bei f0 (die Betragsanpassung
+    // kann |H(f0)| = 0 nicht erzwingen), Verstärkung an DC angepasst
+    if (type == ParameterIDs::FilterType::Notch)
+    {
+        const double cosw0 = std::cos(w0);
+        const double dcScale = (1.0 + a1 + a2) / (2.0 - 2.0 * cosw0);
+        b0 = dcScale;
+        b1 = -2.0 * cosw0 * dcScale;
+        b2 = dcScale;
+        return std::isfinite(dcScale);
+    }
+
+    // |A(e^jw)|² = A0·φ0 + A1·φ1 + A2·φ2 mit φ1 = sin²(w/2), φ0 = 1 - φ1, φ2 = 4·φ0·φ1
+    const double A0 = (1.0 + a1 + a2) * (1.0 + a1 + a2);
+    const double A1 = (1.0 - a1 + a2) * (1.0 - a1 + a2);
+    const double A2 = -4.0 * a2;
+
+    const double phi1 = std::sin(0.5 * w0) * std::sin(0.5 * w0);
+    const double phi0 = 1.0 - phi1;
+    const double phi2 = 4.0 * phi0 * phi1;
+
+    // Zähler-Betrag an DC, Nyquist und f0 auf den Analog-Prototyp legen
+    const double nyquist = 0.5 * sampleRate;
+    const double hDC = getAnalogMagnitude(type, frequency, gainDB, Q, 0.0);
+    const double hNyquist = getAnalogMagnitude(type, frequency, gainDB, Q, nyquist);
+    const double hCentre = getAnalogMagnitude(type, frequency, gainDB, Q, frequency);
+
+    const double B0 = A0 * hDC * hDC;
+    const double B1 = A1 * hNyquist * hNyquist;
+    const double B2 = (hCentre * hCentre * (A0 * phi0 + A1 * phi1 + A2 * phi2) - B0 * phi0 - B1 * phi1) / phi2;
+
+    // Minimalphasige Faktorisierung des Zähler-Betrags
+    const double sqrtB0 = std::sqrt(B0);
+    const double sqrtB1 = std::sqrt(B1);
+    const double W = 0.5 * (sqrtB0 + sqrtB1);
+    const double newB0 = 0.5 * (W + std::sqrt(std::max(0.0, W * W + B2)));
+    const double newB1 = 0.5 * (sqrtB0 - sqrtB1);
+    const double newB2 = newB0 > 0.0 ? -B2 / (4.0 * newB0) : 0.0;
+
+    if (!std::isfinite(newB0) || !std::isfinite(newB1) || !std::isfinite(newB2))
+        return false;
+
+    b0 = newB0;
+    b1 = newB1;
+    b2 = newB2;
+    return true;
+}
@@ -9,6 +9,13 @@
 /**
  * Biquad-Filter Implementierung basierend auf Robert Bristow-Johnson's Audio EQ Cookbook.
  * Unterstützt alle gängigen Filtertypen für einen parametrischen EQ.
+ *
+ * Alternativ (DesignMode::AnalogMatched) werden Bell, Shelves, BandPass und Notch
+ * betragsangepasst entworfen (nach Vicanek, "Matched Second Order Digital Filters"):
+ * Pole per Impulsinvarianz, Nullstellen so, dass |H| an DC, Mittenfrequenz und
+ * Nyquist exakt dem Analog-Prototyp entspricht (Notch: Nullstellen exakt bei f0).
+ * Damit entfällt die Stauchung der bilinearen Transformation Richtung Nyquist
+ * ohne Oversampling.
  * 
  * Differenzgleichung:
  * y[n] = (b0/a0)*x[n] + (b1/a0)*x[n-1] + (b2/a0)*x[n-2] - (a1/a0)*y[n-1] - (a2/a0)*y[n-2]
@@ -16,6 +23,13 @@
 class BiquadFilter
 {
 public:
+    // Koeffizienten-Design (Cut-, Tilt- und AllPass-Typen bleiben immer RBJ)
+    enum class DesignMode
+    {
+        Cookbook = 0,   // RBJ, bilineare Transformation
+        AnalogMatched   // Betrag an DC / Mittenfrequenz / Nyquist an den Analog-Prototyp angepasst
+    };
+
     BiquadFilter();
     ~BiquadFilter() = default;
 
@@ -32,11 +46,25 @@ public:
                            float Q,
                            int slope = 12);  // Slope in dB/Oktave (6, 12, 18, 24, 48)
 
-    // Audio verarbeiten (einzelner Sample)
-    float processSample(float input) noexcept;
+    // Wirkt ab dem nächsten updateCoefficients()
+    void setDesignMode(DesignMode mode) { designMode = mode; }
+    DesignMode getDesignMode() const { return designMode; }
+
+    // Typen, die analog-matched entworfen werden (Bell, Shelves, BandPass, Notch)
+    static bool supportsAnalogMatched(ParameterIDs::FilterType type) noexcept;
+
+    // Linearer Betrag des RBJ-Analog-Prototyps bei frequency (Hz) — Referenz für das
+    // Matched-Design und für Fehlermessungen. Nur für supportsAnalogMatched()-Typen.
+    static double getAnalogMagnitude(ParameterIDs::FilterType type, double centreFrequency,
+                                     double gainDB, double Q, double frequency) noexcept;
+
+    // Audio verarbeiten (einzelner Sample; float oder double, Zustände immer double)
+    template <typename SampleType>
+    SampleType processSample(SampleType input) noexcept;
     
     // Audio verarbeiten (Block)
-    void processBlock(float* data, int numSamples) noexcept;
+    template <typename SampleType>
+    void processBlock(SampleType* data, int numSamples) noexcept;
 
     // Frequenzantwort berechnen für GUI-Darstellung
     // Gibt Magnitude in dB zurück für eine gegebene Frequenz
@@ -51,6 +79,15 @@ public:
     float getQ() const { return currentQ; }
     ParameterIDs::FilterType getType() const { return currentType; }
 
+    // Normalisierte Ziel-Koeffizienten (a0 = 1) für externe Engines (z.B. BiquadCascade)
+    struct Coefficients
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0;
+        double a1 = 0.0, a2 = 0.0;
+    };
+
+    Coefficients getCoefficients() const noexcept { return { nb0, nb1, nb2, na1, na2 }; }
+
 private:
     // Koeffizienten
     double b0 = 1.0, b1 = 0.0, b2 = 0.0;
@@ -83,6 +120,7 @@ private:
     float currentGain = 0.0f;
     float currentQ = 0.71f;
     ParameterIDs::FilterType currentType = ParameterIDs::FilterType::Bell;
+    DesignMode designMode = DesignMode::Cookbook;
 
     // Koeffizienten-Berechnung für verschiedene Filtertypen
     void calculateBellCoefficients(float frequency, float gainDB, float Q);
@@ -96,6 +134,9 @@ private:
     void calculateAllPassCoefficients(float frequency, float Q);
     void calculateFlatTiltCoefficients(float frequency, float gainDB);
 
+    // Analog-Matched-Design; false bei numerischem Versagen (→ RBJ-Design)
+    bool calculateMatchedCoefficients(ParameterIDs::FilterType type, float frequency, float gainDB, float Q);
+
     // Hilfsfunktion: Koeffizienten normalisieren
     void normalizeCoefficients();
 
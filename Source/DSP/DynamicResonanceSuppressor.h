@@ -2,7 +2,11 @@
 
 #include <JuceHeader.h>
 #include "SVFFilter.h"
+#include "SpectralKernels.h"
+#include "SpectralSuppressionEngine.h"
+#include "../Utils/StageCpuMeter.h"
 #include <vector>
+#include <memory>
 #include <cmath>
 #include <array>
 
@@ -16,6 +20,13 @@
  * - Transient-Preservation (schützt Attacks)
  * - Frequenz-spezifische Thresholds
  * - Soft-Knee Kompression
+ * - Zwei Anwendungs-Engines: 16-Band SVF-Filterbank (latenzfrei) oder
+ *   STFT-Maske mit voller Bin-Auflösung (Latenz siehe getLatencyInSamples)
+ * - Eigene Detektions-FFT (Sidechain = Mono-Summe des Eingangs), unabhängig vom
+ *   Anzeige-Analyzer: Hann-Fenster, 87.5% Überlappung, ~21.5 Hz Bin-Raster bei
+ *   jeder Samplerate (2048 @ 44.1/48 kHz, 4096 @ 88.2/96 kHz, 8192 darüber).
+ *   Neue Gain-Reduktionen alle fftSize/8 Samples (~5.8 ms @ 44.1 kHz)
+ * - CPU-Last pro Stufe (Detektion, Gain-Computer, Anwendung) über getStageLoad()
  */
 class DynamicResonanceSuppressor
 {
@@ -46,6 +57,27 @@ public:
         float transientThreshold = 0.3f;  // 0-1
     };
     
+    //==========================================================================
+    // Anwendungs-Engine (Index = Parameter SUPPRESSOR_QUALITY)
+    //==========================================================================
+    enum class Engine
+    {
+        Filterbank = 0,  // 16 SVF-Bells, keine Latenz
+        Spectral         // Per-Bin Maske im STFT, Latenz = STFT-Fensterlänge
+    };
+    
+    //==========================================================================
+    // Verarbeitungsstufen für die CPU-Messung
+    //==========================================================================
+    enum class Stage
+    {
+        Detection = 0,  // Sidechain-Ring, Fenster, FFT, dB-Umrechnung
+        GainComputer,   // Lokaler Durchschnitt, Envelopes, Soft-Knee
+        Apply,          // Filterbank bzw. STFT-Maske
+        NumStages
+    };
+    static_assert(static_cast<int>(Stage::NumStages) <= StageCpuMeter::MAX_STAGES, "Zu viele Stufen");
+    
     //==========================================================================
     // Band-Status für Visualisierung
     //==========================================================================
@@ -71,22 +103,57 @@ public:
         sampleRate = newSampleRate;
         blockSize = newBlockSize;
         
-        // Envelope Follower Koeffizienten berechnen
+        // Detektions-FFT: gleiches Bin-Raster (~21.5 Hz) bei jeder Samplerate,
+        // darauf sind Selectivity-Fenster und Frequenz-Mapping abgestimmt
+        const int order = sampleRate > 96000.0 ? 13 : (sampleRate > 48000.0 ? 12 : 11);
+        setFFTSize(1 << order);
+        detectionHopSize = fftSize / DETECTION_OVERLAP;
+        
+        detectionFft = std::make_unique<juce::dsp::FFT>(order);
+        
+        detectionWindow.resize(static_cast<size_t>(fftSize));
+        float windowSum = 0.0f;
+        for (int i = 0; i < fftSize; ++i)
+        {
+            const float w = 0.5f - 0.5f * std::cos(2.0f * juce::MathConstants<float>::pi
+                                                   * static_cast<float>(i) / static_cast<float>(fftSize));
+            detectionWindow[static_cast<size_t>(i)] = w;
+            windowSum += w;
+        }
+        // Sinus mit Amplitude 1 → 0 dB im Peak-Bin
+        detectionScale = 2.0f / windowSum;
+        
+        detectionRing.assign(static_cast<size_t>(fftSize), 0.0f);
+        detectionFrame.assign(static_cast<size_t>(fftSize * 2), 0.0f);
+        detectionMagnitudesDb.assign(static_cast<size_t>(numBins), -100.0f);
+        
+        // Envelope Follower Koeffizienten berechnen (pro Hop)
         updateEnvelopeCoefficients();
         
+        cpuMeter.prepare(sampleRate);
+        
         // SVF Filterbank initialisieren
         initializeFilters();
         
+        // STFT-Engine immer vorbereiten → Umschalten im Audio-Thread ohne Allokation
+        spectralEngine.prepare(sampleRate);
+        
         reset();
     }
     
-    // FFT-Größe extern setzen (muss vor process() aufgerufen werden)
+    /**
+     * Bin-Raster für process() mit extern berechneten Magnitudes. Die eigene
+     * Detektion (analyzeBlock) setzt das Raster in prepare().
+     */
     void setFFTSize(int newFftSize)
     {
         fftSize = newFftSize;
         numBins = fftSize / 2 + 1;
     }
     
+    /** FFT-Größe der Detektion (Bin-Raster von getGainReductions()). */
+    int getAnalysisFftSize() const { return fftSize; }
+    
     void reset()
     {
         std::fill(envelopeStates.begin(), envelopeStates.end(), -100.0f);
@@ -95,6 +162,7 @@ public:
         std::fill(cachedGainReductions.begin(), cachedGainReductions.end(), 0.0f);
         std::fill(cachedLocalAverages.begin(), cachedLocalAverages.end(), -60.0f);
         std::fill(smoothingTempBuffer.begin(), smoothingTempBuffer.end(), 0.0f);
+        std::fill(detectionBuffer.begin(), detectionBuffer.end(), 0.0f);
         std::fill(previousMagnitudes.begin(), previousMagnitudes.end(), 0.0f);
         previousMagnitudesSize = 0;
         currentNumBins = 0;
@@ -104,6 +172,52 @@ public:
             for (int b = 0; b < NUM_SUPPRESS_BANDS; ++b)
                 suppressionFilters[ch][b].reset();
         std::fill(std::begin(currentBandGainDB), std::end(currentBandGainDB), 0.0f);
+        
+        spectralEngine.reset();
+        spectralEngine.setUnityMask();
+        
+        resetDetector();
+    }
+    
+    /** Engine wählen (Audio-Thread). Beim Wechsel starten beide Engines mit leerem Zustand. */
+    void setEngine(Engine newEngine)
+    {
+        if (engine == newEngine)
+            return;
+        
+        engine = newEngine;
+        reset();
+    }
+    
+    Engine getEngine() const { return engine; }
+    
+    /** Zusätzliche Latenz der aktiven Engine (Filterbank: 0). */
+    int getLatencyInSamples() const
+    {
+        return engine == Engine::Spectral ? spectralEngine.getLatencyInSamples() : 0;
+    }
+    
+    /**
+     * Suppressor aus: Die STFT-Engine läuft mit Einheits-Maske weiter (reine
+     * Verzögerung ohne FFT), damit die gemeldete Latenz konstant bleibt.
+     */
+    void processBypassed(juce::AudioBuffer<float>& buffer)
+    {
+        // Beim Wiedereinschalten nicht mit veraltetem Sidechain-Inhalt starten
+        detectorNeedsReset = true;
+        
+        if (engine != Engine::Spectral)
+            return;
+        
+        spectralEngine.setUnityMask();
+        spectralEngine.process(buffer);
+    }
+    
+    /** Suppressor aus ohne Audio-Zugriff: nur gültig, solange getLatencyInSamples() == 0. */
+    void notifyBypassed()
+    {
+        jassert(engine != Engine::Spectral);
+        detectorNeedsReset = true;
     }
     
     //==========================================================================
@@ -111,109 +225,168 @@ public:
     //==========================================================================
     
     /**
-     * Analysiert das Spektrum und berechnet Gain-Reduktionen
+     * Sidechain-Analyse im Audio-Thread: schiebt den Block (Mono-Summe) in den
+     * Detektions-Ring und rechnet an jeder Hop-Grenze FFT + Gain-Computer.
+     * Ergebnis in cachedGainReductions (RT-safe, keine Allokation).
+     */
+    void analyzeBlock(const juce::AudioBuffer<float>& buffer)
+    {
+        const int numSamples = buffer.getNumSamples();
+        const int numChannels = juce::jmin(buffer.getNumChannels(), MAX_PROCESS_CHANNELS);
+        
+        if (detectionFft == nullptr || numSamples == 0 || numChannels == 0)
+            return;
+        
+        if (detectorNeedsReset)
+        {
+            resetDetector();
+            std::fill(envelopeStates.begin(), envelopeStates.end(), -100.0f);
+            std::fill(gainReductionStates.begin(), gainReductionStates.end(), 0.0f);
+            currentNumBins = 0;
+        }
+        
+        const float channelGain = 1.0f / static_cast<float>(numChannels);
+        juce::int64 detectionTicks = 0;
+        juce::int64 gainComputerTicks = 0;
+        
+        int position = 0;
+        while (position < numSamples)
+        {
+            // Bis zur nächsten Hop-Grenze (fftSize ist Vielfaches des Hops → kein Ring-Überlauf)
+            const int chunk = juce::jmin(numSamples - position, detectionHopSize - detectionHopCounter);
+            
+            float* ring = detectionRing.data() + detectionWritePos;
+            juce::FloatVectorOperations::copyWithMultiply(ring, buffer.getReadPointer(0) + position,
+                                                          channelGain, chunk);
+            for (int ch = 1; ch < numChannels; ++ch)
+                juce::FloatVectorOperations::addWithMultiply(ring, buffer.getReadPointer(ch) + position,
+                                                             channelGain, chunk);
+            
+            detectionWritePos = (detectionWritePos + chunk) & (fftSize - 1);
+            detectionHopCounter += chunk;
+            position += chunk;
+            
+            if (detectionHopCounter == detectionHopSize)
+            {
+                detectionHopCounter = 0;
+                
+                const auto detectionStart = juce::Time::getHighResolutionTicks();
+                computeDetectionSpectrum();
+                const auto gainComputerStart = juce::Time::getHighResolutionTicks();
+                process(detectionMagnitudesDb.data(), numBins);
+                const auto gainComputerEnd = juce::Time::getHighResolutionTicks();
+                
+                detectionTicks += gainComputerStart - detectionStart;
+                gainComputerTicks += gainComputerEnd - gainComputerStart;
+            }
+        }
+        
+        cpuMeter.addMeasurement(static_cast<int>(Stage::Detection), detectionTicks, numSamples);
+        cpuMeter.addMeasurement(static_cast<int>(Stage::GainComputer), gainComputerTicks, numSamples);
+    }
+    
+    /**
+     * Berechnet Gain-Reduktionen aus einem Spektrum im Raster von setFFTSize()
      * @param magnitudesDb FFT-Magnitudes in dB
      * Ergebnis wird intern in cachedGainReductions gespeichert (RT-safe, keine Allokation)
      */
     void process(const std::vector<float>& magnitudesDb)
     {
-        const size_t inputNumBins = magnitudesDb.size();
-        
-        if (inputNumBins < 10 || inputNumBins > MAX_BINS)
+        process(magnitudesDb.data(), static_cast<int>(magnitudesDb.size()));
+    }
+    
+    void process(const float* magnitudesDb, int inputNumBins)
+    {
+        if (inputNumBins < 10 || inputNumBins > static_cast<int>(MAX_BINS))
             return;
         
         // Ergebnis-Array auf aktuelle Größe setzen (kein resize, nur Länge merken)
-        currentNumBins = static_cast<int>(inputNumBins);
+        currentNumBins = inputNumBins;
         
         // Zurücksetzen
-        for (size_t i = 0; i < inputNumBins; ++i)
-            cachedGainReductions[i] = 0.0f;
+        juce::FloatVectorOperations::clear(cachedGainReductions.data(), currentNumBins);
         
         // Lokalen Durchschnitt für jeden Bin berechnen
-        calculateLocalAverages(magnitudesDb);
+        calculateLocalAverages(magnitudesDb, inputNumBins);
         
         // Transient Detection
         bool isTransient = false;
         if (settings.transientProtection)
         {
-            isTransient = detectTransient(magnitudesDb);
+            isTransient = detectTransient(magnitudesDb, inputNumBins);
         }
         
-        // Für jeden Bin: Resonanz-Check und dynamische Unterdrückung
-        for (size_t i = 1; i < inputNumBins; ++i)
+        // Bin-Bereich des Frequenzbereichs (Bin 0/DC wird nie bearbeitet)
+        int firstBin = 1;
+        while (firstBin < currentNumBins && binToFrequency(firstBin) < settings.lowFreq)
+            ++firstBin;
+        
+        int endBin = firstBin;
+        while (endBin < currentNumBins && binToFrequency(endBin) <= settings.highFreq)
+            ++endBin;
+        
+        const int numActive = endBin - firstBin;
+        if (numActive <= 0)
+            return;  // Keine Bins im Bereich → Gain-Reduktionen bleiben 0 dB
+        
+        // Abweichung vom lokalen Durchschnitt → Envelope Following (Peak Detection)
+        float* deviation = detectionBuffer.data() + firstBin;
+        juce::FloatVectorOperations::subtract(deviation, magnitudesDb + firstBin,
+                                              cachedLocalAverages.data() + firstBin, numActive);
+        SpectralKernels::smoothAsymmetric(deviation, envelopeStates.data() + firstBin, numActive,
+                                          attackCoeff, releaseCoeff);
+        
+        // Threshold berechnen (dynamisch basierend auf Settings)
+        const float threshold = settings.threshold * (1.0f - settings.selectivity * 0.5f);
+        
+        // Depth-Skalierung und Transient-Schutz als ein Faktor
+        float gainScale = settings.depth;
+        if (isTransient && settings.transientProtection)
+            gainScale *= (1.0f - settings.transientThreshold);
+        
+        // Ziel-Gain-Reduktion pro Bin (Soft-Knee); unter dem Threshold → Release Richtung 0 dB
+        float* targetGainDb = detectionBuffer.data() + firstBin;
+        for (int i = 0; i < numActive; ++i)
         {
-            float freq = binToFrequency(static_cast<int>(i));
-            
-            // Frequenzbereich prüfen
-            if (freq < settings.lowFreq || freq > settings.highFreq)
-                continue;
-            
-            float input = magnitudesDb[i];
-            float localAvg = cachedLocalAverages[i];
-            float deviation = input - localAvg;
-            
-            // Envelope Following (Peak Detection) - sicherer Index
-            size_t envIdx = i % envelopeStates.size();
-            float& envelope = envelopeStates[envIdx];
-            if (deviation > envelope)
-            {
-                envelope = attackCoeff * envelope + (1.0f - attackCoeff) * deviation;
-            }
-            else
-            {
-                envelope = releaseCoeff * envelope + (1.0f - releaseCoeff) * deviation;
-            }
-            
-            // Threshold berechnen (dynamisch basierend auf Settings)
-            float threshold = settings.threshold * (1.0f - settings.selectivity * 0.5f);
-            
-            // Resonanz-Detektion
-            size_t grIdx = i % gainReductionStates.size();
-            float& grState = gainReductionStates[grIdx];
-            
-            if (envelope > threshold)
-            {
-                // Kompression berechnen (Soft-Knee)
-                float overThreshold = envelope - threshold;
-                float gainRedDb = calculateCompression(overThreshold);
-                
-                // Depth-Skalierung
-                gainRedDb *= settings.depth;
-                
-                // Transient-Schutz
-                if (isTransient && settings.transientProtection)
-                {
-                    gainRedDb *= (1.0f - settings.transientThreshold);
-                }
-                
-                // Smoothing der Gain-Reduktion (samplerate-abhängig)
-                if (gainRedDb < grState)
-                    grState = grState * grAttackCoeff + gainRedDb * (1.0f - grAttackCoeff);
-                else
-                    grState = grState * grReleaseCoeff + gainRedDb * (1.0f - grReleaseCoeff);
-                
-                cachedGainReductions[i] = grState;
-            }
-            else
-            {
-                // Release der Gain-Reduktion (samplerate-abhängig)
-                grState *= grReleaseCoeff;
-                cachedGainReductions[i] = grState;
-            }
+            const float envelope = envelopeStates[static_cast<size_t>(firstBin + i)];
+            targetGainDb[i] = calculateCompression(envelope - threshold) * gainScale;
         }
         
+        // Smoothing der Gain-Reduktion (samplerate-abhängig): Reduktion wird negativer
+        // → Attack, Erholung Richtung 0 dB → Release
+        SpectralKernels::smoothAsymmetric(targetGainDb, gainReductionStates.data() + firstBin, numActive,
+                                          grReleaseCoeff, grAttackCoeff);
+        
+        juce::FloatVectorOperations::copy(cachedGainReductions.data() + firstBin,
+                                          gainReductionStates.data() + firstBin, numActive);
+        
         // Optional: Gain-Reduktionen glätten über benachbarte Bins
         smoothGainReductions();
     }
     
     /**
      * Wendet die berechneten Gain-Reduktionen frequenzselektiv auf einen Audio-Buffer an.
-     * Nutzt eine 16-Band SVF-Filterbank (Cytomic TPT) für echte per-Frequenz Unterdrückung.
-     * Jedes Band wird dynamisch nur so weit gedämpft, wie die Resonanzerkennung es vorgibt.
-     * SVF-Topologie ist modulationsstabil — keine Clicks bei schnellen Gain-Änderungen.
+     * Filterbank: 16-Band SVF-Filterbank (Cytomic TPT), jedes Band wird dynamisch nur so
+     * weit gedämpft, wie die Resonanzerkennung es vorgibt. SVF-Topologie ist
+     * modulationsstabil — keine Clicks bei schnellen Gain-Änderungen.
+     * Spectral: per-Bin Maske (auf das STFT-Raster interpoliert) im Overlap-Add.
      */
-    void applyToBuffer(juce::AudioBuffer<float>& buffer, int /*fftSize*/)
+    void applyToBuffer(juce::AudioBuffer<float>& buffer)
     {
+        StageCpuMeter::ScopedStage stage(cpuMeter, static_cast<int>(Stage::Apply), buffer.getNumSamples());
+        
+        if (engine == Engine::Spectral)
+        {
+            // Auch ohne gültige Analyse weiterlaufen (Latenz muss konstant bleiben)
+            if (currentNumBins >= 10)
+                spectralEngine.setGainReductions(cachedGainReductions.data(), currentNumBins, fftSize);
+            else
+                spectralEngine.setUnityMask();
+            
+            spectralEngine.process(buffer);
+            return;
+        }
+        
         if (currentNumBins < 10 || !filtersInitialized)
             return;
         
@@ -348,6 +521,17 @@ public:
             updateBandFrequencies();
     }
     
+    /** Geglättete CPU-Last einer Stufe (Anteil eines Kerns, beliebiger Thread). */
+    float getStageLoad(Stage stage) const { return cpuMeter.getLoad(static_cast<int>(stage)); }
+    
+    /** Keine Gain-Reduktion mehr aktiv (alle Bins innerhalb IDLE_TOLERANCE_DB um 0 dB). */
+    bool isIdle() const
+    {
+        const float maxReduction = juce::FloatVectorOperations::findMinimum(gainReductionStates.data(),
+                                                                           static_cast<int>(gainReductionStates.size()));
+        return maxReduction > -IDLE_TOLERANCE_DB;
+    }
+    
     float getTotalGainReduction() const
     {
         float total = 0.0f;
@@ -383,6 +567,9 @@ private:
     // Separater Temp-Buffer für smoothGainReductions (nicht cachedLocalAverages missbrauchen)
     std::array<float, MAX_BINS> smoothingTempBuffer;
     
+    // Abweichung / Ziel-Gain-Reduktion pro Bin während process()
+    std::array<float, MAX_BINS> detectionBuffer;
+    
     // Vorheriges Spektrum für Transient-Detection (fixed-size, RT-safe)
     std::array<float, MAX_BINS> previousMagnitudes;
     int previousMagnitudesSize = 0;
@@ -408,6 +595,52 @@ private:
     float lastLowFreq = 0.0f;
     float lastHighFreq = 0.0f;
     
+    // Hochauflösende Alternative zur Filterbank
+    Engine engine = Engine::Filterbank;
+    SpectralSuppressionEngine spectralEngine;
+    
+    // Eigene Detektions-FFT (Sidechain)
+    static constexpr int DETECTION_OVERLAP = 8;
+    
+    // Restreduktion, unter der der Suppressor als entspannt gilt (isIdle)
+    static constexpr float IDLE_TOLERANCE_DB = 0.01f;
+    std::unique_ptr<juce::dsp::FFT> detectionFft;
+    std::vector<float> detectionWindow;
+    std::vector<float> detectionRing;           // Mono-Sidechain, fftSize Samples
+    std::vector<float> detectionFrame;          // 2 * fftSize (FFT-Arbeitspuffer)
+    std::vector<float> detectionMagnitudesDb;   // numBins
+    float detectionScale = 1.0f;
+    int detectionHopSize = 256;
+    int detectionWritePos = 0;
+    int detectionHopCounter = 0;
+    bool detectorNeedsReset = false;
+    
+    StageCpuMeter cpuMeter;
+    
+    void resetDetector()
+    {
+        std::fill(detectionRing.begin(), detectionRing.end(), 0.0f);
+        detectionWritePos = 0;
+        detectionHopCounter = 0;
+        previousMagnitudesSize = 0;
+        detectorNeedsReset = false;
+    }
+    
+    /** Ring zeitlich auspacken, fenstern, FFT → detectionMagnitudesDb. */
+    void computeDetectionSpectrum()
+    {
+        // Ältestes Sample liegt bei detectionWritePos
+        const int firstPart = fftSize - detectionWritePos;
+        std::copy(detectionRing.begin() + detectionWritePos, detectionRing.end(), detectionFrame.begin());
+        std::copy(detectionRing.begin(), detectionRing.begin() + detectionWritePos, detectionFrame.begin() + firstPart);
+        
+        juce::FloatVectorOperations::multiply(detectionFrame.data(), detectionWindow.data(), fftSize);
+        detectionFft->performFrequencyOnlyForwardTransform(detectionFrame.data(), true);
+        
+        SpectralKernels::gainToDecibels(detectionFrame.data(), detectionMagnitudesDb.data(), numBins,
+                                        detectionScale, -100.0f);
+    }
+    
     /**
      * Initialisiert die SVF-Filterbank mit logarithmisch verteilten Bändern.
      */
@@ -498,59 +731,38 @@ private:
         float attackMs = juce::jmap(settings.speed, 20.0f, 1.0f);
         float releaseMs = juce::jmap(settings.speed, 200.0f, 20.0f);
         
-        // Koeffizienten für Blockweise Verarbeitung
+        // Koeffizienten pro Detektions-Hop (ein process()-Aufruf je Hop)
+        const float hop = static_cast<float>(detectionHopSize);
         float attackSamples = static_cast<float>(sampleRate) * attackMs / 1000.0f;
         float releaseSamples = static_cast<float>(sampleRate) * releaseMs / 1000.0f;
         
-        attackCoeff = std::exp(-1.0f / (attackSamples / static_cast<float>(blockSize)));
-        releaseCoeff = std::exp(-1.0f / (releaseSamples / static_cast<float>(blockSize)));
+        attackCoeff = std::exp(-1.0f / (attackSamples / hop));
+        releaseCoeff = std::exp(-1.0f / (releaseSamples / hop));
         
         // Gain-Reduction Smoothing: 5ms Attack, 50ms Release (samplerate-abhängig)
         float grAttackSamples = static_cast<float>(sampleRate) * 0.005f;  // 5ms
         float grReleaseSamples = static_cast<float>(sampleRate) * 0.05f;  // 50ms
-        grAttackCoeff = std::exp(-1.0f / (grAttackSamples / static_cast<float>(blockSize)));
-        grReleaseCoeff = std::exp(-1.0f / (grReleaseSamples / static_cast<float>(blockSize)));
+        grAttackCoeff = std::exp(-1.0f / (grAttackSamples / hop));
+        grReleaseCoeff = std::exp(-1.0f / (grReleaseSamples / hop));
     }
     
     /**
      * Berechnet lokalen Durchschnitt für jeden Bin (RT-safe, nutzt cachedLocalAverages).
-     * Optimiert mit Prefix-Sum für O(n) statt O(n*windowSize).
      */
-    void calculateLocalAverages(const std::vector<float>& mags)
+    void calculateLocalAverages(const float* mags, int numBinsLocal)
     {
-        const size_t numBinsLocal = mags.size();
-        
-        if (numBinsLocal == 0 || numBinsLocal > MAX_BINS)
+        if (numBinsLocal <= 0 || numBinsLocal > static_cast<int>(MAX_BINS))
             return;
         
         // Fensterbreite basierend auf Selectivity
         int windowSize = static_cast<int>(21 + (1.0f - settings.selectivity) * 30);
         windowSize |= 1;  // Ungerade machen
-        int halfWindow = windowSize / 2;
         
-        // Prefix-Sum berechnen für O(1) Bereichssummen
-        // Nutze smoothingTempBuffer als Temp-Speicher (wird erst später in smoothGainReductions gebraucht)
-        auto& prefix = smoothingTempBuffer;
-        prefix[0] = mags[0];
-        for (size_t i = 1; i < numBinsLocal; ++i)
-            prefix[i] = prefix[i - 1] + mags[i];
-        
-        // Lokalen Durchschnitt pro Bin in O(1) berechnen
-        for (size_t i = 0; i < numBinsLocal; ++i)
-        {
-            int start = std::max(0, static_cast<int>(i) - halfWindow);
-            int end = std::min(static_cast<int>(numBinsLocal) - 1, static_cast<int>(i) + halfWindow);
-            
-            // Bereichssumme über Prefix-Sum: sum[start..end] = prefix[end] - prefix[start-1]
-            float windowSum = prefix[static_cast<size_t>(end)] 
-                            - (start > 0 ? prefix[static_cast<size_t>(start - 1)] : 0.0f);
-            
-            // Center-Bin abziehen (Durchschnitt der Nachbarn, ohne sich selbst)
-            float centerVal = mags[i];
-            int count = end - start;  // Elemente im Fenster minus 1 (Center ausgeschlossen)
-            
-            cachedLocalAverages[i] = count > 0 ? (windowSum - centerVal) / static_cast<float>(count) : -60.0f;
-        }
+        // Prefix-Sum-Kernel, O(n) unabhängig von der Fensterbreite.
+        // smoothingTempBuffer dient als Scratch (wird erst später in smoothGainReductions gebraucht)
+        SpectralKernels::localAverageExcludingCentre(mags, cachedLocalAverages.data(),
+                                                     smoothingTempBuffer.data(),
+                                                     numBinsLocal, windowSize / 2, -60.0f);
     }
     
     /**
@@ -582,22 +794,23 @@ private:
     /**
      * Transient-Detektion (schnelle Energie-Änderung)
      */
-    bool detectTransient(const std::vector<float>& mags)
+    bool detectTransient(const float* mags, int numBinsLocal)
     {
-        if (previousMagnitudesSize != static_cast<int>(mags.size()))
+        const int copySize = std::min(numBinsLocal, static_cast<int>(MAX_BINS));
+        
+        if (previousMagnitudesSize != numBinsLocal)
         {
-            size_t copySize = std::min(mags.size(), static_cast<size_t>(MAX_BINS));
-            std::copy(mags.begin(), mags.begin() + static_cast<std::ptrdiff_t>(copySize), previousMagnitudes.begin());
-            previousMagnitudesSize = static_cast<int>(copySize);
+            std::copy(mags, mags + copySize, previousMagnitudes.begin());
+            previousMagnitudesSize = copySize;
             return false;
         }
         
         float flux = 0.0f;
         int count = 0;
         
-        for (size_t i = 1; i < mags.size() && i < MAX_BINS; ++i)
+        for (int i = 1; i < copySize; ++i)
         {
-            float diff = mags[i] - previousMagnitudes[i];
+            float diff = mags[i] - previousMagnitudes[static_cast<size_t>(i)];
             if (diff > 0.0f)  // Nur positive Änderungen (Onsets)
             {
                 flux += diff;
@@ -605,9 +818,8 @@ private:
             }
         }
         
-        size_t copySize = std::min(mags.size(), static_cast<size_t>(MAX_BINS));
-        std::copy(mags.begin(), mags.begin() + static_cast<std::ptrdiff_t>(copySize), previousMagnitudes.begin());
-        previousMagnitudesSize = static_cast<int>(copySize);
+        std::copy(mags, mags + copySize, previousMagnitudes.begin());
+        previousMagnitudesSize = copySize;
         
         float avgFlux = count > 0 ? flux / static_cast<float>(count) : 0.0f;
         
@@ -1,37 +1,101 @@
 #include "EQBand.h"
 
+namespace
+{
+    // Der Dynamic-EQ-Detektor rechnet immer in float: float-Eingang wird
+    // vektorisiert kopiert, double-Eingang beim Laden gewandelt
+    void loadDetector(float* dest, const float* source, int numSamples)
+    {
+        juce::FloatVectorOperations::copy(dest, source, numSamples);
+    }
+
+    void loadDetector(float* dest, const double* source, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = static_cast<float>(source[i]);
+    }
+
+    // dest = a + b bzw. a - b (difference == true)
+    void loadDetectorSum(float* dest, const float* a, const float* b, int numSamples, bool difference)
+    {
+        if (difference)
+            juce::FloatVectorOperations::subtract(dest, a, b, numSamples);
+        else
+            juce::FloatVectorOperations::add(dest, a, b, numSamples);
+    }
+
+    void loadDetectorSum(float* dest, const double* a, const double* b, int numSamples, bool difference)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = static_cast<float>(difference ? a[i] - b[i] : a[i] + b[i]);
+    }
+}
+
 EQBand::EQBand()
 {
     updateFilters();
 }
 
-void EQBand::prepare(double sampleRate, int samplesPerBlock)
+void EQBand::prepare(double sampleRate, int samplesPerBlock, int oversamplingFactor)
+{
+    const int factor = juce::jmax(1, oversamplingFactor);
+    detectorSampleRate = sampleRate / static_cast<double>(factor);
+    
+    // Detektor läuft auf der Basis-Rate; Puffergrößen bleiben bei einem
+    // Oversampling-Wechsel gleich (keine Re-Allokation)
+    const int detectorBlockSize = juce::jmax(1, samplesPerBlock / factor);
+    detectorLeft.prepare(detectorSampleRate, detectorBlockSize);
+    detectorRight.prepare(detectorSampleRate, detectorBlockSize);
+    detectorScratchLeft.assign(static_cast<size_t>(detectorBlockSize), 0.0f);
+    detectorScratchRight.assign(static_cast<size_t>(detectorBlockSize), 0.0f);
+    gainPoints.assign(static_cast<size_t>(detectorBlockSize / MIN_CONTROL_INTERVAL + 2), 0.0f);
+    numGainPoints = 0;
+    updateDetectorFilters(true);
+    
+    setFilterRate(sampleRate, factor);
+    updateEnvelopeCoefficients();  // OPTIMIERUNG: Envelope-Koeffizienten initialisieren
+}
+
+void EQBand::setFilterRate(double sampleRate, int oversamplingFactor)
 {
+    auto& filters = getActiveFilters();
     currentSampleRate = sampleRate;
+    filters.oversampling = juce::jmax(1, oversamplingFactor);
     
+    // Biquad und SVF brauchen nur die Rate (Blockgröße ungenutzt)
     for (int i = 0; i < MAX_CASCADE; ++i)
     {
-        filtersLeft[i].prepare(sampleRate, samplesPerBlock);
-        filtersRight[i].prepare(sampleRate, samplesPerBlock);
+        filters.left[i].prepare(sampleRate, 0);
+        filters.right[i].prepare(sampleRate, 0);
     }
     
-    // SVF-Filter für Dynamic EQ initialisieren
-    svfLeft.prepare(sampleRate, samplesPerBlock);
-    svfRight.prepare(sampleRate, samplesPerBlock);
+    // SVF-Filter für Dynamic EQ initialisieren (tan() hängt von der Rate ab → neu setzen)
+    filters.svfLeft.prepare(sampleRate, 0);
+    filters.svfRight.prepare(sampleRate, 0);
+    filters.svfLeft.setParameters(filterType, frequency, lastDynamicGainDB, q);
+    filters.svfRight.setParameters(filterType, frequency, lastDynamicGainDB, q);
     
     updateFilters();
-    updateEnvelopeCoefficients();  // OPTIMIERUNG: Envelope-Koeffizienten initialisieren
+    filters.cascade.reset();  // Neue Koeffizienten sofort übernehmen (kein Einblenden nach prepare)
 }
 
 void EQBand::reset()
 {
-    for (int i = 0; i < MAX_CASCADE; ++i)
+    for (auto& filters : filterSets)
     {
-        filtersLeft[i].reset();
-        filtersRight[i].reset();
+        for (int i = 0; i < MAX_CASCADE; ++i)
+        {
+            filters.left[i].reset();
+            filters.right[i].reset();
+        }
+        filters.cascade.reset();
+        filters.svfLeft.reset();
+        filters.svfRight.reset();
     }
-    svfLeft.reset();
-    svfRight.reset();
+    detectorLeft.reset();
+    detectorRight.reset();
+    envelope = 0.0f;
+    numGainPoints = 0;
 }
 
 void EQBand::setFrequency(float newFrequency)
@@ -72,12 +136,20 @@ void EQBand::setType(ParameterIDs::FilterType type)
 
 void EQBand::setChannelMode(ParameterIDs::ChannelMode mode)
 {
-    channelMode = mode;
+    if (channelMode != mode)
+    {
+        channelMode = mode;
+        ++parameterVersion;
+    }
 }
 
 void EQBand::setBypassed(bool isBypassed)
 {
-    bypassed = isBypassed;
+    if (bypassed != isBypassed)
+    {
+        bypassed = isBypassed;
+        ++parameterVersion;
+    }
 }
 
 void EQBand::setSlope(int slopeDB)
@@ -94,18 +166,28 @@ void EQBand::setSlope(int slopeDB)
 // Dynamic EQ Setters (NEW)
 void EQBand::setDynamicMode(bool enabled)
 {
+    if (dynamicMode != enabled)
+        ++parameterVersion;
+    
     dynamicMode = enabled;
     if (enabled)
     {
-        envelopeLeft = 0.0f;
-        envelopeRight = 0.0f;
-        dynamicGainReduction = 0.0f;
+        envelope = 0.0f;
+        numGainPoints = 0;
+        lastDynamicGainDB = gain;
+        dynamicGainReduction.store(0.0f, std::memory_order_relaxed);
+        envelopeLevelDB.store(-100.0f, std::memory_order_relaxed);
     }
 }
 
 void EQBand::setThreshold(float thresholdDB)
 {
-    threshold = juce::jlimit(-60.0f, 0.0f, thresholdDB);
+    const float newThreshold = juce::jlimit(-60.0f, 0.0f, thresholdDB);
+    if (newThreshold != threshold)
+        ++displayVersion;   // Snapshot für die Anzeige, ohne Ketten-Rebuild
+    
+    threshold = newThreshold;
+    thresholdPower = std::pow(10.0f, threshold / 10.0f);
 }
 
 void EQBand::setRatio(float newRatio)
@@ -125,6 +207,30 @@ void EQBand::setRelease(float releaseMs)
     updateEnvelopeCoefficients();  // OPTIMIERUNG: Koeffizienten aktualisieren
 }
 
+void EQBand::setControlInterval(int samples)
+{
+    controlInterval.store(juce::jlimit(MIN_CONTROL_INTERVAL, MAX_CONTROL_INTERVAL, samples));
+}
+
+void EQBand::setDesignMode(BiquadFilter::DesignMode mode)
+{
+    if (designMode == mode)
+        return;
+
+    designMode = mode;
+
+    for (auto& filters : filterSets)
+    {
+        for (int i = 0; i < MAX_CASCADE; ++i)
+        {
+            filters.left[i].setDesignMode(mode);
+            filters.right[i].setDesignMode(mode);
+        }
+    }
+
+    updateFilters();  // neue Koeffizienten, erhöht parameterVersion
+}
+
 void EQBand::setParameters(float newFrequency, float gainDB, float newQ,
                             ParameterIDs::FilterType type,
                             ParameterIDs::ChannelMode newChannelMode,
@@ -136,11 +242,13 @@ void EQBand::setParameters(float newFrequency, float gainDB, float newQ,
     filterType = type;
     channelMode = newChannelMode;
     bypassed = isBypassed;
-    updateFilters();
+    updateFilters();  // erhöht parameterVersion (deckt Kanal/Bypass mit ab)
 }
 
 void EQBand::updateFilters()
 {
+    auto& filters = getActiveFilters();
+    
     // Gain pro Stufe für Cut-Filter (verteilen über Kaskaden)
     float gainPerStage = gain;
     
@@ -173,19 +281,47 @@ void EQBand::updateFilters()
                     / static_cast<float>(2 * totalOrder)));
             }
             
-            filtersLeft[i].updateCoefficients(filterType, frequency, gainPerStage, stageQ, slope);
-            filtersRight[i].updateCoefficients(filterType, frequency, gainPerStage, stageQ, slope);
+            filters.left[i].updateCoefficients(filterType, frequency, gainPerStage, stageQ, slope);
+            filters.right[i].updateCoefficients(filterType, frequency, gainPerStage, stageQ, slope);
         }
         else
         {
             // Nicht verwendete Stufen auf Unity setzen
-            filtersLeft[i].updateCoefficients(ParameterIDs::FilterType::Bell, 1000.0f, 0.0f, 1.0f);
-            filtersRight[i].updateCoefficients(ParameterIDs::FilterType::Bell, 1000.0f, 0.0f, 1.0f);
+            filters.left[i].updateCoefficients(ParameterIDs::FilterType::Bell, 1000.0f, 0.0f, 1.0f);
+            filters.right[i].updateCoefficients(ParameterIDs::FilterType::Bell, 1000.0f, 0.0f, 1.0f);
         }
+        
+        // SIMD-Kaskade mit denselben Koeffizienten versorgen
+        filters.cascade.setStageCoefficients(i, filters.left[i].getCoefficients());
     }
+    
+    filters.cascade.setNumStages(numCascadeStages);
+    ++parameterVersion;
 }
 
-void EQBand::processBlock(juce::AudioBuffer<float>& buffer)
+template <typename SampleType>
+void EQBand::processBlock(juce::AudioBuffer<SampleType>& buffer)
+{
+    processWithFilters(getActiveFilters(), buffer);
+}
+
+void EQBand::freezeFilters()
+{
+    // Bisheriger Satz bleibt eingefroren, der andere übernimmt auf derselben Rate
+    // (leerer Zustand, aktuelle Koeffizienten); setFilterRate() stellt danach ggf. um
+    const int factor = getActiveFilters().oversampling;
+    activeFilterSet ^= 1;
+    setFilterRate(currentSampleRate, factor);
+}
+
+template <typename SampleType>
+void EQBand::processFrozenBlock(juce::AudioBuffer<SampleType>& buffer)
+{
+    processWithFilters(filterSets[static_cast<size_t>(activeFilterSet ^ 1)], buffer);
+}
+
+template <typename SampleType>
+void EQBand::processWithFilters(FilterSet& filters, juce::AudioBuffer<SampleType>& buffer)
 {
     if (bypassed || !active)
         return;
@@ -193,81 +329,67 @@ void EQBand::processBlock(juce::AudioBuffer<float>& buffer)
     const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
 
-    if (numChannels < 2)
+    // Engine-Wechsel im Audio-Thread übernehmen; die neue Engine startet mit
+    // leerem Zustand (verhindert Sprünge durch veraltete Delay-Elemente)
+    const auto engine = requestedEngine.load();
+    if (engine != activeEngine)
     {
-        // Mono: nur linken Kanal verarbeiten
-        auto* data = buffer.getWritePointer(0);
-        
-        // Dynamic EQ für Mono — SVF-basiert (modulationsstabil)
-        if (dynamicMode)
+        activeEngine = engine;
+        if (activeEngine == CascadeEngine::SIMD)
         {
-            // Einmalig Basis-Parameter setzen (inkl. teurem tan())
-            svfLeft.setParameters(filterType, frequency, gain, q);
-            
-            for (int i = 0; i < numSamples; ++i)
-            {
-                float env = processEnvelope(std::abs(data[i]), envelopeLeft);
-                float dynamicGain = calculateDynamicGain(env);
-                float effectiveGain = gain * dynamicGain;
-                
-                // SVF: nur Gain-Update (kein tan() — ~10x schneller)
-                svfLeft.updateGainOnly(effectiveGain);
-                data[i] = svfLeft.processSample(data[i]);
-            }
+            filters.cascade.reset();
         }
         else
         {
-            // Standard Processing
-            for (int stage = 0; stage < numCascadeStages; ++stage)
+            for (int i = 0; i < MAX_CASCADE; ++i)
             {
-                filtersLeft[stage].processBlock(data, numSamples);
+                filters.left[i].reset();
+                filters.right[i].reset();
             }
         }
+    }
+
+    // Dynamic EQ: SVF mit Gain-Punkten aus analyzeDynamics()
+    if (dynamicMode)
+    {
+        processDynamicBlock(filters, buffer.getWritePointer(0),
+                            numChannels >= 2 ? buffer.getWritePointer(1) : nullptr,
+                            numSamples);
         return;
     }
 
-    auto* leftData = buffer.getWritePointer(0);
-    auto* rightData = buffer.getWritePointer(1);
+    // SIMD-Kaskade: alle Stufen, beide Kanäle und M/S-Routing in einem Pass
+    if (activeEngine == CascadeEngine::SIMD)
+    {
+        filters.cascade.process(buffer.getWritePointer(0),
+                        numChannels >= 2 ? buffer.getWritePointer(1) : nullptr,
+                        numSamples, channelMode);
+        return;
+    }
 
-    // Dynamic EQ Processing — SVF-basiert (modulationsstabil)
-    if (dynamicMode)
+    if (numChannels < 2)
     {
-        // Nur bei Parameteränderung (Frequenz/Q/Typ) teure tan()-Berechnung
-        if (svfLeft.needsFullUpdate(filterType, frequency, q))
-        {
-            svfLeft.setParameters(filterType, frequency, gain, q);
-            svfRight.setParameters(filterType, frequency, gain, q);
-        }
+        // Mono: nur linken Kanal verarbeiten
+        auto* data = buffer.getWritePointer(0);
         
-        for (int i = 0; i < numSamples; ++i)
+        for (int stage = 0; stage < numCascadeStages; ++stage)
         {
-            // Envelope Followers für beide Kanäle
-            float envL = processEnvelope(std::abs(leftData[i]), envelopeLeft);
-            float envR = processEnvelope(std::abs(rightData[i]), envelopeRight);
-            
-            // Nutze Maximum für linked Processing
-            float maxEnv = juce::jmax(envL, envR);
-            float dynamicGain = calculateDynamicGain(maxEnv);
-            float effectiveGain = gain * dynamicGain;
-            
-            // SVF: nur Gain-Update pro Sample (kein tan() — ~10x schneller)
-            svfLeft.updateGainOnly(effectiveGain);
-            svfRight.updateGainOnly(effectiveGain);
-            
-            leftData[i] = svfLeft.processSample(leftData[i]);
-            rightData[i] = svfRight.processSample(rightData[i]);
+            filters.left[stage].processBlock(data, numSamples);
         }
         return;
     }
 
+    auto* leftData = buffer.getWritePointer(0);
+    auto* rightData = buffer.getWritePointer(1);
+
     switch (channelMode)
     {
         case ParameterIDs::ChannelMode::Stereo:
             // Beide Kanäle gleich verarbeiten
             for (int stage = 0; stage < numCascadeStages; ++stage)
             {
-                filtersLeft[stage].processBlock(leftData, numSamples);
-                filtersRight[stage].processBlock(rightData, numSamples);
+                filters.left[stage].processBlock(leftData, numSamples);
+                filters.right[stage].processBlock(rightData, numSamples);
             }
             break;
 
@@ -275,7 +397,7 @@ void EQBand::processBlock(juce::AudioBuffer<float>& buffer)
             // Nur linken Kanal verarbeiten
             for (int stage = 0; stage < numCascadeStages; ++stage)
             {
-                filtersLeft[stage].processBlock(leftData, numSamples);
+                filters.left[stage].processBlock(leftData, numSamples);
             }
             break;
 
@@ -283,7 +405,7 @@ void EQBand::processBlock(juce::AudioBuffer<float>& buffer)
             // Nur rechten Kanal verarbeiten
             for (int stage = 0; stage < numCascadeStages; ++stage)
             {
-                filtersRight[stage].processBlock(rightData, numSamples);
+                filters.right[stage].processBlock(rightData, numSamples);
             }
             break;
 
@@ -293,8 +415,8 @@ void EQBand::processBlock(juce::AudioBuffer<float>& buffer)
             // Schritt 1: Encode gesamten Block zu M/S (Mid in leftData, Side in rightData)
             for (int i = 0; i < numSamples; ++i)
             {
-                const float mid = (leftData[i] + rightData[i]) * 0.5f;
-                const float side = (leftData[i] - rightData[i]) * 0.5f;
+                const SampleType mid = (leftData[i] + rightData[i]) * static_cast<SampleType>(0.5);
+                const SampleType side = (leftData[i] - rightData[i]) * static_cast<SampleType>(0.5);
                 leftData[i] = mid;
                 rightData[i] = side;
             }
@@ -304,22 +426,22 @@ void EQBand::processBlock(juce::AudioBuffer<float>& buffer)
             {
                 for (int stage = 0; stage < numCascadeStages; ++stage)
                 {
-                    filtersLeft[stage].processBlock(leftData, numSamples);
+                    filters.left[stage].processBlock(leftData, numSamples);
                 }
             }
             else // Side
             {
                 for (int stage = 0; stage < numCascadeStages; ++stage)
                 {
-                    filtersRight[stage].processBlock(rightData, numSamples);
+                    filters.right[stage].processBlock(rightData, numSamples);
                 }
             }
             
             // Schritt 3: Decode gesamten Block zurück zu L/R
             for (int i = 0; i < numSamples; ++i)
             {
-                const float left = leftData[i] + rightData[i];
-                const float right = leftData[i] - rightData[i];
+                const SampleType left = leftData[i] + rightData[i];
+                const SampleType right = leftData[i] - rightData[i];
                 leftData[i] = left;
                 rightData[i] = right;
             }
@@ -339,23 +461,25 @@ float EQBand::getMagnitudeForFrequency(float freq) const
     float totalMagnitude = 0.0f;
     for (int stage = 0; stage < numCascadeStages; ++stage)
     {
-        totalMagnitude += filtersLeft[stage].getMagnitudeForFrequency(freq);
+        totalMagnitude += getActiveFilters().left[stage].getMagnitudeForFrequency(freq);
     }
     return totalMagnitude;
 }
 
-void EQBand::encodeToMidSide(float& left, float& right)
+template <typename SampleType>
+void EQBand::encodeToMidSide(SampleType& left, SampleType& right)
 {
-    const float mid = (left + right) * 0.5f;
-    const float side = (left - right) * 0.5f;
+    const SampleType mid = (left + right) * static_cast<SampleType>(0.5);
+    const SampleType side = (left - right) * static_cast<SampleType>(0.5);
     left = mid;
     right = side;
 }
 
-void EQBand::decodeFromMidSide(float& mid, float& side)
+template <typename SampleType>
+void EQBand::decodeFromMidSide(SampleType& mid, SampleType& side)
 {
-    const float left = mid + side;
-    const float right = mid - side;
+    const SampleType left = mid + side;
+    const SampleType right = mid - side;
     mid = left;
     side = right;
 }
@@ -363,59 +487,250 @@ void EQBand::decodeFromMidSide(float& mid, float& side)
 // OPTIMIERUNG: Envelope-Koeffizienten einmalig berechnen (nicht pro Sample!)
 void EQBand::updateEnvelopeCoefficients()
 {
-    if (currentSampleRate <= 0.0) return;
+    if (detectorSampleRate <= 0.0) return;
     
-    float attackTimeSamples = attack * 0.001f * static_cast<float>(currentSampleRate);
-    float releaseTimeSamples = release * 0.001f * static_cast<float>(currentSampleRate);
+    // Hüllkurve läuft auf der Detektor-Rate (Basis-Rate)
+    float attackTimeSamples = attack * 0.001f * static_cast<float>(detectorSampleRate);
+    float releaseTimeSamples = release * 0.001f * static_cast<float>(detectorSampleRate);
     
     cachedAttackCoeff = std::exp(-1.0f / std::max(1.0f, attackTimeSamples));
     cachedReleaseCoeff = std::exp(-1.0f / std::max(1.0f, releaseTimeSamples));
 }
 
-// Dynamic EQ Processing Functions (OPTIMIZED)
-float EQBand::processEnvelope(float input, float& envelope)
+void EQBand::updateDetectorFilters(bool force)
 {
-    // RMS-ähnliche Envelope Follower
-    float inputSquared = input * input;
+    // Detektor hört nur den Bereich, den das Band bearbeitet
+    auto detectorType = ParameterIDs::FilterType::BandPass;
+    float detectorQ = q;
     
-    // OPTIMIERUNG: Verwende gecachte Koeffizienten statt exp() pro Sample
-    // Envelope Update
-    if (inputSquared > envelope)
+    switch (filterType)
     {
-        // Attack
-        envelope = cachedAttackCoeff * envelope + (1.0f - cachedAttackCoeff) * inputSquared;
+        case ParameterIDs::FilterType::LowShelf:
+        case ParameterIDs::FilterType::LowCut:
+            detectorType = ParameterIDs::FilterType::HighCut;  // Tiefpass
+            detectorQ = 0.71f;
+            break;
+        
+        case ParameterIDs::FilterType::HighShelf:
+        case ParameterIDs::FilterType::HighCut:
+            detectorType = ParameterIDs::FilterType::LowCut;   // Hochpass
+            detectorQ = 0.71f;
+            break;
+        
+        default:
+            break;
     }
-    else
+    
+    if (!force && !detectorLeft.needsFullUpdate(detectorType, frequency, detectorQ))
+        return;
+    
+    detectorLeft.setParameters(detectorType, frequency, 0.0f, detectorQ);
+    detectorRight.setParameters(detectorType, frequency, 0.0f, detectorQ);
+    
+    // SVF-Bandpass hat Peak-Gain Q → Leistung auf 0 dB in Bandmitte normieren
+    const float clampedQ = juce::jlimit(0.1f, 18.0f, detectorQ);
+    detectorPowerScale = (detectorType == ParameterIDs::FilterType::BandPass) ? 1.0f / (clampedQ * clampedQ) : 1.0f;
+}
+
+template <typename SampleType>
+void EQBand::analyzeDynamics(const SampleType* left, const SampleType* right, int numSamples)
+{
+    numGainPoints = 0;
+    
+    if (!dynamicMode || bypassed || !active || numSamples <= 0 || gainPoints.empty())
+        return;
+    
+    updateDetectorFilters();
+    
+    // Mehr Samples als angekündigt → größerer Punktabstand, Punkte passen immer
+    const int maxPoints = static_cast<int>(gainPoints.size());
+    const int spacing = juce::jmax(controlInterval.load(std::memory_order_relaxed),
+                                   (numSamples + maxPoints - 1) / maxPoints);
+    gainPointSpacing = spacing;
+    gainPointBlockLength = numSamples;
+    
+    const bool stereoDetector = right != nullptr;
+    float* detector = detectorScratchLeft.data();
+    float* detectorSecond = detectorScratchRight.data();
+    const int scratchSize = static_cast<int>(detectorScratchLeft.size());
+    
+    float gainReductionDB = 0.0f;
+    auto addGainPoint = [this, &gainReductionDB]
     {
-        // Release
-        envelope = cachedReleaseCoeff * envelope + (1.0f - cachedReleaseCoeff) * inputSquared;
+        const float scale = calculateDynamicGain(envelope * detectorPowerScale, gainReductionDB);
+        gainPoints[static_cast<size_t>(numGainPoints++)] = gain * scale;
+    };
+    
+    int untilNextPoint = spacing;
+    
+    for (int offset = 0; offset < numSamples; offset += scratchSize)
+    {
+        const int n = juce::jmin(scratchSize, numSamples - offset);
+        const SampleType* l = left + offset;
+        const SampleType* r = stereoDetector ? right + offset : nullptr;
+        
+        // Detektor-Signal nach Kanal-Modus (gleiche Zuordnung wie der Audio-Pfad)
+        bool twoChannels = false;
+        if (r == nullptr || channelMode == ParameterIDs::ChannelMode::Left)
+        {
+            loadDetector(detector, l, n);
+        }
+        else if (channelMode == ParameterIDs::ChannelMode::Right)
+        {
+            loadDetector(detector, r, n);
+        }
+        else if (channelMode == ParameterIDs::ChannelMode::Mid)
+        {
+            loadDetectorSum(detector, l, r, n, false);
+            juce::FloatVectorOperations::multiply(detector, 0.5f, n);
+        }
+        else if (channelMode == ParameterIDs::ChannelMode::Side)
+        {
+            loadDetectorSum(detector, l, r, n, true);
+            juce::FloatVectorOperations::multiply(detector, 0.5f, n);
+        }
+        else
+        {
+            loadDetector(detector, l, n);
+            loadDetector(detectorSecond, r, n);
+            twoChannels = true;
+        }
+        
+        // Bandbegrenzen, quadrieren, Stereo verlinken (Maximum der Leistungen)
+        detectorLeft.processBlockFast(detector, n);
+        juce::FloatVectorOperations::multiply(detector, detector, n);
+        
+        if (twoChannels)
+        {
+            detectorRight.processBlockFast(detectorSecond, n);
+            juce::FloatVectorOperations::multiply(detectorSecond, detectorSecond, n);
+            juce::FloatVectorOperations::max(detector, detector, detectorSecond, n);
+        }
+        
+        // Hüllkurve (linear, einziger serieller Teil); Gain nur an Kontrollpunkten
+        float env = envelope;
+        for (int i = 0; i < n; ++i)
+        {
+            const float power = detector[i];
+            const float coeff = power > env ? cachedAttackCoeff : cachedReleaseCoeff;
+            env = power + coeff * (env - power);
+            
+            if (--untilNextPoint == 0)
+            {
+                envelope = env;
+                addGainPoint();
+                untilNextPoint = spacing;
+            }
+        }
+        envelope = env;
     }
     
-    // OPTIMIERUNG: Schnellere dB-Approximation für Envelope
-    // log10(x) ≈ (x-1)/(x+1) * 2/ln(10) für x nahe 1, aber wir brauchen genaueren Wert
-    float envelopeDB = 10.0f * std::log10(envelope + 1e-10f);
-    return envelopeDB;
+    // Letztes (kürzeres) Segment endet am Blockende
+    if (untilNextPoint != spacing)
+        addGainPoint();
+    
+    lastDynamicGainDB = gainPoints[static_cast<size_t>(numGainPoints - 1)];
+    ++gainPointsGeneration;
+    
+    // Metering einmal pro Block
+    const float levelPower = envelope * detectorPowerScale;
+    envelopeLevelDB.store(levelPower > 1e-10f ? 10.0f * std::log10(levelPower) : -100.0f, std::memory_order_relaxed);
+    dynamicGainReduction.store(gainReductionDB, std::memory_order_relaxed);
 }
 
-float EQBand::calculateDynamicGain(float envelopeDB)
+template <typename SampleType>
+void EQBand::processDynamicBlock(FilterSet& filters, SampleType* left, SampleType* right, int numSamples)
 {
-    // Berechne Gain Reduction basierend auf Threshold und Ratio
-    float overThreshold = envelopeDB - threshold;
+    // Nur bei Parameteränderung (Frequenz/Q/Typ) teure tan()-Berechnung
+    if (filters.svfLeft.needsFullUpdate(filterType, frequency, q))
+    {
+        filters.svfLeft.setParameters(filterType, frequency, lastDynamicGainDB, q);
+        filters.svfRight.setParameters(filterType, frequency, lastDynamicGainDB, q);
+    }
+    
+    // Kanal-Routing wie im statischen Pfad (M/S: Encode → ein Kanal → Decode)
+    SVFFilter* firstFilter = &filters.svfLeft;
+    SVFFilter* secondFilter = &filters.svfRight;
+    SampleType* first = left;
+    SampleType* second = right;
+    const bool midSide = right != nullptr
+                      && (channelMode == ParameterIDs::ChannelMode::Mid || channelMode == ParameterIDs::ChannelMode::Side);
+    
+    if (midSide)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            encodeToMidSide(left[i], right[i]);
+    }
+    
+    if (right == nullptr || channelMode == ParameterIDs::ChannelMode::Left || channelMode == ParameterIDs::ChannelMode::Mid)
+    {
+        second = nullptr;
+        secondFilter = nullptr;
+    }
+    else if (channelMode == ParameterIDs::ChannelMode::Right || channelMode == ParameterIDs::ChannelMode::Side)
+    {
+        first = right;
+        firstFilter = &filters.svfRight;
+        second = nullptr;
+        secondFilter = nullptr;
+    }
     
-    if (overThreshold > 0.0f)
+    // Gain-Punkte gelten für diesen Block, wenn die Länge passt und der Filtersatz
+    // sie noch nicht verarbeitet hat; sonst (kein Detektor-Lauf, z.B. anderer
+    // Aufrufer) den letzten Gain halten
+    if (numGainPoints > 0 && filters.gainPointsRead != gainPointsGeneration
+        && gainPointBlockLength * filters.oversampling == numSamples)
     {
-        // Über Threshold: Gain Reduction anwenden
-        float gainReductionDB = overThreshold * (1.0f - 1.0f / ratio);
-        dynamicGainReduction = gainReductionDB;
+        const int spacing = gainPointSpacing * filters.oversampling;
+        int offset = 0;
         
-        // Konvertiere zu linearem Skalierungsfaktor (0.0 - 1.0)
-        // FIX: Clamp auf [0, 1] — ohne Clamp konnte der Wert negativ werden
-        // und die EQ-Band-Polarität umkehren wenn gain klein war
-        float absGain = std::abs(gain) + 1e-6f;
-        float dynamicScale = 1.0f - (gainReductionDB / absGain);
-        return juce::jlimit(0.0f, 1.0f, dynamicScale);
+        for (int p = 0; p < numGainPoints && offset < numSamples; ++p)
+        {
+            const int length = juce::jmin(spacing, numSamples - offset);
+            const auto target = firstFilter->getCoefficientsForGain(gainPoints[static_cast<size_t>(p)]);
+            SVFFilter::processRamped(*firstFilter, first + offset, secondFilter,
+                                     second != nullptr ? second + offset : nullptr, length, target);
+            offset += length;
+        }
+    }
+    else
+    {
+        SVFFilter::processRamped(*firstFilter, first, secondFilter, second, numSamples,
+                                 firstFilter->getCoefficientsForGain(lastDynamicGainDB));
     }
     
-    dynamicGainReduction = 0.0f;
-    return 1.0f;  // Kein Effekt unter Threshold
+    filters.gainPointsRead = gainPointsGeneration;  // verbraucht (pro Filtersatz)
+    
+    if (midSide)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            decodeFromMidSide(left[i], right[i]);
+    }
+}
+
+float EQBand::calculateDynamicGain(float envelopePower, float& gainReductionDB) const
+{
+    // Unter Threshold: kein Effekt (linearer Vergleich, kein log10)
+    if (envelopePower <= thresholdPower)
+    {
+        gainReductionDB = 0.0f;
+        return 1.0f;
+    }
+    
+    // Über Threshold: Gain Reduction anwenden
+    const float overThreshold = 10.0f * std::log10(envelopePower) - threshold;
+    gainReductionDB = overThreshold * (1.0f - 1.0f / ratio);
+    
+    // Konvertiere zu linearem Skalierungsfaktor (0.0 - 1.0)
+    // FIX: Clamp auf [0, 1] — ohne Clamp konnte der Wert negativ werden
+    // und die EQ-Band-Polarität umkehren wenn gain klein war
+    const float absGain = std::abs(gain) + 1e-6f;
+    return juce::jlimit(0.0f, 1.0f, 1.0f - gainReductionDB / absGain);
 }
+
+template void EQBand::processBlock<float>(juce::AudioBuffer<float>&);
+template void EQBand::processBlock<double>(juce::AudioBuffer<double>&);
+template void EQBand::processFrozenBlock<float>(juce::AudioBuffer<float>&);
+template void EQBand::processFrozenBlock<double>(juce::AudioBuffer<double>&);
+template void EQBand::analyzeDynamics<float>(const float*, const float*, int);
+template void EQBand::analyzeDynamics<double>(const double*, const double*, int);
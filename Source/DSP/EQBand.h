@@ -2,22 +2,53 @@
 
 #include <JuceHeader.h>
 #include "BiquadFilter.h"
+#include "BiquadCascade.h"
 #include "SVFFilter.h"
 #include "../Parameters/ParameterIDs.h"
 
 /**
  * EQ-Band: Verwaltet einen einzelnen EQ-Punkt mit allen zugehörigen Parametern
  * und Filtern für Stereo/Mid-Side-Verarbeitung.
+ *
+ * Dynamic EQ läuft in zwei Schritten:
+ * - analyzeDynamics() (Basis-Rate, vor Lookahead/Oversampling): bandbegrenzter
+ *   Detektor (SVF auf Bandfrequenz), Hüllkurve linear auf der Leistung,
+ *   Gain-Berechnung nur alle controlInterval Samples → Gain-Punkte für den Block
+ * - processBlock() (Filter-Rate): SVF-Koeffizienten laufen pro Sample linear
+ *   zwischen den Gain-Punkten (kein pow()/log10() pro Sample)
  */
 class EQBand
 {
 public:
+    // Verarbeitungs-Engine für die statische Biquad-Kaskade (A/B-vergleichbar)
+    enum class CascadeEngine
+    {
+        Scalar = 0,  // Klassisch: eine BiquadFilter-Stufe pro Pass und Kanal
+        SIMD         // BiquadCascade: alle Stufen + L/R in einem Pass
+    };
+
     EQBand();
     ~EQBand() = default;
 
-    void prepare(double sampleRate, int samplesPerBlock);
+    static constexpr int DEFAULT_CONTROL_INTERVAL = 32;  // Gain-Update alle N Samples (Basis-Rate)
+    static constexpr int MIN_CONTROL_INTERVAL = 4;
+    static constexpr int MAX_CONTROL_INTERVAL = 256;
+
+    /**
+     * @param oversamplingFactor  Verhältnis Filter-Rate / Rate des Detektor-Signals
+     *                            (analyzeDynamics läuft auf sampleRate / oversamplingFactor)
+     */
+    void prepare(double sampleRate, int samplesPerBlock, int oversamplingFactor = 1);
     void reset();
 
+    /**
+     * Wechselt die Filter-Rate ohne Allokation (Filter-Zustände starten leer).
+     * Der Detektor bleibt auf der Basis-Rate aus prepare(); oversamplingFactor
+     * ist das neue Verhältnis Filter-Rate / Basis-Rate.
+     */
+    void setFilterRate(double sampleRate, int oversamplingFactor);
+    double getFilterRate() const { return currentSampleRate; }
+
     // Parameter setzen
     void setFrequency(float frequency);
     void setGain(float gainDB);
@@ -26,6 +57,14 @@ public:
     void setChannelMode(ParameterIDs::ChannelMode mode);
     void setBypassed(bool bypassed);
     void setSlope(int slopeDB);  // 6, 12, 18, 24, 48 dB/Oct
+
+    // Engine-Wahl (thread-safe: Umschaltung wird im Audio-Thread übernommen)
+    void setCascadeEngine(CascadeEngine engine) { requestedEngine.store(engine); }
+    CascadeEngine getCascadeEngine() const { return requestedEngine.load(); }
+
+    // Koeffizienten-Design aller Stufen (Audio-Thread, s. EQProcessor::setFilterDesign)
+    void setDesignMode(BiquadFilter::DesignMode mode);
+    BiquadFilter::DesignMode getDesignMode() const { return designMode; }
     
     // Dynamic EQ Parameters (NEW)
     void setDynamicMode(bool enabled);
@@ -33,6 +72,8 @@ public:
     void setRatio(float ratio);
     void setAttack(float attackMs);
     void setRelease(float releaseMs);
+    void setExternalSidechain(bool enabled) { externalSidechain = enabled; }
+    void setControlInterval(int samples);
 
     // Alle Parameter auf einmal setzen
     void setParameters(float frequency, float gainDB, float Q, 
@@ -40,8 +81,28 @@ public:
                        ParameterIDs::ChannelMode channelMode = ParameterIDs::ChannelMode::Stereo,
                        bool bypassed = false);
 
-    // Audio verarbeiten (Stereo)
-    void processBlock(juce::AudioBuffer<float>& buffer);
+    // Audio verarbeiten (Stereo); float und double (explizit instanziiert)
+    template <typename SampleType>
+    void processBlock(juce::AudioBuffer<SampleType>& buffer);
+
+    /**
+     * Oversampling-Wechsel (Audio-Thread, vor setFilterRate): der bisherige Filtersatz
+     * bleibt mit Zustand, Rate und Koeffizienten eingefroren, ein zweiter übernimmt mit
+     * leerem Zustand. processFrozenBlock() verarbeitet den ausblendenden Pfad damit
+     * (gleiche Dynamic-Gain-Punkte wie processBlock()). Allokationsfrei.
+     */
+    void freezeFilters();
+
+    template <typename SampleType>
+    void processFrozenBlock(juce::AudioBuffer<SampleType>& buffer);
+
+    /**
+     * Dynamic EQ: Detektor für den nächsten processBlock()-Aufruf (Basis-Rate,
+     * unverzögertes Signal bzw. externe Sidechain). right == nullptr → Mono.
+     * RT-safe, keine Allokation. Der Detektor selbst rechnet immer in float.
+     */
+    template <typename SampleType>
+    void analyzeDynamics(const SampleType* left, const SampleType* right, int numSamples);
 
     // Frequenzantwort für GUI
     float getMagnitudeForFrequency(float frequency) const;
@@ -54,7 +115,27 @@ public:
     ParameterIDs::ChannelMode getChannelMode() const { return channelMode; }
     bool isBypassed() const { return bypassed; }
     bool isActive() const { return active; }
-    void setActive(bool isActive) { active = isActive; }
+    void setActive(bool isActive)
+    {
+        if (active != isActive)
+        {
+            active = isActive;
+            ++parameterVersion;
+        }
+    }
+    
+    // Kaskaden-Infos für den fusionierten EQProcessor-Pfad
+    int getNumCascadeStages() const { return numCascadeStages; }
+    BiquadFilter::Coefficients getStageCoefficients(int stage) const
+    {
+        return getActiveFilters().left[static_cast<size_t>(juce::jlimit(0, MAX_CASCADE - 1, stage))].getCoefficients();
+    }
+    
+    // Wird bei jeder Koeffizienten-/Routing-Änderung erhöht (Rebuild-Erkennung)
+    uint32_t getParameterVersion() const { return parameterVersion.load(); }
+    
+    // Wird bei Änderungen erhöht, die nur die Anzeige betreffen (Dynamic-Threshold)
+    uint32_t getDisplayVersion() const { return displayVersion.load(); }
     
     // Dynamic EQ Getters (NEW)
     bool isDynamicMode() const { return dynamicMode; }
@@ -62,28 +143,60 @@ public:
     float getRatio() const { return ratio; }
     float getAttack() const { return attack; }
     float getRelease() const { return release; }
-    float getDynamicGainReduction() const { return dynamicGainReduction; }  // Für Metering
+    bool usesExternalSidechain() const { return externalSidechain; }
+    int getControlInterval() const { return controlInterval.load(); }
+    float getDynamicGainReduction() const { return dynamicGainReduction.load(std::memory_order_relaxed); }  // Für Metering
     
-    // Signal-Level in dB (für GUI: Level-Indikator am Handle)
-    float getEnvelopeLevelDB() const
-    {
-        float env = juce::jmax(envelopeLeft, envelopeRight);
-        if (env < 1e-10f) return -100.0f;
-        return 10.0f * std::log10(env + 1e-10f);
-    }
+    // Signal-Level im Detektor-Band in dB (für GUI: Level-Indikator am Handle)
+    float getEnvelopeLevelDB() const { return envelopeLevelDB.load(std::memory_order_relaxed); }
 
 private:
-    // Filter für jeden Kanal (L, R oder Mid, Side)
     // Mehrere Filter für höhere Slopes (kaskadiert)
     static constexpr int MAX_CASCADE = 8;  // Bis zu 96 dB/Oct (8 x 12 dB)
-    static constexpr int DYNAMIC_UPDATE_INTERVAL = 32;  // Koeffizienten-Update alle N Samples (Performance!)
     
-    std::array<BiquadFilter, MAX_CASCADE> filtersLeft;
-    std::array<BiquadFilter, MAX_CASCADE> filtersRight;
+    // Alle Filter einer Filter-Rate. Zwei Sätze: beim Oversampling-Wechsel läuft
+    // der bisherige eingefroren weiter (s. freezeFilters)
+    struct FilterSet
+    {
+        // Filter für jeden Kanal (L, R oder Mid, Side)
+        std::array<BiquadFilter, MAX_CASCADE> left;
+        std::array<BiquadFilter, MAX_CASCADE> right;
+        
+        // Vektorisierte Kaskade (nutzt die Koeffizienten aus left)
+        BiquadCascade cascade;
+        
+        // SVF-Filter für Dynamic EQ (modulationsstabil — kein Zipper-Rauschen)
+        SVFFilter svfLeft;
+        SVFFilter svfRight;
+        
+        int oversampling = 1;         // Filter-Rate / Basis-Rate
+        uint32_t gainPointsRead = 0;  // zuletzt verarbeitete Gain-Punkt-Generation
+    };
+    
+    std::array<FilterSet, 2> filterSets;
+    int activeFilterSet = 0;
+    FilterSet& getActiveFilters() { return filterSets[static_cast<size_t>(activeFilterSet)]; }
+    const FilterSet& getActiveFilters() const { return filterSets[static_cast<size_t>(activeFilterSet)]; }
+    
+    std::atomic<CascadeEngine> requestedEngine { CascadeEngine::SIMD };
+    CascadeEngine activeEngine = CascadeEngine::SIMD;
+    BiquadFilter::DesignMode designMode = BiquadFilter::DesignMode::Cookbook;
     
-    // SVF-Filter für Dynamic EQ (modulationsstabil — kein Zipper-Rauschen)
-    SVFFilter svfLeft;
-    SVFFilter svfRight;
+    // Bandbegrenzter Detektor (Basis-Rate)
+    SVFFilter detectorLeft;
+    SVFFilter detectorRight;
+    std::vector<float> detectorScratchLeft;
+    std::vector<float> detectorScratchRight;
+    float detectorPowerScale = 1.0f;  // Bandpass: Peak-Gain Q → 1
+    
+    // Gain-Punkte des nächsten Blocks: effektiver Band-Gain (dB) am Ende jedes
+    // Segments (Segmentlänge gainPointSpacing, das letzte endet am Blockende)
+    std::vector<float> gainPoints;
+    int numGainPoints = 0;
+    int gainPointSpacing = 0;        // Detektor-Samples zwischen zwei Punkten
+    int gainPointBlockLength = 0;    // Detektor-Samples des analysierten Blocks
+    uint32_t gainPointsGeneration = 0;  // erhöht mit jedem analyzeDynamics() mit Punkten
+    float lastDynamicGainDB = 0.0f;  // effektiver Band-Gain am Ende des letzten Blocks
     
     // Parameter
     float frequency = 1000.0f;
@@ -101,31 +214,44 @@ private:
     float ratio = 1.0f;           // 1:1 bis 10:1
     float attack = 10.0f;         // ms
     float release = 100.0f;       // ms
+    float thresholdPower = 1.0f;  // 10^(threshold/10), Vergleich ohne log10()
+    bool externalSidechain = false;
+    std::atomic<int> controlInterval { DEFAULT_CONTROL_INTERVAL };
     
-    // Envelope Follower für Dynamic EQ
-    float envelopeLeft = 0.0f;
-    float envelopeRight = 0.0f;
-    float dynamicGainReduction = 0.0f;
+    // Envelope Follower für Dynamic EQ (Leistung, linear)
+    float envelope = 0.0f;
+    std::atomic<float> envelopeLevelDB { -100.0f };
+    std::atomic<float> dynamicGainReduction { 0.0f };
     
     // OPTIMIERUNG: Gecachte Koeffizienten (berechnet in prepare/setAttack/setRelease)
     float cachedAttackCoeff = 0.0f;
     float cachedReleaseCoeff = 0.0f;
-    float lastDynamicGain = 1.0f;  // Für Koeffizienten-Änderungserkennung
 
     double currentSampleRate = 44100.0;
+    double detectorSampleRate = 44100.0;
     int numCascadeStages = 1;
+    
+    std::atomic<uint32_t> parameterVersion { 0 };
+    std::atomic<uint32_t> displayVersion { 0 };
 
     // Koeffizienten aktualisieren
     void updateFilters();
     void updateEnvelopeCoefficients();  // OPTIMIERUNG: Envelope-Koeffizienten cachen
 
     // Mid/Side Encoding/Decoding
-    void encodeToMidSide(float& left, float& right);
-    void decodeFromMidSide(float& mid, float& side);
+    template <typename SampleType>
+    static void encodeToMidSide(SampleType& left, SampleType& right);
+    template <typename SampleType>
+    static void decodeFromMidSide(SampleType& mid, SampleType& side);
+    
+    template <typename SampleType>
+    void processWithFilters(FilterSet& filters, juce::AudioBuffer<SampleType>& buffer);
     
-    // Dynamic EQ Processing (NEW)
-    float processEnvelope(float input, float& envelope);
-    float calculateDynamicGain(float envelope);
+    // Dynamic EQ Processing
+    template <typename SampleType>
+    void processDynamicBlock(FilterSet& filters, SampleType* left, SampleType* right, int numSamples);
+    void updateDetectorFilters(bool force = false);
+    float calculateDynamicGain(float envelopePower, float& gainReductionDB) const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EQBand)
 };
@@ -1,5 +1,44 @@
 #include "EQProcessor.h"
 
+namespace
+{
+    // Höchste Frequenz, bis zu der ein Band den Frequenzgang formt (dort wirkt die
+    // Stauchung der bilinearen Transformation): Glocken-/Bandfilter bis zur oberen
+    // Bandkante f0·(√(1 + 1/4Q²) + 1/2Q), alle anderen Typen bis f0
+    double getUpperBandEdge(const EQBand& band)
+    {
+        const double f0 = band.getFrequency();
+
+        switch (band.getType())
+        {
+            case ParameterIDs::FilterType::Bell:
+            case ParameterIDs::FilterType::BandPass:
+            case ParameterIDs::FilterType::Notch:
+            {
+                const double k = 0.5 / juce::jmax(0.1, static_cast<double>(band.getQ()));
+                return f0 * (std::sqrt(1.0 + k * k) + k);
+            }
+            default:
+                return f0;
+        }
+    }
+
+    // Zurück auf die Basis-Rate erst 20 % unter der Schwelle (kein Pendeln bei Automation)
+    constexpr double GROUP_HYSTERESIS = 0.8;
+    
+    // Aus- bzw. Einblendzeit beim Gruppenwechsel (Basis-Rate, ~10 ms bei 48 kHz)
+    constexpr int GROUP_FADE_SAMPLES = 512;
+    
+    constexpr int MAX_OVERSAMPLING_FACTOR = 16;
+    
+    // Anteil des Band-Ausgangs bei remaining verbleibenden Samples der Phase
+    float getGroupFadeGain(bool fadingIn, int remaining)
+    {
+        const float position = static_cast<float>(remaining) / static_cast<float>(GROUP_FADE_SAMPLES);
+        return fadingIn ? 1.0f - position : position;
+    }
+}
+
 EQProcessor::EQProcessor()
 {
     // Standard-Konfiguration für die Bänder
@@ -15,14 +54,41 @@ EQProcessor::EQProcessor()
     }
 }
 
-void EQProcessor::prepare(double sampleRate, int samplesPerBlock)
+void EQProcessor::prepare(double sampleRate, int samplesPerBlock, int factor)
 {
     currentSampleRate = sampleRate;
+    oversamplingFactor = juce::jmax(1, factor);
+    baseSampleRate = sampleRate / static_cast<double>(oversamplingFactor);
     
     for (auto& band : bands)
     {
-        band.prepare(sampleRate, samplesPerBlock);
+        band.prepare(sampleRate, samplesPerBlock, oversamplingFactor);
+    }
+    
+    // Dry-Kopie für den größten Faktor (Faktorwechsel laufen ohne erneutes prepare)
+    const int maxFilterBlockSize = (samplesPerBlock / oversamplingFactor + 1) * MAX_OVERSAMPLING_FACTOR;
+    fadeScratch.setSize(2, maxFilterBlockSize);
+    fadeScratchDouble.setSize(2, maxFilterBlockSize);
+    
+    // Gruppen neu zuordnen (ohne Hysterese und Blende, alle Bänder sind frisch vorbereitet)
+    const double threshold = oversamplingThreshold.load() * 0.5 * baseSampleRate;
+    baseRateMask = 0;
+    groupMoves = {};
+    bandFades = {};
+    fadingMask = 0;
+    oversampledPathLive = true;
+    
+    for (int b = 0; b < ParameterIDs::MAX_BANDS; ++b)
+    {
+        const bool atBaseRate = getUpperBandEdge(bands[static_cast<size_t>(b)]) < threshold;
+        bandAtBaseRate[static_cast<size_t>(b)] = false;
+        if (atBaseRate)
+            setBandGroup(b, true);
     }
+    
+    for (auto& chain : fusedChains)
+        chain.reset();
+    fusedChainBaseRate.reset();
 }
 
 void EQProcessor::reset()
@@ -31,32 +97,201 @@ void EQProcessor::reset()
     {
         band.reset();
     }
+    
+    for (auto& chain : fusedChains)
+        chain.reset();
+    fusedChainBaseRate.reset();
 }
 
-void EQProcessor::processBlock(juce::AudioBuffer<float>& buffer)
+template <typename SampleType>
+void EQProcessor::processBlock(juce::AudioBuffer<SampleType>& buffer, BandGroup group)
 {
-    // Input Gain anwenden
-    if (std::abs(inputGainLinear - 1.0f) > 0.0001f)
+    // Blockanfang: erster (bzw. einziger) Aufruf pro Block
+    if (group != BandGroup::Oversampled)
     {
-        buffer.applyGain(inputGainLinear);
+        updateBandGroups(buffer.getNumSamples());
+        publishSnapshot();
+        
+        // Input Gain anwenden
+        if (std::abs(inputGainLinear - 1.0f) > 0.0001f)
+        {
+            buffer.applyGain(static_cast<SampleType>(inputGainLinear));
+        }
+        
+        // Moduswechsel im Audio-Thread übernehmen (neuer Pfad startet mit leerem Zustand)
+        const auto mode = requestedMode.load();
+        if (mode != activeMode)
+        {
+            activeMode = mode;
+            if (activeMode == ProcessingMode::Fused)
+            {
+                for (auto& chain : fusedChains)
+                    chain.reset();
+                fusedChainBaseRate.reset();
+            }
+            else
+            {
+                for (auto& band : bands)
+                    band.reset();
+            }
+        }
     }
     
-    // Alle aktiven Bänder anwenden
-    for (auto& band : bands)
+    const uint32_t bandMask = group == BandGroup::All      ? FusedEQChain::ALL_BANDS
+                            : group == BandGroup::BaseRate ? baseRateMask
+                                                           : FusedEQChain::ALL_BANDS & ~baseRateMask;
+    
+    if (activeMode == ProcessingMode::Fused)
     {
-        if (band.isActive() && !band.isBypassed())
+        // Blendende Dynamic-Bänder laufen nach der Kette (Zustand gehört dem Band,
+        // Reihenfolge egal: alle Bänder linear in Serie)
+        uint32_t fadingDynamicMask = 0;
+        for (int b = 0; b < ParameterIDs::MAX_BANDS; ++b)
+            if ((fadingMask & bandMask & (1u << b)) != 0 && bands[static_cast<size_t>(b)].isDynamicMode())
+                fadingDynamicMask |= (1u << b);
+        
+        // Alle aktiven Bänder der Gruppe in einem Pass (Rebuild nur bei Band-Änderungen)
+        auto& chain = group == BandGroup::BaseRate ? fusedChainBaseRate : fusedChains[static_cast<size_t>(activeChain)];
+        chain.process(buffer, bands, bandMask & ~fadingDynamicMask, fadingMask & bandMask, bandFades.data());
+        
+        for (int b = 0; b < ParameterIDs::MAX_BANDS; ++b)
+        {
+            auto& band = bands[static_cast<size_t>(b)];
+            if ((fadingDynamicMask & (1u << b)) != 0 && band.isActive() && !band.isBypassed())
+                processFadingBand(buffer, b);
+        }
+    }
+    else
+    {
+        // Alle aktiven Bänder der Gruppe anwenden
+        for (int b = 0; b < ParameterIDs::MAX_BANDS; ++b)
         {
-            band.processBlock(buffer);
+            auto& band = bands[static_cast<size_t>(b)];
+            if (band.isActive() && !band.isBypassed() && (bandMask & (1u << b)) != 0)
+            {
+                if ((fadingMask & (1u << b)) != 0)
+                    processFadingBand(buffer, b);
+                else
+                    band.processBlock(buffer);
+            }
         }
     }
 
-    // Output Gain anwenden
-    if (std::abs(outputGainLinear - 1.0f) > 0.0001f)
+    // Output Gain anwenden (linear → beim ersten Aufruf, der Oversampled-Aufruf
+    // kann bei übersprungenem Oversampler entfallen)
+    if (group != BandGroup::Oversampled && std::abs(outputGainLinear - 1.0f) > 0.0001f)
+    {
+        buffer.applyGain(static_cast<SampleType>(outputGainLinear));
+    }
+}
+
+template <typename SampleType>
+void EQProcessor::processSoloedBlock(juce::AudioBuffer<SampleType>& buffer, BandGroup group, uint32_t soloMask)
+{
+    if (group != BandGroup::Oversampled)
+    {
+        updateBandGroups(buffer.getNumSamples());
+        publishSnapshot();
+    }
+    
+    const uint32_t bandMask = group == BandGroup::All      ? FusedEQChain::ALL_BANDS
+                            : group == BandGroup::BaseRate ? baseRateMask
+                                                           : FusedEQChain::ALL_BANDS & ~baseRateMask;
+    
+    for (int b = 0; b < ParameterIDs::MAX_BANDS; ++b)
+    {
+        auto& band = bands[static_cast<size_t>(b)];
+        if (band.isActive() && !band.isBypassed() && (bandMask & soloMask & (1u << b)) != 0)
+        {
+            if ((fadingMask & (1u << b)) != 0)
+                processFadingBand(buffer, b);
+            else
+                band.processBlock(buffer);
+        }
+    }
+}
+
+template <typename SampleType>
+void EQProcessor::processFadingBand(juce::AudioBuffer<SampleType>& buffer, int index)
+{
+    const int numChannels = juce::jmin(buffer.getNumChannels(), 2);
+    const int numSamples = buffer.getNumSamples();
+    auto& dry = getFadeScratch(SampleType());
+    
+    // In prepare() für die größte Filter-Blocklänge alloziert (größere Host-Blöcke teilt der Processor)
+    jassert(dry.getNumSamples() >= numSamples);
+    
+    for (int ch = 0; ch < numChannels; ++ch)
+        dry.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+    
+    bands[static_cast<size_t>(index)].processBlock(buffer);
+    
+    // y = x + g·(H(x) − x), g linear über den Block
+    const auto& fade = bandFades[static_cast<size_t>(index)];
+    const double step = (static_cast<double>(fade.to) - static_cast<double>(fade.from)) / numSamples;
+    
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        SampleType* wet = buffer.getWritePointer(ch);
+        const SampleType* input = dry.getReadPointer(ch);
+        
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto g = static_cast<SampleType>(static_cast<double>(fade.from) + step * (i + 1));
+            wet[i] = input[i] + g * (wet[i] - input[i]);
+        }
+    }
+}
+
+template <typename SampleType>
+void EQProcessor::analyzeDynamics(const juce::AudioBuffer<SampleType>& input, const juce::AudioBuffer<SampleType>* sidechain)
+{
+    const bool hasSidechain = sidechain != nullptr && sidechain->getNumChannels() > 0
+                           && sidechain->getNumSamples() >= input.getNumSamples();
+    
+    for (auto& band : bands)
+    {
+        if (!band.isDynamicMode() || !band.isActive() || band.isBypassed())
+            continue;
+        
+        const auto& source = (hasSidechain && band.usesExternalSidechain()) ? *sidechain : input;
+        band.analyzeDynamics(source.getReadPointer(0),
+                             source.getNumChannels() >= 2 ? source.getReadPointer(1) : nullptr,
+                             input.getNumSamples());
+    }
+}
+
+template <typename SampleType>
+void EQProcessor::processFadingBlock(juce::AudioBuffer<SampleType>& buffer, uint32_t soloMask)
+{
+    if (activeMode == ProcessingMode::Fused && soloMask == 0)
+    {
+        fusedChains[static_cast<size_t>(activeChain ^ 1)].processFrozen(buffer, bands);
+        return;
+    }
+    
+    // Bandweise (bzw. Solo): Bänder mit ihrem eingefrorenen Zustand
+    const uint32_t bandMask = (FusedEQChain::ALL_BANDS & ~baseRateMask) & (soloMask != 0 ? soloMask : FusedEQChain::ALL_BANDS);
+    
+    for (int b = 0; b < ParameterIDs::MAX_BANDS; ++b)
     {
-        buffer.applyGain(outputGainLinear);
+        auto& band = bands[static_cast<size_t>(b)];
+        if (band.isActive() && !band.isBypassed() && (bandMask & (1u << b)) != 0)
+            band.processFrozenBlock(buffer);
     }
 }
 
+template void EQProcessor::processBlock<float>(juce::AudioBuffer<float>&, BandGroup);
+template void EQProcessor::processBlock<double>(juce::AudioBuffer<double>&, BandGroup);
+template void EQProcessor::processFadingBlock<float>(juce::AudioBuffer<float>&, uint32_t);
+template void EQProcessor::processFadingBlock<double>(juce::AudioBuffer<double>&, uint32_t);
+template void EQProcessor::processSoloedBlock<float>(juce::AudioBuffer<float>&, BandGroup, uint32_t);
+template void EQProcessor::processSoloedBlock<double>(juce::AudioBuffer<double>&, BandGroup, uint32_t);
+template void EQProcessor::processFadingBand<float>(juce::AudioBuffer<float>&, int);
+template void EQProcessor::processFadingBand<double>(juce::AudioBuffer<double>&, int);
+template void EQProcessor::analyzeDynamics<float>(const juce::AudioBuffer<float>&, const juce::AudioBuffer<float>*);
+template void EQProcessor::analyzeDynamics<double>(const juce::AudioBuffer<double>&, const juce::AudioBuffer<double>*);
+
 EQBand& EQProcessor::getBand(int index)
 {
     jassert(index >= 0 && index < ParameterIDs::MAX_BANDS);
@@ -69,6 +304,133 @@ const EQBand& EQProcessor::getBand(int index) const
     return bands[static_cast<size_t>(index)];
 }
 
+EQProcessor::BandGroup EQProcessor::getBandGroup(int index) const
+{
+    jassert(index >= 0 && index < ParameterIDs::MAX_BANDS);
+    return bandAtBaseRate[static_cast<size_t>(index)] ? BandGroup::BaseRate : BandGroup::Oversampled;
+}
+
+bool EQProcessor::hasOversampledBands() const
+{
+    for (int b = 0; b < ParameterIDs::MAX_BANDS; ++b)
+    {
+        const auto& band = bands[static_cast<size_t>(b)];
+        const bool movingIn = bandAtBaseRate[static_cast<size_t>(b)]
+                           && groupMoves[static_cast<size_t>(b)].phase == GroupFade::Out;
+        
+        if ((!bandAtBaseRate[static_cast<size_t>(b)] || movingIn) && band.isActive() && !band.isBypassed())
+            return true;
+    }
+    
+    return false;
+}
+
+void EQProcessor::updateBandGroups(int numSamples)
+{
+    const double threshold = oversamplingThreshold.load() * 0.5 * baseSampleRate;
+    fadingMask = 0;
+    
+    for (int b = 0; b < ParameterIDs::MAX_BANDS; ++b)
+    {
+        auto& band = bands[static_cast<size_t>(b)];
+        auto& move = groupMoves[static_cast<size_t>(b)];
+        const bool atBaseRate = bandAtBaseRate[static_cast<size_t>(b)];
+        
+        // Ausgeblendet: Wechsel ohne hörbaren Beitrag, neue Gruppe blendet ein. In die
+        // oversampelte Gruppe erst, wenn die Stage deren Pfad ausgibt (sonst blendet das
+        // Band auf einem noch stummen Pfad ein) - bis dahin bleibt es ausgeblendet
+        const bool targetLive = !atBaseRate || oversampledPathLive;
+        
+        if (move.phase == GroupFade::Out && move.remaining == 0 && targetLive)
+        {
+            setBandGroup(b, !atBaseRate);
+            move.phase = GroupFade::In;
+            move.remaining = GROUP_FADE_SAMPLES;
+        }
+        else if (move.phase == GroupFade::In && move.remaining == 0)
+        {
+            move.phase = GroupFade::None;
+        }
+        
+        if (move.phase == GroupFade::None)
+        {
+            const double edge = getUpperBandEdge(band);
+            const bool wantBaseRate = edge < (atBaseRate ? threshold : GROUP_HYSTERESIS * threshold);
+            
+            if (wantBaseRate != atBaseRate)
+            {
+                // Stumme Bänder wechseln sofort, hörbare blenden erst aus
+                if (band.isActive() && !band.isBypassed())
+                {
+                    move.phase = GroupFade::Out;
+                    move.remaining = GROUP_FADE_SAMPLES;
+                }
+                else
+                {
+                    setBandGroup(b, wantBaseRate);
+                }
+            }
+        }
+        
+        if (move.phase != GroupFade::None)
+        {
+            // Rampe dieses Blocks (wartend: from = to = 0) (gilt für beide Gruppen-Aufrufe des Blocks)
+            const bool fadingIn = move.phase == GroupFade::In;
+            auto& fade = bandFades[static_cast<size_t>(b)];
+            fade.from = getGroupFadeGain(fadingIn, move.remaining);
+            move.remaining -= juce::jmin(numSamples, move.remaining);
+            fade.to = getGroupFadeGain(fadingIn, move.remaining);
+            fadingMask |= (1u << b);
+        }
+    }
+}
+
+void EQProcessor::setBandGroup(int index, bool atBaseRate)
+{
+    bandAtBaseRate[static_cast<size_t>(index)] = atBaseRate;
+    
+    if (atBaseRate)
+        baseRateMask |= (1u << index);
+    else
+        baseRateMask &= ~(1u << index);
+    
+    // Neue Filter-Rate (allokationsfrei, erhöht die Band-Version → Ketten und Snapshot folgen)
+    auto& band = bands[static_cast<size_t>(index)];
+    if (atBaseRate)
+        band.setFilterRate(baseSampleRate, 1);
+    else
+        band.setFilterRate(currentSampleRate, oversamplingFactor);
+}
+
+void EQProcessor::beginOversamplingTransition(int newFactor)
+{
+    // Bisherige Kette einfrieren, die neue kompiliert beim ersten Block mit leerem Zustand
+    activeChain ^= 1;
+    fusedChains[static_cast<size_t>(activeChain)].reset();
+    
+    // Band-Zustände der oversampelten Gruppe für den ausblendenden Pfad festhalten
+    // (bandweiser Modus, Solo, Dynamic-Bänder), vor dem Ratenwechsel
+    for (int b = 0; b < ParameterIDs::MAX_BANDS; ++b)
+    {
+        if (!bandAtBaseRate[static_cast<size_t>(b)])
+            bands[static_cast<size_t>(b)].freezeFilters();
+    }
+    
+    newFactor = juce::jmax(1, newFactor);
+    if (newFactor == oversamplingFactor)
+        return;
+    
+    oversamplingFactor = newFactor;
+    currentSampleRate = baseSampleRate * static_cast<double>(oversamplingFactor);
+    
+    // Nur die oversampelte Gruppe wechselt die Rate (allokationsfrei, erhöht die Band-Versionen)
+    for (int b = 0; b < ParameterIDs::MAX_BANDS; ++b)
+    {
+        if (!bandAtBaseRate[static_cast<size_t>(b)])
+            bands[static_cast<size_t>(b)].setFilterRate(currentSampleRate, oversamplingFactor);
+    }
+}
+
 float EQProcessor::getTotalMagnitudeForFrequency(float frequency) const
 {
     float totalMagnitude = 0.0f;
@@ -95,8 +457,81 @@ void EQProcessor::getMagnitudeResponse(const float* frequencies, float* magnitud
     }
 }
 
+uint32_t EQProcessor::getResponseVersion() const
+{
+    // Summe monoton steigender Zähler → jede Änderung ändert die Summe
+    uint32_t version = outputGainVersion.load();
+
+    for (const auto& band : bands)
+        version += band.getParameterVersion();
+
+    return version;
+}
+
+void EQProcessor::publishSnapshot()
+{
+    // Design-Wechsel vor dem Snapshot übernehmen (ändert die Band-Versionen)
+    const auto design = requestedDesign.load();
+    if (design != activeDesign)
+    {
+        activeDesign = design;
+        for (auto& band : bands)
+            band.setDesignMode(design);
+    }
+    
+    const uint32_t version = getResponseVersion();
+    
+    // Anzeige-Werte ändern die Response-Version nicht (kein Kurven-/LP-Neudesign)
+    uint32_t displayVersion = 0;
+    for (const auto& band : bands)
+        displayVersion += band.getDisplayVersion();
+    
+    if (snapshotPublished.load(std::memory_order_relaxed)
+        && version == snapshotVersion.load(std::memory_order_relaxed)
+        && displayVersion == snapshotDisplayVersion.load(std::memory_order_relaxed))
+        return;
+    
+    const bool published = snapshot.tryPublish([this, version](ResponseSnapshot& s)
+    {
+        for (int b = 0; b < ParameterIDs::MAX_BANDS; ++b)
+        {
+            const auto& band = bands[static_cast<size_t>(b)];
+            auto& entry = s.bands[static_cast<size_t>(b)];
+            
+            entry.version = band.getParameterVersion();
+            entry.audible = band.isActive() && !band.isBypassed();
+            entry.dynamicMode = band.isDynamicMode();
+            entry.threshold = band.getThreshold();
+            entry.baseRate = bandAtBaseRate[static_cast<size_t>(b)];
+            entry.numStages = juce::jlimit(0, BiquadCascade::MAX_STAGES, band.getNumCascadeStages());
+            entry.frequency = band.getFrequency();
+            entry.gain = band.getGain();
+            entry.q = band.getQ();
+            entry.type = band.getType();
+            
+            for (int stage = 0; stage < entry.numStages; ++stage)
+                entry.stages[static_cast<size_t>(stage)] = band.getStageCoefficients(stage);
+        }
+        
+        s.outputGainDB = outputGainDB;
+        s.sampleRate = currentSampleRate;
+        s.baseSampleRate = baseSampleRate;
+        s.version = version;
+    });
+    
+    if (published)
+    {
+        snapshotVersion.store(version, std::memory_order_relaxed);
+        snapshotDisplayVersion.store(displayVersion, std::memory_order_relaxed);
+        snapshotPublished.store(true, std::memory_order_relaxed);
+    }
+}
+
 void EQProcessor::setOutputGain(float gainDB)
 {
+    if (gainDB != outputGainDB)
+        ++outputGainVersion;
+
     outputGainDB = gainDB;
     outputGainLinear = juce::Decibels::decibelsToGain(gainDB);
 }
@@ -113,6 +548,14 @@ void EQProcessor::setInputGain(float gainDB)
     inputGainLinear = juce::Decibels::decibelsToGain(gainDB);
 }
 
+void EQProcessor::setCascadeEngine(EQBand::CascadeEngine engine)
+{
+    for (auto& band : bands)
+    {
+        band.setCascadeEngine(engine);
+    }
+}
+
 void EQProcessor::copyBandSettings(int sourceBandIndex)
 {
     if (sourceBandIndex >= 0 && sourceBandIndex < ParameterIDs::MAX_BANDS)
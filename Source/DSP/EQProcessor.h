@@ -2,23 +2,109 @@
 
 #include <JuceHeader.h>
 #include "EQBand.h"
+#include "FusedEQChain.h"
+#include "SeqLockSnapshot.h"
 #include "../Parameters/ParameterIDs.h"
 
 /**
  * EQProcessor: Hauptklasse für die komplette EQ-Verarbeitung.
  * Verwaltet alle EQ-Bänder und koordiniert die Audio-Verarbeitung.
+ *
+ * Leser außerhalb des Audio-Threads (Kurve, LinearPhase-Design) lesen die Bänder
+ * nicht direkt, sondern einen versionierten ResponseSnapshot. Er wird am
+ * Blockanfang veröffentlicht, sobald sich die Response-Version geändert hat
+ * (Seqlock: der Audio-Thread blockiert nie, Leser sehen immer einen
+ * konsistenten Stand aller Bänder).
+ *
+ * Selektives Oversampling: nur Bänder, deren obere Bandkante über der Schwelle
+ * (Anteil der Basis-Nyquist-Frequenz) liegt, laufen auf der oversampelten Rate.
+ * Die übrigen bilden die Basis-Raten-Gruppe und laufen VOR dem Upsampling. Da
+ * alle Bänder linear sind und in Serie liegen, ist die Aufteilung exakt und
+ * braucht keinen eigenen Latenzausgleich (die Oversampler-Latenz gilt für beide).
+ * Wechselt ein hörbares Band die Gruppe, blendet es in der alten Gruppe aus und
+ * in der neuen (mit leerem Filterzustand) wieder ein (je GROUP_FADE_SAMPLES).
  */
 class EQProcessor
 {
 public:
+    // Verarbeitungsmodus der Bandkette
+    enum class ProcessingMode
+    {
+        PerBand = 0,  // Ein Pass pro aktivem Band (Band-Engine: Scalar/SIMD)
+        Fused         // Alle Bänder als flache Sektionsliste in einem Pass
+    };
+
+    // Bandgruppe eines processBlock()-Aufrufs
+    enum class BandGroup
+    {
+        All = 0,      // Alle Bänder in einem Pass (nur wenn alle auf einer Rate laufen: Faktor 1 oder Schwelle 0)
+        BaseRate,     // Basis-Raten-Gruppe, vor dem Upsampling (erster Aufruf pro Block)
+        Oversampled   // Bänder ab der Schwelle, auf dem oversampelten Buffer
+    };
+
+    // Unveränderliche Kopie aller Band-Koeffizienten (für Nicht-Audio-Threads)
+    struct ResponseSnapshot
+    {
+        struct Band
+        {
+            uint32_t version = 0;       // EQBand::getParameterVersion()
+            bool audible = false;       // aktiv und nicht gebypasst
+            bool dynamicMode = false;
+            float threshold = 0.0f;     // Dynamic-EQ-Threshold in dB (nur Anzeige)
+            bool baseRate = false;      // Koeffizienten für baseSampleRate statt sampleRate
+            int numStages = 0;
+            float frequency = 1000.0f;
+            float gain = 0.0f;
+            float q = 0.71f;
+            ParameterIDs::FilterType type = ParameterIDs::FilterType::Bell;
+            std::array<BiquadFilter::Coefficients, BiquadCascade::MAX_STAGES> stages {};
+        };
+        
+        std::array<Band, ParameterIDs::MAX_BANDS> bands {};
+        float outputGainDB = 0.0f;
+        double sampleRate = 44100.0;    // Filter-Rate der oversampelten Gruppe
+        double baseSampleRate = 44100.0;
+        uint32_t version = 0;           // getResponseVersion() beim Veröffentlichen
+    };
+
     EQProcessor();
     ~EQProcessor() = default;
 
-    void prepare(double sampleRate, int samplesPerBlock);
+    /**
+     * @param oversamplingFactor  Filter-Rate / Basis-Rate; die Dynamic-EQ-Detektoren
+     *                            laufen auf der Basis-Rate (analyzeDynamics)
+     */
+    void prepare(double sampleRate, int samplesPerBlock, int oversamplingFactor = 1);
     void reset();
+    
+    // Samplerate der Filter (bei Oversampling die oversampelte Rate)
+    double getSampleRate() const { return currentSampleRate; }
+    double getBaseSampleRate() const { return baseSampleRate; }
+
+    /**
+     * Audio verarbeiten (float und double, explizit instanziiert).
+     * Bei Oversampling pro Block zuerst BaseRate auf dem Basis-Buffer, dann
+     * Oversampled auf dem oversampelten Buffer (Input und Output Gain im
+     * ersten Aufruf; der Oversampled-Aufruf entfällt ohne oversampelte Bänder).
+     */
+    template <typename SampleType>
+    void processBlock(juce::AudioBuffer<SampleType>& buffer, BandGroup group = BandGroup::All);
 
-    // Audio verarbeiten
-    void processBlock(juce::AudioBuffer<float>& buffer);
+    /**
+     * Solo: statt processBlock() nur die Bänder mit gesetztem Bit in soloMask
+     * (bandweise, ohne Input-/Output-Gain). Gleiche Aufruf-Reihenfolge der Gruppen;
+     * Gruppenwechsel und Snapshot laufen wie in processBlock() weiter.
+     */
+    template <typename SampleType>
+    void processSoloedBlock(juce::AudioBuffer<SampleType>& buffer, BandGroup group, uint32_t soloMask);
+
+    /**
+     * Dynamic EQ: Detektoren aller dynamischen Bänder für den nächsten Block
+     * (Basis-Rate, VOR Lookahead und Oversampling). Bänder mit externer Sidechain
+     * hören sidechain, sofern vorhanden (nullptr / 0 Kanäle → input).
+     */
+    template <typename SampleType>
+    void analyzeDynamics(const juce::AudioBuffer<SampleType>& input, const juce::AudioBuffer<SampleType>* sidechain);
 
     // Zugriff auf einzelne Bänder
     EQBand& getBand(int index);
@@ -31,6 +117,23 @@ public:
     // Frequenzantwort für ein Array von Frequenzen berechnen (effizienter)
     void getMagnitudeResponse(const float* frequencies, float* magnitudes, int numPoints) const;
 
+    // Ändert sich bei jeder Änderung, die die Frequenzantwort beeinflusst
+    // (Band-Parameter, Samplerate, Output Gain) — für Hintergrund-Neuberechnungen
+    uint32_t getResponseVersion() const;
+
+    // Snapshot veröffentlichen, falls sich die Response-Version oder ein reiner
+    // Anzeige-Wert (EQBand::getDisplayVersion) geändert hat
+    // (übernimmt vorher einen ausstehenden Design-Wechsel).
+    // Läuft am Anfang von processBlock(); ohne Audio-Callback vom Message-Thread
+    // aufrufen. Blockiert nie (bei parallelem Schreiber: nächster Aufruf)
+    void publishSnapshot();
+
+    // Konsistente Kopie des zuletzt veröffentlichten Snapshots (nicht im Audio-Thread)
+    void readSnapshot(ResponseSnapshot& dest) const { snapshot.read(dest); }
+
+    // Ändert sich mit jeder Veröffentlichung → Leser überspringen unveränderte Stände
+    uint32_t getSnapshotSequence() const { return snapshot.getSequence(); }
+
     // Output Gain
     void setOutputGain(float gainDB);
     float getOutputGain() const { return outputGainDB; }
@@ -47,11 +150,78 @@ public:
     void setInputGain(float gainDB);
     float getInputGain() const { return inputGainDB; }
 
+    // Kaskaden-Engine für alle Bänder (Scalar vs. SIMD, für A/B-Vergleiche)
+    void setCascadeEngine(EQBand::CascadeEngine engine);
+    EQBand::CascadeEngine getCascadeEngine() const { return bands[0].getCascadeEngine(); }
+
+    /**
+     * Selektives Oversampling: Bänder mit oberer Bandkante ab fractionOfNyquist der
+     * Basis-Nyquist-Frequenz laufen oversampelt (0 = alle, wie ohne Aufteilung).
+     * Thread-safe; Gruppenwechsel am Blockanfang, hörbare Bänder blenden dabei
+     * in der alten Gruppe aus und in der neuen wieder ein (klickfrei).
+     */
+    void setOversamplingThreshold(float fractionOfNyquist) { oversamplingThreshold.store(fractionOfNyquist); }
+    float getOversamplingThreshold() const { return oversamplingThreshold.load(); }
+
+    // Gruppe eines Bands (BaseRate oder Oversampled) — nur im Audio-Thread
+    BandGroup getBandGroup(int index) const;
+
+    // Mindestens ein hörbares Band in der oversampelten Gruppe oder auf dem Weg
+    // dorthin (nur im Audio-Thread; die OversamplingStage schaltet dann den
+    // oversampelten Pfad zu, bevor das Band dort einblendet)
+    bool hasOversampledBands() const;
+
+    /**
+     * Gibt die OversamplingStage den oversampelten Pfad gerade aus (kein Bypass-Delay,
+     * kein Crossfade)? Audio-Thread, vor processBlock(). Bänder, die in die
+     * oversampelte Gruppe wechseln, bleiben bis dahin ausgeblendet.
+     */
+    void setOversampledPathLive(bool isLive) { oversampledPathLive = isLive; }
+
+    /**
+     * Oversampling-Faktor ohne Allokation wechseln (Audio-Thread, Blockanfang).
+     * Nur die oversampelte Gruppe wechselt die Rate, die Basis-Raten-Gruppe läuft
+     * ungestört weiter. Die bisherige Kette bleibt mit alten Koeffizienten und
+     * Zuständen eingefroren: processFadingBlock() liefert damit den ausblendenden
+     * Pfad des Crossfades (auch bei gleichem Faktor, z.B. Filter-Qualität).
+     */
+    void beginOversamplingTransition(int newFactor);
+    int getOversamplingFactor() const { return oversamplingFactor; }
+
+    /**
+     * Oversampelte Gruppe mit der eingefrorenen Kette bzw. den eingefrorenen
+     * Band-Zuständen (bandweiser Modus, Dynamic-Bänder). soloMask != 0: nur diese
+     * Bänder, bandweise wie processSoloedBlock().
+     */
+    template <typename SampleType>
+    void processFadingBlock(juce::AudioBuffer<SampleType>& buffer, uint32_t soloMask = 0);
+
+    // Fusionierter vs. bandweiser Pfad (thread-safe, Wechsel im Audio-Thread)
+    void setProcessingMode(ProcessingMode mode) { requestedMode.store(mode); }
+    ProcessingMode getProcessingMode() const { return requestedMode.load(); }
+
+    // Cookbook vs. Analog-Matched für alle Bänder (thread-safe; übernommen in
+    // publishSnapshot(), also am Blockanfang bzw. ohne Audio-Callback sofort)
+    void setFilterDesign(BiquadFilter::DesignMode mode) { requestedDesign.store(mode); }
+    BiquadFilter::DesignMode getFilterDesign() const { return requestedDesign.load(); }
+
 private:
     std::array<EQBand, ParameterIDs::MAX_BANDS> bands;
     
+    // Fusionierte Ketten (werden nur bei Band-Änderungen neu kompiliert):
+    // alle bzw. oversampelte Bänder (zwei, die bisherige bleibt beim Faktor-Wechsel
+    // eingefroren für den Crossfade) und die Basis-Raten-Gruppe
+    std::array<FusedEQChain, 2> fusedChains;
+    int activeChain = 0;
+    FusedEQChain fusedChainBaseRate;
+    std::atomic<ProcessingMode> requestedMode { ProcessingMode::Fused };
+    ProcessingMode activeMode = ProcessingMode::Fused;
+    std::atomic<BiquadFilter::DesignMode> requestedDesign { BiquadFilter::DesignMode::Cookbook };
+    BiquadFilter::DesignMode activeDesign = BiquadFilter::DesignMode::Cookbook;
+    
     float outputGainDB = 0.0f;
     float outputGainLinear = 1.0f;
+    std::atomic<uint32_t> outputGainVersion { 0 };
     float inputGainDB = 0.0f;
     float inputGainLinear = 1.0f;
     
@@ -68,6 +238,43 @@ private:
     BandSnapshot copiedBandData;
     
     double currentSampleRate = 44100.0;
+    double baseSampleRate = 44100.0;
+    int oversamplingFactor = 1;
+    
+    // Selektives Oversampling
+    std::atomic<float> oversamplingThreshold { 0.0f };
+    std::array<bool, ParameterIDs::MAX_BANDS> bandAtBaseRate {};
+    uint32_t baseRateMask = 0;  // Bit pro Band der Basis-Raten-Gruppe
+    
+    // Gruppenwechsel: Ausblenden in der alten, Einblenden in der neuen Gruppe
+    enum class GroupFade : uint8_t { None, Out, In };
+    struct GroupMove
+    {
+        GroupFade phase = GroupFade::None;
+        int remaining = 0;   // Basis-Raten-Samples bis zum Ende der Phase
+    };
+    std::array<GroupMove, ParameterIDs::MAX_BANDS> groupMoves {};
+    std::array<FusedEQChain::BandFade, ParameterIDs::MAX_BANDS> bandFades {};   // Rampe des aktuellen Blocks
+    uint32_t fadingMask = 0;  // Bit pro Band mit Rampe im aktuellen Block
+    bool oversampledPathLive = true;
+    
+    // Dry-Kopie für blendende Bänder außerhalb der fusionierten Kette (max. 16x Oversampling)
+    juce::AudioBuffer<float> fadeScratch;
+    juce::AudioBuffer<double> fadeScratchDouble;
+    juce::AudioBuffer<float>& getFadeScratch(float) { return fadeScratch; }
+    juce::AudioBuffer<double>& getFadeScratch(double) { return fadeScratchDouble; }
+    
+    void updateBandGroups(int numSamples);
+    void setBandGroup(int index, bool atBaseRate);
+    
+    // Band mit Dry/Wet-Rampe bandFades[index] (bandweiser Pfad, Dynamic-Bänder)
+    template <typename SampleType>
+    void processFadingBand(juce::AudioBuffer<SampleType>& buffer, int index);
+    
+    SeqLockSnapshot<ResponseSnapshot> snapshot;
+    std::atomic<uint32_t> snapshotVersion { 0 };
+    std::atomic<uint32_t> snapshotDisplayVersion { 0 };
+    std::atomic<bool> snapshotPublished { false };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EQProcessor)
 };
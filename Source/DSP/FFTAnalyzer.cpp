@@ -1,11 +1,22 @@
 #include "FFTAnalyzer.h"
+#include "SpectralKernels.h"
 
 FFTAnalyzer::FFTAnalyzer()
 {
+    sampleRing.resize(RING_SIZE, 0.0f);
+    frames = std::make_unique<std::array<PublishedFrame, NUM_FRAME_SLOTS>>();
+    displayMagnitudes.reserve(static_cast<size_t>(MAX_NUM_BINS));
+
     // Standard-Auflösung: Medium (2048)
     setResolution(FFTResolution::Medium);
 }
 
+FFTAnalyzer::~FFTAnalyzer()
+{
+    if (analysisThread != nullptr)
+        analysisThread->stopThread(1000);
+}
+
 void FFTAnalyzer::reallocateBuffers()
 {
     // FFT-Objekte neu erstellen
@@ -20,17 +31,18 @@ void FFTAnalyzer::reallocateBuffers()
     fftData.resize(static_cast<size_t>(currentFFTSize * 2));
     magnitudes.resize(static_cast<size_t>(currentNumBins));
     smoothedMagnitudes.resize(static_cast<size_t>(currentNumBins));
-    frozenMagnitudes.resize(static_cast<size_t>(currentNumBins));
+    overlapBuffer.resize(static_cast<size_t>(currentFFTSize));
 
     // Alle auf Null/Floor setzen
     std::fill(fifo.begin(), fifo.end(), 0.0f);
     std::fill(fftData.begin(), fftData.end(), 0.0f);
     std::fill(magnitudes.begin(), magnitudes.end(), floorDB);
     std::fill(smoothedMagnitudes.begin(), smoothedMagnitudes.end(), floorDB);
-    std::fill(frozenMagnitudes.begin(), frozenMagnitudes.end(), floorDB);
+    std::fill(overlapBuffer.begin(), overlapBuffer.end(), 0.0f);
 
     fifoIndex = 0;
     fifoReady = false;
+    samplesInOverlapBuffer = 0;
 }
 
 void FFTAnalyzer::setResolution(FFTResolution resolution)
@@ -84,14 +96,55 @@ void FFTAnalyzer::setCustomSmoothing(float attack, float release)
     releaseCoeff = juce::jlimit(0.0f, 0.99f, release);
 }
 
+int FFTAnalyzer::getSilenceSettleSamples() const
+{
+    // Release pro Frame der Länge fftSize (bei Überlappung gleich schnell in Sekunden),
+    // Startpunkt höchstens 0 dB → Abstand zum Floor auf 0.1 dB abklingen lassen
+    const float release = releaseCoeff;
+    const float range = juce::jmax(1.0f, -floorDB);
+    int releaseFrames = 1;
+
+    if (release > 0.0f)
+        releaseFrames = juce::jmax(1, static_cast<int>(std::ceil(std::log(0.1f / range) / std::log(release))));
+
+    return currentFFTSize * (releaseFrames + 1);
+}
+
 void FFTAnalyzer::setFrozen(bool freeze)
 {
-    if (freeze && !frozen.load())
+    // Im Freeze-Modus werden keine Frames mehr veröffentlicht → die
+    // Display-Kopie bleibt automatisch auf dem letzten Stand stehen
+    frozen.store(freeze);
+}
+
+void FFTAnalyzer::setOverlap(AnalyzerOverlap newOverlap)
+{
+    if (overlap.load() == newOverlap)
+        return;
+
     {
-        // Beim Einfrieren: aktuelle Magnitudes speichern
-        frozenMagnitudes = smoothedMagnitudes;
+        // Producer-Zustand wechselt den Thread → unter Lock zurücksetzen
+        const juce::SpinLock::ScopedLockType lock(resolutionLock);
+
+        overlap.store(newOverlap);
+        fifoIndex = 0;
+        fifoReady = false;
+        samplesInOverlapBuffer = 0;
+        ringReadPos = ringWritePos.load(std::memory_order_acquire);
+    }
+
+    if (newOverlap != AnalyzerOverlap::None)
+    {
+        if (analysisThread == nullptr)
+            analysisThread = std::make_unique<AnalysisThread>(*this);
+
+        if (!analysisThread->isThreadRunning())
+            analysisThread->startThread(juce::Thread::Priority::low);
+    }
+    else if (analysisThread != nullptr)
+    {
+        analysisThread->stopThread(1000);
     }
-    frozen.store(freeze);
 }
 
 void FFTAnalyzer::prepare(double newSampleRate)
@@ -102,6 +155,9 @@ void FFTAnalyzer::prepare(double newSampleRate)
 
 void FFTAnalyzer::reset()
 {
+    // Worker läuft ggf. weiter → Producer-Zustand nur unter Lock anfassen
+    const juce::SpinLock::ScopedLockType lock(resolutionLock);
+
     // Sichere, dass Buffers initialisiert sind
     if (fifo.empty() || fftData.empty())
         reallocateBuffers();
@@ -112,6 +168,8 @@ void FFTAnalyzer::reset()
     std::fill(fftData.begin(), fftData.end(), 0.0f);
     std::fill(magnitudes.begin(), magnitudes.end(), floorDB);
     std::fill(smoothedMagnitudes.begin(), smoothedMagnitudes.end(), floorDB);
+    samplesInOverlapBuffer = 0;
+    ringReadPos = ringWritePos.load(std::memory_order_acquire);
     newDataAvailable = false;
 }
 
@@ -121,23 +179,23 @@ void FFTAnalyzer::pushSamples(const float* samples, int numSamples)
     if (frozen.load())
         return;
 
+    if (isWorkerMode())
+    {
+        // Wait-free: nur in den Ring schreiben, FFT läuft auf dem Worker
+        uint32_t writePos = ringWritePos.load(std::memory_order_relaxed);
+        for (int i = 0; i < numSamples; ++i)
+            sampleRing[static_cast<size_t>(writePos++ & RING_MASK)] = samples[i];
+        ringWritePos.store(writePos, std::memory_order_release);
+        return;
+    }
+
     // TryLock: Falls Resolution gerade geaendert wird, Samples verwerfen (RT-safe)
     const juce::SpinLock::ScopedTryLockType lock(resolutionLock);
     if (!lock.isLocked())
         return;
 
     for (int i = 0; i < numSamples; ++i)
-    {
-        fifo[static_cast<size_t>(fifoIndex)] = samples[i];
-        ++fifoIndex;
-
-        if (fifoIndex >= currentFFTSize)
-        {
-            fifoReady = true;
-            fifoIndex = 0;
-            processFFT();
-        }
-    }
+        pushSampleInline(samples[i]);
 }
 
 void FFTAnalyzer::pushBuffer(const juce::AudioBuffer<float>& buffer)
@@ -156,27 +214,40 @@ void FFTAnalyzer::pushBuffer(const juce::AudioBuffer<float>& buffer)
     if (numChannels == 1)
     {
         pushSamples(buffer.getReadPointer(0), numSamples);
+        return;
     }
-    else
-    {
-        // Stereo zu Mono mischen
-        const float* left = buffer.getReadPointer(0);
-        const float* right = buffer.getReadPointer(1);
 
+    // Stereo zu Mono mischen
+    const float* left = buffer.getReadPointer(0);
+    const float* right = buffer.getReadPointer(1);
+
+    if (isWorkerMode())
+    {
+        uint32_t writePos = ringWritePos.load(std::memory_order_relaxed);
         for (int i = 0; i < numSamples; ++i)
-        {
-            float monoSample = (left[i] + right[i]) * 0.5f;
-
-            fifo[static_cast<size_t>(fifoIndex)] = monoSample;
-            ++fifoIndex;
-
-            if (fifoIndex >= currentFFTSize)
-            {
-                fifoReady = true;
-                fifoIndex = 0;
-                processFFT();
-            }
-        }
+            sampleRing[static_cast<size_t>(writePos++ & RING_MASK)] = (left[i] + right[i]) * 0.5f;
+        ringWritePos.store(writePos, std::memory_order_release);
+        return;
+    }
+
+    const juce::SpinLock::ScopedTryLockType lock(resolutionLock);
+    if (!lock.isLocked())
+        return;
+
+    for (int i = 0; i < numSamples; ++i)
+        pushSampleInline((left[i] + right[i]) * 0.5f);
+}
+
+void FFTAnalyzer::pushSampleInline(float sample)
+{
+    fifo[static_cast<size_t>(fifoIndex)] = sample;
+    ++fifoIndex;
+
+    if (fifoIndex >= currentFFTSize)
+    {
+        fifoReady = true;
+        fifoIndex = 0;
+        processFFT();
     }
 }
 
@@ -185,8 +256,56 @@ void FFTAnalyzer::processFFT()
     if (!fifoReady || frozen.load())
         return;
 
-    // FIFO in FFT-Daten kopieren
-    std::copy(fifo.begin(), fifo.begin() + currentFFTSize, fftData.begin());
+    computeSpectrum(fifo.data(), 1.0f);
+    fifoReady = false;
+}
+
+void FFTAnalyzer::processPendingSamples()
+{
+    const juce::SpinLock::ScopedLockType lock(resolutionLock);
+
+    if (!isWorkerMode() || frozen.load() || overlapBuffer.size() < static_cast<size_t>(currentFFTSize))
+        return;
+
+    const int hopSize = getHopSize();
+    const uint32_t startReadPos = ringReadPos;
+    const uint32_t writePos = ringWritePos.load(std::memory_order_acquire);
+
+    if (writePos - ringReadPos > RING_SIZE)
+    {
+        // Worker war zu langsam, Ring wurde überschrieben → neu aufsetzen
+        ringReadPos = writePos - static_cast<uint32_t>(currentFFTSize);
+        samplesInOverlapBuffer = 0;
+    }
+
+    const float frameFraction = static_cast<float>(hopSize) / static_cast<float>(currentFFTSize);
+    const size_t keep = static_cast<size_t>(currentFFTSize - hopSize);
+
+    while (writePos - ringReadPos >= static_cast<uint32_t>(hopSize))
+    {
+        // Fenster um einen Hop weiterschieben und neue Samples anhängen
+        std::memmove(overlapBuffer.data(), overlapBuffer.data() + hopSize, keep * sizeof(float));
+
+        float* dest = overlapBuffer.data() + keep;
+        for (int i = 0; i < hopSize; ++i)
+            dest[i] = sampleRing[static_cast<size_t>((ringReadPos + static_cast<uint32_t>(i)) & RING_MASK)];
+
+        ringReadPos += static_cast<uint32_t>(hopSize);
+        samplesInOverlapBuffer = juce::jmin(currentFFTSize, samplesInOverlapBuffer + hopSize);
+
+        if (samplesInOverlapBuffer >= currentFFTSize)
+            computeSpectrum(overlapBuffer.data(), frameFraction);
+    }
+
+    // Hat der Audio-Thread während des Lesens überholt, sind die Daten ungültig
+    if (ringWritePos.load(std::memory_order_acquire) - startReadPos > RING_SIZE)
+        samplesInOverlapBuffer = 0;
+}
+
+void FFTAnalyzer::computeSpectrum(const float* timeData, float frameFraction)
+{
+    // Zeitdaten in FFT-Daten kopieren
+    std::copy(timeData, timeData + currentFFTSize, fftData.begin());
 
     // Windowing anwenden
     window->multiplyWithWindowingTable(fftData.data(), static_cast<size_t>(currentFFTSize));
@@ -194,38 +313,81 @@ void FFTAnalyzer::processFFT()
     // FFT durchführen (in-place)
     fft->performFrequencyOnlyForwardTransform(fftData.data());
 
-    // Magnitude berechnen und in dB umwandeln mit asymmetrischem Smoothing
-    for (int i = 0; i < currentNumBins; ++i)
+    // Bei Überlappung kommen mehr Frames pro Sekunde → Koeffizienten so anpassen,
+    // dass Attack/Release in Sekunden gleich bleiben
+    const float attack = frameFraction < 1.0f ? std::pow(attackCoeff, frameFraction) : attackCoeff;
+    const float release = frameFraction < 1.0f ? std::pow(releaseCoeff, frameFraction) : releaseCoeff;
+
+    // Normalisieren + dB (vektorisiert), danach asymmetrisches Smoothing:
+    // schneller Attack beim Anstieg, langsamer Release beim Abfall
+    SpectralKernels::gainToDecibels(fftData.data(), magnitudes.data(), currentNumBins,
+                                    1.0f / static_cast<float>(currentFFTSize), floorDB);
+    SpectralKernels::smoothAsymmetric(magnitudes.data(), smoothedMagnitudes.data(), currentNumBins,
+                                      attack, release);
+
+    publishFrame();
+    newDataAvailable = true;
+}
+
+void FFTAnalyzer::publishFrame()
+{
+    // Ältesten Slot beschreiben: Leser des neuesten Slots werden nie gestört,
+    // Leser des vorherigen haben eine volle Frame-Periode Zeit
+    const int slot = (latestFrameSlot.load(std::memory_order_relaxed) + 1) % NUM_FRAME_SLOTS;
+    auto& frame = (*frames)[static_cast<size_t>(slot)];
+    auto& sequence = frameSequence[static_cast<size_t>(slot)];
+
+    const uint32_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::copy(smoothedMagnitudes.begin(), smoothedMagnitudes.begin() + currentNumBins,
+              frame.magnitudes.begin());
+    frame.numBins = currentNumBins;
+    frame.fftSize = currentFFTSize;
+    frame.version = frameVersion.load(std::memory_order_relaxed) + 1;
+
+    sequence.store(seq + 2, std::memory_order_release);
+    latestFrameSlot.store(slot, std::memory_order_release);
+    frameVersion.store(frame.version, std::memory_order_release);
+}
+
+FFTAnalyzer::FrameInfo FFTAnalyzer::readLatestFrame(float* dest, int maxBins) const
+{
+    FrameInfo info;
+
+    for (;;)
     {
-        float magnitude = fftData[static_cast<size_t>(i)];
-
-        // Normalisieren
-        magnitude /= static_cast<float>(currentFFTSize);
-
-        // In dB umwandeln
-        float magnitudeDB = juce::Decibels::gainToDecibels(magnitude, floorDB);
-
-        // Asymmetrisches Smoothing: schneller Attack, langsamer Release
-        float currentValue = smoothedMagnitudes[static_cast<size_t>(i)];
-
-        if (magnitudeDB > currentValue)
-        {
-            // Attack: schneller Anstieg
-            smoothedMagnitudes[static_cast<size_t>(i)] =
-                attackCoeff * currentValue + (1.0f - attackCoeff) * magnitudeDB;
-        }
-        else
-        {
-            // Release: langsamer Abfall
-            smoothedMagnitudes[static_cast<size_t>(i)] =
-                releaseCoeff * currentValue + (1.0f - releaseCoeff) * magnitudeDB;
-        }
-
-        magnitudes[static_cast<size_t>(i)] = magnitudeDB;
+        const int slot = latestFrameSlot.load(std::memory_order_acquire);
+        const auto& frame = (*frames)[static_cast<size_t>(slot)];
+        const auto& sequence = frameSequence[static_cast<size_t>(slot)];
+
+        const uint32_t before = sequence.load(std::memory_order_acquire);
+        if ((before & 1u) != 0)
+            continue;  // Slot wird gerade beschrieben
+
+        info.numBins = juce::jmin(frame.numBins, maxBins);
+        info.fftSize = frame.fftSize;
+        info.version = frame.version;
+        std::copy(frame.magnitudes.begin(), frame.magnitudes.begin() + info.numBins, dest);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before)
+            return info;
     }
+}
 
-    fifoReady = false;
-    newDataAvailable = true;
+void FFTAnalyzer::updateDisplayFrame()
+{
+    if (getFrameVersion() == displayFrameVersion)
+        return;
+
+    // Kapazität ist für MAX_NUM_BINS reserviert → resize alloziert nicht
+    displayMagnitudes.resize(static_cast<size_t>(MAX_NUM_BINS));
+    const auto info = readLatestFrame(displayMagnitudes.data(), MAX_NUM_BINS);
+    displayMagnitudes.resize(static_cast<size_t>(info.numBins));
+    displayFftSize = info.fftSize;
+    displayFrameVersion = info.version;
 }
 
 float FFTAnalyzer::applyTiltCompensation(float frequency, float magnitudeDb) const
@@ -257,22 +419,23 @@ float FFTAnalyzer::getRawMagnitudeForFrequency(float frequency) const
     if (sampleRate <= 0.0 || currentFFTSize <= 0 || currentNumBins <= 0)
         return floorDB;
 
-    // Im Freeze-Modus: eingefrorene Magnitudes verwenden
-    const auto& mags = frozen.load() ? frozenMagnitudes : smoothedMagnitudes;
+    // Display-Kopie des zuletzt veröffentlichten Frames (im Freeze-Modus eingefroren)
+    const auto& mags = displayMagnitudes;
+    const int numBins = static_cast<int>(mags.size());
     
-    // Pruefen ob Vektoren alloziert sind
-    if (mags.empty())
+    // Pruefen ob schon ein Frame da ist
+    if (numBins == 0 || displayFftSize <= 0)
         return floorDB;
 
-    // Lineare Interpolation zwischen benachbarten Bins
-    float exactBin = frequency * static_cast<float>(currentFFTSize) / static_cast<float>(sampleRate);
+    // Lineare Interpolation zwischen benachbarten Bins (FFT-Größe des Frames!)
+    float exactBin = frequency * static_cast<float>(displayFftSize) / static_cast<float>(sampleRate);
     int lowerBin = static_cast<int>(exactBin);
     int upperBin = lowerBin + 1;
 
     if (lowerBin < 0)
         return mags[0];
-    if (upperBin >= currentNumBins)
-        return mags[static_cast<size_t>(currentNumBins - 1)];
+    if (upperBin >= numBins)
+        return mags[static_cast<size_t>(numBins - 1)];
 
     float fraction = exactBin - static_cast<float>(lowerBin);
 
@@ -11,6 +11,14 @@
  * - Spektrum-Tilt-Kompensation (4.5 dB/Oktave Standard)
  * - Asymmetrisches Smoothing (schneller Attack, langsamer Release)
  * - Freeze-Modus
+ * - Überlappende Analyse (50/75/87.5%) auf einem Worker-Thread: der Audio-Thread
+ *   schreibt nur Samples in einen wait-free Ring
+ *
+ * Thread-Modell:
+ * - Jeder fertige Frame wird versioniert in einen Triple-Buffer veröffentlicht
+ *   (Seqlock pro Slot, beliebig viele Leser)
+ * - Audio-Thread / Worker lesen Frames über readLatestFrame()
+ * - Die GUI liest nur die Display-Kopie (updateDisplayFrame() im Message-Thread)
  */
 class FFTAnalyzer
 {
@@ -38,13 +46,35 @@ public:
         VeryFast    // Sehr schneller Release
     };
 
+    //==========================================================================
+    // Überlappung: None = FFT inline im Audio-Thread (bisheriges Verhalten),
+    // sonst FFT/dB/Smoothing auf dem Worker mit Hop = fftSize >> Stufe
+    //==========================================================================
+    enum class AnalyzerOverlap
+    {
+        None = 0,           // 0%    (inline)
+        Half = 1,           // 50%
+        ThreeQuarter = 2,   // 75%
+        SevenEighths = 3    // 87.5%
+    };
+
+    //==========================================================================
+    // Info zum gelesenen Frame
+    //==========================================================================
+    struct FrameInfo
+    {
+        int numBins = 0;
+        int fftSize = 0;
+        uint32_t version = 0;   // 0 = noch kein Frame veröffentlicht
+    };
+
     // Maximale FFT-Größe für Buffer-Allokation
     static constexpr int MAX_FFT_ORDER = 13;
     static constexpr int MAX_FFT_SIZE = 1 << MAX_FFT_ORDER;  // 8192
     static constexpr int MAX_NUM_BINS = MAX_FFT_SIZE / 2 + 1; // 4097
 
     FFTAnalyzer();
-    ~FFTAnalyzer() = default;
+    ~FFTAnalyzer();
 
     void prepare(double sampleRate);
     void reset();
@@ -58,8 +88,35 @@ public:
     // FFT durchführen, wenn genug Samples vorhanden
     void processFFT();
 
+    //==========================================================================
+    // Überlappende Analyse (Worker-Modus)
+    //==========================================================================
+    void setOverlap(AnalyzerOverlap newOverlap);   // Message-Thread
+    AnalyzerOverlap getOverlap() const { return overlap.load(); }
+    bool isWorkerMode() const { return overlap.load() != AnalyzerOverlap::None; }
+    int getHopSize() const { return currentFFTSize >> static_cast<int>(overlap.load()); }
+
+    // Worker: Ring leeren und pro Hop einen Frame berechnen
+    void processPendingSamples();
+
+    //==========================================================================
+    // Veröffentlichte Frames (thread-sicher, lock-free)
+    //==========================================================================
+    uint32_t getFrameVersion() const { return frameVersion.load(std::memory_order_acquire); }
+
+    // Kopiert den neuesten Frame (geglättete dB-Werte) nach dest (max. maxBins Werte)
+    FrameInfo readLatestFrame(float* dest, int maxBins) const;
+
+    // Message-Thread: Display-Kopie auf den neuesten Frame bringen
+    void updateDisplayFrame();
+    const std::vector<float>& getDisplayMagnitudes() const { return displayMagnitudes; }
+    int getDisplayFftSize() const { return displayFftSize; }
+    uint32_t getDisplayFrameVersion() const { return displayFrameVersion; }
+
     //==========================================================================
     // Spektrum-Daten abrufen
+    // HINWEIS: Arbeits-Buffer des Producers (Audio-Thread im Inline-Modus) -
+    // andere Threads lesen über readLatestFrame() bzw. getDisplayMagnitudes()
     //==========================================================================
     const std::vector<float>& getMagnitudes() const { return smoothedMagnitudes; }
 
@@ -69,7 +126,7 @@ public:
     // Bin für eine Frequenz berechnen
     int getBinForFrequency(float frequency) const;
 
-    // Magnitude für eine bestimmte Frequenz (interpoliert, mit Tilt)
+    // Magnitude für eine bestimmte Frequenz (interpoliert, mit Tilt) - liest die Display-Kopie
     float getMagnitudeForFrequency(float frequency) const;
 
     // Magnitude ohne Tilt-Kompensation
@@ -106,6 +163,10 @@ public:
     float getAttackCoeff() const { return attackCoeff; }
     float getReleaseCoeff() const { return releaseCoeff; }
 
+    // Samples Stille, nach denen das geglättete Spektrum den Floor erreicht hat
+    // (Fenster geleert + Release bis auf 0.1 dB) — danach ändert pushBuffer() nichts mehr
+    int getSilenceSettleSamples() const;
+
     //==========================================================================
     // Freeze-Modus (Pro-Q Style)
     //==========================================================================
@@ -127,6 +188,43 @@ public:
     double getSampleRate() const { return sampleRate; }
 
 private:
+    //==========================================================================
+    // Worker-Thread für die überlappende Analyse
+    //==========================================================================
+    class AnalysisThread : public juce::Thread
+    {
+    public:
+        explicit AnalysisThread(FFTAnalyzer& a) : juce::Thread("Aura FFT Analyzer"), owner(a) {}
+
+        void run() override
+        {
+            while (!threadShouldExit())
+            {
+                owner.processPendingSamples();
+                wait(POLL_INTERVAL_MS);
+            }
+        }
+
+    private:
+        static constexpr int POLL_INTERVAL_MS = 5;
+        FFTAnalyzer& owner;
+    };
+
+    //==========================================================================
+    // Veröffentlichter Frame (feste Größe → keine Re-Allokation bei Auflösungswechsel)
+    //==========================================================================
+    struct PublishedFrame
+    {
+        std::array<float, MAX_NUM_BINS> magnitudes {};
+        int numBins = 0;
+        int fftSize = 0;
+        uint32_t version = 0;
+    };
+
+    static constexpr int NUM_FRAME_SLOTS = 3;
+    static constexpr uint32_t RING_SIZE = 4 * MAX_FFT_SIZE;   // Zweierpotenz
+    static constexpr uint32_t RING_MASK = RING_SIZE - 1;
+
     //==========================================================================
     // Tilt-Kompensation berechnen
     //==========================================================================
@@ -157,7 +255,30 @@ private:
     std::vector<float> fftData;
     std::vector<float> magnitudes;
     std::vector<float> smoothedMagnitudes;
-    std::vector<float> frozenMagnitudes;  // Für Freeze-Modus
+
+    //==========================================================================
+    // Worker-Modus: wait-free Sample-Ring (Audio-Thread → Worker)
+    //==========================================================================
+    std::atomic<AnalyzerOverlap> overlap { AnalyzerOverlap::None };
+    std::vector<float> sampleRing;
+    std::atomic<uint32_t> ringWritePos { 0 };   // nur Audio-Thread schreibt
+    uint32_t ringReadPos = 0;                   // nur Worker (unter resolutionLock)
+    std::vector<float> overlapBuffer;           // gleitendes Analysefenster (fftSize)
+    int samplesInOverlapBuffer = 0;
+    std::unique_ptr<AnalysisThread> analysisThread;
+
+    //==========================================================================
+    // Triple-Buffer für veröffentlichte Frames (Seqlock pro Slot)
+    //==========================================================================
+    std::unique_ptr<std::array<PublishedFrame, NUM_FRAME_SLOTS>> frames;
+    std::array<std::atomic<uint32_t>, NUM_FRAME_SLOTS> frameSequence { { 0, 0, 0 } };
+    std::atomic<int> latestFrameSlot { 0 };
+    std::atomic<uint32_t> frameVersion { 0 };
+
+    // Display-Kopie (nur Message-Thread)
+    std::vector<float> displayMagnitudes;
+    int displayFftSize = 0;
+    uint32_t displayFrameVersion = 0;
 
     //==========================================================================
     // Tilt-Kompensation Parameter
@@ -195,6 +316,9 @@ private:
     // Interne Hilfsfunktionen
     //==========================================================================
     void reallocateBuffers();
+    void pushSampleInline(float sample);
+    void computeSpectrum(const float* timeData, float frameFraction);
+    void publishFrame();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FFTAnalyzer)
 };
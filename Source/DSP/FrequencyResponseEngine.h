@@ -0,0 +1,267 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "EQProcessor.h"
+#include "SpectralKernels.h"
+#include <array>
+#include <vector>
+
+/**
+ * FrequencyResponseEngine: Frequenzgang aller EQ-Bänder auf einem festen Frequenzraster
+ * (Pixel der EQ-Kurve bzw. FFT-Bins des LinearPhaseEQ).
+ *
+ * - cos/sin(ω) und cos/sin(2ω) werden einmal pro Raster und Filter-Samplerate
+ *   tabelliert — danach keine Trigonometrie mehr. Zwei Tabellensätze: oversampelte
+ *   Rate und Basis-Rate (selektives Oversampling, Bänder der Basis-Raten-Gruppe)
+ * - Pro Stufe nur |Zähler|² / |Nenner|² als Multiply-Add auf den Tabellen
+ *   (verzweigungsfreie double-Schleife, vom Compiler vektorisiert); alle Stufen
+ *   eines Bands werden als Leistungs-Produkt akkumuliert, dB erst am Ende
+ *   (ein log2 pro Punkt und Band statt log10 + sqrt pro Stufe)
+ * - Quelle ist der ResponseSnapshot des EQProcessor (konsistent, ohne Zugriff
+ *   auf die Bänder des Audio-Threads). Unveränderte Snapshots (gleiche Sequenz)
+ *   werden gar nicht erst gelesen
+ * - Cache pro Band, Schlüssel = Band-Version im Snapshot: beim Ziehen eines
+ *   Bands wird nur dieses Band neu berechnet, die Summenkurve ist eine Addition
+ *
+ * Eine Instanz pro Verbraucher (GUI, LinearPhase-Producer), nicht im Audio-Thread.
+ */
+class FrequencyResponseEngine
+{
+public:
+    static constexpr int NUM_BANDS = ParameterIDs::MAX_BANDS;
+
+    /** Setzt das Frequenzraster in Hz (alloziert, nicht im Audio-Thread aufrufen). */
+    void setFrequencies(const float* frequencies, int numFrequencies)
+    {
+        numPoints = juce::jmax(0, numFrequencies);
+        const auto size = static_cast<size_t>(numPoints);
+
+        gridFrequencies.assign(frequencies, frequencies + numPoints);
+        for (auto& t : tables)
+        {
+            t.cosW.assign(size, 1.0);
+            t.sinW.assign(size, 0.0);
+            t.cos2W.assign(size, 1.0);
+            t.sin2W.assign(size, 0.0);
+            t.sampleRate = 0.0;
+        }
+        powerBuffer.assign(size, 1.0);
+
+        for (auto& response : bandResponses)
+            response.assign(size, 0.0f);
+        totalResponse.assign(size, 0.0f);
+
+        invalidate();
+    }
+
+    int getNumPoints() const { return numPoints; }
+
+    /** Erzwingt eine komplette Neuberechnung beim nächsten update(). */
+    void invalidate()
+    {
+        bandValid.fill(false);
+        totalValid = false;
+    }
+
+    /**
+     * Liest den aktuellen Snapshot des EQProcessor (nur wenn ein neuer
+     * veröffentlicht wurde) und aktualisiert die Kurven. Nicht im Audio-Thread.
+     * @return true wenn sich die Kurven geändert haben
+     */
+    bool update(const EQProcessor& eqProcessor)
+    {
+        if (numPoints == 0)
+            return false;
+
+        const uint32_t sequence = eqProcessor.getSnapshotSequence();
+        if (!snapshotRead || sequence != snapshotSequence)
+        {
+            eqProcessor.readSnapshot(snapshot);
+            snapshotSequence = sequence;
+            snapshotRead = true;
+        }
+        else if (totalValid)
+        {
+            return false;
+        }
+
+        return update(snapshot);
+    }
+
+    /**
+     * Berechnet alle Bänder neu, deren Version sich geändert hat, und danach die
+     * Summenkurve (inkl. Output Gain). Allokationsfrei.
+     * @return true wenn sich die Kurven geändert haben
+     */
+    bool update(const EQProcessor::ResponseSnapshot& source)
+    {
+        if (numPoints == 0)
+            return false;
+
+        // Filter laufen ggf. mit oversampelter Rate → ω mit deren Samplerate
+        const double rates[] = { source.sampleRate, source.baseSampleRate };
+        for (size_t t = 0; t < tables.size(); ++t)
+        {
+            if (rates[t] != tables[t].sampleRate)
+            {
+                computeTables(tables[t], rates[t]);
+                invalidate();
+            }
+        }
+
+        bool changed = false;
+
+        for (int b = 0; b < NUM_BANDS; ++b)
+        {
+            const auto& band = source.bands[static_cast<size_t>(b)];
+            const auto index = static_cast<size_t>(b);
+
+            if (bandValid[index] && band.version == bandVersions[index])
+                continue;
+
+            computeBand(band, b);
+            bandVersions[index] = band.version;
+            bandValid[index] = true;
+            changed = true;
+        }
+
+        snapshotVersion = source.version;
+
+        const float outputGain = source.outputGainDB;
+        if (changed || !totalValid || outputGain != totalOutputGain)
+        {
+            std::fill(totalResponse.begin(), totalResponse.end(), outputGain);
+
+            for (int b = 0; b < NUM_BANDS; ++b)
+            {
+                if (bandAudible[static_cast<size_t>(b)])
+                    juce::FloatVectorOperations::add(totalResponse.data(),
+                                                     bandResponses[static_cast<size_t>(b)].data(), numPoints);
+            }
+
+            totalOutputGain = outputGain;
+            totalValid = true;
+            changed = true;
+        }
+
+        return changed;
+    }
+
+    /** Summenkurve in dB (alle aktiven, nicht gebypassten Bänder + Output Gain). */
+    const float* getTotalResponse() const { return totalResponse.data(); }
+
+    /** Frequenzgang eines Bands in dB (0 dB wenn inaktiv oder gebypasst). */
+    const float* getBandResponse(int bandIndex) const
+    {
+        return bandResponses[static_cast<size_t>(bandIndex)].data();
+    }
+
+    bool isBandAudible(int bandIndex) const { return bandAudible[static_cast<size_t>(bandIndex)]; }
+
+    /** Response-Version des zuletzt verarbeiteten Snapshots. */
+    uint32_t getSnapshotVersion() const { return snapshotVersion; }
+
+    /** Zuletzt gelesener Snapshot (Band-Status für die Anzeige, Stand des letzten update()). */
+    const EQProcessor::ResponseSnapshot& getSnapshot() const { return snapshot; }
+
+private:
+    // Trigonometrie-Tabellen einer Filter-Rate
+    struct RateTables
+    {
+        double sampleRate = 0.0;
+        std::vector<double> cosW, sinW, cos2W, sin2W;
+    };
+
+    static constexpr size_t OVERSAMPLED_TABLES = 0;
+    static constexpr size_t BASE_RATE_TABLES = 1;
+
+    void computeTables(RateTables& t, double sampleRate)
+    {
+        t.sampleRate = sampleRate;
+        if (sampleRate <= 0.0)
+            return;
+
+        const double omegaPerHz = juce::MathConstants<double>::twoPi / sampleRate;
+
+        for (size_t i = 0; i < static_cast<size_t>(numPoints); ++i)
+        {
+            const double omega = omegaPerHz * static_cast<double>(gridFrequencies[i]);
+            const double c = std::cos(omega);
+            const double s = std::sin(omega);
+
+            t.cosW[i] = c;
+            t.sinW[i] = s;
+            t.cos2W[i] = 2.0 * c * c - 1.0;
+            t.sin2W[i] = 2.0 * s * c;
+        }
+    }
+
+    void computeBand(const EQProcessor::ResponseSnapshot::Band& band, int bandIndex)
+    {
+        const auto index = static_cast<size_t>(bandIndex);
+        auto& response = bandResponses[index];
+
+        bandAudible[index] = band.audible;
+        if (!bandAudible[index])
+        {
+            std::fill(response.begin(), response.end(), 0.0f);
+            return;
+        }
+
+        std::fill(powerBuffer.begin(), powerBuffer.end(), 1.0);
+
+        const auto& t = tables[band.baseRate ? BASE_RATE_TABLES : OVERSAMPLED_TABLES];
+        const double* c1 = t.cosW.data();
+        const double* s1 = t.sinW.data();
+        const double* c2 = t.cos2W.data();
+        const double* s2 = t.sin2W.data();
+        double* power = powerBuffer.data();
+
+        for (int stage = 0; stage < band.numStages; ++stage)
+        {
+            const auto& k = band.stages[static_cast<size_t>(stage)];
+
+            // H(e^jω) = (b0 + b1·e^-jω + b2·e^-j2ω) / (1 + a1·e^-jω + a2·e^-j2ω)
+            for (int i = 0; i < numPoints; ++i)
+            {
+                const double numRe = k.b0 + k.b1 * c1[i] + k.b2 * c2[i];
+                const double numIm = k.b1 * s1[i] + k.b2 * s2[i];
+                const double denRe = 1.0 + k.a1 * c1[i] + k.a2 * c2[i];
+                const double denIm = k.a1 * s1[i] + k.a2 * s2[i];
+
+                const double numMag2 = numRe * numRe + numIm * numIm;
+                const double denMag2 = std::max(denRe * denRe + denIm * denIm, 1e-10);
+                power[i] *= numMag2 / denMag2;
+            }
+        }
+
+        // Leistung → dB, ein log2 pro Punkt (Bereich ±200 dB)
+        constexpr double dbPerLog2Power = 3.01029996;  // 10 * log10(2)
+        for (int i = 0; i < numPoints; ++i)
+        {
+            const double clamped = juce::jlimit(1e-20, 1e20, power[i]);
+            response[static_cast<size_t>(i)] = static_cast<float>(dbPerLog2Power)
+                                             * SpectralKernels::fastLog2(static_cast<float>(clamped));
+        }
+    }
+
+    int numPoints = 0;
+
+    EQProcessor::ResponseSnapshot snapshot;
+    uint32_t snapshotSequence = 0;
+    uint32_t snapshotVersion = 0;
+    bool snapshotRead = false;
+
+    std::vector<float> gridFrequencies;
+    std::array<RateTables, 2> tables;
+    std::vector<double> powerBuffer;
+
+    std::array<std::vector<float>, NUM_BANDS> bandResponses;
+    std::array<uint32_t, NUM_BANDS> bandVersions {};
+    std::array<bool, NUM_BANDS> bandValid {};
+    std::array<bool, NUM_BANDS> bandAudible {};
+
+    std::vector<float> totalResponse;
+    float totalOutputGain = 0.0f;
+    bool totalValid = false;
+};
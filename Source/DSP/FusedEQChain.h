@@ -0,0 +1,559 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "EQBand.h"
+#include "BiquadCascade.h"
+#include "../Parameters/ParameterIDs.h"
+
+/**
+ * FusedEQChain: Alle aktiven EQ-Bänder als eine flache Serie von Biquad-Sektionen.
+ *
+ * Statt pro Band (und pro Kaskadenstufe) einen eigenen Pass über den Buffer zu
+ * machen, werden die aktiven Bänder in eine zusammenhängende Liste von
+ * Second-Order-Sections mit gepackten Koeffizienten "kompiliert":
+ * - Koeffizienten pro Lane (Lane 0 = L/Mid, Lane 1 = R/Side). Kanal-Modi werden
+ *   über Identitäts-Koeffizienten auf der unbeteiligten Lane abgebildet
+ * - Mid/Side-Bänder tragen eine Domain-Markierung; Encode/Decode passiert nur
+ *   an Domain-Grenzen, aufeinanderfolgende M/S-Bänder teilen sich den Wechsel
+ * - Verarbeitung in Sub-Blöcken (SUB_BLOCK_SIZE Frames, ~1 KB → L1-resident),
+ *   jeweils bis zu GROUP_SIZE Sektionen pro Sample-Schleife (Zustände in Registern)
+ * - Dynamic-EQ-Bänder (SVF, sample-genaue Modulation) bleiben eigene Schritte
+ *   und trennen die Kette an dieser Stelle
+ *
+ * Eine Kette kann auf eine Teilmenge der Bänder beschränkt werden (bandMask, z.B.
+ * die Basis-Raten-Gruppe beim selektiven Oversampling). Bänder in fadeMask werden
+ * als eigener Schritt mit Dry/Wet-Rampe verarbeitet (y = x + g·(H(x) − x), g laut
+ * BandFade über den Block) — Ein-/Ausblenden beim Wechsel der Oversampling-Gruppe.
+ *
+ * Neu kompiliert wird nur, wenn sich die parameterVersion eines Bands oder die
+ * Band-Auswahl ändert.
+ * Filter-Zustände und Koeffizienten-Smoothing werden beim Rebuild pro
+ * (Band, Stufe)-Slot übernommen — Parameteränderungen bleiben klickfrei.
+ */
+class FusedEQChain
+{
+public:
+    static constexpr int NUM_BANDS = ParameterIDs::MAX_BANDS;
+    static constexpr int MAX_STAGES = BiquadCascade::MAX_STAGES;
+    static constexpr int MAX_SECTIONS = NUM_BANDS * MAX_STAGES;  // 96
+    static constexpr int SUB_BLOCK_SIZE = 64;
+    static constexpr int GROUP_SIZE = 4;
+
+    using BandArray = std::array<EQBand, ParameterIDs::MAX_BANDS>;
+
+    static constexpr uint32_t ALL_BANDS = (1u << NUM_BANDS) - 1u;
+    static_assert(NUM_BANDS < 32, "Band-Auswahl als 32-Bit-Maske");
+
+    // Anteil des Band-Ausgangs am Anfang und Ende eines Blocks (linear dazwischen)
+    struct BandFade
+    {
+        float from = 1.0f;
+        float to = 1.0f;
+    };
+
+    FusedEQChain()
+    {
+        slotToSection.fill(-1);
+        for (auto& t : target)
+            t = packCoefficients({}, 0);  // Identität
+        reset();
+    }
+
+    /** Löscht alle Filter-Zustände und erzwingt einen Rebuild beim nächsten Block. */
+    void reset() noexcept
+    {
+        for (int s = 0; s < MAX_SECTIONS; ++s)
+        {
+            state1[s] = Vec::expand(0.0);
+            state2[s] = Vec::expand(0.0);
+            current[s] = target[s];
+            smoothing[s] = false;
+        }
+        needsRebuild = true;
+    }
+
+    /** Erzwingt einen Rebuild (z.B. nach prepare mit neuer Sample-Rate). */
+    void invalidate() noexcept { needsRebuild = true; }
+
+    /**
+     * Verarbeitet den Buffer durch die Bandkette (Bänder mit gesetztem Bit in bandMask).
+     * Kompiliert vorher neu, falls sich ein Band oder die Auswahl geändert hat.
+     * Bänder in fadeMask laufen mit der Rampe fades[band] (nur statische Bänder).
+     */
+    template <typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& buffer, BandArray& bands, uint32_t bandMask = ALL_BANDS,
+                 uint32_t fadeMask = 0, const BandFade* fades = nullptr) noexcept
+    {
+        const int numChannels = buffer.getNumChannels();
+        const int numSamples = buffer.getNumSamples();
+
+        if (numChannels == 0 || numSamples == 0)
+            return;
+
+        if (fades == nullptr)
+            fadeMask = 0;
+
+        const bool mono = numChannels < 2;
+        if (needsRebuild || mono != compiledMono || bandMask != compiledMask || fadeMask != compiledFadeMask
+            || bandsChanged(bands))
+            compile(bands, mono, bandMask, fadeMask);
+
+        SampleType* left = buffer.getWritePointer(0);
+        SampleType* right = mono ? nullptr : buffer.getWritePointer(1);
+
+        for (int i = 0; i < numSteps; ++i)
+        {
+            const auto& step = steps[static_cast<size_t>(i)];
+
+            if (step.kind == Step::Kind::DynamicBand)
+                bands[static_cast<size_t>(step.first)].processBlock(buffer);
+            else
+                processSections(left, right, numSamples, step.first, step.count,
+                                step.fadeBand >= 0 ? &fades[step.fadeBand] : nullptr);
+        }
+    }
+
+    /**
+     * Verarbeitet mit dem zuletzt kompilierten Stand, ohne Rebuild (eingefrorene
+     * Kette, z.B. der ausblendende Pfad eines Oversampling-Wechsels). Dynamic-Bänder
+     * laufen an ihrer Stelle mit ihrem eingefrorenen Zustand (EQBand::processFrozenBlock).
+     * Ein-/Ausblendungen gelten hier nicht (Bänder laufen voll).
+     */
+    template <typename SampleType>
+    void processFrozen(juce::AudioBuffer<SampleType>& buffer, BandArray& bands) noexcept
+    {
+        const int numChannels = buffer.getNumChannels();
+        const int numSamples = buffer.getNumSamples();
+
+        if (needsRebuild || numChannels == 0 || numSamples == 0 || (numChannels < 2) != compiledMono)
+            return;
+
+        SampleType* left = buffer.getWritePointer(0);
+        SampleType* right = compiledMono ? nullptr : buffer.getWritePointer(1);
+
+        for (int i = 0; i < numSteps; ++i)
+        {
+            const auto& step = steps[static_cast<size_t>(i)];
+
+            if (step.kind == Step::Kind::DynamicBand)
+                bands[static_cast<size_t>(step.first)].processFrozenBlock(buffer);
+            else
+                processSections(left, right, numSamples, step.first, step.count, nullptr);
+        }
+    }
+
+    int getNumCompiledSections() const noexcept { return numSections; }
+
+private:
+    using Vec = juce::dsp::SIMDRegister<double>;
+    static_assert(Vec::SIMDNumElements >= 2, "FusedEQChain benötigt mindestens 2 double-Lanes");
+
+    static constexpr double smoothingCoeff = 0.999;    // identisch zu BiquadFilter
+    static constexpr double smoothingEpsilon = 1e-8;
+
+    enum class Domain : uint8_t { LeftRight, MidSide };
+
+    // Gepackte Koeffizienten einer Sektion (pro Lane, a0 = 1)
+    struct Section
+    {
+        Vec b0, b1, b2, a1, a2;
+    };
+
+    // Ausführungsschritt: zusammenhängender Sektions-Bereich oder Dynamic-Band
+    struct Step
+    {
+        enum class Kind : uint8_t { Sections, DynamicBand };
+        Kind kind = Kind::Sections;
+        int first = 0;   // Erste Sektion bzw. Band-Index
+        int count = 0;   // Anzahl Sektionen
+        int fadeBand = -1;   // Band mit Dry/Wet-Rampe (eigener Schritt) oder -1
+    };
+
+    //==========================================================================
+    // Rebuild-Erkennung
+    //==========================================================================
+    bool bandsChanged(const BandArray& bands) const noexcept
+    {
+        for (int b = 0; b < NUM_BANDS; ++b)
+            if (bands[static_cast<size_t>(b)].getParameterVersion() != compiledVersions[static_cast<size_t>(b)])
+                return true;
+        return false;
+    }
+
+    //==========================================================================
+    // Kompilieren: aktive Bänder → flache Sektionsliste (RT-safe, keine Allokation)
+    //==========================================================================
+    void compile(const BandArray& bands, bool mono, uint32_t bandMask, uint32_t fadeMask) noexcept
+    {
+        // Alte Zustände/Smoothing nach Slot sichern (Slot = band * MAX_STAGES + stage)
+        std::array<int, MAX_SECTIONS> oldSlotToSection = slotToSection;
+        std::array<Vec, MAX_SECTIONS> oldState1, oldState2;
+        std::array<Section, MAX_SECTIONS> oldCurrent;
+        std::array<uint8_t, MAX_SECTIONS> oldLaneMask;
+
+        for (int s = 0; s < numSections; ++s)
+        {
+            oldState1[static_cast<size_t>(s)] = state1[s];
+            oldState2[static_cast<size_t>(s)] = state2[s];
+            oldCurrent[static_cast<size_t>(s)] = current[s];
+            oldLaneMask[static_cast<size_t>(s)] = laneMask[s];
+        }
+
+        slotToSection.fill(-1);
+        numSections = 0;
+        numSteps = 0;
+
+        Step run;
+        run.first = 0;
+        run.count = 0;
+
+        auto flushRun = [this, &run]
+        {
+            if (run.count > 0)
+                steps[static_cast<size_t>(numSteps++)] = run;
+            run.first = numSections;
+            run.count = 0;
+            run.fadeBand = -1;
+        };
+
+        for (int b = 0; b < NUM_BANDS; ++b)
+        {
+            const auto& band = bands[static_cast<size_t>(b)];
+            compiledVersions[static_cast<size_t>(b)] = band.getParameterVersion();
+
+            if (!band.isActive() || band.isBypassed() || (bandMask & (1u << b)) == 0)
+                continue;
+
+            if (band.isDynamicMode())
+            {
+                flushRun();
+                Step dyn;
+                dyn.kind = Step::Kind::DynamicBand;
+                dyn.first = b;
+                steps[static_cast<size_t>(numSteps++)] = dyn;
+                continue;
+            }
+
+            uint8_t mask = 0x3;
+            Domain domain = Domain::LeftRight;
+
+            // Mono: Kanal-Modus wird ignoriert (wie im Einzelband-Pfad), nur Lane 0
+            if (mono)
+            {
+                mask = 0x1;
+            }
+            else
+            {
+                switch (band.getChannelMode())
+                {
+                    case ParameterIDs::ChannelMode::Left:  mask = 0x1; break;
+                    case ParameterIDs::ChannelMode::Right: mask = 0x2; break;
+                    case ParameterIDs::ChannelMode::Mid:   mask = 0x1; domain = Domain::MidSide; break;
+                    case ParameterIDs::ChannelMode::Side:  mask = 0x2; domain = Domain::MidSide; break;
+                    default: break;
+                }
+            }
+
+            // Blendendes Band: eigener Schritt (Dry/Wet über genau seine Sektionen)
+            const bool fading = (fadeMask & (1u << b)) != 0;
+            if (fading)
+            {
+                flushRun();
+                run.fadeBand = b;
+            }
+
+            for (int stage = 0; stage < band.getNumCascadeStages(); ++stage)
+            {
+                const int slot = b * MAX_STAGES + stage;
+                const int s = numSections++;
+
+                slotToSection[static_cast<size_t>(slot)] = s;
+                sectionDomain[s] = domain;
+                laneMask[s] = mask;
+                target[s] = packCoefficients(band.getStageCoefficients(stage), mask);
+
+                const int old = oldSlotToSection[static_cast<size_t>(slot)];
+                if (old >= 0 && oldLaneMask[static_cast<size_t>(old)] == mask)
+                {
+                    // Bestehende Sektion: Zustand behalten, neue Koeffizienten einblenden
+                    state1[s] = oldState1[static_cast<size_t>(old)];
+                    state2[s] = oldState2[static_cast<size_t>(old)];
+                    current[s] = oldCurrent[static_cast<size_t>(old)];
+                    smoothing[s] = !isConverged(current[s], target[s]);
+                }
+                else
+                {
+                    // Neue Sektion: leerer Zustand, Koeffizienten sofort
+                    state1[s] = Vec::expand(0.0);
+                    state2[s] = Vec::expand(0.0);
+                    current[s] = target[s];
+                    smoothing[s] = false;
+                }
+
+                ++run.count;
+            }
+
+            if (fading)
+                flushRun();
+        }
+
+        flushRun();
+
+        compiledMono = mono;
+        compiledMask = bandMask;
+        compiledFadeMask = fadeMask;
+        needsRebuild = false;
+    }
+
+    static Section packCoefficients(const BiquadFilter::Coefficients& c, uint8_t mask) noexcept
+    {
+        // Unbeteiligte Lanes bekommen Identität (b0 = 1, Rest 0)
+        Section sec;
+        sec.b0 = Vec::expand(1.0);
+        sec.b1 = Vec::expand(0.0);
+        sec.b2 = Vec::expand(0.0);
+        sec.a1 = Vec::expand(0.0);
+        sec.a2 = Vec::expand(0.0);
+
+        for (size_t lane = 0; lane < 2; ++lane)
+        {
+            if ((mask & (1u << lane)) == 0)
+                continue;
+
+            sec.b0.set(lane, c.b0);
+            sec.b1.set(lane, c.b1);
+            sec.b2.set(lane, c.b2);
+            sec.a1.set(lane, c.a1);
+            sec.a2.set(lane, c.a2);
+        }
+
+        return sec;
+    }
+
+    //==========================================================================
+    // Verarbeitung eines Sektions-Bereichs in Sub-Blöcken
+    //==========================================================================
+    template <typename SampleType>
+    void processSections(SampleType* left, SampleType* right, int numSamples, int first, int count,
+                         const BandFade* fade) noexcept
+    {
+        Vec frames[SUB_BLOCK_SIZE];
+        Vec dry[SUB_BLOCK_SIZE];
+        const int end = first + count;
+
+        // Dry/Wet-Rampe: g pro Sample linear von fade->from nach fade->to
+        const double fadeFrom = fade != nullptr ? static_cast<double>(fade->from) : 1.0;
+        const double fadeStep = fade != nullptr ? (static_cast<double>(fade->to) - fadeFrom) / numSamples : 0.0;
+
+        for (int start = 0; start < numSamples; start += SUB_BLOCK_SIZE)
+        {
+            const int n = juce::jmin(SUB_BLOCK_SIZE, numSamples - start);
+            SampleType* l = left + start;
+            SampleType* r = (right != nullptr) ? right + start : nullptr;
+
+            // Laden (immer L/R-Domain)
+            for (int i = 0; i < n; ++i)
+            {
+                Vec v = Vec::expand(0.0);
+                v.set(0, l[i]);
+                if (r != nullptr)
+                    v.set(1, r[i]);
+                frames[i] = v;
+            }
+
+            if (fade != nullptr)
+                std::copy(frames, frames + n, dry);
+
+            Domain domain = Domain::LeftRight;
+            int s = first;
+
+            while (s < end)
+            {
+                // Domain-Wechsel nur an Grenzen (im Mono-Fall gibt es keine M/S-Sektionen)
+                if (sectionDomain[s] != domain)
+                {
+                    if (sectionDomain[s] == Domain::MidSide)
+                        encodeMidSide(frames, n);
+                    else
+                        decodeMidSide(frames, n);
+                    domain = sectionDomain[s];
+                }
+
+                // Gruppe: bis zu GROUP_SIZE Sektionen derselben Domain
+                int groupEnd = s + 1;
+                while (groupEnd < end && groupEnd - s < GROUP_SIZE && sectionDomain[groupEnd] == domain)
+                    ++groupEnd;
+
+                for (int g = s; g < groupEnd; ++g)
+                    if (smoothing[g])
+                        advanceSmoothing(g, n);
+
+                switch (groupEnd - s)
+                {
+                    case 1:  processGroup<1>(frames, n, s); break;
+                    case 2:  processGroup<2>(frames, n, s); break;
+                    case 3:  processGroup<3>(frames, n, s); break;
+                    default: processGroup<4>(frames, n, s); break;
+                }
+
+                s = groupEnd;
+            }
+
+            if (domain == Domain::MidSide)
+                decodeMidSide(frames, n);
+
+            if (fade != nullptr)
+            {
+                for (int i = 0; i < n; ++i)
+                {
+                    const Vec g = Vec::expand(fadeFrom + fadeStep * (start + i + 1));
+                    frames[i] = dry[i] + g * (frames[i] - dry[i]);
+                }
+            }
+
+            // Speichern
+            for (int i = 0; i < n; ++i)
+            {
+                l[i] = static_cast<SampleType>(frames[i].get(0));
+                if (r != nullptr)
+                    r[i] = static_cast<SampleType>(frames[i].get(1));
+            }
+        }
+
+        flushDenormals(first, end);
+    }
+
+    template <int N>
+    void processGroup(Vec* frames, int n, int first) noexcept
+    {
+        Vec b0[N], b1[N], b2[N], a1[N], a2[N], z1[N], z2[N];
+
+        for (int k = 0; k < N; ++k)
+        {
+            const auto& c = current[first + k];
+            b0[k] = c.b0; b1[k] = c.b1; b2[k] = c.b2;
+            a1[k] = c.a1; a2[k] = c.a2;
+            z1[k] = state1[first + k];
+            z2[k] = state2[first + k];
+        }
+
+        for (int i = 0; i < n; ++i)
+        {
+            Vec x = frames[i];
+
+            for (int k = 0; k < N; ++k)
+            {
+                // Transposed Direct Form II
+                const Vec y = b0[k] * x + z1[k];
+                z1[k] = b1[k] * x - a1[k] * y + z2[k];
+                z2[k] = b2[k] * x - a2[k] * y;
+                x = y;
+            }
+
+            frames[i] = x;
+        }
+
+        for (int k = 0; k < N; ++k)
+        {
+            state1[first + k] = z1[k];
+            state2[first + k] = z2[k];
+        }
+    }
+
+    static void encodeMidSide(Vec* frames, int n) noexcept
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            const double l = frames[i].get(0);
+            const double r = frames[i].get(1);
+            frames[i].set(0, (l + r) * 0.5);
+            frames[i].set(1, (l - r) * 0.5);
+        }
+    }
+
+    static void decodeMidSide(Vec* frames, int n) noexcept
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            const double m = frames[i].get(0);
+            const double sd = frames[i].get(1);
+            frames[i].set(0, m + sd);
+            frames[i].set(1, m - sd);
+        }
+    }
+
+    //==========================================================================
+    // Smoothing pro Sub-Block (gleicher Verlauf wie BiquadFilter, 0.999/Sample)
+    //==========================================================================
+    void advanceSmoothing(int s, int n) noexcept
+    {
+        const double decay = (n == SUB_BLOCK_SIZE) ? subBlockDecay
+                                                   : std::pow(smoothingCoeff, static_cast<double>(n));
+        auto& c = current[s];
+        const auto& t = target[s];
+
+        c.b0 = t.b0 + (c.b0 - t.b0) * decay;
+        c.b1 = t.b1 + (c.b1 - t.b1) * decay;
+        c.b2 = t.b2 + (c.b2 - t.b2) * decay;
+        c.a1 = t.a1 + (c.a1 - t.a1) * decay;
+        c.a2 = t.a2 + (c.a2 - t.a2) * decay;
+
+        if (isConverged(c, t))
+        {
+            c = t;
+            smoothing[s] = false;
+        }
+    }
+
+    static bool isConverged(const Section& a, const Section& b) noexcept
+    {
+        for (size_t lane = 0; lane < 2; ++lane)
+        {
+            if (std::abs(a.b0.get(lane) - b.b0.get(lane)) >= smoothingEpsilon
+                || std::abs(a.b1.get(lane) - b.b1.get(lane)) >= smoothingEpsilon
+                || std::abs(a.b2.get(lane) - b.b2.get(lane)) >= smoothingEpsilon
+                || std::abs(a.a1.get(lane) - b.a1.get(lane)) >= smoothingEpsilon
+                || std::abs(a.a2.get(lane) - b.a2.get(lane)) >= smoothingEpsilon)
+                return false;
+        }
+        return true;
+    }
+
+    void flushDenormals(int first, int end) noexcept
+    {
+        for (int s = first; s < end; ++s)
+        {
+            for (size_t lane = 0; lane < 2; ++lane)
+            {
+                if (std::abs(state1[s].get(lane)) < ANTI_DENORMAL) state1[s].set(lane, 0.0);
+                if (std::abs(state2[s].get(lane)) < ANTI_DENORMAL) state2[s].set(lane, 0.0);
+            }
+        }
+    }
+
+    //==========================================================================
+    // Member (feste Größen — Rebuild allokiert nicht)
+    //==========================================================================
+    Section target[MAX_SECTIONS];
+    Section current[MAX_SECTIONS];
+    Vec state1[MAX_SECTIONS];
+    Vec state2[MAX_SECTIONS];
+    Domain sectionDomain[MAX_SECTIONS] {};
+    uint8_t laneMask[MAX_SECTIONS] {};
+    bool smoothing[MAX_SECTIONS] {};
+    int numSections = 0;
+
+    std::array<int, MAX_SECTIONS> slotToSection {};
+    std::array<Step, 2 * NUM_BANDS + 1> steps {};
+    int numSteps = 0;
+
+    std::array<uint32_t, NUM_BANDS> compiledVersions {};
+    bool compiledMono = false;
+    uint32_t compiledMask = ALL_BANDS;
+    uint32_t compiledFadeMask = 0;
+    bool needsRebuild = true;
+
+    const double subBlockDecay = std::pow(smoothingCoeff, static_cast<double>(SUB_BLOCK_SIZE));
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FusedEQChain)
+};
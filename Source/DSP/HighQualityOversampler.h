@@ -4,24 +4,8 @@
 #include <vector>
 #include <array>
 
-/**
- * HighQualityOversampler: Oversampling für nicht-lineare Verarbeitung
- * 
- * Verhindert Aliasing bei Saturation, Limiting, Clipping etc.
- * Verwendet polyphase FIR-Filter für maximale Effizienz und Qualität.
- * 
- * Features:
- * - 2x, 4x, 8x, 16x Oversampling
- * - Linearphasige FIR Anti-Aliasing Filter
- * - Minimal Phase Option für geringere Latenz
- * - Automatische Latenz-Kompensation
- * 
- * Workflow:
- * 1. upsample() - Input auf höhere Rate bringen
- * 2. Nicht-lineare Verarbeitung bei hoher Rate
- * 3. downsample() - Zurück auf Original-Rate
- */
-class HighQualityOversampler
+// Vom Sample-Typ unabhängiger Teil (Faktor, Filter-Qualität, Latenz-Obergrenze)
+class HighQualityOversamplerBase
 {
 public:
     //==========================================================================
@@ -35,7 +19,49 @@ public:
         x8 = 8,
         x16 = 16
     };
-    
+
+    //==========================================================================
+    // Filter-Qualität
+    //==========================================================================
+    enum class FilterQuality
+    {
+        LinearPhase = 0,   // Lange Halfband-FIRs (höhere Latenz, phasenlinear)
+        MinimumPhase       // Kurze Polyphase-IIRs (geringe Latenz, minimalphasig)
+    };
+
+    static constexpr int MAX_STAGES = 4;
+
+    // Obergrenze von getLatencyInSamples() über alle Faktoren/Qualitäten
+    // (x16 Linear Phase: 32 + 8 + 4 + 2 = 46 Samples, IIR deutlich darunter)
+    static constexpr int MAX_LATENCY_SAMPLES = 64;
+};
+
+/**
+ * HighQualityOversampler: Oversampling für nicht-lineare Verarbeitung
+ *
+ * Verhindert Aliasing bei Saturation, Limiting, Clipping etc.
+ * Kaskade aus 2x-Halfband-Stufen in Polyphasen-Form.
+ *
+ * Features:
+ * - 2x, 4x, 8x, 16x Oversampling
+ * - Filter-Qualität wählbar:
+ *   LinearPhase:  Halfband-FIR (Kaiser-Fenster), Polyphase ohne Null-Taps,
+ *                 Taps blockweise über FloatVectorOperations (SIMD)
+ *   MinimumPhase: Polyphase-IIR-Halfband (2 Allpass-Zweige, elliptisch),
+ *                 wenige Samples Gruppenlaufzeit statt FIR-Latenz
+ * - Automatische Latenz-Kompensation (getLatencyInSamples)
+ * - SampleType float oder double: Taps, Zustände und Puffer im Sample-Typ,
+ *   der float-Pfad rechnet damit doppelt so viele Taps pro SIMD-Register
+ *
+ * Workflow:
+ * 1. upsampleBlock() / upsample() - Input auf höhere Rate bringen
+ * 2. Nicht-lineare Verarbeitung bei hoher Rate
+ * 3. downsampleBlock() / downsample() - Zurück auf Original-Rate
+ */
+template <typename SampleType>
+class HighQualityOversampler : public HighQualityOversamplerBase
+{
+public:
     //==========================================================================
     // Konstruktor
     //==========================================================================
@@ -43,7 +69,7 @@ public:
     {
         initializeFilters();
     }
-    
+
     //==========================================================================
     // Initialisierung
     //==========================================================================
@@ -51,53 +77,51 @@ public:
     {
         baseSampleRate = sampleRate;
         baseBlockSize = maxBlockSize;
-        this->numChannels = channels;
-        
+        this->numChannels = juce::jmax(1, channels);
+
         // Maximale Buffer-Größe für höchstes Oversampling
         int maxOversampledSize = maxBlockSize * static_cast<int>(Factor::x16);
-        
+
         // Buffer für jeden Kanal allokieren
         oversampledBuffers.resize(static_cast<size_t>(numChannels));
         for (auto& buffer : oversampledBuffers)
         {
-            buffer.resize(static_cast<size_t>(maxOversampledSize), 0.0f);
+            buffer.resize(static_cast<size_t>(maxOversampledSize), SampleType());
         }
-        
+
+        channelPointers.resize(static_cast<size_t>(numChannels), nullptr);
+        for (int ch = 0; ch < numChannels; ++ch)
+            channelPointers[static_cast<size_t>(ch)] = oversampledBuffers[static_cast<size_t>(ch)].data();
+
         // Scratch-Buffer für RT-safe In-Place Verarbeitung
-        scratchBuffer.resize(static_cast<size_t>(maxOversampledSize), 0.0f);
-        
-        // Filter für jede Stage neu initialisieren
+        // (Historie + längster Stufen-Input; Halbphasen bei 16x = 8 x Block)
+        const int maxHistory = 2 * FIR_HALF_TAPS_FIRST;
+        scratchBuffer.resize(static_cast<size_t>(maxOversampledSize), SampleType());
+        workA.resize(static_cast<size_t>(maxOversampledSize + maxHistory), SampleType());
+        workB.resize(static_cast<size_t>(maxOversampledSize + maxHistory), SampleType());
+        workC.resize(static_cast<size_t>(maxOversampledSize), SampleType());
+
+        // Filter-Zustände pro Stage/Kanal
         initializeFilters();
-        
+
         prepared = true;
     }
-    
+
     void reset()
     {
-        // Filter-Zustände zurücksetzen
-        for (auto& stage : upsampleFilters)
+        for (auto& stage : stageStates)
         {
-            for (auto& filter : stage)
+            for (auto& state : stage)
             {
-                std::fill(filter.begin(), filter.end(), 0.0f);
+                std::fill(state.upHistory.begin(), state.upHistory.end(), SampleType());
+                std::fill(state.downOddHistory.begin(), state.downOddHistory.end(), SampleType());
+                std::fill(state.downEvenHistory.begin(), state.downEvenHistory.end(), SampleType());
+                state.upAllpass = {};
+                state.downAllpass = {};
             }
         }
-        
-        for (auto& stage : downsampleFilters)
-        {
-            for (auto& filter : stage)
-            {
-                std::fill(filter.begin(), filter.end(), 0.0f);
-            }
-        }
-        
-        // Circular Buffer Indizes zurücksetzen
-        for (auto& stage : upsampleFilterIdx)
-            std::fill(stage.begin(), stage.end(), 0);
-        for (auto& stage : downsampleFilterIdx)
-            std::fill(stage.begin(), stage.end(), 0);
     }
-    
+
     //==========================================================================
     // Oversampling-Faktor setzen
     //==========================================================================
@@ -109,221 +133,308 @@ public:
             reset();  // Filter zurücksetzen bei Wechsel
         }
     }
-    
+
     Factor getOversamplingFactor() const { return factor; }
     int getFactorAsInt() const { return static_cast<int>(factor); }
-    
+
     //==========================================================================
-    // Latenz in Samples (bei Basis-Samplerate)
+    // Filter-Qualität setzen (FIR linear-phasig vs. IIR minimal-phasig)
     //==========================================================================
-    int getLatencyInSamples() const
+    void setFilterQuality(FilterQuality newQuality)
     {
-        // Latenz kommt von den FIR-Filtern
-        // Jede Stage hat filterOrder/2 Samples Latenz
-        int numStages = getNumStages();
-        return (numStages * filterOrder) / 2;
+        if (quality != newQuality)
+        {
+            quality = newQuality;
+            reset();
+        }
     }
-    
+
+    FilterQuality getFilterQuality() const { return quality; }
+
     //==========================================================================
-    // Upsampling: Input-Block auf höhere Rate bringen
+    // Latenz in Samples (bei Basis-Samplerate, Up + Down)
     //==========================================================================
-    void upsample(const float* input, int numInputSamples, int channel)
+    int getLatencyInSamples() const { return getLatencyInSamples(factor, quality); }
+
+    /** Latenz einer beliebigen Einstellung (z.B. Ziel eines noch ausstehenden Wechsels). */
+    int getLatencyInSamples(Factor forFactor, FilterQuality forQuality) const
     {
+        const int numStages = getNumStages(forFactor);
+        double latency = 0.0;
+
+        // Stufe s läuft mit 2^s-facher Basisrate → Latenz / 2^s
+        for (int s = 0; s < numStages; ++s)
+        {
+            const double stageScale = 1.0 / static_cast<double>(1 << s);
+
+            if (forQuality == FilterQuality::LinearPhase)
+                latency += 2.0 * static_cast<double>(getFIRHalfTaps(s)) * stageScale;  // exakt ganzzahlig
+            else
+                latency += iirGroupDelay[static_cast<size_t>(s)] * stageScale;        // Gruppenlaufzeit bei DC
+        }
+
+        return static_cast<int>(std::lround(latency));
+    }
+
+    //==========================================================================
+    // Block-API: alle Kanäle auf einmal
+    //==========================================================================
+
+    /** Upsampled die ersten numCh Kanäle und liefert die Kanal-Pointer (Länge getOversampledSize()). */
+    SampleType* const* upsampleBlock(const juce::AudioBuffer<SampleType>& input, int numCh)
+    {
+        numCh = juce::jmin(numCh, numChannels, input.getNumChannels());
+
+        for (int ch = 0; ch < numCh; ++ch)
+            upsample(input.getReadPointer(ch), input.getNumSamples(), ch);
+
+        return channelPointers.data();
+    }
+
+    /** Downsampled die oversampled Kanäle zurück in output (numSamples = Basis-Blockgröße). */
+    void downsampleBlock(juce::AudioBuffer<SampleType>& output, int numCh)
+    {
+        numCh = juce::jmin(numCh, numChannels, output.getNumChannels());
+
+        for (int ch = 0; ch < numCh; ++ch)
+            downsample(output.getWritePointer(ch), output.getNumSamples(), ch);
+    }
+
+    //==========================================================================
+    // Upsampling: Input-Block eines Kanals auf höhere Rate bringen
+    //==========================================================================
+    void upsample(const SampleType* input, int numInputSamples, int channel)
+    {
+        auto& buffer = oversampledBuffers[static_cast<size_t>(channel)];
+
         if (!prepared || factor == Factor::x1)
         {
             // Bypass: direkt kopieren
-            for (int i = 0; i < numInputSamples; ++i)
-            {
-                oversampledBuffers[static_cast<size_t>(channel)][static_cast<size_t>(i)] = input[i];
-            }
+            juce::FloatVectorOperations::copy(buffer.data(), input, numInputSamples);
             currentOversampledSize = numInputSamples;
             return;
         }
-        
-        auto& buffer = oversampledBuffers[static_cast<size_t>(channel)];
-        
-        // Stufen-weise Upsampling (je Stufe 2x)
+
+        // Stufen-weise Upsampling (je Stufe 2x), Stage 0: Input -> 2x
+        const int numStages = getNumStages();
         int currentSize = numInputSamples;
-        
-        // Stage 1: Input -> 2x
-        if (static_cast<int>(factor) >= 2)
-        {
-            upsample2x(input, buffer.data(), numInputSamples, channel, 0);
-            currentSize *= 2;
-        }
-        
-        // Stage 2: 2x -> 4x
-        if (static_cast<int>(factor) >= 4)
+
+        upsampleStage(input, buffer.data(), currentSize, channel, 0);
+        currentSize *= 2;
+
+        for (int stage = 1; stage < numStages; ++stage)
         {
             // Pre-allokierter Scratch-Buffer (RT-safe, keine Heap-Allokation)
-            std::copy(buffer.begin(), buffer.begin() + currentSize, scratchBuffer.begin());
-            upsample2x(scratchBuffer.data(), buffer.data(), currentSize, channel, 1);
-            currentSize *= 2;
-        }
-        
-        // Stage 3: 4x -> 8x
-        if (static_cast<int>(factor) >= 8)
-        {
-            std::copy(buffer.begin(), buffer.begin() + currentSize, scratchBuffer.begin());
-            upsample2x(scratchBuffer.data(), buffer.data(), currentSize, channel, 2);
+            juce::FloatVectorOperations::copy(scratchBuffer.data(), buffer.data(), currentSize);
+            upsampleStage(scratchBuffer.data(), buffer.data(), currentSize, channel, stage);
             currentSize *= 2;
         }
-        
-        // Stage 4: 8x -> 16x
-        if (static_cast<int>(factor) >= 16)
-        {
-            std::copy(buffer.begin(), buffer.begin() + currentSize, scratchBuffer.begin());
-            upsample2x(scratchBuffer.data(), buffer.data(), currentSize, channel, 3);
-            currentSize *= 2;
-        }
-        
+
         currentOversampledSize = currentSize;
     }
-    
+
     //==========================================================================
-    // Downsampling: Oversampled-Block zurück auf Basis-Rate
+    // Downsampling: Oversampled-Block eines Kanals zurück auf Basis-Rate
     //==========================================================================
-    void downsample(float* output, int numOutputSamples, int channel)
+    void downsample(SampleType* output, int numOutputSamples, int channel)
     {
+        auto& buffer = oversampledBuffers[static_cast<size_t>(channel)];
+
         if (!prepared || factor == Factor::x1)
         {
             // Bypass: direkt kopieren
-            for (int i = 0; i < numOutputSamples; ++i)
-            {
-                output[i] = oversampledBuffers[static_cast<size_t>(channel)][static_cast<size_t>(i)];
-            }
+            juce::FloatVectorOperations::copy(output, buffer.data(), numOutputSamples);
             return;
         }
-        
-        auto& buffer = oversampledBuffers[static_cast<size_t>(channel)];
-        int currentSize = currentOversampledSize;
-        
-        // Stufen-weise Downsampling (je Stufe /2)
-        
-        // Stage 4: 16x -> 8x
-        if (static_cast<int>(factor) >= 16)
-        {
-            std::copy(buffer.begin(), buffer.begin() + currentSize, scratchBuffer.begin());
-            downsample2x(scratchBuffer.data(), buffer.data(), currentSize, channel, 3);
-            currentSize /= 2;
-        }
-        
-        // Stage 3: 8x -> 4x
-        if (static_cast<int>(factor) >= 8)
-        {
-            std::copy(buffer.begin(), buffer.begin() + currentSize, scratchBuffer.begin());
-            downsample2x(scratchBuffer.data(), buffer.data(), currentSize, channel, 2);
-            currentSize /= 2;
-        }
-        
-        // Stage 2: 4x -> 2x
-        if (static_cast<int>(factor) >= 4)
+
+        // Stufen-weise Downsampling (je Stufe /2), letzte Stufe zuerst
+        const int numStages = getNumStages();
+        int currentSize = numOutputSamples * getFactorAsInt();
+
+        for (int stage = numStages - 1; stage >= 1; --stage)
         {
-            std::copy(buffer.begin(), buffer.begin() + currentSize, scratchBuffer.begin());
-            downsample2x(scratchBuffer.data(), buffer.data(), currentSize, channel, 1);
+            juce::FloatVectorOperations::copy(scratchBuffer.data(), buffer.data(), currentSize);
+            downsampleStage(scratchBuffer.data(), buffer.data(), currentSize / 2, channel, stage);
             currentSize /= 2;
         }
-        
-        // Stage 1: 2x -> 1x
-        if (static_cast<int>(factor) >= 2)
-        {
-            std::copy(buffer.begin(), buffer.begin() + currentSize, scratchBuffer.begin());
-            downsample2x(scratchBuffer.data(), output, currentSize, channel, 0);
-        }
+
+        // Stage 0: 2x -> 1x direkt in den Output
+        downsampleStage(buffer.data(), output, currentSize / 2, channel, 0);
     }
-    
+
     //==========================================================================
     // Zugriff auf Oversampled Buffer (für Verarbeitung)
     //==========================================================================
-    float* getOversampledBuffer(int channel)
+    SampleType* getOversampledBuffer(int channel)
     {
         return oversampledBuffers[static_cast<size_t>(channel)].data();
     }
-    
+
     int getOversampledSize() const { return currentOversampledSize; }
-    
-    double getOversampledSampleRate() const 
-    { 
-        return baseSampleRate * static_cast<double>(static_cast<int>(factor)); 
+
+    double getOversampledSampleRate() const
+    {
+        return baseSampleRate * static_cast<double>(static_cast<int>(factor));
     }
-    
+
 private:
+    //==========================================================================
+    // Filter-Spezifikation
+    //==========================================================================
+    // FIR: Anzahl Nicht-Null-Seiten-Taps pro Seite (K). Halfband-Länge = 4K - 1.
+    // Erste Stufe: steiler Übergang bei Nyquist der Basisrate, spätere Stufen
+    // haben viel Übergangsband (das Nutzsignal liegt bereits unter fs/4).
+    static constexpr int FIR_HALF_TAPS_FIRST = 16;   // 63 Taps
+    static constexpr int FIR_HALF_TAPS_LATER = 8;    // 31 Taps
+
+    // IIR: Allpass-Koeffizienten (aufsteigend, abwechselnd Zweig 0 / Zweig 1)
+    static constexpr int MAX_IIR_COEFFS = 8;
+    static constexpr int IIR_COEFFS_FIRST = 8;       // Übergangsband 0.04, ~-99 dB
+    static constexpr int IIR_COEFFS_LATER = 4;       // Übergangsband 0.2,  ~-100 dB
+
+    static int getFIRHalfTaps(int stage) { return stage == 0 ? FIR_HALF_TAPS_FIRST : FIR_HALF_TAPS_LATER; }
+    static int getIIRNumCoeffs(int stage) { return stage == 0 ? IIR_COEFFS_FIRST : IIR_COEFFS_LATER; }
+
+    // Erster Ordnung Allpass in z^-1 der Halbrate: y = a * (x - y1) + x1
+    struct AllpassState
+    {
+        std::array<SampleType, MAX_IIR_COEFFS> x1 {};
+        std::array<SampleType, MAX_IIR_COEFFS> y1 {};
+    };
+
+    struct StageState
+    {
+        // FIR: Historie der jeweils letzten Input-Samples (Polyphasen)
+        std::vector<SampleType> upHistory;        // 2K - 1
+        std::vector<SampleType> downOddHistory;   // 2K
+        std::vector<SampleType> downEvenHistory;  // K
+
+        // IIR: zwei Allpass-Zweige (Zustände pro Koeffizient)
+        AllpassState upAllpass;
+        AllpassState downAllpass;
+    };
+
     //==========================================================================
     // Filter-Initialisierung
     //==========================================================================
     void initializeFilters()
     {
-        // Halfband FIR Koeffizienten (optimiert für -120dB Stopband)
-        // Diese sind für 2x Up/Downsampling optimiert
-        
-        // 31-tap Halfband Filter (Type II, symmetric)
-        // Cutoff bei 0.25 * fs (Nyquist/2), sehr steiler Rolloff
-        filterCoeffs = {
-            0.0f,
-            -0.00025f,
-            0.0f,
-            0.00123f,
-            0.0f,
-            -0.00438f,
-            0.0f,
-            0.01193f,
-            0.0f,
-            -0.02774f,
-            0.0f,
-            0.06294f,
-            0.0f,
-            -0.18677f,
-            0.0f,
-            0.62915f,  // Center (halbe Leistung)
-            0.0f,
-            -0.18677f,
-            0.0f,
-            0.06294f,
-            0.0f,
-            -0.02774f,
-            0.0f,
-            0.01193f,
-            0.0f,
-            -0.00438f,
-            0.0f,
-            0.00123f,
-            0.0f,
-            -0.00025f,
-            0.0f
-        };
-        
-        filterOrder = static_cast<int>(filterCoeffs.size());
-        
-        // Filter-Zustände für bis zu 4 Stages und maxNumChannels Kanäle
-        constexpr int maxStages = 4;
-        constexpr int maxNumChannels = 8;
-        
-        upsampleFilters.resize(maxStages);
-        downsampleFilters.resize(maxStages);
-        upsampleFilterIdx.resize(maxStages);
-        downsampleFilterIdx.resize(maxStages);
-        
-        for (int stage = 0; stage < maxStages; ++stage)
+        // FIR-Halfbands: h[0] = 0.5, h[±(2j+1)] = Seiten-Taps, alle anderen 0
+        for (int s = 0; s < MAX_STAGES; ++s)
+            designHalfbandFIR(firSideTaps[static_cast<size_t>(s)], getFIRHalfTaps(s));
+
+        // IIR-Halfbands + Gruppenlaufzeit bei DC (für Latenz-Meldung)
+        for (int s = 0; s < MAX_STAGES; ++s)
+        {
+            auto& coeffs = iirCoeffs[static_cast<size_t>(s)];
+            const int n = getIIRNumCoeffs(s);
+            designHalfbandIIR(coeffs, n, s == 0 ? 0.04 : 0.2);
+
+            // Zweig 0 (gerade Indizes): Allpass in z^-2 → Laufzeit 2(1-a)/(1+a) Samples
+            // pro Richtung, Angabe in Samples der Stufen-Eingangsrate (/2), Up + Down
+            double delay = 0.0;
+            for (int i = 0; i < n; i += 2)
+                delay += 2.0 * (1.0 - coeffs[static_cast<size_t>(i)]) / (1.0 + coeffs[static_cast<size_t>(i)]);
+            iirGroupDelay[static_cast<size_t>(s)] = delay;  // (2 Richtungen x /2)
+        }
+
+        // Zustände für bis zu 4 Stages und numChannels Kanäle
+        for (int s = 0; s < MAX_STAGES; ++s)
         {
-            upsampleFilters[static_cast<size_t>(stage)].resize(maxNumChannels);
-            downsampleFilters[static_cast<size_t>(stage)].resize(maxNumChannels);
-            upsampleFilterIdx[static_cast<size_t>(stage)].resize(static_cast<size_t>(maxNumChannels), 0);
-            downsampleFilterIdx[static_cast<size_t>(stage)].resize(static_cast<size_t>(maxNumChannels), 0);
-            
-            for (int ch = 0; ch < maxNumChannels; ++ch)
+            const int k = getFIRHalfTaps(s);
+            auto& stage = stageStates[static_cast<size_t>(s)];
+            stage.resize(static_cast<size_t>(numChannels));
+
+            for (auto& state : stage)
             {
-                // Doppelte Größe für Branch-freien Circular Buffer (SIMD-freundlich)
-                upsampleFilters[static_cast<size_t>(stage)][static_cast<size_t>(ch)].resize(
-                    static_cast<size_t>(filterOrder * 2), 0.0f);
-                downsampleFilters[static_cast<size_t>(stage)][static_cast<size_t>(ch)].resize(
-                    static_cast<size_t>(filterOrder * 2), 0.0f);
+                state.upHistory.assign(static_cast<size_t>(2 * k - 1), SampleType());
+                state.downOddHistory.assign(static_cast<size_t>(2 * k), SampleType());
+                state.downEvenHistory.assign(static_cast<size_t>(k), SampleType());
+                state.upAllpass = {};
+                state.downAllpass = {};
             }
         }
     }
-    
-    int getNumStages() const
+
+    /** Kaiser-gefensterter Halfband-Tiefpass, Seiten-Taps auf Summe 0.25 normiert (DC = 1). */
+    static void designHalfbandFIR(std::vector<SampleType>& sideTaps, int halfTaps)
+    {
+        constexpr double beta = 8.0;  // ~-80 dB Sperrdämpfung
+        const double halfLength = static_cast<double>(2 * halfTaps);  // Fenster-Halbbreite
+
+        sideTaps.resize(static_cast<size_t>(halfTaps));
+        double sum = 0.0;
+
+        for (int j = 0; j < halfTaps; ++j)
+        {
+            const double n = static_cast<double>(2 * j + 1);
+            const double sinc = std::sin(juce::MathConstants<double>::halfPi * n) / (juce::MathConstants<double>::pi * n);
+            const double r = n / halfLength;
+            const double window = besselI0(beta * std::sqrt(juce::jmax(0.0, 1.0 - r * r))) / besselI0(beta);
+
+            sideTaps[static_cast<size_t>(j)] = static_cast<SampleType>(sinc * window);
+            sum += sinc * window;
+        }
+
+        for (auto& tap : sideTaps)
+            tap = static_cast<SampleType>(tap * 0.25 / sum);
+    }
+
+    static double besselI0(double x)
     {
-        switch (factor)
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 50; ++k)
+        {
+            term *= (x * 0.5 / k) * (x * 0.5 / k);
+            sum += term;
+            if (term < 1e-12 * sum) break;
+        }
+        return sum;
+    }
+
+    /**
+     * Elliptischer Polyphase-IIR-Halfband (zwei Allpass-Zweige in z^-2),
+     * Koeffizienten nach dem Valenzuela/Constantinides-Verfahren.
+     * H(z) = 0.5 * (A0(z^2) + z^-1 * A1(z^2))
+     */
+    static void designHalfbandIIR(std::array<double, MAX_IIR_COEFFS>& coeffs, int numCoeffs, double transitionBandwidth)
+    {
+        double k = std::tan((1.0 - transitionBandwidth * 2.0) * juce::MathConstants<double>::pi / 4.0);
+        k *= k;
+        const double kksqrt = std::pow(1.0 - k * k, 0.25);
+        const double e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+        const double e4 = e * e * e * e;
+        const double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+        const int order = numCoeffs * 2 + 1;
+
+        for (int i = 0; i < numCoeffs; ++i)
+        {
+            const int c = i + 1;
+
+            // Zähler-/Nenner-Reihen (Jacobi-Theta), konvergieren sehr schnell
+            double num = 0.0, den = 0.0;
+            for (int m = 0; m < 20; ++m)
+                num += ((m & 1) ? -1.0 : 1.0) * std::pow(q, m * (m + 1))
+                     * std::sin((2 * m + 1) * c * juce::MathConstants<double>::pi / order);
+            for (int m = 1; m < 20; ++m)
+                den += ((m & 1) ? -1.0 : 1.0) * std::pow(q, m * m)
+                     * std::cos(2 * m * c * juce::MathConstants<double>::pi / order);
+
+            const double ww = num * std::pow(q, 0.25) / (den + 0.5);
+            const double wwsq = ww * ww;
+            const double x = std::sqrt((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+            coeffs[static_cast<size_t>(i)] = (1.0 - x) / (1.0 + x);
+        }
+
+        for (int i = numCoeffs; i < MAX_IIR_COEFFS; ++i)
+            coeffs[static_cast<size_t>(i)] = 0.0;
+    }
+
+    int getNumStages() const { return getNumStages(factor); }
+
+    static int getNumStages(Factor forFactor)
+    {
+        switch (forFactor)
         {
             case Factor::x2:  return 1;
             case Factor::x4:  return 2;
@@ -332,122 +443,212 @@ private:
             default: return 0;
         }
     }
-    
+
+    void upsampleStage(const SampleType* input, SampleType* output, int numInputSamples, int channel, int stage)
+    {
+        if (quality == FilterQuality::LinearPhase)
+            upsample2xFIR(input, output, numInputSamples, channel, stage);
+        else
+            upsample2xIIR(input, output, numInputSamples, channel, stage);
+    }
+
+    void downsampleStage(const SampleType* input, SampleType* output, int numOutputSamples, int channel, int stage)
+    {
+        if (quality == FilterQuality::LinearPhase)
+            downsample2xFIR(input, output, numOutputSamples, channel, stage);
+        else
+            downsample2xIIR(input, output, numOutputSamples, channel, stage);
+    }
+
     //==========================================================================
-    // 2x Upsampling mit Halfband Filter
+    // 2x Upsampling, Polyphase-Halfband-FIR
+    // Gerade Phase = reine Verzögerung (Center-Tap), ungerade Phase = symmetrischer
+    // FIR aus den K Seiten-Taps. Die Null-Taps des Halfbands werden nie gerechnet.
+    //   y[2m]   = x[m-K]
+    //   y[2m+1] = Σ_j 2·h_j · (x[m-K-j] + x[m-K+1+j])
     //==========================================================================
-    void upsample2x(const float* input, float* output, int numInputSamples, int channel, int stage)
+    void upsample2xFIR(const SampleType* input, SampleType* output, int numInputSamples, int channel, int stage)
     {
-        auto& filterState = upsampleFilters[static_cast<size_t>(stage)][static_cast<size_t>(channel)];
-        auto& circIdx = upsampleFilterIdx[static_cast<size_t>(stage)][static_cast<size_t>(channel)];
-        
-        int outputIndex = 0;
-        
-        for (int i = 0; i < numInputSamples; ++i)
+        auto& state = stageStates[static_cast<size_t>(stage)][static_cast<size_t>(channel)];
+        const auto& taps = firSideTaps[static_cast<size_t>(stage)];
+        const int k = getFIRHalfTaps(stage);
+        const int historySize = 2 * k - 1;
+        const int n = numInputSamples;
+
+        // Arbeitsbuffer: [Historie | Input] → x[m-d] liegt bei (historySize + m - d)
+        SampleType* work = workA.data();
+        juce::FloatVectorOperations::copy(work, state.upHistory.data(), historySize);
+        juce::FloatVectorOperations::copy(work + historySize, input, n);
+
+        // Ungerade Phase: pro Tap zwei vektorisierte Multiply-Adds über den ganzen Block
+        SampleType* odd = workC.data();
+        juce::FloatVectorOperations::clear(odd, n);
+
+        for (int j = 0; j < k; ++j)
         {
-            // Sample 1: Original mit Filterung (Circular Buffer)
-            output[outputIndex++] = applyFIR(filterState, circIdx, input[i] * 2.0f);
-            
-            // Sample 2: Interpoliertes Sample (Zero-Stuffed)
-            output[outputIndex++] = applyFIR(filterState, circIdx, 0.0f);
+            const SampleType c = static_cast<SampleType>(2) * taps[static_cast<size_t>(j)];
+            juce::FloatVectorOperations::addWithMultiply(odd, work + (k - 1 - j), c, n);
+            juce::FloatVectorOperations::addWithMultiply(odd, work + (k + j), c, n);
         }
+
+        // Interleaven: gerade Phase ist x[m-K]
+        const SampleType* even = work + (k - 1);
+        for (int m = 0; m < n; ++m)
+        {
+            output[2 * m]     = even[m];
+            output[2 * m + 1] = odd[m];
+        }
+
+        // Historie aktualisieren (letzte 2K-1 Samples)
+        juce::FloatVectorOperations::copy(state.upHistory.data(), work + n, historySize);
     }
-    
+
     //==========================================================================
-    // 2x Downsampling mit Halfband Filter + Decimation
+    // 2x Downsampling, Polyphase-Halfband-FIR (nur behaltene Outputs werden gerechnet)
+    //   e[m] = s[2m], o[m] = s[2m+1]
+    //   y[m] = 0.5·e[m-K] + Σ_j h_j · (o[m-K+j] + o[m-K-1-j])
     //==========================================================================
-    void downsample2x(const float* input, float* output, int numInputSamples, int channel, int stage)
+    void downsample2xFIR(const SampleType* input, SampleType* output, int numOutputSamples, int channel, int stage)
     {
-        auto& filterState = downsampleFilters[static_cast<size_t>(stage)][static_cast<size_t>(channel)];
-        auto& circIdx = downsampleFilterIdx[static_cast<size_t>(stage)][static_cast<size_t>(channel)];
-        
-        int outputIndex = 0;
-        
-        for (int i = 0; i < numInputSamples; i += 2)
+        auto& state = stageStates[static_cast<size_t>(stage)][static_cast<size_t>(channel)];
+        const auto& taps = firSideTaps[static_cast<size_t>(stage)];
+        const int k = getFIRHalfTaps(stage);
+        const int n = numOutputSamples;
+
+        // Deinterleave in [Historie | neue Phase-Samples]
+        SampleType* oddWork = workA.data();    // o[m-d] bei (2K + m - d)
+        SampleType* evenWork = workB.data();   // e[m-d] bei (K + m - d)
+        juce::FloatVectorOperations::copy(oddWork, state.downOddHistory.data(), 2 * k);
+        juce::FloatVectorOperations::copy(evenWork, state.downEvenHistory.data(), k);
+
+        for (int m = 0; m < n; ++m)
         {
-            // Anti-Aliasing Tiefpass mit Circular Buffer, dann Decimation
-            applyFIR(filterState, circIdx, input[i]);
-            
-            // Verarbeite Sample 2 und output (Decimation: nur jeden 2.)
-            float filtered = 0.0f;
-            if (i + 1 < numInputSamples)
-                filtered = applyFIR(filterState, circIdx, input[i + 1]);
-            else
-                filtered = applyFIR(filterState, circIdx, 0.0f);
-            
-            output[outputIndex++] = filtered;
+            evenWork[k + m] = input[2 * m];
+            oddWork[2 * k + m] = input[2 * m + 1];
+        }
+
+        // Center-Tap (e[m-K]) + symmetrische Seiten-Taps, blockweise vektorisiert
+        juce::FloatVectorOperations::multiply(output, evenWork, static_cast<SampleType>(0.5), n);
+
+        for (int j = 0; j < k; ++j)
+        {
+            const SampleType c = taps[static_cast<size_t>(j)];
+            juce::FloatVectorOperations::addWithMultiply(output, oddWork + (k + j), c, n);
+            juce::FloatVectorOperations::addWithMultiply(output, oddWork + (k - 1 - j), c, n);
+        }
+
+        juce::FloatVectorOperations::copy(state.downOddHistory.data(), oddWork + n, 2 * k);
+        juce::FloatVectorOperations::copy(state.downEvenHistory.data(), evenWork + n, k);
+    }
+
+    //==========================================================================
+    // 2x Up/Downsampling, Polyphase-IIR-Halfband (minimalphasig)
+    // Zweig 0: gerade Koeffizienten, Zweig 1: ungerade Koeffizienten
+    //==========================================================================
+    static inline SampleType processAllpassChain(AllpassState& st, const std::array<double, MAX_IIR_COEFFS>& coeffs,
+                                            int first, int numCoeffs, SampleType x) noexcept
+    {
+        for (int i = first; i < numCoeffs; i += 2)
+        {
+            const auto idx = static_cast<size_t>(i);
+            const SampleType y = static_cast<SampleType>(coeffs[idx]) * (x - st.y1[idx]) + st.x1[idx];
+            st.x1[idx] = x;
+            st.y1[idx] = y;
+            x = y;
+        }
+        return x;
+    }
+
+    void upsample2xIIR(const SampleType* input, SampleType* output, int numInputSamples, int channel, int stage)
+    {
+        auto& state = stageStates[static_cast<size_t>(stage)][static_cast<size_t>(channel)];
+        const auto& coeffs = iirCoeffs[static_cast<size_t>(stage)];
+        const int numCoeffs = getIIRNumCoeffs(stage);
+
+        for (int m = 0; m < numInputSamples; ++m)
+        {
+            const SampleType x = input[m];
+            output[2 * m]     = processAllpassChain(state.upAllpass, coeffs, 0, numCoeffs, x);
+            output[2 * m + 1] = processAllpassChain(state.upAllpass, coeffs, 1, numCoeffs, x);
+        }
+
+        flushAllpassDenormals(state.upAllpass);
+    }
+
+    void downsample2xIIR(const SampleType* input, SampleType* output, int numOutputSamples, int channel, int stage)
+    {
+        auto& state = stageStates[static_cast<size_t>(stage)][static_cast<size_t>(channel)];
+        const auto& coeffs = iirCoeffs[static_cast<size_t>(stage)];
+        const int numCoeffs = getIIRNumCoeffs(stage);
+
+        for (int m = 0; m < numOutputSamples; ++m)
+        {
+            // Zweig 0 bekommt das spätere, Zweig 1 (z^-1) das frühere Sample
+            const SampleType branch0 = processAllpassChain(state.downAllpass, coeffs, 0, numCoeffs, input[2 * m + 1]);
+            const SampleType branch1 = processAllpassChain(state.downAllpass, coeffs, 1, numCoeffs, input[2 * m]);
+            output[m] = static_cast<SampleType>(0.5) * (branch0 + branch1);
+        }
+
+        flushAllpassDenormals(state.downAllpass);
+    }
+
+    static void flushAllpassDenormals(AllpassState& st) noexcept
+    {
+        for (size_t i = 0; i < MAX_IIR_COEFFS; ++i)
+        {
+            if (std::abs(st.x1[i]) < static_cast<SampleType>(1.0e-15)) st.x1[i] = 0;
+            if (std::abs(st.y1[i]) < static_cast<SampleType>(1.0e-15)) st.y1[i] = 0;
         }
     }
-    
+
     //==========================================================================
     // Member-Variablen
     //==========================================================================
     double baseSampleRate = 44100.0;
     int baseBlockSize = 512;
     int numChannels = 2;
-    
+
     Factor factor = Factor::x1;
+    FilterQuality quality = FilterQuality::LinearPhase;
     bool prepared = false;
     int currentOversampledSize = 0;
-    
-    // Oversampled Audio-Buffer (pro Kanal)
-    std::vector<std::vector<float>> oversampledBuffers;
-    
-    // Pre-allokierter Scratch-Buffer (RT-safe, verhindert Heap-Allokation)
-    std::vector<float> scratchBuffer;
-    
-    // FIR Filter Koeffizienten (Halfband)
-    std::vector<float> filterCoeffs;
-    int filterOrder = 31;
-    
-    // Filter-Zustände [stage][channel][filterState]
-    std::vector<std::vector<std::vector<float>>> upsampleFilters;
-    std::vector<std::vector<std::vector<float>>> downsampleFilters;
-    
-    // Circular Buffer Indizes [stage][channel]
-    std::vector<std::vector<int>> upsampleFilterIdx;
-    std::vector<std::vector<int>> downsampleFilterIdx;
-    
-    // SIMD-freundlicher FIR mit doppeltem Circular Buffer:
-    // State ist 2x filterOrder lang; Daten werden an [writeIdx] UND [writeIdx + filterOrder] geschrieben.
-    // Dadurch kann der innere Loop branchfrei lesen (kein Wrap-Around-Check nötig).
-    inline float applyFIR(std::vector<float>& state, int& writeIdx, float inputSample) const
-    {
-        // Schreibe an beide Positionen im doppelten Buffer
-        state[static_cast<size_t>(writeIdx)] = inputSample;
-        state[static_cast<size_t>(writeIdx + filterOrder)] = inputSample;
-        
-        // Dot-Product: branchfreier linearer Zugriff dank doppeltem Buffer
-        // Lese rückwärts ab writeIdx: state[writeIdx], state[writeIdx-1], ... 
-        // = state[writeIdx+filterOrder], state[writeIdx+filterOrder-1], ... (doppelter buffer)
-        const float* readPtr = state.data() + writeIdx + 1;  // readPtr[filterOrder-1] = neuestes Sample
-        float filtered = 0.0f;
-        for (int j = 0; j < filterOrder; ++j)
-        {
-            filtered += readPtr[filterOrder - 1 - j] * filterCoeffs[static_cast<size_t>(j)];
-        }
-        
-        if (++writeIdx >= filterOrder) writeIdx = 0;
-        return filtered;
-    }
-    
+
+    // Oversampled Audio-Buffer (pro Kanal) + Pointer-Array für AudioBuffer-Wrapping
+    std::vector<std::vector<SampleType>> oversampledBuffers;
+    std::vector<SampleType*> channelPointers;
+
+    // Pre-allokierte Scratch-/Arbeits-Buffer (RT-safe, verhindert Heap-Allokation)
+    std::vector<SampleType> scratchBuffer;
+    std::vector<SampleType> workA, workB, workC;
+
+    // Halfband-FIR: Seiten-Taps h_j = h[±(2j+1)] pro Stage
+    std::array<std::vector<SampleType>, MAX_STAGES> firSideTaps;
+
+    // Halfband-IIR: Allpass-Koeffizienten + DC-Gruppenlaufzeit pro Stage
+    std::array<std::array<double, MAX_IIR_COEFFS>, MAX_STAGES> iirCoeffs {};
+    std::array<double, MAX_STAGES> iirGroupDelay {};
+
+    // Filter-Zustände [stage][channel]
+    std::array<std::vector<StageState>, MAX_STAGES> stageStates;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HighQualityOversampler)
 };
 
 
 /**
  * OversampledProcessor: Wrapper für einfaches Oversampling von Callback-Funktionen
- * 
+ *
  * Verwendung:
- * OversampledProcessor oversampler;
+ * OversampledProcessor<float> oversampler;
  * oversampler.prepare(sampleRate, blockSize);
- * oversampler.setOversamplingFactor(HighQualityOversampler::Factor::x4);
- * 
+ * oversampler.setOversamplingFactor(HighQualityOversamplerBase::Factor::x4);
+ *
  * oversampler.process(buffer, [](float sample) {
  *     // Nicht-lineare Verarbeitung hier
  *     return std::tanh(sample);  // z.B. Soft-Clipping
  * });
  */
+template <typename SampleType>
 class OversampledProcessor
 {
 public:
@@ -456,49 +657,49 @@ public:
         oversampler.prepare(sampleRate, maxBlockSize, channels);
         this->numChannels = channels;
     }
-    
+
     void reset() { oversampler.reset(); }
-    
-    void setOversamplingFactor(HighQualityOversampler::Factor factor)
+
+    void setOversamplingFactor(HighQualityOversamplerBase::Factor factor)
     {
         oversampler.setOversamplingFactor(factor);
     }
-    
+
     int getLatencyInSamples() const { return oversampler.getLatencyInSamples(); }
-    
+
     /**
      * Verarbeitet einen Buffer mit optionalem Oversampling
-     * 
+     *
      * @param buffer Audio-Buffer (wird in-place modifiziert)
      * @param processFunc Funktion die auf jeden oversampled Sample angewendet wird
      */
     template<typename ProcessFunc>
-    void process(juce::AudioBuffer<float>& buffer, ProcessFunc processFunc)
+    void process(juce::AudioBuffer<SampleType>& buffer, ProcessFunc processFunc)
     {
         int numSamples = buffer.getNumSamples();
-        
+
         for (int ch = 0; ch < numChannels && ch < buffer.getNumChannels(); ++ch)
         {
-            float* channelData = buffer.getWritePointer(ch);
-            
+            SampleType* channelData = buffer.getWritePointer(ch);
+
             // Upsample
             oversampler.upsample(channelData, numSamples, ch);
-            
+
             // Verarbeitung bei hoher Sample-Rate
-            float* oversampledData = oversampler.getOversampledBuffer(ch);
+            SampleType* oversampledData = oversampler.getOversampledBuffer(ch);
             int oversampledSize = oversampler.getOversampledSize();
-            
+
             for (int i = 0; i < oversampledSize; ++i)
             {
                 oversampledData[i] = processFunc(oversampledData[i]);
             }
-            
+
             // Downsample
             oversampler.downsample(channelData, numSamples, ch);
         }
     }
-    
+
 private:
-    HighQualityOversampler oversampler;
+    HighQualityOversampler<SampleType> oversampler;
     int numChannels = 2;
 };
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+/**
+ * LatencyCompensationDelay: Gemeinsame Verzögerungsleitung für alle Dry-Abgriffe.
+ *
+ * - Der unbearbeitete Block wird EINMAL pro processBlock geschrieben (push)
+ * - Jeder Abgriff (Wet/Dry-Mix, A/B- bzw. Delta-Vergleich, Auto-Gain-Eingang)
+ *   liest denselben Block mit der Latenz der Stufen, gegen die er verglichen
+ *   wird (read) → kein Kammfilter durch Oversampling, Linear Phase oder STFT
+ * - Kapazität wird in prepare() für die größtmögliche Latenz aller Modi
+ *   alloziert: Moduswechsel zur Laufzeit ändern nur die Leseposition
+ * - Ring mit Zweierpotenz-Länge, Kopien als Blockoperationen (max. 2 pro Kanal)
+ * - Ring in double: verlustfrei für den float- und den double-Pfad des Hosts
+ */
+class LatencyCompensationDelay
+{
+public:
+    static constexpr int MAX_CHANNELS = 2;
+
+    void prepare(int maxDelaySamples, int maxBlockSize)
+    {
+        maxDelay = juce::jmax(0, maxDelaySamples);
+        bufferSize = juce::nextPowerOfTwo(maxDelay + juce::jmax(1, maxBlockSize));
+
+        for (auto& channel : ring)
+            channel.assign(static_cast<size_t>(bufferSize), 0.0);
+
+        reset();
+    }
+
+    void reset()
+    {
+        for (auto& channel : ring)
+            std::fill(channel.begin(), channel.end(), 0.0);
+
+        writePos = 0;
+        lastBlockSize = 0;
+        numPushedChannels = 0;
+    }
+
+    /** true, wenn ein Block dieser Länge mit voller Verzögerung gelesen werden kann. */
+    bool canProcess(int numSamples) const
+    {
+        return bufferSize > 0 && numSamples + maxDelay <= bufferSize;
+    }
+
+    /** Schreibt den aktuellen (unbearbeiteten) Block. */
+    template <typename SampleType>
+    void push(const juce::AudioBuffer<SampleType>& buffer)
+    {
+        if (bufferSize == 0)
+            return;
+
+        const int numSamples = buffer.getNumSamples();
+        numPushedChannels = juce::jmin(buffer.getNumChannels(), MAX_CHANNELS);
+
+        jassert(numSamples <= bufferSize);
+        lastBlockSize = juce::jmin(numSamples, bufferSize);
+
+        const int firstPart = juce::jmin(lastBlockSize, bufferSize - writePos);
+        const int secondPart = lastBlockSize - firstPart;
+        const int sourceOffset = numSamples - lastBlockSize;
+
+        for (int ch = 0; ch < numPushedChannels; ++ch)
+        {
+            const SampleType* source = buffer.getReadPointer(ch) + sourceOffset;
+            double* channel = ring[ch].data();
+
+            copySamples(channel + writePos, source, firstPart);
+            copySamples(channel, source + firstPart, secondPart);
+        }
+
+        writePos = (writePos + lastBlockSize) & (bufferSize - 1);
+    }
+
+    /**
+     * Liest den zuletzt geschriebenen Block um delaySamples verzögert nach dest
+     * (erste lastBlockSize Samples). Beliebig viele Abgriffe pro Block.
+     */
+    template <typename SampleType>
+    void read(juce::AudioBuffer<SampleType>& dest, int delaySamples) const
+    {
+        if (bufferSize == 0)
+            return;
+
+        const int numSamples = juce::jmin(lastBlockSize, dest.getNumSamples());
+        const int numChannels = juce::jmin(numPushedChannels, dest.getNumChannels());
+
+        jassert(delaySamples <= maxDelay);
+        const int delay = juce::jlimit(0, bufferSize - lastBlockSize, delaySamples);
+
+        const int readPos = (writePos - lastBlockSize - delay) & (bufferSize - 1);
+        const int firstPart = juce::jmin(numSamples, bufferSize - readPos);
+        const int secondPart = numSamples - firstPart;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const double* channel = ring[ch].data();
+            SampleType* target = dest.getWritePointer(ch);
+
+            copySamples(target, channel + readPos, firstPart);
+            copySamples(target + firstPart, channel, secondPart);
+        }
+    }
+
+    int getMaxDelay() const { return maxDelay; }
+
+private:
+    // double-Pfad: Blockkopie; float-Pfad: Wandlung (vektorisierbare Schleife)
+    static void copySamples(double* dest, const double* source, int numSamples)
+    {
+        juce::FloatVectorOperations::copy(dest, source, numSamples);
+    }
+
+    template <typename Dest, typename Source>
+    static void copySamples(Dest* dest, const Source* source, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = static_cast<Dest>(source[i]);
+    }
+
+    std::vector<double> ring[MAX_CHANNELS];
+    int bufferSize = 0;
+    int maxDelay = 0;
+    int writePos = 0;
+    int lastBlockSize = 0;
+    int numPushedChannels = 0;
+};
@@ -2,294 +2,492 @@
 
 #include <JuceHeader.h>
 #include "EQProcessor.h"
+#include "FrequencyResponseEngine.h"
 
 /**
- * LinearPhaseEQ: FFT-basierter Zero-Phase EQ
- * 
+ * LinearPhaseEQ: FIR-basierter Linear-Phase EQ (partitionierte FFT-Faltung)
+ *
  * Funktionsprinzip:
- * 1. Sammelt Input-Samples in einem Overlap-Add-Buffer (50% Overlap)
- * 2. Wendet ein Hann-Fenster an
- * 3. FFT → Frequenzbereich
- * 4. Multipliziert mit der gewünschten Magnitude-Antwort (Phase = 0)
- * 5. IFFT → Zeitbereich
- * 6. Overlap-Add in den Output-Buffer
- * 
- * Latenz: FFT_SIZE / 2 Samples (bei 4096: ~46ms bei 44.1kHz)
- * 
- * Latenz-Stufen:
- *   Low:    2048 Samples (~46ms bei 44.1kHz)  — für Mixing
- *   Medium: 4096 Samples (~93ms bei 44.1kHz)  — Standardmodus
- *   High:   8192 Samples (~186ms bei 44.1kHz) — für Mastering (beste Qualität)
+ * 1. FIR-Design (Producer-Thread): Magnitude-Kurve des EQProcessor auf dem
+ *    Raster der Design-FFT abtasten → IFFT (Zero-Phase-Impulsantwort)
+ *    → um die Kernel-Mitte zentrieren → Hann-Fenster → symmetrischer Kernel
+ * 2. Kernel in Partitionen der Größe B zerlegen, jede Partition vorab
+ *    transformieren (Spektren liegen im Triple-Buffer-Slot)
+ * 3. Audio-Thread: Uniform Partitioned Overlap-Save (UPOLS) mit
+ *    Frequency-Domain-Delay-Line — echte lineare Faltung, keine
+ *    Zirkular-Artefakte wie beim direkten STFT-Multiplizieren
+ *
+ * B folgt der Host-Blockgröße (Zweierpotenz, 64..1024): Pro Host-Block fällt
+ * (fast) immer gleich viel Arbeit an — kein 8192er-FFT-Spike alle paar Blöcke.
+ *
+ * Latenz: fftSize / 2 = Kernel-Mitte (fftSize / 2 − B) + Eingangspuffer (B)
+ *
+ * Latenz-Stufen (Design-Größe):
+ *   UltraLow: 512 Samples  (~6ms Latenz bei 44.1kHz)   — Tracking, grobe Bass-Auflösung
+ *   VeryLow:  1024 Samples (~12ms Latenz bei 44.1kHz)  — Tracking/Mixing
+ *   Low:      2048 Samples (~23ms Latenz bei 44.1kHz)  — für Mixing
+ *   Medium:   4096 Samples (~46ms Latenz bei 44.1kHz)  — Standardmodus
+ *   High:     8192 Samples (~93ms Latenz bei 44.1kHz)  — für Mastering (beste Qualität)
+ *
+ * Kernel-Übergabe (Producer → Audio-Thread):
+ *   Triple-Buffer mit vorallokierten Slots (Partitions-Spektren). Der Producer
+ *   (Hintergrund-Worker bzw. Offline-Render im Audio-Thread) schreibt in seinen
+ *   privaten Slot und tauscht ihn per atomic exchange gegen den geteilten Slot.
+ *   Der Audio-Thread übernimmt den geteilten Slot ebenfalls per exchange —
+ *   ohne Lock, ohne Kopie.
+ *
+ * Latenz-Wechsel: prepare() alloziert eine Engine (FFTs, Faltungs-Buffer,
+ *   Slots) pro Latenz-Stufe. setLatencyMode() speichert nur die Anfrage
+ *   (thread-safe, auch aus dem Parameter-Listener im Audio-Thread); der
+ *   Audio-Thread wechselt am Blockanfang den Engine-Zeiger, ohne Allokation.
+ *   Der Producer rechnet immer den Kernel der angefragten Stufe.
  */
 class LinearPhaseEQ
 {
 public:
+    // Werte bleiben stabil (neue Stufen hinten angehängt)
     enum class LatencyMode
     {
         Low = 0,    // 2048
         Medium,     // 4096
-        High        // 8192
+        High,       // 8192
+        VeryLow,    // 1024
+        UltraLow    // 512
     };
 
+    static constexpr int NUM_LATENCY_MODES = 5;
+    static constexpr int MAX_FFT_SIZE = 8192;
+    static constexpr int MIN_PARTITION_SIZE = 64;
+    static constexpr int MAX_PARTITION_SIZE = 1024;
+
     LinearPhaseEQ() = default;
     ~LinearPhaseEQ() = default;
 
-    void prepare(double sampleRate, int /*samplesPerBlock*/, int numChannels)
+    /** Alloziert die Engines aller Latenz-Stufen (nicht parallel zu processBlock()). */
+    void prepare(double sampleRate, int samplesPerBlock, int numChannels)
     {
+        const juce::ScopedLock sl(producerLock);
+
         currentSampleRate = sampleRate;
+        hostBlockSize = juce::jmax(1, samplesPerBlock);
         maxChannels = juce::jmin(numChannels, 2);
-        
-        updateFFTSize();
-    }
 
-    void setLatencyMode(LatencyMode mode)
-    {
-        if (latencyMode != mode)
+        for (int i = 0; i < NUM_LATENCY_MODES; ++i)
         {
-            latencyMode = mode;
-            updateFFTSize();
+            auto& engine = engines[static_cast<size_t>(i)];
+            if (engine == nullptr)
+                engine = std::make_unique<Engine>();
+
+            allocateEngine(*engine, getFFTSizeForMode(static_cast<LatencyMode>(i)));
         }
+
+        activeMode = requestedMode.load();
+        active = engines[static_cast<size_t>(activeMode)].get();
     }
 
-    LatencyMode getLatencyMode() const { return latencyMode; }
+    /** Thread-safe Anfrage, übernommen am Anfang des nächsten processBlock(). */
+    void setLatencyMode(LatencyMode mode) { requestedMode.store(mode); }
 
-    int getLatencyInSamples() const { return fftSize / 2; }
+    LatencyMode getLatencyMode() const { return requestedMode.load(); }
+
+    /** Latenz der angefragten Stufe (gilt ab dem nächsten processBlock()). */
+    int getLatencyInSamples() const { return getFFTSizeForMode(requestedMode.load()) / 2; }
+
+    int getPartitionSize() const { return active != nullptr ? active->partitionSize : 0; }
+    int getNumPartitions() const { return active != nullptr ? active->numPartitions : 0; }
 
     void reset()
     {
-        for (int ch = 0; ch < maxChannels; ++ch)
-        {
-            inputBuffer[ch].clear();
-            outputBuffer[ch].clear();
-            overlapBuffer[ch].clear();
-        }
-        inputWritePos = 0;
-        outputReadPos = 0;
-        samplesUntilNextFFT = hopSize;
+        for (auto& engine : engines)
+            if (engine != nullptr)
+                resetConvolution(*engine);
     }
 
     /**
-     * Aktualisiert die Ziel-Magnitude-Antwort aus dem EQProcessor.
-     * Sollte vom GUI/Timer-Thread aufgerufen werden — nicht im Audio-Thread.
+     * Berechnet Kernel und Partitions-Spektren der angefragten Latenz-Stufe aus
+     * dem EQProcessor neu, falls sich Band-Parameter, Output-Gain, Stufe oder
+     * Samplerate seit der letzten Berechnung geändert haben. Allokationsfrei.
+     *
+     * Aufruf vom LinearPhaseResponseWorker (Realtime) bzw. direkt im Audio-Thread
+     * beim Offline-Rendering (dort darf blockiert werden).
+     * @return true wenn ein neuer Kernel veröffentlicht wurde
      */
-    void updateMagnitudeResponse(const EQProcessor& eqProcessor)
+    bool updateMagnitudeResponseIfNeeded(const EQProcessor& eqProcessor)
     {
+        const juce::ScopedLock sl(producerLock);
+
+        auto* engine = engines[static_cast<size_t>(requestedMode.load())].get();
+        if (engine == nullptr)
+            return false;
+
+        // Konsistenter Snapshot aller Bänder (kein Lesen der Audio-Thread-Filter)
+        engine->responseEngine.update(eqProcessor);
+        const uint32_t version = engine->responseEngine.getSnapshotVersion();
+
+        if (engine->publishedValid && version == engine->publishedVersion
+            && engine->publishedSampleRate == currentSampleRate)
+            return false;
+
+        const int fftSize = engine->fftSize;
+        const int kernelSize = engine->kernelSize;
+
+        // 1. Magnitude-Kurve auf dem Design-Raster (Phase = 0).
+        //    Nur geänderte Bänder wurden neu ausgewertet (Cache im responseEngine)
         const int numBins = fftSize / 2 + 1;
-        
-        // Temporäres Array für die neue Magnitude-Antwort
-        std::vector<float> newResponse(numBins);
+        std::fill(engine->designBuffer.begin(), engine->designBuffer.end(), 0.0f);
+
+        const float* magnitudesDB = engine->responseEngine.getTotalResponse();
 
         for (int bin = 0; bin < numBins; ++bin)
         {
-            float freq = static_cast<float>(bin) * static_cast<float>(currentSampleRate) / static_cast<float>(fftSize);
-            if (freq < 1.0f) freq = 1.0f;
-            
-            // Magnitude in dB von allen EQ-Bändern + Output Gain
-            float magnitudeDB = eqProcessor.getTotalMagnitudeForFrequency(freq);
-            
-            // dB zu linearem Gain
-            newResponse[bin] = juce::Decibels::decibelsToGain(magnitudeDB);
+            // dB zu linearem Gain (Realteil, Imaginärteil bleibt 0)
+            engine->designBuffer[static_cast<size_t>(bin * 2)] = juce::Decibels::decibelsToGain(magnitudesDB[bin]);
         }
 
-        // Atomic-Swap in den Ziel-Buffer (lock-free für Audio-Thread)
-        juce::SpinLock::ScopedLockType lock(magnitudeLock);
-        targetMagnitudeResponse.swap(newResponse);
-        magnitudeResponseDirty.store(true);
+        // 2. IFFT → zirkuläre Zero-Phase-Impulsantwort (Peak bei Index 0)
+        engine->designFFT->performRealOnlyInverseTransform(engine->designBuffer.data());
+
+        // 3. Zentrieren + Fenstern → symmetrischer Kernel (Mitte = kernelSize / 2)
+        const int centre = kernelSize / 2;
+
+        for (int n = 0; n < kernelSize; ++n)
+        {
+            const int irIndex = ((n - centre) % fftSize + fftSize) % fftSize;
+            engine->kernel[static_cast<size_t>(n)] = engine->designBuffer[static_cast<size_t>(irIndex)]
+                                                   * engine->kernelWindow[static_cast<size_t>(n)];
+        }
+
+        // 4. Partitionen transformieren → privater Slot
+        writePartitionSpectra(*engine, engine->responseSlots[static_cast<size_t>(engine->writeSlot)]);
+
+        // Slot veröffentlichen: privaten gegen geteilten Slot tauschen
+        engine->writeSlot = engine->sharedSlot.exchange(engine->writeSlot | NEW_DATA_FLAG, std::memory_order_acq_rel)
+                          & SLOT_INDEX_MASK;
+
+        engine->publishedVersion = version;
+        engine->publishedSampleRate = currentSampleRate;
+        engine->publishedValid = true;
+        return true;
     }
 
     /**
-     * Verarbeitet einen Audio-Block mit linearer Phase.
-     * Overlap-Add-Verfahren mit 50% Overlap.
+     * Verarbeitet einen Audio-Block mit linearer Phase (in-place).
+     * Sammelt B Samples, faltet dann einmal pro Partition-Block.
      */
     void processBlock(juce::AudioBuffer<float>& buffer)
     {
-        // Lade neue Magnitude-Antwort (wenn verfügbar)
-        if (magnitudeResponseDirty.load())
+        // Angefragte Latenz-Stufe übernehmen (vorallokiert → nur Zeigerwechsel,
+        // die neue Engine startet mit leerem Faltungs-Zustand)
+        const auto mode = requestedMode.load();
+        if (mode != activeMode && engines[static_cast<size_t>(mode)] != nullptr)
         {
-            juce::SpinLock::ScopedLockType lock(magnitudeLock);
-            currentMagnitudeResponse = targetMagnitudeResponse;
-            magnitudeResponseDirty.store(false);
+            activeMode = mode;
+            active = engines[static_cast<size_t>(mode)].get();
+            resetConvolution(*active);
         }
 
+        // Robustheit: Prüfe ob die Faltungs-Engine initialisiert ist
+        if (active == nullptr || active->partitionFFT == nullptr || active->numPartitions == 0)
+            return;
+
+        auto& engine = *active;
+
+        // Neuen Kernel übernehmen (lock-free Slot-Tausch, keine Kopie)
+        if ((engine.sharedSlot.load(std::memory_order_acquire) & NEW_DATA_FLAG) != 0)
+            engine.readSlot = engine.sharedSlot.exchange(engine.readSlot, std::memory_order_acq_rel) & SLOT_INDEX_MASK;
+
         const int numSamples = buffer.getNumSamples();
         const int numCh = juce::jmin(buffer.getNumChannels(), maxChannels);
-        
-        // Robustheit: Prüfe ob FFT-Engine initialisiert ist
-        if (fft == nullptr || fftSize == 0)
-            return;
+        const int partitionSize = engine.partitionSize;
 
-        for (int i = 0; i < numSamples; ++i)
+        for (int pos = 0; pos < numSamples;)
         {
-            // Input-Samples in den Ring-Buffer schreiben
+            const int n = juce::jmin(numSamples - pos, partitionSize - engine.blockPos);
+
             for (int ch = 0; ch < numCh; ++ch)
             {
-                inputBuffer[ch].setSample(0, inputWritePos, buffer.getSample(ch, i));
-            }
-
-            inputWritePos = (inputWritePos + 1) % fftSize;
-            --samplesUntilNextFFT;
+                float* data = buffer.getWritePointer(ch, pos);
 
-            // Wenn genug Samples gesammelt: FFT-Block verarbeiten
-            if (samplesUntilNextFFT <= 0)
-            {
-                processFFTBlock(numCh);
-                samplesUntilNextFFT = hopSize;
+                // Neue Samples in die zweite Hälfte des Overlap-Save-Fensters,
+                // Output stammt aus dem vorherigen Partition-Block (Latenz = B)
+                juce::FloatVectorOperations::copy(engine.inputWindow[ch].data() + partitionSize + engine.blockPos, data, n);
+                juce::FloatVectorOperations::copy(data, engine.outputBlock[ch].data() + engine.blockPos, n);
             }
 
-            // Output aus dem Overlap-Add-Buffer lesen
-            for (int ch = 0; ch < numCh; ++ch)
+            engine.blockPos += n;
+            pos += n;
+
+            if (engine.blockPos == partitionSize)
             {
-                buffer.setSample(ch, i, outputBuffer[ch].getSample(0, outputReadPos));
-                outputBuffer[ch].setSample(0, outputReadPos, 0.0f); // Gelesen → Clear
+                processPartitionBlock(engine, numCh);
+                engine.blockPos = 0;
             }
-
-            outputReadPos = (outputReadPos + 1) % (fftSize * 2);
         }
     }
 
-    bool isEnabled() const { return enabled; }
-    void setEnabled(bool shouldBeEnabled) { enabled = shouldBeEnabled; }
+    bool isEnabled() const { return enabled.load(); }
+    void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled); }
 
 private:
-    void updateFFTSize()
+    // Partitions-Spektren eines Kernels (ein Triple-Buffer-Slot)
+    struct ResponseSlot
+    {
+        std::vector<float> spectra;  // numPartitions x spectrumSize, in allocateEngine() allokiert
+    };
+
+    static constexpr int SLOT_INDEX_MASK = 0x3;
+    static constexpr int NEW_DATA_FLAG = 0x4;
+
+    // Alles, was von der Latenz-Stufe abhängt (eine Instanz pro Stufe)
+    struct Engine
     {
-        switch (latencyMode)
+        // Geometrie
+        int fftSize = 4096;        // Design-Größe (Latenz = fftSize / 2)
+        int partitionSize = 512;   // B
+        int kernelSize = 0;        // fftSize − 2B
+        int numPartitions = 0;
+        int spectrumSize = 0;      // Floats pro Partitions-Spektrum
+
+        // FFT-Engines
+        std::unique_ptr<juce::dsp::FFT> designFFT;             // Producer
+        std::unique_ptr<juce::dsp::FFT> producerPartitionFFT;  // Producer
+        std::unique_ptr<juce::dsp::FFT> partitionFFT;          // Audio-Thread
+
+        // Faltungs-Zustand (pro Kanal, Audio-Thread)
+        std::vector<float> inputWindow[2];   // 2B: [vorheriger Block | aktueller Block]
+        std::vector<float> outputBlock[2];   // B
+        std::vector<float> delayLine[2];     // numPartitions x spectrumSize
+        std::vector<float> fftWorkBuffer;
+        std::vector<float> accumulator;
+        int blockPos = 0;
+        int delayLinePos = 0;
+
+        // FIR-Design (Producer, unter producerLock)
+        FrequencyResponseEngine responseEngine;
+        std::vector<float> designBuffer;
+        std::vector<float> kernel;
+        std::vector<float> kernelWindow;
+        std::vector<float> producerWorkBuffer;
+
+        // Partitions-Spektren — Triple-Buffer
+        std::array<ResponseSlot, 3> responseSlots;
+        std::atomic<int> sharedSlot { 1 };  // Index | NEW_DATA_FLAG
+        int writeSlot = 0;                  // nur Producer (unter producerLock)
+        int readSlot = 2;                   // nur Audio-Thread
+
+        uint32_t publishedVersion = 0;
+        double publishedSampleRate = 0.0;
+        bool publishedValid = false;
+    };
+
+    static int getFFTSizeForMode(LatencyMode mode)
+    {
+        switch (mode)
         {
-            case LatencyMode::Low:    fftSize = 2048; fftOrder = 11; break;
-            case LatencyMode::Medium: fftSize = 4096; fftOrder = 12; break;
-            case LatencyMode::High:   fftSize = 8192; fftOrder = 13; break;
+            case LatencyMode::UltraLow: return 512;
+            case LatencyMode::VeryLow:  return 1024;
+            case LatencyMode::Low:      return 2048;
+            case LatencyMode::Medium:   return 4096;
+            case LatencyMode::High:     return 8192;
         }
+        return 4096;
+    }
 
-        hopSize = fftSize / 2;
+    // Größte Zweierpotenz <= hostBlockSize, begrenzt auf [MIN, min(MAX, fftSize / 8)]
+    int choosePartitionSize(int fftSize) const
+    {
+        int size = MIN_PARTITION_SIZE;
+        while (size * 2 <= hostBlockSize)
+            size *= 2;
 
-        // FFT-Engine erstellen
-        fft = std::make_unique<juce::dsp::FFT>(fftOrder);
+        return juce::jlimit(MIN_PARTITION_SIZE, juce::jmin(MAX_PARTITION_SIZE, fftSize / 8), size);
+    }
 
-        // Hann-Fenster erstellen
-        window.resize(fftSize);
-        juce::dsp::WindowingFunction<float>::fillWindowingTables(
-            window.data(), fftSize,
-            juce::dsp::WindowingFunction<float>::hann, false);
+    static int log2OfPowerOfTwo(int value)
+    {
+        int order = 0;
+        while ((1 << order) < value)
+            ++order;
+        return order;
+    }
+
+    /** Alloziert alles für eine Stufe (unter producerLock, nicht im Audio-Thread). */
+    void allocateEngine(Engine& engine, int fftSize)
+    {
+        jassert(fftSize <= MAX_FFT_SIZE);
+
+        engine.fftSize = fftSize;
+        engine.partitionSize = choosePartitionSize(fftSize);
+
+        const int partitionSize = engine.partitionSize;
 
-        // Buffers allokieren
+        // Kernel-Mitte liegt B vor der Latenz → Gesamtlatenz bleibt fftSize / 2
+        engine.kernelSize = fftSize - 2 * partitionSize;
+        engine.numPartitions = (engine.kernelSize + partitionSize - 1) / partitionSize;
+        engine.spectrumSize = (partitionSize + 1) * 2;   // Interleaved Re/Im, Bins 0..B
+
+        const int kernelSize = engine.kernelSize;
+        const int numPartitions = engine.numPartitions;
+        const int spectrumSize = engine.spectrumSize;
+
+        // FFT-Engines: Design und Partitionen (Producer und Audio-Thread getrennt)
+        engine.designFFT = std::make_unique<juce::dsp::FFT>(log2OfPowerOfTwo(fftSize));
+        engine.producerPartitionFFT = std::make_unique<juce::dsp::FFT>(log2OfPowerOfTwo(partitionSize * 2));
+        engine.partitionFFT = std::make_unique<juce::dsp::FFT>(log2OfPowerOfTwo(partitionSize * 2));
+
+        engine.designBuffer.assign(static_cast<size_t>(fftSize * 2), 0.0f);
+
+        // Frequenzraster der Design-Bins (Bin 0 → 1 Hz) für den Frequenzgang
+        const int numBins = fftSize / 2 + 1;
+        std::vector<float> binFrequencies(static_cast<size_t>(numBins));
+        for (int bin = 0; bin < numBins; ++bin)
+            binFrequencies[static_cast<size_t>(bin)] = juce::jmax(1.0f, static_cast<float>(bin) * static_cast<float>(currentSampleRate)
+                                                                            / static_cast<float>(fftSize));
+        engine.responseEngine.setFrequencies(binFrequencies.data(), numBins);
+        engine.kernel.assign(static_cast<size_t>(kernelSize), 0.0f);
+        engine.producerWorkBuffer.assign(static_cast<size_t>(partitionSize * 4), 0.0f);
+
+        // Symmetrisches Hann-Fenster über [0, kernelSize], Maximum bei kernelSize / 2
+        engine.kernelWindow.resize(static_cast<size_t>(kernelSize));
+        for (int n = 0; n < kernelSize; ++n)
+            engine.kernelWindow[static_cast<size_t>(n)] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi
+                                                                                  * static_cast<float>(n) / static_cast<float>(kernelSize));
+
+        // Faltungs-Buffers (pro Kanal)
         for (int ch = 0; ch < 2; ++ch)
         {
-            inputBuffer[ch].setSize(1, fftSize);
-            inputBuffer[ch].clear();
-            outputBuffer[ch].setSize(1, fftSize * 2);
-            outputBuffer[ch].clear();
-            overlapBuffer[ch].setSize(1, fftSize);
-            overlapBuffer[ch].clear();
+            engine.inputWindow[ch].assign(static_cast<size_t>(partitionSize * 2), 0.0f);
+            engine.outputBlock[ch].assign(static_cast<size_t>(partitionSize), 0.0f);
+            engine.delayLine[ch].assign(static_cast<size_t>(numPartitions * spectrumSize), 0.0f);
         }
 
-        // FFT-Arbeitsbuffer (Real + Imaginary interleaved, doppelte Größe)
-        fftWorkBuffer.resize(fftSize * 2, 0.0f);
+        // FFT-Arbeitsbuffer (JUCE Real-FFT braucht 2 x FFT-Größe)
+        engine.fftWorkBuffer.assign(static_cast<size_t>(partitionSize * 4), 0.0f);
+        engine.accumulator.assign(static_cast<size_t>(partitionSize * 4), 0.0f);
+
+        // Alle Slots mit einem Einheits-Kernel (Delta in der Kernel-Mitte)
+        // initialisieren → bis zur ersten Berechnung verzögerter Bypass
+        engine.kernel[static_cast<size_t>(kernelSize / 2)] = 1.0f;
 
-        // Magnitude-Response mit Unity initialisieren
-        int numBins = fftSize / 2 + 1;
-        currentMagnitudeResponse.resize(numBins, 1.0f);
-        targetMagnitudeResponse.resize(numBins, 1.0f);
+        for (auto& slot : engine.responseSlots)
+        {
+            slot.spectra.assign(static_cast<size_t>(numPartitions * spectrumSize), 0.0f);
+            writePartitionSpectra(engine, slot);
+        }
 
-        // Reset Positionen
-        inputWritePos = 0;
-        outputReadPos = fftSize - hopSize; // Latenz-Kompensation: Start bei -hopSize
-        samplesUntilNextFFT = hopSize;
+        engine.publishedValid = false;
+        engine.blockPos = 0;
+        engine.delayLinePos = 0;
     }
 
-    void processFFTBlock(int numChannels)
+    /** Faltungs-Zustand leeren (allokationsfrei, Audio-Thread beim Stufenwechsel). */
+    static void resetConvolution(Engine& engine)
     {
-        for (int ch = 0; ch < numChannels; ++ch)
+        for (int ch = 0; ch < 2; ++ch)
         {
-            // 1. Input-Block aus dem Ring-Buffer extrahieren (ab aktuellem Schreibpunkt - fftSize)
-            const int startPos = (inputWritePos + fftSize) % fftSize; // = inputWritePos (nach Modulo)
-            
-            // Kopiere fftSize Samples in den Arbeitsbuffer
-            for (int i = 0; i < fftSize; ++i)
-            {
-                int readIdx = (startPos + i) % fftSize;
-                fftWorkBuffer[i] = inputBuffer[ch].getSample(0, readIdx);
-            }
+            std::fill(engine.inputWindow[ch].begin(), engine.inputWindow[ch].end(), 0.0f);
+            std::fill(engine.outputBlock[ch].begin(), engine.outputBlock[ch].end(), 0.0f);
+            std::fill(engine.delayLine[ch].begin(), engine.delayLine[ch].end(), 0.0f);
+        }
+        engine.blockPos = 0;
+        engine.delayLinePos = 0;
+    }
+
+    /** Kernel → Partitions-Spektren (Producer-Seite). */
+    static void writePartitionSpectra(Engine& engine, ResponseSlot& slot)
+    {
+        const int partitionSize = engine.partitionSize;
+        const int spectrumSize = engine.spectrumSize;
 
-            // 2. Hann-Fenster anwenden
-            juce::FloatVectorOperations::multiply(fftWorkBuffer.data(), window.data(), fftSize);
+        for (int p = 0; p < engine.numPartitions; ++p)
+        {
+            const int start = p * partitionSize;
+            const int count = juce::jmin(partitionSize, engine.kernelSize - start);
 
-            // 3. Zero-pad den Imaginary-Teil
-            for (int i = fftSize; i < fftSize * 2; ++i)
-                fftWorkBuffer[i] = 0.0f;
+            std::fill(engine.producerWorkBuffer.begin(), engine.producerWorkBuffer.end(), 0.0f);
+            std::copy(engine.kernel.begin() + start, engine.kernel.begin() + start + count, engine.producerWorkBuffer.begin());
 
-            // 4. FFT vorwärts
-            fft->performRealOnlyForwardTransform(fftWorkBuffer.data(), true);
+            engine.producerPartitionFFT->performRealOnlyForwardTransform(engine.producerWorkBuffer.data(), true);
 
-            // 5. Magnitude-Response im Frequenzbereich anwenden (Linear Phase EQ)
-            //    Skalierung von Real- und Imaginärteil mit demselben Gain-Faktor
-            //    modifiziert nur die Magnitude, nicht die Phase. Die lineare Phase
-            //    (= konstante Gruppenlaufzeit von FFT_SIZE/2 Samples) ergibt sich
-            //    aus dem symmetrischen Overlap-Add-Verfahren mit Hann-Fensterung.
-            const int numBins = fftSize / 2 + 1;
-            const int magResponseSize = static_cast<int>(currentMagnitudeResponse.size());
+            std::copy(engine.producerWorkBuffer.begin(), engine.producerWorkBuffer.begin() + spectrumSize,
+                      slot.spectra.begin() + p * spectrumSize);
+        }
+    }
 
-            for (int bin = 0; bin < numBins; ++bin)
-            {
-                float gain = (bin < magResponseSize) ? currentMagnitudeResponse[bin] : 1.0f;
-                
-                // Magnitude modifizieren, Original-Signal-Phase beibehalten
-                fftWorkBuffer[bin * 2]     *= gain;  // Real
-                fftWorkBuffer[bin * 2 + 1] *= gain;  // Imaginary
-            }
+    /** Ein Overlap-Save-Schritt für alle Kanäle (Audio-Thread). */
+    static void processPartitionBlock(Engine& engine, int numChannels)
+    {
+        const float* kernelSpectra = engine.responseSlots[static_cast<size_t>(engine.readSlot)].spectra.data();
+        const int partitionSize = engine.partitionSize;
+        const int spectrumSize = engine.spectrumSize;
+        const int numPartitions = engine.numPartitions;
+        const int fftLength = partitionSize * 2;
+        float* fftWorkBuffer = engine.fftWorkBuffer.data();
+        float* accumulator = engine.accumulator.data();
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            // 1. Fenster [alter Block | neuer Block] transformieren
+            juce::FloatVectorOperations::copy(fftWorkBuffer, engine.inputWindow[ch].data(), fftLength);
+            juce::FloatVectorOperations::clear(fftWorkBuffer + fftLength, fftLength);
+            engine.partitionFFT->performRealOnlyForwardTransform(fftWorkBuffer, true);
+
+            // 2. Spektrum in die Frequency-Domain-Delay-Line
+            float* fdl = engine.delayLine[ch].data();
+            juce::FloatVectorOperations::copy(fdl + engine.delayLinePos * spectrumSize, fftWorkBuffer, spectrumSize);
 
-            // 6. IFFT rückwärts
-            fft->performRealOnlyInverseTransform(fftWorkBuffer.data());
-
-            // 7. Overlap-Add in den Output-Buffer
-            // KEIN zweites Hann-Fenster: Bei 50% Overlap erfüllt ein einzelnes Hann-Fenster
-            // die COLA-Bedingung (Constant Overlap-Add): Hann(n) + Hann(n-N/2) = 1.0.
-            // Doppeltes Hann-Fenster mit 50% Overlap wäre NICHT COLA:
-            // Hann²(n) + Hann²(n-N/2) = 0.75 + 0.25·cos(4πn/N) ≠ const → Amplitudenmodulation!
-            // Die Position im Output-Buffer ist relativ zum aktuellen outputReadPos
-            int outputWriteStart = (outputReadPos + hopSize) % (fftSize * 2);
-            
-            for (int i = 0; i < fftSize; ++i)
+            // 3. Y = Σ X[k − p] · H[p]
+            juce::FloatVectorOperations::clear(accumulator, fftLength * 2);
+
+            for (int p = 0; p < numPartitions; ++p)
             {
-                int outIdx = (outputWriteStart + i) % (fftSize * 2);
-                float current = outputBuffer[ch].getSample(0, outIdx);
-                outputBuffer[ch].setSample(0, outIdx, current + fftWorkBuffer[i]);
+                int slotIndex = engine.delayLinePos - p;
+                if (slotIndex < 0) slotIndex += numPartitions;
+
+                complexMultiplyAccumulate(accumulator,
+                                          fdl + slotIndex * spectrumSize,
+                                          kernelSpectra + p * spectrumSize,
+                                          partitionSize + 1);
             }
+
+            // 4. IFFT → die hintere Hälfte ist das gültige (nicht-zirkuläre) Ergebnis
+            engine.partitionFFT->performRealOnlyInverseTransform(accumulator);
+            juce::FloatVectorOperations::copy(engine.outputBlock[ch].data(), accumulator + partitionSize, partitionSize);
+
+            // 5. Neuer Block wird zum alten Block
+            juce::FloatVectorOperations::copy(engine.inputWindow[ch].data(), engine.inputWindow[ch].data() + partitionSize, partitionSize);
+        }
+
+        if (++engine.delayLinePos >= numPartitions)
+            engine.delayLinePos = 0;
+    }
+
+    // Interleaved Re/Im (Format von performRealOnlyForwardTransform)
+    static void complexMultiplyAccumulate(float* acc, const float* a, const float* b, int numBins) noexcept
+    {
+        for (int k = 0; k < numBins; ++k)
+        {
+            const float ar = a[2 * k], ai = a[2 * k + 1];
+            const float br = b[2 * k], bi = b[2 * k + 1];
+            acc[2 * k]     += ar * br - ai * bi;
+            acc[2 * k + 1] += ar * bi + ai * br;
         }
     }
 
     // Parameter
-    LatencyMode latencyMode = LatencyMode::Medium;
-    bool enabled = false;
+    std::atomic<LatencyMode> requestedMode { LatencyMode::Medium };
+    std::atomic<bool> enabled { false };
     double currentSampleRate = 44100.0;
+    int hostBlockSize = 512;
     int maxChannels = 2;
 
-    // FFT
-    std::unique_ptr<juce::dsp::FFT> fft;
-    int fftSize = 4096;
-    int fftOrder = 12;
-    int hopSize = 2048;
-
-    // Buffers (pro Kanal)
-    juce::AudioBuffer<float> inputBuffer[2];
-    juce::AudioBuffer<float> outputBuffer[2];
-    juce::AudioBuffer<float> overlapBuffer[2];
-
-    // Fenster
-    std::vector<float> window;
-
-    // FFT-Arbeitsbuffer
-    std::vector<float> fftWorkBuffer;
-
-    // Magnitude-Response (linear, pro Bin)
-    std::vector<float> currentMagnitudeResponse;   // Audio-Thread Kopie
-    std::vector<float> targetMagnitudeResponse;     // GUI-Thread schreibt hier
-    juce::SpinLock magnitudeLock;
-    std::atomic<bool> magnitudeResponseDirty { false };
-
-    // Ring-Buffer Positionen
-    int inputWritePos = 0;
-    int outputReadPos = 0;
-    int samplesUntilNextFFT = 0;
+    // Eine Engine pro Latenz-Stufe (Index = LatencyMode), alle in prepare() alloziert
+    std::array<std::unique_ptr<Engine>, NUM_LATENCY_MODES> engines;
+    LatencyMode activeMode = LatencyMode::Medium;   // nur Audio-Thread (bzw. prepare)
+    Engine* active = nullptr;
+
+    // Producer-Seite: serialisiert Worker, Offline-Render und prepare()
+    juce::CriticalSection producerLock;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LinearPhaseEQ)
 };
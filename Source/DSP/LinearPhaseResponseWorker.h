@@ -0,0 +1,70 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "EQProcessor.h"
+#include "LinearPhaseEQ.h"
+
+/**
+ * LinearPhaseResponseWorker: Hält die Magnitude-Antwort des LinearPhaseEQ
+ * unabhängig vom Editor aktuell (Headless, Automation, Offline-Bounce).
+ *
+ * - Gehört dem AuraAudioProcessor, läuft auf einem Low-Priority-Thread
+ * - Pollt die Response-Version des EQProcessor und rechnet nur bei Änderungen neu
+ * - Der Audio-Thread wird nie benachrichtigt oder blockiert: die Übergabe läuft
+ *   über den Triple-Buffer im LinearPhaseEQ
+ * - Beim Offline-Rendering ruft der Processor updateMagnitudeResponseIfNeeded()
+ *   zusätzlich synchron auf, damit kein Block mit veralteter Kurve gerendert wird
+ */
+class LinearPhaseResponseWorker : private juce::Thread
+{
+public:
+    LinearPhaseResponseWorker(LinearPhaseEQ& lp, const EQProcessor& eq)
+        : juce::Thread("Aura LinearPhase Response"),
+          linearPhaseEQ(lp),
+          eqProcessor(eq)
+    {
+    }
+
+    ~LinearPhaseResponseWorker() override
+    {
+        stop();
+    }
+
+    /** Raw-Parameter LINEAR_PHASE_MODE — ohne ihn rechnet der Worker immer. */
+    void setModeParameter(std::atomic<float>* linearPhaseModeParam)
+    {
+        modeParam = linearPhaseModeParam;
+    }
+
+    void start()
+    {
+        if (!isThreadRunning())
+            startThread(juce::Thread::Priority::low);
+    }
+
+    void stop()
+    {
+        stopThread(2000);
+    }
+
+private:
+    static constexpr int POLL_INTERVAL_MS = 15;
+
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            // Nur rechnen, wenn Linear Phase aktiv ist (spart CPU beim Kurven-Ziehen)
+            if (modeParam == nullptr || modeParam->load() > 0.5f)
+                linearPhaseEQ.updateMagnitudeResponseIfNeeded(eqProcessor);
+
+            wait(POLL_INTERVAL_MS);
+        }
+    }
+
+    LinearPhaseEQ& linearPhaseEQ;
+    const EQProcessor& eqProcessor;
+    std::atomic<float>* modeParam = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LinearPhaseResponseWorker)
+};
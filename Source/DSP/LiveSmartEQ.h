@@ -4,6 +4,7 @@
 #include "SmartAnalyzer.h"
 #include "EQProcessor.h"
 #include "SpectralMatcher.h"
+#include "BandModulation.h"
 #include "../Parameters/ParameterIDs.h"
 #include <array>
 #include <atomic>
@@ -19,14 +20,17 @@
  * - Tiefe-Kontrolle (wie stark eingegriffen wird)
  * - Transient-Protection zum Schutz von Attacks
  * - Pro-Band Gain-Reduction Metering für Visualisierung
- * - RT-Safe: Parameter-Änderungen werden über AsyncUpdater an den Message-Thread delegiert
+ * - Band-Gain/Frequenz/Q gehen direkt über BandModulation in den Audio-Pfad
+ *   (auch ohne offenen Editor); der APVTS wird nur verzögert für Anzeige und
+ *   Automation über die Pending-Queue nachgezogen
  * 
  * Inspiriert von: iZotope Neutron, Sonible smart:EQ, Oeksound Soothe2
  */
 
 /**
- * PendingParamChange: Lock-free Queue-Eintrag für Audio→Message-Thread Parameter-Delegation.
- * Wird vom Audio-Thread in einen Ring-Buffer geschrieben und vom Message-Thread gelesen/angewendet.
+ * PendingParamChange: Lock-free Queue-Eintrag für Worker→Message-Thread APVTS-Sync.
+ * Wird vom Worker in einen Ring-Buffer geschrieben und vom Message-Thread gelesen/angewendet.
+ * Hörbar ist die Änderung bereits vorher über BandModulation.
  */
 struct PendingParamChange
 {
@@ -41,6 +45,7 @@ struct PendingParamChange
     bool updateFreqAndQ = false;  // Frequenz/Q updaten (kontinuierlich)?
     bool setChannelMode = false;  // Channel-Mode setzen?
     bool valid = false;           // Gültiger Eintrag?
+    uint32_t modulationGeneration = 0;  // BandModulation-Generation beim Deaktivieren
 };
 
 class LiveSmartEQ
@@ -148,29 +153,40 @@ public:
             lastAppliedGains[i] = 0.0f;
             lastBandActive[i] = false;
         }
+        appliedLiveBands.store(0);
+        stateResetPending.store(false);
         transientEnvelope = 0.0f;
         samplesSinceLastUpdate = 0;
+        
+        // Übernommene Bänder transparent machen — der Band-Status ist jetzt vergessen
+        bandModulation.neutraliseAll();
     }
     
     // EQ-Bänder zurücksetzen (für Smart Mode Deaktivierung)
     // WICHTIG: Diese Funktion sollte NICHT im Audio-Thread aufgerufen werden!
-    // Stattdessen wird sie jetzt über einen Flag gesteuert und im Message-Thread ausgeführt
-    void resetEQBands(juce::AudioProcessorValueTreeState& apvts)
+    // Läuft im Message-Thread (Timer des Processors) und setzt nur den APVTS zurück.
+    // Den Band-Zustand des Workers (lastAppliedGains, lastBandActive, bandStates)
+    // leert der Worker selbst (applyPendingStateReset), hier wird nur die von ihm
+    // veröffentlichte Maske der benutzten Bänder gelesen.
+    // Gibt false zurück, wenn das Reset wegen Rate-Limiting verschoben wurde
+    bool resetEQBands(juce::AudioProcessorValueTreeState& apvts)
     {
         // Rate-Limiting: Nur einmal pro 100ms
         juce::int64 now = juce::Time::currentTimeMillis();
         if (now - lastResetTime < 100)
-            return;
+            return false;
         lastResetTime = now;
         
+        const uint32_t usedBands = appliedLiveBands.load();
+        
         // Bänder 5-12 (Index 4-11) zurücksetzen
         for (int i = 0; i < maxLiveBands; ++i)
         {
             int eqBandIndex = 4 + i;  // Bänder 5-12
             if (eqBandIndex >= ParameterIDs::MAX_BANDS) continue;
             
-            // Nur ändern wenn nötig
-            if (lastBandActive[i] || std::abs(lastAppliedGains[i]) > 0.1f)
+            // Nur ändern wenn nötig (Band war aktiv oder hatte Gain)
+            if ((usedBands & (1u << i)) != 0)
             {
                 // Gain auf 0 - sanft über Parameter
                 if (auto* param = apvts.getParameter(ParameterIDs::getBandGainID(eqBandIndex)))
@@ -195,18 +211,58 @@ public:
                     }
                 }
             }
-            
+        }
+        
+        // Worker-Zustand mit dem nächsten Durchlauf des Workers leeren
+        stateResetPending.store(true);
+        
+        // APVTS ist jetzt auf dem Reset-Stand → Bänder wieder dem APVTS überlassen
+        // (außer denen, die der Worker seit der Anfrage neu übernommen hat)
+        BandModulation::Generations generations {};
+        for (size_t i = 0; i < generations.size(); ++i)
+            generations[i] = resetGenerations[i].load();
+        
+        bandModulation.releaseAll(generations);
+        return true;
+    }
+    
+    /**
+     * Worker-Thread (SmartAnalysisWorker, vor jedem Frame): leert den Band-Zustand
+     * nach einem Reset im Message-Thread. Nur hier, damit processFrame() die Arrays
+     * nie gleichzeitig mit dem Message-Thread sieht.
+     */
+    void applyPendingStateReset()
+    {
+        if (!stateResetPending.exchange(false))
+            return;
+        
+        for (int i = 0; i < maxLiveBands; ++i)
+        {
             lastAppliedGains[i] = 0.0f;
             lastBandActive[i] = false;
             bandStates[i].active = false;
             bandStates[i].gainReduction = 0.0f;
         }
+        
+        appliedLiveBands.store(0);
     }
     
     // Flag für asynchrones Zurücksetzen (atomic für Thread-Safety Audio↔Message)
     std::atomic<bool> needsReset { false };
     
-    void requestReset() { needsReset.store(true); }
+    void requestReset()
+    {
+        // Hörbar sofort (auch ohne Editor), APVTS-Reset folgt im Message-Thread.
+        // Generationen merken: freigegeben werden nur Bänder, die bis dahin nicht
+        // neu übernommen wurden
+        bandModulation.neutraliseAll();
+        
+        const auto generations = bandModulation.getGenerations();
+        for (size_t i = 0; i < generations.size(); ++i)
+            resetGenerations[i].store(generations[i]);
+        
+        needsReset.store(true);
+    }
     bool shouldReset() const { return needsReset.load(); }
     void clearResetFlag() { needsReset.store(false); }
     
@@ -217,6 +273,7 @@ public:
     {
         const juce::SpinLock::ScopedLockType lock(settingsLock);
         settings = newSettings;
+        transientProtectionEnabled.store(newSettings.transientProtection, std::memory_order_relaxed);
         updateEnvelopeCoefficients();
     }
     
@@ -304,10 +361,45 @@ public:
                  const juce::AudioBuffer<float>& buffer,
                  const FFTAnalyzer* fftAnalyzer = nullptr)
     {
+        const bool isTransient = updateTransientDetection(buffer);
+        processFrame(analyzer, apvts, isTransient,
+                     fftAnalyzer != nullptr ? &fftAnalyzer->getMagnitudes() : nullptr, 1);
+    }
+    
+    //==========================================================================
+    // Transient-Erkennung pro Audio-Block (bleibt im Audio-Thread, da sie den
+    // Buffer braucht). Das Ergebnis wird mit dem nächsten Spektrum-Frame übergeben.
+    //==========================================================================
+    // Liest nur die atomare Kopie des Flags (Settings werden im Worker gesetzt)
+    bool updateTransientDetection(const juce::AudioBuffer<float>& buffer)
+    {
+        return transientProtectionEnabled.load(std::memory_order_relaxed) && detectTransient(buffer);
+    }
+    
+    // Bei Stille liefert die Erkennung nichts mehr: Envelope am Floor (-100 dB)
+    // bzw. Transient-Schutz aus → der Aufruf darf entfallen
+    bool isTransientDetectionIdle() const
+    {
+        return !transientProtectionEnabled.load(std::memory_order_relaxed) || transientEnvelope <= -100.0f + 0.01f;
+    }
+    
+    //==========================================================================
+    // Entscheidungslogik pro Spektrum-Frame (läuft im SmartAnalysisWorker).
+    // numBlocks = Audio-Blöcke seit dem letzten Frame → Envelopes und Rate-Limit
+    // laufen in Block-Schritten weiter, als wäre process() pro Block aufgerufen worden.
+    //==========================================================================
+    void processFrame(SmartAnalyzer& analyzer,
+                      juce::AudioProcessorValueTreeState& apvts,
+                      bool isTransient,
+                      const std::vector<float>* inputMagnitudes,
+                      int numBlocks)
+    {
+        numBlocks = juce::jmax(1, numBlocks);
+        
         if (!settings.enabled)
         {
             // Sanftes Ausblenden und EQ-Bänder zurücksetzen (rate-limited)
-            if (shouldUpdateParameters())
+            if (shouldUpdateParameters(numBlocks))
             {
                 fadeOutAndResetEQ(apvts);
             }
@@ -321,20 +413,13 @@ public:
             analyzer.setInstrumentProfile(settings.profileName);
         }
         
-        // Transient Detection
-        bool isTransient = false;
-        if (settings.transientProtection)
-        {
-            isTransient = detectTransient(buffer);
-        }
-        
         // NEU: Wenn Reference-Matching aktiv ist, Match-Punkte vom SpectralMatcher verwenden
         if (hasReferenceSpectrum && settings.useReferenceAsTarget)
         {
             // NEU: Input-Spektrum an SpectralMatcher übergeben (wichtig!)
-            if (fftAnalyzer != nullptr)
+            if (inputMagnitudes != nullptr)
             {
-                spectralMatcher.updateInputSpectrum(fftAnalyzer->getMagnitudes());
+                spectralMatcher.updateInputSpectrum(*inputMagnitudes);
             }
             
             // Match-Punkte vom SpectralMatcher holen und auf EQ-Bänder anwenden
@@ -356,84 +441,90 @@ public:
             }
         }
         
-        // Envelope Following und Smoothing
-        for (int i = 0; i < maxBands; ++i)
+        // Envelope Following und Smoothing (ein Schritt pro vergangenem Audio-Block)
+        for (int block = 0; block < numBlocks; ++block)
         {
-            auto& state = bandStates[i];
-            
-            if (state.active)
+            for (int i = 0; i < maxBands; ++i)
             {
-                // Ziel-Gain berechnen (mit Depth-Skalierung)
-                float targetGain = state.targetGain * settings.depth;
+                auto& state = bandStates[i];
                 
-                // Prüfe ob es ein Boost oder Cut ist
-                state.isBoost = targetGain > 0.0f;
-                
-                // Gain-Limits anwenden (unterschiedlich für Boost und Cut)
-                if (state.isBoost)
+                if (state.active)
                 {
-                    targetGain = std::min(targetGain, settings.maxGainBoost);
-                }
-                else
-                {
-                    targetGain = std::max(targetGain, settings.maxGainReduction);
-                }
-                
-                // Transient Protection: Weniger Eingriff bei Transienten (nur für Cuts)
-                if (isTransient && settings.transientProtection && !state.isBoost)
-                {
-                    targetGain *= (1.0f - settings.transientSensitivity * 0.7f);
-                }
-                
-                // Envelope Following mit frequenzabhängigem Attack/Release
-                float& envelope = envelopeStates[i];
-                float bandAttack = perBandAttackCoeff[i];
-                float bandRelease = perBandReleaseCoeff[i];
-                
-                if (state.isBoost)
-                {
-                    // Für Boosts: Attack wenn Gain steigt, Release wenn er fällt
-                    if (targetGain > envelope)
+                    // Ziel-Gain berechnen (mit Depth-Skalierung)
+                    float targetGain = state.targetGain * settings.depth;
+                    
+                    // Prüfe ob es ein Boost oder Cut ist
+                    state.isBoost = targetGain > 0.0f;
+                    
+                    // Gain-Limits anwenden (unterschiedlich für Boost und Cut)
+                    if (state.isBoost)
                     {
-                        envelope = bandAttack * envelope + (1.0f - bandAttack) * targetGain;
+                        targetGain = std::min(targetGain, settings.maxGainBoost);
                     }
                     else
                     {
-                        envelope = bandRelease * envelope + (1.0f - bandRelease) * targetGain;
+                        targetGain = std::max(targetGain, settings.maxGainReduction);
                     }
-                }
-                else
-                {
-                    // Für Cuts: Attack wenn Gain fällt (tiefer), Release wenn er steigt (zurück zu 0)
-                    if (targetGain < envelope)
+                    
+                    // Transient Protection: Weniger Eingriff bei Transienten (nur für Cuts)
+                    if (isTransient && settings.transientProtection && !state.isBoost)
+                    {
+                        targetGain *= (1.0f - settings.transientSensitivity * 0.7f);
+                    }
+                    
+                    // Envelope Following mit frequenzabhängigem Attack/Release
+                    float& envelope = envelopeStates[i];
+                    float bandAttack = perBandAttackCoeff[i];
+                    float bandRelease = perBandReleaseCoeff[i];
+                    
+                    if (state.isBoost)
                     {
-                        envelope = bandAttack * envelope + (1.0f - bandAttack) * targetGain;
+                        // Für Boosts: Attack wenn Gain steigt, Release wenn er fällt
+                        if (targetGain > envelope)
+                        {
+                            envelope = bandAttack * envelope + (1.0f - bandAttack) * targetGain;
+                        }
+                        else
+                        {
+                            envelope = bandRelease * envelope + (1.0f - bandRelease) * targetGain;
+                        }
                     }
                     else
                     {
-                        envelope = bandRelease * envelope + (1.0f - bandRelease) * targetGain;
+                        // Für Cuts: Attack wenn Gain fällt (tiefer), Release wenn er steigt (zurück zu 0)
+                        if (targetGain < envelope)
+                        {
+                            envelope = bandAttack * envelope + (1.0f - bandAttack) * targetGain;
+                        }
+                        else
+                        {
+                            envelope = bandRelease * envelope + (1.0f - bandRelease) * targetGain;
+                        }
                     }
+                    
+                    // SmoothedValue updaten
+                    gainSmoothed[i].setTargetValue(envelope);
+                    
+                    // Aktuelle Werte für Anzeige
+                    state.currentGain = gainSmoothed[i].getNextValue();
+                    state.gainReduction = state.currentGain;
+                }
+                else
+                {
+                    // Inaktive Bänder sanft auf 0 bringen
+                    envelopeStates[i] = releaseCoeff * envelopeStates[i];
+                    gainSmoothed[i].setTargetValue(0.0f);
+                    state.currentGain = gainSmoothed[i].getNextValue();
+                    state.gainReduction = state.currentGain;
                 }
-                
-                // SmoothedValue updaten
-                gainSmoothed[i].setTargetValue(envelope);
-                
-                // Aktuelle Werte für Anzeige
-                state.currentGain = gainSmoothed[i].getNextValue();
-                state.gainReduction = state.currentGain;
-            }
-            else
-            {
-                // Inaktive Bänder sanft auf 0 bringen
-                envelopeStates[i] = releaseCoeff * envelopeStates[i];
-                gainSmoothed[i].setTargetValue(0.0f);
-                state.currentGain = gainSmoothed[i].getNextValue();
-                state.gainReduction = state.currentGain;
             }
         }
         
-        // EQ-Parameter nur rate-limited aktualisieren (alle ~50ms)
-        if (shouldUpdateParameters())
+        // Audio-Pfad pro Frame nachführen (Interpolation übernimmt das Koeffizienten-Smoothing)
+        publishModulation();
+        
+        // APVTS-Sync nur rate-limited (alle ~50ms)
+        if (shouldUpdateParameters(numBlocks))
         {
             // Auto-Gain Compensation: Kurven-basiert berechnen
             updateAutoGainCompensation();
@@ -452,6 +543,9 @@ public:
     
     int getMaxBands() const { return maxBands; }
     
+    // Direkte Band-Modulation (Audio-Thread liest sie am Blockanfang)
+    BandModulation& getBandModulation() { return bandModulation; }
+    
     // Auto-Gain Compensation Wert für UI-Anzeige
     float getAutoGainCompensationDb() const { return autoGainCompensationDb; }
     
@@ -529,9 +623,9 @@ private:
     
     // Rate-Limiting für Parameter-Updates (verhindert Knackser)
     // OPTIMIERUNG: Sample-Counter statt std::chrono für Realtime-Safety
-    bool shouldUpdateParameters()
+    bool shouldUpdateParameters(int numBlocks = 1)
     {
-        samplesSinceLastUpdate += blockSize;
+        samplesSinceLastUpdate += blockSize * numBlocks;
         
         // Berechne benötigte Samples für das eingestellte Intervall
         int samplesNeeded = static_cast<int>((settings.updateIntervalMs / 1000.0f) * sampleRate);
@@ -544,7 +638,7 @@ private:
         return false;
     }
     
-    // EQ-Parameter RT-safe in Queue schreiben (Audio-Thread → Message-Thread)
+    // Band-Übernahme im Audio-Pfad + APVTS-Sync RT-safe in Queue schreiben (Worker → Message-Thread)
     void updateEQParameters(juce::AudioProcessorValueTreeState& /*apvts*/)
     {
         for (int i = 0; i < maxLiveBands; ++i)
@@ -591,6 +685,14 @@ private:
                 {
                     change.setChannelMode = true;
                     change.channelMode = computeChannelModeForBand(state.frequency);
+                    
+                    // Band im Audio-Pfad übernehmen (Bell, Dynamic EQ aus)
+                    BandModulation::Values values;
+                    values.frequency = state.frequency;
+                    values.gainDb = currentGain;
+                    values.q = state.q;
+                    values.channelMode = change.channelMode;
+                    bandModulation.engage(eqBandIndex, values);
                 }
                 
                 pushPendingChange(change);
@@ -613,6 +715,10 @@ private:
                 {
                     change.setChannelMode = true;
                     change.channelMode = static_cast<int>(ParameterIDs::ChannelMode::Stereo);
+                    
+                    // Im Audio-Pfad sofort aus; freigegeben wird nach dem APVTS-Sync
+                    bandModulation.disengage(eqBandIndex);
+                    change.modulationGeneration = bandModulation.getGeneration(eqBandIndex);
                 }
                 
                 pushPendingChange(change);
@@ -623,6 +729,15 @@ private:
                     lastBandActive[i] = false;
             }
         }
+        
+        // Benutzte Bänder für resetEQBands() im Message-Thread veröffentlichen
+        uint32_t usedBands = 0;
+        for (int i = 0; i < maxLiveBands; ++i)
+        {
+            if (lastBandActive[i] || std::abs(lastAppliedGains[i]) > 0.1f)
+                usedBands |= (1u << i);
+        }
+        appliedLiveBands.store(usedBands);
     }
     
     /**
@@ -732,7 +847,8 @@ private:
 public:
     /**
      * Muss vom Message-Thread aufgerufen werden (z.B. via Timer oder AsyncUpdater).
-     * Wendet gepufferte Parameter-Änderungen sicher auf APVTS an.
+     * Zieht den APVTS für Anzeige und Automation nach; hörbar sind die Änderungen
+     * bereits über BandModulation.
      */
     void applyPendingParameterChanges(juce::AudioProcessorValueTreeState& apvts)
     {
@@ -792,6 +908,9 @@ public:
                 {
                     if (auto* param = apvts.getParameter(ParameterIDs::getBandActiveID(change.bandIndex)))
                         param->setValueNotifyingHost(0.0f);
+                    
+                    // APVTS entspricht jetzt dem Audio-Pfad → Band wieder freigeben
+                    bandModulation.release(change.bandIndex, change.modulationGeneration);
                 }
             }
             
@@ -1077,9 +1196,46 @@ private:
         }
         
         // EQ-Parameter zurücksetzen (rate-limited über updateEQParameters)
+        publishModulation();
         updateEQParameters(apvts);
     }
     
+    /**
+     * Schreibt die aktuellen Werte aller übernommenen Live-Bänder in die
+     * BandModulation. Kleine Änderungen werden ausgelassen, damit der Audio-Thread
+     * nicht bei jedem Frame neue Koeffizienten berechnen muss.
+     */
+    void publishModulation()
+    {
+        for (int i = 0; i < maxLiveBands; ++i)
+        {
+            const int eqBandIndex = 4 + i;  // Bänder 5-12 für Live-EQ
+            if (eqBandIndex >= ParameterIDs::MAX_BANDS) continue;
+            
+            if (bandModulation.getState(eqBandIndex) != BandModulation::State::Active)
+                continue;
+            
+            const auto& state = bandStates[i];
+            if (state.frequency <= 0.0f)
+                continue;  // Band-Status nach reset() noch leer
+            
+            const auto published = bandModulation.getValues(eqBandIndex);
+            
+            const bool gainChanged = std::abs(state.currentGain - published.gainDb) > 0.05f;
+            const bool freqChanged = std::abs(state.frequency - published.frequency) > published.frequency * 0.005f;
+            const bool qChanged = std::abs(state.q - published.q) > 0.02f;
+            
+            if (gainChanged || freqChanged || qChanged)
+            {
+                BandModulation::Values values = published;
+                values.gainDb = state.currentGain;
+                values.frequency = state.frequency;
+                values.q = state.q;
+                bandModulation.update(eqBandIndex, values);
+            }
+        }
+    }
+    
     //==========================================================================
     // Member-Variablen
     //==========================================================================
@@ -1089,6 +1245,7 @@ private:
     
     Settings settings;
     mutable juce::SpinLock settingsLock;
+    std::atomic<bool> transientProtectionEnabled { true };   // Kopie von settings.transientProtection für den Audio-Thread
     Mode currentMode = Mode::Normal;
     
     double sampleRate = 44100.0;
@@ -1119,6 +1276,14 @@ private:
     std::array<float, maxBands> lastAppliedQ = {};
     std::array<bool, maxBands> lastBandActive = {};
     
+    // Direkte Band-Modulation (Worker → Audio-Thread)
+    BandModulation bandModulation;
+    
+    // Reset-Übergabe Worker ↔ Message-Thread (Bit i = Live-Band i benutzt, s. resetEQBands)
+    std::atomic<uint32_t> appliedLiveBands { 0 };
+    std::atomic<bool> stateResetPending { false };
+    std::array<std::atomic<uint32_t>, BandModulation::NUM_BANDS> resetGenerations {};
+    
     // Transient Detection
     float transientEnvelope = -100.0f;
     
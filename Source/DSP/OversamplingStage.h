@@ -0,0 +1,344 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "HighQualityOversampler.h"
+#include "LatencyCompensationDelay.h"
+
+/**
+ * OversamplingStage: Oversampling um die oversampelte EQ-Gruppe, mit
+ * klickfreien Wechseln von Faktor, Filter-Qualität und Bypass.
+ *
+ * - Zwei Oversampler, beide in prepare() für 16x alloziert: ein Faktor- oder
+ *   Qualitätswechsel stellt nur den freien um (keine Allokation, kein Reset
+ *   des laufenden Pfads)
+ * - Wechsel werden angefragt (thread-safe) und am Blockanfang im Audio-Thread
+ *   übernommen (applyPendingChange). Der neue Pfad schwingt im Hintergrund ein,
+ *   während der alte weiter ausgibt, danach Crossfade über FADE_SAMPLES.
+ *   Der alte Pfad verarbeitet dabei mit der eingefrorenen EQ-Kette
+ *   (highRateStage(buffer, true), s. EQProcessor::processFadingBlock)
+ * - Bypass (selektives Oversampling): solange kein Band die hohe Rate braucht,
+ *   ersetzt bei FIR-Qualität ein gleich langes Delay Up + Down (dort im
+ *   Durchlassbereich eine reine, ganzzahlige Verzögerung). IIR-Qualität
+ *   (Phasengang ≠ Delay) läuft immer durch den Oversampler
+ * - Faktor 1: die Gruppe läuft direkt auf dem Basis-Buffer
+ * - Gemeldete Latenz = Latenz des hörbaren Pfads (getPlayingLatency): bis zum
+ *   Ende des Crossfades die alte, danach die neue. getLatencyInSamples liefert
+ *   das Ziel des letzten Wechsels (für Anzeige/Tail ohne laufenden Audio-Thread)
+ */
+template <typename SampleType>
+class OversamplingStage
+{
+public:
+    using Factor = HighQualityOversamplerBase::Factor;
+    using FilterQuality = HighQualityOversamplerBase::FilterQuality;
+
+    static constexpr int NUM_CHANNELS = LatencyCompensationDelay::MAX_CHANNELS;
+    static constexpr int FADE_SAMPLES = 256;       // Crossfade (~5 ms bei 48 kHz)
+    static constexpr int WARMUP_SAMPLES = 1024;    // Einschwingen nach Faktor-/Qualitätswechsel
+
+    void prepare(double sampleRate, int maxBlockSize)
+    {
+        for (auto& oversampler : oversamplers)
+            oversampler.prepare(sampleRate, maxBlockSize, NUM_CHANNELS);
+
+        delay.prepare(HighQualityOversamplerBase::MAX_LATENCY_SAMPLES, maxBlockSize);
+        fadingBuffer.setSize(NUM_CHANNELS, maxBlockSize);
+        reset();
+    }
+
+    /** Übernimmt die angefragte Einstellung ohne Crossfade (prepare, Transport-Reset). */
+    void reset()
+    {
+        appliedFactor = requestedFactor.load();
+        appliedQuality = requestedQuality.load();
+
+        for (auto& oversampler : oversamplers)
+        {
+            oversampler.setOversamplingFactor(appliedFactor);
+            oversampler.setFilterQuality(appliedQuality);
+            oversampler.reset();
+        }
+
+        activeOversampler = 0;
+        current = makePath(true);
+        fading = false;
+        currentWeight = 1.0;
+        warmupRemaining = 0;
+        idle = false;
+        blockFade = {};
+        delay.reset();
+        fadingBuffer.clear();
+    }
+
+    // Thread-safe Anfragen, übernommen mit dem nächsten applyPendingChange()
+    void setOversamplingFactor(Factor factor) { requestedFactor.store(factor); }
+    void setFilterQuality(FilterQuality quality) { requestedQuality.store(quality); }
+
+    Factor getOversamplingFactor() const { return requestedFactor.load(); }
+    FilterQuality getFilterQuality() const { return requestedQuality.load(); }
+
+    // Faktor, mit dem der aktive Pfad läuft (Audio-Thread, für die EQ-Rate)
+    int getActiveFactorAsInt() const { return static_cast<int>(appliedFactor); }
+
+    /** Latenz der angefragten Einstellung (Basis-Rate, Up + Down bzw. Bypass-Delay). */
+    int getLatencyInSamples() const
+    {
+        return oversamplers[0].getLatencyInSamples(requestedFactor.load(), requestedQuality.load());
+    }
+
+    /**
+     * Latenz des Pfads, der gerade ausgibt (Audio-Thread): während Einschwingen und
+     * Crossfade eines Wechsels die des alten Pfads, erst danach die neue.
+     */
+    int getPlayingLatency() const { return fading ? previous.latency : current.latency; }
+
+    /**
+     * Übernimmt einen angefragten Wechsel (Audio-Thread, Blockanfang). Liefert true,
+     * wenn ein Crossfade begonnen hat: dann EQProcessor::beginOversamplingTransition()
+     * mit getActiveFactorAsInt() aufrufen. Ein laufender Crossfade wird erst beendet.
+     */
+    bool applyPendingChange()
+    {
+        // Neuer Block: Überblendung des vorigen gilt nicht mehr (auch falls process() entfällt)
+        blockFade.active = false;
+
+        const auto factor = requestedFactor.load();
+        const auto quality = requestedQuality.load();
+
+        if ((factor == appliedFactor && quality == appliedQuality) || fading)
+            return false;
+
+        appliedFactor = factor;
+        appliedQuality = quality;
+
+        // Freien Oversampler umstellen (alloziert in prepare), der alte Pfad läuft weiter
+        activeOversampler ^= 1;
+        auto& oversampler = oversamplers[static_cast<size_t>(activeOversampler)];
+        oversampler.setOversamplingFactor(factor);
+        oversampler.setFilterQuality(quality);
+        oversampler.reset();
+
+        previous = current;
+        previous.frozenChain = true;
+        current = makePath(lastWantOversampling);
+        startFade(current.route == Route::Delayed ? 0 : WARMUP_SAMPLES);
+        return true;
+    }
+
+    bool isFading() const { return fading; }
+
+    // Gibt die Stufe den oversampelten (bzw. bei Faktor 1 den direkten) Pfad voll aus?
+    bool isOversampledPathLive() const { return !fading && current.route != Route::Delayed; }
+
+    /**
+     * Block, in dem die Stufe nicht läuft (Linear Phase, A/B-Bypass). Bypass-Delay
+     * und Oversampler-Filter halten dann veraltetes Audio und werden beim nächsten
+     * process() geleert, statt es nach der Pause auszugeben.
+     */
+    void markIdle()
+    {
+        idle = true;
+        blockFade.active = false;
+    }
+
+    /**
+     * Verarbeitet einen Block: highRateStage(juce::AudioBuffer<SampleType>&, bool frozenChain)
+     * läuft auf dem oversampelten (bei Faktor 1 auf dem Basis-)Buffer, frozenChain == true
+     * für den ausblendenden Pfad eines Faktor-/Qualitätswechsels.
+     */
+    template <typename HighRateStage>
+    void process(juce::AudioBuffer<SampleType>& buffer, int numChannels,
+                 bool wantOversampling, HighRateStage&& highRateStage)
+    {
+        const int numSamples = buffer.getNumSamples();
+        numChannels = juce::jmin(numChannels, NUM_CHANNELS);
+
+        // Blocklänge ≤ maxBlockSize aus prepare() (größere Host-Blöcke teilt der Processor)
+        jassert(delay.canProcess(numSamples) && fadingBuffer.getNumSamples() >= numSamples);
+
+        if (idle)
+        {
+            delay.reset();
+            for (auto& oversampler : oversamplers)
+                oversampler.reset();
+            idle = false;
+        }
+
+        // Delay immer mitschreiben, damit der Bypass jederzeit übernehmen kann
+        delay.push(buffer);
+        lastWantOversampling = wantOversampling;
+
+        // Bypass ein/aus: gleiche Einstellung, Crossfade Oversampler ↔ Delay
+        if (!fading && current.route != Route::Direct)
+        {
+            const auto route = canBypass() && !wantOversampling ? Route::Delayed : Route::Oversampled;
+
+            if (route != current.route)
+            {
+                previous = current;
+                current.route = route;
+
+                if (route == Route::Oversampled)
+                    oversamplers[static_cast<size_t>(current.oversampler)].reset();
+
+                startFade(route == Route::Oversampled ? 2 * current.latency : 0);
+            }
+        }
+
+        // Überblendung dieses Blocks für die Dry-/Original-Abgriffe festhalten
+        blockFade = { fading, currentWeight, warmupRemaining, previous.latency, current.latency };
+
+        if (fading)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                fadingBuffer.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+        }
+
+        renderPath(current, buffer, numChannels, highRateStage);
+
+        if (!fading)
+            return;
+
+        juce::AudioBuffer<SampleType> previousBuffer(fadingBuffer.getArrayOfWritePointers(), numChannels, numSamples);
+        renderPath(previous, previousBuffer, numChannels, highRateStage);
+
+        // Crossfade alt → neu (Gewicht des neuen Pfads steigt erst nach dem Einschwingen)
+        crossfade(buffer, previousBuffer, numChannels, numSamples, currentWeight, warmupRemaining);
+        fading = currentWeight < 1.0;
+    }
+
+    /**
+     * Hat der letzte process() zwei Pfade überblendet? Dann liegen Abgriffe des
+     * unbearbeiteten Signals (Dry, Original) auf beiden Latenzen: getBlockFadeLatency()
+     * liefert sie, alignTaps() mischt sie mit denselben Gewichten wie der Ausgang.
+     * Gilt bis zum nächsten Blockanfang (applyPendingChange) bzw. markIdle().
+     */
+    bool wasCrossfading() const { return blockFade.active; }
+    int getBlockFadeLatency(bool previousPath) const { return previousPath ? blockFade.previousLatency : blockFade.currentLatency; }
+
+    /** tap (Latenz des neuen Pfads) ← Überblendung von previousTap (alte Latenz) nach tap. */
+    void alignTaps(juce::AudioBuffer<SampleType>& tap, const juce::AudioBuffer<SampleType>& previousTap,
+                   int numChannels, int numSamples) const
+    {
+        double weight = blockFade.weight;
+        int warmup = blockFade.warmup;
+        crossfade(tap, previousTap, juce::jmin(numChannels, tap.getNumChannels(), previousTap.getNumChannels()),
+                  numSamples, weight, warmup);
+    }
+
+private:
+    enum class Route { Direct, Oversampled, Delayed };
+
+    struct Path
+    {
+        Route route = Route::Direct;
+        int oversampler = 0;
+        int latency = 0;
+        bool frozenChain = false;   // eingefrorene EQ-Kette (alter Pfad eines Wechsels)
+    };
+
+    bool canBypass() const { return appliedQuality == FilterQuality::LinearPhase; }
+
+    Path makePath(bool wantOversampling) const
+    {
+        Path path;
+        path.oversampler = activeOversampler;
+        path.latency = oversamplers[static_cast<size_t>(activeOversampler)].getLatencyInSamples();
+
+        if (appliedFactor == Factor::x1)
+            path.route = Route::Direct;
+        else
+            path.route = canBypass() && !wantOversampling ? Route::Delayed : Route::Oversampled;
+
+        return path;
+    }
+
+    // output ← old + weight * (output - old); weight/warmup laufen über den Block weiter
+    static void crossfade(juce::AudioBuffer<SampleType>& output, const juce::AudioBuffer<SampleType>& old,
+                          int numChannels, int numSamples, double& weight, int& warmup)
+    {
+        const double step = 1.0 / FADE_SAMPLES;
+        const double startWeight = weight;
+        const int startWarmup = warmup;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            SampleType* out = output.getWritePointer(ch);
+            const SampleType* previousOut = old.getReadPointer(ch);
+            weight = startWeight;
+            warmup = startWarmup;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                if (warmup > 0)
+                    --warmup;
+                else
+                    weight = juce::jmin(1.0, weight + step);
+
+                out[i] = static_cast<SampleType>(previousOut[i] + weight * (out[i] - previousOut[i]));
+            }
+        }
+    }
+
+    void startFade(int warmupSamples)
+    {
+        fading = true;
+        currentWeight = 0.0;
+        warmupRemaining = warmupSamples;
+    }
+
+    template <typename HighRateStage>
+    void renderPath(const Path& path, juce::AudioBuffer<SampleType>& buffer, int numChannels,
+                    HighRateStage& highRateStage)
+    {
+        switch (path.route)
+        {
+            case Route::Direct:
+                highRateStage(buffer, path.frozenChain);
+                break;
+
+            case Route::Delayed:
+                delay.read(buffer, path.latency);
+                break;
+
+            case Route::Oversampled:
+            {
+                auto& oversampler = oversamplers[static_cast<size_t>(path.oversampler)];
+                SampleType* const* osChannels = oversampler.upsampleBlock(buffer, numChannels);
+                juce::AudioBuffer<SampleType> osBuffer(osChannels, numChannels, oversampler.getOversampledSize());
+                highRateStage(osBuffer, path.frozenChain);
+                oversampler.downsampleBlock(buffer, numChannels);
+                break;
+            }
+        }
+    }
+
+    std::array<HighQualityOversampler<SampleType>, 2> oversamplers;
+    int activeOversampler = 0;
+
+    LatencyCompensationDelay delay;
+    juce::AudioBuffer<SampleType> fadingBuffer;   // Eingang/Ausgang des ausblendenden Pfads
+
+    std::atomic<Factor> requestedFactor { Factor::x1 };
+    std::atomic<FilterQuality> requestedQuality { FilterQuality::LinearPhase };
+    Factor appliedFactor = Factor::x1;
+    FilterQuality appliedQuality = FilterQuality::LinearPhase;
+
+    Path current, previous;
+    bool fading = false;
+    bool lastWantOversampling = true;
+    bool idle = false;            // letzter Block ohne process() (s. markIdle)
+    double currentWeight = 1.0;   // 0 = alter Pfad, 1 = neuer Pfad
+    int warmupRemaining = 0;
+
+    // Überblendung des letzten process() (Startwerte), s. alignTaps
+    struct BlockFade
+    {
+        bool active = false;
+        double weight = 1.0;
+        int warmup = 0;
+        int previousLatency = 0;
+        int currentLatency = 0;
+    };
+    BlockFade blockFade;
+};
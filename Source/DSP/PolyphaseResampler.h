@@ -0,0 +1,247 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+/**
+ * PolyphaseResampler: Blockweiser Samplerate-Wandler mit beliebigem Verhältnis
+ * (44.1 ↔ 48 ↔ 96 kHz) für Streaming-Quellen.
+ *
+ * - Kaiser-gefensterter Sinc, NUM_PHASES Teilfilter; zwischen zwei benachbarten
+ *   Phasen wird linear interpoliert (zwei Skalarprodukte pro Ausgangs-Sample)
+ * - Beim Heruntertakten wandert die Grenzfrequenz mit der Ziel-Nyquist-Frequenz,
+ *   die Tap-Anzahl wächst entsprechend (Übergangsband bleibt gleich breit)
+ * - Zustandsbehaftet: Eingang kann in beliebig großen Stücken kommen,
+ *   Übergänge zwischen den Stücken sind lückenlos
+ * - reset() setzt auf einen (fraktionalen) Quellzeitpunkt ohne Verzögerung auf;
+ *   mit Vorlauf (Samples vor dem Startpunkt) ist auch der Einschwingvorgang
+ *   nach einem Seek sauber
+ *
+ * prepare() alloziert; process() ist allokationsfrei.
+ */
+class PolyphaseResampler
+{
+public:
+    static constexpr int MAX_CHANNELS = 2;
+    static constexpr int NUM_PHASES = 256;
+    static constexpr int BASE_TAPS = 32;
+    static constexpr int MAX_TAPS = 128;
+    static constexpr double PASSBAND = 0.91;    // Grenzfrequenz relativ zur (kleineren) Nyquist-Frequenz
+    static constexpr double KAISER_BETA = 8.6;  // ≈ 90 dB Sperrdämpfung
+
+    /**
+     * @param maxInputBlock  größtes Stück, das an process() übergeben wird
+     */
+    void prepare(double inputRate, double outputRate, int numChannels, int maxInputBlock)
+    {
+        jassert(inputRate > 0.0 && outputRate > 0.0);
+
+        step = inputRate / outputRate;
+        channels = juce::jlimit(1, MAX_CHANNELS, numChannels);
+
+        const double bandwidth = std::min(1.0, outputRate / inputRate);
+        const int taps = static_cast<int>(std::ceil(static_cast<double>(BASE_TAPS) / bandwidth));
+        numTaps = juce::jlimit(BASE_TAPS, MAX_TAPS, (taps + 3) & ~3);
+
+        designKernel(bandwidth * PASSBAND);
+
+        capacity = numTaps + maxInputBlock + static_cast<int>(std::ceil(step)) + 4;
+        for (auto& history : histories)
+            history.assign(static_cast<size_t>(capacity), 0.0f);
+
+        reset();
+    }
+
+    /**
+     * Startet neu; das erste Ausgangs-Sample liegt fractionalOffset (0..1) Samples
+     * hinter dem Startpunkt. Die ersten numPreroll gelieferten Eingangs-Samples
+     * liegen vor dem Startpunkt (Vorlauf, höchstens getPrerollLength()); fehlender
+     * Vorlauf wird mit Nullen aufgefüllt.
+     */
+    void reset(double fractionalOffset = 0.0, int numPreroll = 0)
+    {
+        // numTaps/2 - 1 Samples Vorlauf braucht der Kernel vor seinem Mittelpunkt
+        // → keine Verzögerung gegenüber der Quelle
+        numBuffered = getPrerollLength() - juce::jlimit(0, getPrerollLength(), numPreroll);
+        for (int ch = 0; ch < channels; ++ch)
+            std::fill(histories[static_cast<size_t>(ch)].begin(), histories[static_cast<size_t>(ch)].end(), 0.0f);
+
+        position = juce::jlimit(0.0, 0.999999, fractionalOffset);
+    }
+
+    /**
+     * Hängt numInput Eingangs-Samples an und erzeugt so viele Ausgangs-Samples
+     * wie möglich (höchstens maxOutput; Rest bleibt für den nächsten Aufruf).
+     * @return Anzahl erzeugter Ausgangs-Samples
+     */
+    int process(const float* const* input, int numInput, float* const* output, int maxOutput)
+    {
+        jassert(numBuffered + numInput <= capacity);
+        numInput = juce::jmax(0, juce::jmin(numInput, capacity - numBuffered));
+
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            float* history = histories[static_cast<size_t>(ch)].data();
+            if (input != nullptr)
+                std::memcpy(history + numBuffered, input[ch], sizeof(float) * static_cast<size_t>(numInput));
+            else
+                std::fill(history + numBuffered, history + numBuffered + numInput, 0.0f);
+        }
+        numBuffered += numInput;
+
+        int produced = 0;
+
+        while (produced < maxOutput)
+        {
+            const int base = static_cast<int>(position);
+            if (base + numTaps > numBuffered)
+                break;
+
+            const double phasePosition = (position - static_cast<double>(base)) * static_cast<double>(NUM_PHASES);
+            const int phase = juce::jmin(NUM_PHASES - 1, static_cast<int>(phasePosition));
+            const float phaseFraction = static_cast<float>(phasePosition - static_cast<double>(phase));
+
+            const float* h0 = kernel.data() + static_cast<size_t>(phase) * static_cast<size_t>(numTaps);
+            const float* h1 = h0 + numTaps;
+
+            for (int ch = 0; ch < channels; ++ch)
+            {
+                const float* x = histories[static_cast<size_t>(ch)].data() + base;
+                float sum0 = 0.0f;
+                float sum1 = 0.0f;
+
+                for (int k = 0; k < numTaps; ++k)
+                {
+                    sum0 += x[k] * h0[k];
+                    sum1 += x[k] * h1[k];
+                }
+
+                output[ch][produced] = sum0 + phaseFraction * (sum1 - sum0);
+            }
+
+            ++produced;
+            position += step;
+        }
+
+        // Verbrauchte Samples verwerfen
+        const int consumed = juce::jmin(static_cast<int>(position), numBuffered);
+        if (consumed > 0)
+        {
+            const auto remaining = static_cast<size_t>(numBuffered - consumed);
+            for (int ch = 0; ch < channels; ++ch)
+            {
+                float* history = histories[static_cast<size_t>(ch)].data();
+                std::memmove(history, history + consumed, sizeof(float) * remaining);
+            }
+
+            numBuffered -= consumed;
+            position -= static_cast<double>(consumed);
+        }
+
+        return produced;
+    }
+
+    /**
+     * Eingangs-Samples, die noch fehlen, um numOutput Ausgangs-Samples zu erzeugen
+     * (begrenzt auf den freien Platz im Verlauf). Wer genau so viel nachliefert,
+     * hält den Rest im Verlauf unter getNumTaps() + ceil(getStep()).
+     */
+    int getInputRequired(int numOutput) const
+    {
+        if (numOutput <= 0)
+            return 0;
+
+        // Ausgangs-Sample bei position braucht floor(position) + numTaps Samples im Verlauf
+        const double lastPosition = position + static_cast<double>(numOutput - 1) * step;
+        const auto required = static_cast<juce::int64>(std::floor(lastPosition)) + numTaps - numBuffered;
+        return static_cast<int>(juce::jlimit<juce::int64>(0, capacity - numBuffered, required));
+    }
+
+    /** Eingangs-Samples im Verlauf, die noch nicht verbraucht sind. */
+    int getNumBuffered() const { return numBuffered; }
+
+    /** Eingangs-Samples pro Ausgangs-Sample. */
+    double getStep() const { return step; }
+
+    /** Nullen, die am Quellende nachgeschoben werden müssen, um alles auszugeben. */
+    int getTailLength() const { return numTaps; }
+
+    /** Maximaler Vorlauf vor dem Startpunkt (= Verzögerung des Kernels). */
+    int getPrerollLength() const { return numTaps / 2 - 1; }
+
+    int getNumTaps() const { return numTaps; }
+
+private:
+
+    static double besselI0(double x)
+    {
+        double sum = 1.0;
+        double term = 1.0;
+        const double halfX = 0.5 * x;
+
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (halfX / static_cast<double>(k)) * (halfX / static_cast<double>(k));
+            sum += term;
+            if (term < sum * 1e-12)
+                break;
+        }
+
+        return sum;
+    }
+
+    void designKernel(double cutoff)
+    {
+        // NUM_PHASES + 1 Phasen: die letzte (= Phase 0 um ein Sample verschoben)
+        // erlaubt die Interpolation ohne Sonderfall
+        kernel.assign(static_cast<size_t>((NUM_PHASES + 1) * numTaps), 0.0f);
+
+        const double delay = static_cast<double>(getPrerollLength());
+        const double halfLength = 0.5 * static_cast<double>(numTaps);
+        const double i0Beta = besselI0(KAISER_BETA);
+
+        for (int p = 0; p <= NUM_PHASES; ++p)
+        {
+            const double fraction = static_cast<double>(p) / static_cast<double>(NUM_PHASES);
+            float* h = kernel.data() + static_cast<size_t>(p) * static_cast<size_t>(numTaps);
+            double sum = 0.0;
+
+            for (int k = 0; k < numTaps; ++k)
+            {
+                const double t = static_cast<double>(k) - delay - fraction;
+                const double x = juce::MathConstants<double>::pi * cutoff * t;
+                const double sinc = (std::abs(x) < 1e-9) ? 1.0 : std::sin(x) / x;
+
+                const double r = t / halfLength;
+                const double window = (std::abs(r) < 1.0)
+                                          ? besselI0(KAISER_BETA * std::sqrt(1.0 - r * r)) / i0Beta
+                                          : 0.0;
+
+                const double value = cutoff * sinc * window;
+                h[k] = static_cast<float>(value);
+                sum += value;
+            }
+
+            // DC-Verstärkung jeder Phase exakt 1
+            if (sum > 0.0)
+            {
+                const float scale = static_cast<float>(1.0 / sum);
+                juce::FloatVectorOperations::multiply(h, scale, numTaps);
+            }
+        }
+    }
+
+    double step = 1.0;
+    int channels = 1;
+    int numTaps = BASE_TAPS;
+    int capacity = 0;
+
+    std::vector<float> kernel;
+    std::array<std::vector<float>, MAX_CHANNELS> histories;
+    int numBuffered = 0;
+    double position = 0.0;
+};
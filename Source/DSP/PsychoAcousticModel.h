@@ -4,6 +4,7 @@
 #include <vector>
 #include <cmath>
 #include <array>
+#include "SpectralKernels.h"
 
 /**
  * PsychoAcousticModel: Psychoakustische Gewichtung nach ISO 226:2003
@@ -24,6 +25,7 @@ public:
     PsychoAcousticModel()
     {
         initializeEqualLoudnessContours();
+        initializeBinWeightTables();
     }
     
     void prepare(double newSampleRate, int newFftSize = 2048)
@@ -31,6 +33,8 @@ public:
         sampleRate = newSampleRate;
         fftSize = newFftSize;
         numBins = fftSize / 2 + 1;
+        
+        initializeBinWeightTables();
     }
     
     //==========================================================================
@@ -69,11 +73,7 @@ public:
         if (f > 10000.0f)
             highWeight = -15.0f * std::log10(f / 10000.0f);
         
-        // Phon-abhängige Skalierung (bei höheren Pegeln flachere Kurven)
-        float phonScale = 1.0f - (phon - 40.0f) / 120.0f;
-        phonScale = juce::jlimit(0.3f, 1.0f, phonScale);
-        
-        return (lowWeight - midWeight + highWeight) * phonScale;
+        return (lowWeight - midWeight + highWeight) * getPhonScale(phon);
     }
     
     /**
@@ -82,14 +82,12 @@ public:
     std::vector<float> applyEqualLoudnessWeighting(const std::vector<float>& magnitudesDb, 
                                                     float phon = 70.0f) const
     {
-        std::vector<float> weighted(magnitudesDb.size());
+        const int n = getNumTableBins(magnitudesDb);
+        std::vector<float> weighted(magnitudesDb.begin(), magnitudesDb.begin() + n);
         
-        for (size_t i = 0; i < magnitudesDb.size(); ++i)
-        {
-            float freq = binToFrequency(static_cast<int>(i));
-            float weight = getEqualLoudnessWeight(freq, phon);
-            weighted[i] = magnitudesDb[i] + weight;
-        }
+        // Kontur ist pegelunabhängig, die Phon-Abhängigkeit ist nur ein Faktor
+        juce::FloatVectorOperations::addWithMultiply(weighted.data(), binEqualLoudness.data(),
+                                                     getPhonScale(phon), n);
         
         return weighted;
     }
@@ -122,21 +120,10 @@ public:
     
     std::vector<float> applyAWeighting(const std::vector<float>& magnitudesDb) const
     {
-        std::vector<float> weighted(magnitudesDb.size());
+        const int n = getNumTableBins(magnitudesDb);
+        std::vector<float> weighted(static_cast<size_t>(n));
         
-        for (size_t i = 0; i < magnitudesDb.size(); ++i)
-        {
-            float freq = binToFrequency(static_cast<int>(i));
-            if (freq > 10.0f)  // Vermeidet Division durch sehr kleine Werte
-            {
-                float weight = getAWeighting(freq);
-                weighted[i] = magnitudesDb[i] + weight;
-            }
-            else
-            {
-                weighted[i] = magnitudesDb[i] - 50.0f;  // Stark dämpfen
-            }
-        }
+        juce::FloatVectorOperations::add(weighted.data(), magnitudesDb.data(), binAWeighting.data(), n);
         
         return weighted;
     }
@@ -222,24 +209,13 @@ public:
      */
     float calculatePerceptualLoudness(const std::vector<float>& magnitudesDb) const
     {
-        float totalLoudness = 0.0f;
-        
-        for (size_t i = 1; i < magnitudesDb.size(); ++i)
-        {
-            float freq = binToFrequency(static_cast<int>(i));
-            
-            // K-Gewichtung (Hochpass + Hochregal)
-            float kWeight = getKWeighting(freq);
-            
-            float weightedDb = magnitudesDb[i] + kWeight;
-            
-            // In lineare Leistung umrechnen und summieren
-            if (weightedDb > -100.0f)
-            {
-                float linearPower = std::pow(10.0f, weightedDb / 10.0f);
-                totalLoudness += linearPower;
-            }
-        }
+        // K-Gewichtung (Hochpass + Hochregal) aus der Bin-Tabelle, in lineare Leistung
+        // umrechnen und summieren (DC-Bin ausgenommen)
+        const int n = getNumTableBins(magnitudesDb);
+        const float totalLoudness = n > 1
+            ? SpectralKernels::sumWeightedPower(magnitudesDb.data() + 1, binKWeighting.data() + 1,
+                                                n - 1, -100.0f)
+            : 0.0f;
         
         // Zurück in dB (LUFS-ähnlich)
         if (totalLoudness > 0.0f)
@@ -319,6 +295,13 @@ private:
     // Lookup-Tabellen für Performance
     std::array<float, 1000> equalLoudnessLUT;
     
+    // Gewichtungen pro FFT-Bin (für die aktuelle Samplerate/FFT-Größe, in prepare() gebaut).
+    // Auf die maximale Bin-Anzahl ausgelegt, damit auch abweichende Spektrum-Größen passen.
+    static constexpr int MAX_TABLE_BINS = 4097;
+    std::array<float, MAX_TABLE_BINS> binKWeighting {};
+    std::array<float, MAX_TABLE_BINS> binAWeighting {};
+    std::array<float, MAX_TABLE_BINS> binEqualLoudness {};  // bei Phon-Skalierung 1
+    
     //==========================================================================
     // Hilfsfunktionen
     //==========================================================================
@@ -327,6 +310,34 @@ private:
         return static_cast<float>(bin) * static_cast<float>(sampleRate) / static_cast<float>(fftSize);
     }
     
+    static float getPhonScale(float phon)
+    {
+        // Phon-abhängige Skalierung (bei höheren Pegeln flachere Kurven)
+        return juce::jlimit(0.3f, 1.0f, 1.0f - (phon - 40.0f) / 120.0f);
+    }
+    
+    static int getNumTableBins(const std::vector<float>& magnitudesDb)
+    {
+        return std::min(static_cast<int>(magnitudesDb.size()), MAX_TABLE_BINS);
+    }
+    
+    void initializeBinWeightTables()
+    {
+        for (int i = 0; i < MAX_TABLE_BINS; ++i)
+        {
+            const float freq = binToFrequency(i);
+            const auto idx = static_cast<size_t>(i);
+            
+            binKWeighting[idx] = getKWeighting(freq);
+            
+            // Unter 10 Hz stark dämpfen (vermeidet Division durch sehr kleine Werte)
+            binAWeighting[idx] = freq > 10.0f ? getAWeighting(freq) : -50.0f;
+            
+            // phon = 40 → Skalierung 1, der Phon-Faktor wird beim Anwenden multipliziert
+            binEqualLoudness[idx] = getEqualLoudnessWeight(freq, 40.0f);
+        }
+    }
+    
     void initializeEqualLoudnessContours()
     {
         // Lookup-Tabelle für schnelleren Zugriff
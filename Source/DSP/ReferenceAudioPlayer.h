@@ -2,116 +2,127 @@
 
 #include <JuceHeader.h>
 #include "FFTAnalyzer.h"
+#include "ReferenceSpectrumAnalysis.h"
+#include "ResampledFileReader.h"
+#include <array>
+#include <atomic>
+#include <limits>
 
 /**
  * ReferenceAudioPlayer: Lädt und analysiert Reference-Audio für Spektralvergleich.
- * 
+ *
  * Features:
  * - Unterstützt WAV, AIFF, FLAC, MP3
- * - Automatisches Resampling auf Plugin-Samplerate
- * - Spektralanalyse des Reference-Tracks
+ * - Automatisches Resampling auf Plugin-Samplerate (Polyphasen-Sinc, blockweise)
+ * - Spektralanalyse des kompletten Reference-Tracks (ReferenceSpectrumAnalysis,
+ *   parallel im ThreadPool, Ergebnis im Platten-Cache)
  * - A/B-Vergleich mit aktuellem Signal
  * - Waveform-Thumbnail für UI
+ *
+ * Streaming statt Komplett-Laden:
+ * - loadFile() kehrt sofort zurück; Öffnen und Vorpuffern laufen im Stream-Thread,
+ *   die Analyse parallel dazu. onFileLoaded (nach der Analyse) bzw. onLoadFailed
+ *   kommen im Message-Thread
+ * - Der Stream-Thread liest die Datei in Stücken, resampelt sie und hält einen
+ *   festen Ring (RING_SIZE Samples pro Kanal) gefüllt — Speicherbedarf unabhängig
+ *   von der Dateilänge
+ * - Der Audio-Thread liest in getNextBlock() nur aus dem Ring (lock- und
+ *   allokationsfrei). Seek und Dateiwechsel starten eine neue Generation: der
+ *   Leser springt über alle Daten der alten Generation hinweg, ohne dass der
+ *   Ring geleert werden muss
  */
-class ReferenceAudioPlayer : public juce::ChangeListener
+class ReferenceAudioPlayer : public juce::ChangeListener,
+                             private juce::Thread,
+                             private juce::AsyncUpdater
 {
 public:
+    static constexpr int MAX_CHANNELS = ResampledFileReader::MAX_CHANNELS;
+    static constexpr int RING_SIZE = 1 << 17;           // ≈ 2.7 s bei 48 kHz
+    static constexpr int STREAM_CHUNK = 4096;           // Ausgangs-Samples pro Schreibvorgang
+    static constexpr int STREAM_POLL_MS = 10;
+
     //==========================================================================
     // Konstruktor / Destruktor
     //==========================================================================
     ReferenceAudioPlayer()
-        : thumbnailCache(5),
+        : juce::Thread("Aura Reference Stream"),
+          thumbnailCache(5),
           thumbnail(512, formatManager, thumbnailCache)
     {
         // Standard-Formate registrieren
         formatManager.registerBasicFormats();
         thumbnail.addChangeListener(this);
+
+        for (auto& ring : ringBuffers)
+            ring.assign(static_cast<size_t>(RING_SIZE), 0.0f);
+
+        chunkBuffer.setSize(MAX_CHANNELS, STREAM_CHUNK);
     }
-    
+
     ~ReferenceAudioPlayer() override
     {
+        stopThread(2000);
+        cancelPendingUpdate();
         thumbnail.removeChangeListener(this);
     }
-    
+
     //==========================================================================
-    // Audio-Datei laden
+    // Audio-Datei laden (asynchron)
     //==========================================================================
+    /**
+     * Startet das Laden im Stream-Thread.
+     * @return false wenn die Datei nicht existiert oder kein passendes Format
+     *         registriert ist; Lesefehler melden sich später über onLoadFailed
+     */
     bool loadFile(const juce::File& file)
     {
-        if (!file.existsAsFile())
+        if (!file.existsAsFile()
+            || formatManager.findFormatForFileExtension(file.getFileExtension()) == nullptr)
             return false;
-        
-        // Reader erstellen
-        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
-        if (reader == nullptr)
-            return false;
-        
-        // Metadaten speichern
-        currentFile = file;
-        originalSampleRate = reader->sampleRate;
-        originalNumChannels = static_cast<int>(reader->numChannels);
-        originalLengthInSamples = reader->lengthInSamples;
-        durationSeconds = static_cast<float>(reader->lengthInSamples) / static_cast<float>(reader->sampleRate);
-        
-        // Audio in Buffer laden
-        referenceBuffer.setSize(static_cast<int>(reader->numChannels), 
-                                static_cast<int>(reader->lengthInSamples));
-        reader->read(&referenceBuffer, 0, 
-                     static_cast<int>(reader->lengthInSamples), 0, true, true);
-        
-        // Thumbnail laden
-        thumbnail.setSource(new juce::FileInputSource(file));
-        
-        // Resampling falls nötig
-        if (currentSampleRate > 0 && std::abs(reader->sampleRate - currentSampleRate) > 1.0)
-        {
-            resampleBuffer();
-        }
-        
-        loaded = true;
-        
-        // Spektrum analysieren
-        analyzeSpectrum();
-        
-        // Listener benachrichtigen
-        if (onFileLoaded)
-            onFileLoaded(file);
-        
+
+        requestLoad(file);
         return true;
     }
-    
+
     void unloadFile()
     {
-        referenceBuffer.setSize(0, 0);
-        resampledBuffer.setSize(0, 0);
-        spectrumMagnitudes.clear();
+        // Audio-Thread sofort abkoppeln, Reader schließt der Stream-Thread
+        streamActive.store(false, std::memory_order_release);
+        playing.store(false);
+        requestLoad(juce::File());
+
+        analysisResult = ReferenceSpectrumAnalysis::Result();
         currentFile = juce::File();
+        originalSampleRate = 0.0;
+        originalNumChannels = 0;
+        originalLengthInSamples = 0;
+        durationSeconds = 0.0f;
         loaded = false;
+        playbackPosition.store(0.0f);
         thumbnail.clear();
-        
+
         if (onFileUnloaded)
             onFileUnloaded();
     }
-    
+
     //==========================================================================
     // Samplerate setzen (für Resampling)
     //==========================================================================
     void prepare(double sampleRate, int blockSize)
     {
-        currentSampleRate = sampleRate;
+        const bool rateChanged = std::abs(sampleRate - targetSampleRate.load()) > 1.0;
+
+        targetSampleRate.store(sampleRate);
         currentBlockSize = blockSize;
-        
+
         // FFT für Spektralanalyse vorbereiten
         fftAnalyzer.prepare(sampleRate);
-        
-        // Wenn bereits geladen, neu resamplen
-        if (loaded && std::abs(originalSampleRate - currentSampleRate) > 1.0)
-        {
-            resampleBuffer();
-            analyzeSpectrum();
-        }
+
+        // Wenn bereits geladen: Stream und Spektrum für die neue Rate neu aufsetzen
+        if (loaded && rateChanged)
+            requestLoad(currentFile);
     }
-    
+
     //==========================================================================
     // Getters
     //==========================================================================
@@ -121,86 +132,135 @@ public:
     float getDurationSeconds() const { return durationSeconds; }
     int getNumChannels() const { return originalNumChannels; }
     double getOriginalSampleRate() const { return originalSampleRate; }
-    
-    // Buffer für Playback/Analyse
-    const juce::AudioBuffer<float>& getBuffer() const
-    {
-        if (resampledBuffer.getNumSamples() > 0)
-            return resampledBuffer;
-        return referenceBuffer;
-    }
-    
-    // Spektrum-Daten für Overlay
-    const std::vector<float>& getSpectrumMagnitudes() const { return spectrumMagnitudes; }
-    
+
+    // Spektrum-Daten für Overlay und Matching (Langzeit-Mittel, dB pro Bin)
+    const std::vector<float>& getSpectrumMagnitudes() const { return analysisResult.average; }
+
+    // Vollständige Analyse (Mittel, Median, 95. Perzentil, integrierte Lautheit)
+    const ReferenceSpectrumAnalysis::Result& getSpectrumAnalysis() const { return analysisResult; }
+
     // Thumbnail für Waveform-Anzeige
     juce::AudioThumbnail& getThumbnail() { return thumbnail; }
-    
+
     //==========================================================================
     // Playback (optional - für Vorhören)
     //==========================================================================
     void setPlaybackPosition(float normalizedPosition)
     {
-        playbackPosition = juce::jlimit(0.0f, 1.0f, normalizedPosition);
-        playbackSampleIndex = static_cast<juce::int64>(playbackPosition * static_cast<float>(getBuffer().getNumSamples()));
+        const float position = juce::jlimit(0.0f, 1.0f, normalizedPosition);
+        playbackPosition.store(position);
+
+        // Seek übernimmt der Stream-Thread (neue Generation im Ring)
+        const auto length = streamOutputLength.load();
+        seekTarget.store(static_cast<juce::int64>(static_cast<double>(position) * static_cast<double>(length)));
+        seekRequest.fetch_add(1, std::memory_order_release);
+        notify();
+    }
+
+    float getPlaybackPosition() const { return playbackPosition.load(); }
+
+    void setPlaying(bool shouldPlay)
+    {
+        // Am Ende abgespielter Stream → von vorn (der Ring ist verbraucht)
+        if (shouldPlay && !playing.load() && playbackPosition.load() >= 1.0f)
+            setPlaybackPosition(0.0f);
+
+        playing.store(shouldPlay);
     }
-    
-    float getPlaybackPosition() const { return playbackPosition; }
-    
-    void setPlaying(bool shouldPlay) { playing = shouldPlay; }
-    bool isPlaying() const { return playing; }
-    
-    // Holt nächsten Block für Playback (für Mix mit Eingangssignal)
+
+    bool isPlaying() const { return playing.load(); }
+
+    // Holt nächsten Block für Playback (für Mix mit Eingangssignal).
+    // Echtzeit-sicher: liest nur aus dem Ring; fehlen Daten, bleibt der Rest still
     void getNextBlock(juce::AudioBuffer<float>& outputBuffer)
     {
-        if (!loaded || !playing)
+        if (!streamActive.load(std::memory_order_acquire))
             return;
-        
-        const auto& sourceBuffer = getBuffer();
-        int numSamples = outputBuffer.getNumSamples();
-        int numChannels = std::min(outputBuffer.getNumChannels(), sourceBuffer.getNumChannels());
-        
-        for (int ch = 0; ch < numChannels; ++ch)
+
+        auto read = readPosition.load(std::memory_order_relaxed);
+
+        // Neue Generation (Seek/Dateiwechsel): alte Daten überspringen
+        const uint32_t generation = streamGeneration.load(std::memory_order_acquire);
+        if (generation != readGeneration)
         {
-            for (int i = 0; i < numSamples; ++i)
-            {
-                juce::int64 sampleIdx = playbackSampleIndex + i;
-                if (sampleIdx < sourceBuffer.getNumSamples())
-                {
-                    outputBuffer.addSample(ch, i, 
-                        sourceBuffer.getSample(ch, static_cast<int>(sampleIdx)) * playbackGain);
-                }
-            }
+            readGeneration = generation;
+            read = std::max(read, generationStart.load(std::memory_order_relaxed));
+            readChannels = generationChannels.load(std::memory_order_relaxed);
+            readLength = generationLength.load(std::memory_order_relaxed);
+            playbackSampleIndex = generationOutputPosition.load(std::memory_order_relaxed);
+            readPosition.store(read, std::memory_order_release);
         }
-        
-        playbackSampleIndex += numSamples;
-        
-        // Loop oder Stop am Ende
-        if (playbackSampleIndex >= sourceBuffer.getNumSamples())
+
+        if (!playing.load(std::memory_order_relaxed))
+            return;
+
+        const int numSamples = outputBuffer.getNumSamples();
+        const auto available = writePosition.load(std::memory_order_acquire) - read;
+        const int numToRead = static_cast<int>(std::min<uint64_t>(static_cast<uint64_t>(numSamples), available));
+        const int numChannels = std::min(outputBuffer.getNumChannels(), readChannels);
+        const float gain = playbackGain.load(std::memory_order_relaxed);
+
+        const int start = static_cast<int>(read & RING_MASK);
+        const int first = std::min(numToRead, RING_SIZE - start);
+
+        for (int ch = 0; ch < numChannels; ++ch)
         {
-            if (looping)
-                playbackSampleIndex = 0;
-            else
-                playing = false;
+            const float* ring = ringBuffers[static_cast<size_t>(ch)].data();
+            float* output = outputBuffer.getWritePointer(ch);
+
+            juce::FloatVectorOperations::addWithMultiply(output, ring + start, gain, first);
+            if (numToRead > first)
+                juce::FloatVectorOperations::addWithMultiply(output + first, ring, gain, numToRead - first);
         }
-        
-        playbackPosition = static_cast<float>(playbackSampleIndex) / static_cast<float>(sourceBuffer.getNumSamples());
+
+        read += static_cast<uint64_t>(numToRead);
+        readPosition.store(read, std::memory_order_release);
+        playbackSampleIndex += numToRead;
+
+        // Loop oder Stop am Ende (der Stream-Thread liefert beim Loop nahtlos weiter)
+        if (readLength > 0 && playbackSampleIndex >= readLength)
+            playbackSampleIndex = looping.load(std::memory_order_relaxed) ? playbackSampleIndex % readLength
+                                                                          : readLength;
+
+        if (numToRead < numSamples && read >= endOfStreamPosition.load(std::memory_order_acquire))
+            playing.store(false, std::memory_order_relaxed);
+
+        if (readLength > 0)
+            playbackPosition.store(static_cast<float>(playbackSampleIndex) / static_cast<float>(readLength),
+                                   std::memory_order_relaxed);
     }
-    
-    void setPlaybackGain(float gain) { playbackGain = juce::jlimit(0.0f, 2.0f, gain); }
-    float getPlaybackGain() const { return playbackGain; }
-    
-    void setLooping(bool shouldLoop) { looping = shouldLoop; }
-    bool isLooping() const { return looping; }
-    
+
+    void setPlaybackGain(float gain) { playbackGain.store(juce::jlimit(0.0f, 2.0f, gain)); }
+    float getPlaybackGain() const { return playbackGain.load(); }
+
+    void setLooping(bool shouldLoop) { looping.store(shouldLoop); }
+    bool isLooping() const { return looping.load(); }
+
     //==========================================================================
-    // Callbacks
+    // Callbacks (Message-Thread)
     //==========================================================================
     std::function<void(const juce::File&)> onFileLoaded;
+    std::function<void(const juce::File&)> onLoadFailed;
     std::function<void()> onFileUnloaded;
     std::function<void()> onThumbnailChanged;
-    
+
 private:
+    static constexpr uint64_t RING_MASK = static_cast<uint64_t>(RING_SIZE - 1);
+    static constexpr uint64_t NO_END = std::numeric_limits<uint64_t>::max();
+
+    // Ergebnis eines Ladeauftrags (Stream-Thread → Message-Thread)
+    struct LoadResult
+    {
+        uint32_t requestId = 0;
+        bool valid = false;
+        bool success = false;
+        juce::File file;
+        double sampleRate = 0.0;
+        int numChannels = 0;
+        juce::int64 lengthInSamples = 0;
+        ReferenceSpectrumAnalysis::Result analysis;
+    };
+
     //==========================================================================
     // ChangeListener für Thumbnail
     //==========================================================================
@@ -209,149 +269,309 @@ private:
         if (onThumbnailChanged)
             onThumbnailChanged();
     }
-    
+
     //==========================================================================
-    // Resampling
+    // Ladeauftrag an den Stream-Thread (leere Datei = schließen)
     //==========================================================================
-    void resampleBuffer()
+    void requestLoad(const juce::File& file)
     {
-        if (referenceBuffer.getNumSamples() == 0 || currentSampleRate <= 0)
-            return;
-        
-        double ratio = currentSampleRate / originalSampleRate;
-        int newNumSamples = static_cast<int>(static_cast<double>(referenceBuffer.getNumSamples()) * ratio);
-        
-        resampledBuffer.setSize(referenceBuffer.getNumChannels(), newNumSamples);
-        
-        // Einfaches lineares Resampling (könnte durch LagrangeInterpolator verbessert werden)
-        for (int ch = 0; ch < referenceBuffer.getNumChannels(); ++ch)
         {
-            const float* input = referenceBuffer.getReadPointer(ch);
-            float* output = resampledBuffer.getWritePointer(ch);
-            
-            for (int i = 0; i < newNumSamples; ++i)
-            {
-                double srcPos = static_cast<double>(i) / ratio;
-                int srcIdx = static_cast<int>(srcPos);
-                float frac = static_cast<float>(srcPos - srcIdx);
-                
-                if (srcIdx + 1 < referenceBuffer.getNumSamples())
-                {
-                    output[i] = input[srcIdx] * (1.0f - frac) + input[srcIdx + 1] * frac;
-                }
-                else if (srcIdx < referenceBuffer.getNumSamples())
-                {
-                    output[i] = input[srcIdx];
-                }
-            }
+            const juce::ScopedLock sl(requestLock);
+            pendingFile = file;
+            pendingRequestId = latestRequestId.fetch_add(1) + 1;
+            hasPendingRequest.store(true);
         }
+
+        if (!isThreadRunning())
+            startThread(juce::Thread::Priority::low);
+
+        notify();
     }
-    
+
     //==========================================================================
-    // Spektralanalyse
+    // Ergebnis übernehmen (Message-Thread)
     //==========================================================================
-    void analyzeSpectrum()
+    void handleAsyncUpdate() override
     {
-        if (!loaded)
+        LoadResult result;
+        {
+            const juce::ScopedLock sl(resultLock);
+            result = std::move(pendingResult);
+            pendingResult = LoadResult();
+        }
+
+        // Inzwischen neu angefordert oder entladen → veraltet
+        if (!result.valid || result.requestId != latestRequestId.load())
             return;
-        
-        const auto& buffer = getBuffer();
-        if (buffer.getNumSamples() == 0)
+
+        if (!result.success)
+        {
+            if (onLoadFailed)
+                onLoadFailed(result.file);
             return;
-        
-        // Analysiere mehrere Abschnitte und mittele das Spektrum
-        const int numSections = 8;
-        const int fftSize = 4096;
-        const int numBins = fftSize / 2 + 1;
-        
-        spectrumMagnitudes.clear();
-        spectrumMagnitudes.resize(static_cast<size_t>(numBins), 0.0f);
-        
-        std::vector<float> windowedSamples(static_cast<size_t>(fftSize), 0.0f);
-        std::vector<float> fftData(static_cast<size_t>(fftSize * 2), 0.0f);
-        
-        juce::dsp::FFT fft(static_cast<int>(std::log2(fftSize)));
-        juce::dsp::WindowingFunction<float> window(static_cast<size_t>(fftSize), 
-            juce::dsp::WindowingFunction<float>::hann);
-        
-        int sectionLength = buffer.getNumSamples() / numSections;
-        int validSections = 0;
-        
-        for (int section = 0; section < numSections; ++section)
+        }
+
+        const bool newFile = !loaded || result.file != currentFile;
+
+        currentFile = result.file;
+        originalSampleRate = result.sampleRate;
+        originalNumChannels = result.numChannels;
+        originalLengthInSamples = result.lengthInSamples;
+        durationSeconds = static_cast<float>(static_cast<double>(result.lengthInSamples) / result.sampleRate);
+        analysisResult = std::move(result.analysis);
+        loaded = true;
+
+        // Thumbnail liest selbst im Hintergrund
+        if (newFile)
+            thumbnail.setSource(new juce::FileInputSource(currentFile));
+
+        if (onFileLoaded)
+            onFileLoaded(currentFile);
+    }
+
+    //==========================================================================
+    // Stream-Thread
+    //==========================================================================
+    void run() override
+    {
+        while (!threadShouldExit())
         {
-            int startSample = section * sectionLength + (sectionLength - fftSize) / 2;
-            if (startSample < 0 || startSample + fftSize > buffer.getNumSamples())
-                continue;
-            
-            // Mono-Mix der Kanäle
-            for (int i = 0; i < fftSize; ++i)
+            if (hasPendingRequest.load())
             {
-                float sample = 0.0f;
-                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                juce::File file;
+                uint32_t requestId = 0;
                 {
-                    sample += buffer.getSample(ch, startSample + i);
+                    const juce::ScopedLock sl(requestLock);
+                    file = pendingFile;
+                    requestId = pendingRequestId;
+                    hasPendingRequest.store(false);
                 }
-                windowedSamples[static_cast<size_t>(i)] = sample / static_cast<float>(buffer.getNumChannels());
+
+                openStream(file, requestId);
+                continue;
             }
-            
-            // Fenster anwenden
-            window.multiplyWithWindowingTable(windowedSamples.data(), static_cast<size_t>(fftSize));
-            
-            // FFT durchführen
-            std::copy(windowedSamples.begin(), windowedSamples.end(), fftData.begin());
-            fft.performFrequencyOnlyForwardTransform(fftData.data());
-            
-            // Magnitudes akkumulieren
-            for (int i = 0; i < numBins; ++i)
+
+            const uint32_t seek = seekRequest.load(std::memory_order_acquire);
+            if (seek != handledSeekRequest)
+            {
+                handledSeekRequest = seek;
+                if (reader != nullptr)
+                    restartStream(seekTarget.load());
+            }
+
+            fillRing();
+
+            // Analyse fertig → Ladeergebnis veröffentlichen
+            if (analysisPending && spectrumAnalysis.isFinished())
             {
-                float magnitude = fftData[static_cast<size_t>(i)];
-                float dB = juce::Decibels::gainToDecibels(magnitude, -100.0f);
-                spectrumMagnitudes[static_cast<size_t>(i)] += dB;
+                analysisPending = false;
+                pendingLoad.analysis = spectrumAnalysis.takeResult();
+                postResult(std::move(pendingLoad));
             }
-            
-            ++validSections;
+
+            wait((reader != nullptr || analysisPending) ? STREAM_POLL_MS : -1);
+        }
+    }
+
+    void openStream(const juce::File& file, uint32_t requestId)
+    {
+        // Laufende Analyse gehört zu einem überholten Auftrag
+        if (analysisPending)
+        {
+            spectrumAnalysis.cancel();
+            analysisPending = false;
+        }
+
+        if (file == juce::File())
+        {
+            streamActive.store(false, std::memory_order_release);
+            reader.reset();
+            return;
+        }
+
+        LoadResult result;
+        result.requestId = requestId;
+        result.valid = true;
+        result.file = file;
+
+        // Neuen Reader erst öffnen: schlägt das fehl, läuft der alte Stream weiter
+        std::unique_ptr<juce::AudioFormatReader> newReader(formatManager.createReaderFor(file));
+
+        if (newReader == nullptr || newReader->lengthInSamples <= 0 || newReader->sampleRate <= 0.0)
+        {
+            postResult(std::move(result));
+            return;
+        }
+
+        streamActive.store(false, std::memory_order_release);
+        reader = std::move(newReader);
+
+        const double outputRate = targetSampleRate.load();
+        streamSource.prepare(*reader, outputRate);
+        outputLength = streamSource.getOutputLength();
+
+        streamOutputLength.store(outputLength);
+        handledSeekRequest = seekRequest.load(std::memory_order_acquire);  // Seeks des alten Streams verwerfen
+        restartStream(0);
+        streamActive.store(true, std::memory_order_release);
+
+        fillRing();
+
+        result.success = true;
+        result.sampleRate = reader->sampleRate;
+        result.numChannels = static_cast<int>(reader->numChannels);
+        result.lengthInSamples = reader->lengthInSamples;
+
+        // Ganze Datei im ThreadPool analysieren (Cache-Treffer: sofort fertig);
+        // der Stream läuft währenddessen weiter
+        if (spectrumAnalysis.start(file, formatManager, outputRate))
+        {
+            pendingLoad = std::move(result);
+            analysisPending = true;
+            return;
+        }
+
+        postResult(std::move(result));
+    }
+
+    void postResult(LoadResult&& result)
+    {
+        {
+            const juce::ScopedLock sl(resultLock);
+            pendingResult = std::move(result);
         }
-        
-        // Durchschnitt bilden
-        if (validSections > 0)
+
+        triggerAsyncUpdate();
+    }
+
+    // Neue Generation ab outputPosition (Ausgangs-Samples)
+    void restartStream(juce::int64 outputPosition)
+    {
+        outputPosition = juce::jlimit<juce::int64>(0, outputLength, outputPosition);
+        streamSource.seek(outputPosition);
+        streamEnded = false;
+
+        endOfStreamPosition.store(NO_END, std::memory_order_relaxed);
+        generationStart.store(writePosition.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        generationOutputPosition.store(outputPosition, std::memory_order_relaxed);
+        generationChannels.store(streamSource.getNumChannels(), std::memory_order_relaxed);
+        generationLength.store(outputLength, std::memory_order_relaxed);
+        streamGeneration.fetch_add(1, std::memory_order_release);
+    }
+
+    // Schreibt ganze Stücke in den Ring, solange Platz ist
+    void fillRing()
+    {
+        if (reader == nullptr || streamEnded)
+            return;
+
+        const bool loop = looping.load();
+        float* const* chunk = chunkBuffer.getArrayOfWritePointers();
+
+        while (!threadShouldExit() && !hasPendingRequest.load()
+               && seekRequest.load(std::memory_order_relaxed) == handledSeekRequest)
         {
-            for (auto& mag : spectrumMagnitudes)
+            const auto write = writePosition.load(std::memory_order_relaxed);
+            const auto used = write - readPosition.load(std::memory_order_acquire);
+            if (used + static_cast<uint64_t>(STREAM_CHUNK) > static_cast<uint64_t>(RING_SIZE))
+                break;
+
+            const int produced = streamSource.read(chunk, STREAM_CHUNK, loop);
+
+            const int start = static_cast<int>(write & RING_MASK);
+            const int first = std::min(produced, RING_SIZE - start);
+
+            for (int ch = 0; ch < streamSource.getNumChannels(); ++ch)
+            {
+                float* ring = ringBuffers[static_cast<size_t>(ch)].data();
+                juce::FloatVectorOperations::copy(ring + start, chunk[ch], first);
+                if (produced > first)
+                    juce::FloatVectorOperations::copy(ring, chunk[ch] + first, produced - first);
+            }
+
+            const auto newWrite = write + static_cast<uint64_t>(produced);
+            writePosition.store(newWrite, std::memory_order_release);
+
+            if (produced < STREAM_CHUNK)
             {
-                mag /= static_cast<float>(validSections);
+                streamEnded = true;
+                endOfStreamPosition.store(newWrite, std::memory_order_release);
+                break;
             }
         }
     }
-    
+
     //==========================================================================
     // Member-Variablen
     //==========================================================================
     juce::AudioFormatManager formatManager;
     juce::AudioThumbnailCache thumbnailCache;
     juce::AudioThumbnail thumbnail;
-    
-    juce::AudioBuffer<float> referenceBuffer;
-    juce::AudioBuffer<float> resampledBuffer;
-    std::vector<float> spectrumMagnitudes;
-    
+
     FFTAnalyzer fftAnalyzer;
-    
+
+    // Message-Thread
+    ReferenceSpectrumAnalysis::Result analysisResult;
     juce::File currentFile;
     double originalSampleRate = 0.0;
     int originalNumChannels = 0;
     juce::int64 originalLengthInSamples = 0;
     float durationSeconds = 0.0f;
-    
-    double currentSampleRate = 44100.0;
-    int currentBlockSize = 512;
-    
     bool loaded = false;
-    
-    // Playback
-    bool playing = false;
-    bool looping = true;
+
+    std::atomic<double> targetSampleRate { 44100.0 };
+    int currentBlockSize = 512;
+
+    // Aufträge / Ergebnisse
+    juce::CriticalSection requestLock;
+    juce::File pendingFile;
+    uint32_t pendingRequestId = 0;
+    std::atomic<bool> hasPendingRequest { false };
+    std::atomic<uint32_t> latestRequestId { 0 };
+
+    juce::CriticalSection resultLock;
+    LoadResult pendingResult;
+
+    std::atomic<juce::int64> seekTarget { 0 };
+    std::atomic<uint32_t> seekRequest { 0 };
+
+    // Stream-Thread
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    ResampledFileReader streamSource;
+    juce::AudioBuffer<float> chunkBuffer;
+    juce::int64 outputLength = 0;
+    bool streamEnded = false;
+    ReferenceSpectrumAnalysis spectrumAnalysis;
+    LoadResult pendingLoad;
+    bool analysisPending = false;
+    uint32_t handledSeekRequest = 0;
+
+    // Ring (ein Schreiber: Stream-Thread, ein Leser: Audio-Thread)
+    std::array<std::vector<float>, MAX_CHANNELS> ringBuffers;
+    std::atomic<uint64_t> writePosition { 0 };
+    std::atomic<uint64_t> readPosition { 0 };
+    std::atomic<uint64_t> endOfStreamPosition { NO_END };
+    std::atomic<bool> streamActive { false };
+    std::atomic<juce::int64> streamOutputLength { 0 };
+
+    // Generation (wird mit release veröffentlicht, Werte davor geschrieben)
+    std::atomic<uint32_t> streamGeneration { 0 };
+    std::atomic<uint64_t> generationStart { 0 };
+    std::atomic<juce::int64> generationOutputPosition { 0 };
+    std::atomic<int> generationChannels { 1 };
+    std::atomic<juce::int64> generationLength { 0 };
+
+    // Audio-Thread
+    uint32_t readGeneration = 0;
+    int readChannels = 1;
+    juce::int64 readLength = 0;
     juce::int64 playbackSampleIndex = 0;
-    float playbackPosition = 0.0f;
-    float playbackGain = 1.0f;
-    
+
+    // Playback (GUI ↔ Audio-Thread)
+    std::atomic<bool> playing { false };
+    std::atomic<bool> looping { true };
+    std::atomic<float> playbackPosition { 0.0f };
+    std::atomic<float> playbackGain { 1.0f };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ReferenceAudioPlayer)
 };
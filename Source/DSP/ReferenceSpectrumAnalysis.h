@@ -0,0 +1,744 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "ResampledFileReader.h"
+#include "SpectralKernels.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * ReferenceSpectrumAnalysis: Analyse des kompletten Reference-Tracks im Hintergrund.
+ *
+ * - Die ganze Datei läuft in der Plugin-Samplerate durch überlappende FFTs
+ *   (4096 Punkte, Hann, 50 % Überlappung, Mono-Mix)
+ * - Die Datei wird in zusammenhängende Abschnitte geteilt, ein ThreadPool-Job pro
+ *   Abschnitt mit eigenem Reader und Resampler. Jeder Job akkumuliert pro Bin die
+ *   Leistungssumme und ein dB-Histogramm (0.5 dB) sowie die K-gewichtete Energie
+ *   in 100-ms-Blöcken; die Reduktion ist eine reine Addition
+ * - Ergebnis: Langzeit-Mittel (Leistungsmittel), Median und 95. Perzentil pro Bin
+ *   und die integrierte Lautheit nach ITU-R BS.1770 (400-ms-Blöcke mit 75 %
+ *   Überlappung, absolutes Gate −70 LUFS, relatives Gate −10 LU)
+ * - Ergebnisse werden auf der Platte zwischengespeichert, Schlüssel = MD5 über
+ *   Dateigröße, Änderungszeit, Anfang und Ende der Datei, 64 gleichmäßig verteilte
+ *   Stichproben dazwischen sowie die Analyse-Samplerate → erneutes Laden derselben
+ *   Referenz ist sofort fertig
+ *
+ * start(), cancel(), isFinished() und takeResult() nur von einem Thread aus
+ * aufrufen (Stream-Thread des ReferenceAudioPlayer).
+ */
+class ReferenceSpectrumAnalysis
+{
+public:
+    static constexpr int FFT_ORDER = 12;
+    static constexpr int FFT_SIZE = 1 << FFT_ORDER;
+    static constexpr int NUM_BINS = FFT_SIZE / 2 + 1;
+    static constexpr int HOP_SIZE = FFT_SIZE / 2;
+
+    // dB-Werte roher FFT-Magnituden (Vollaussteuerung ≈ +60 dB)
+    static constexpr float FLOOR_DB = -100.0f;
+    static constexpr float HISTOGRAM_MAX_DB = 70.0f;
+    static constexpr float HISTOGRAM_STEPS_PER_DB = 2.0f;
+    static constexpr int HISTOGRAM_SIZE = static_cast<int>((HISTOGRAM_MAX_DB - FLOOR_DB) * HISTOGRAM_STEPS_PER_DB);
+
+    static constexpr int MIN_FRAMES_PER_JOB = 64;
+    static constexpr int MAX_JOBS = 8;
+    static constexpr double LOUDNESS_STEP_SECONDS = 0.1;   // 400-ms-Blöcke = 4 Schritte
+    static constexpr int MAX_CACHE_FILES = 64;
+    static constexpr juce::int64 FINGERPRINT_BYTES = 1 << 20;
+    static constexpr int FINGERPRINT_PROBES = 64;                 // Stichproben zwischen Kopf und Ende
+    static constexpr juce::int64 FINGERPRINT_PROBE_BYTES = 4096;
+
+    struct Result
+    {
+        double sampleRate = 0.0;
+        juce::int64 numFrames = 0;
+        std::vector<float> average;        // dB pro Bin (Leistungsmittel)
+        std::vector<float> median;         // dB pro Bin
+        std::vector<float> percentile95;   // dB pro Bin
+        float integratedLoudness = -70.0f; // LUFS
+        bool fromCache = false;
+
+        bool isValid() const { return average.size() == static_cast<size_t>(NUM_BINS); }
+    };
+
+    ReferenceSpectrumAnalysis()
+        : pool(juce::ThreadPoolOptions{}
+                   .withThreadName("Aura Reference Analysis")
+                   .withNumberOfThreads(getNumWorkers())
+                   .withDesiredThreadPriority(juce::Thread::Priority::low))
+    {
+        window.resize(static_cast<size_t>(FFT_SIZE));
+        juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(), static_cast<size_t>(FFT_SIZE),
+                                                                 juce::dsp::WindowingFunction<float>::hann);
+    }
+
+    ~ReferenceSpectrumAnalysis()
+    {
+        cancel();
+    }
+
+    /**
+     * Startet die Analyse von file in der Samplerate sampleRate. Liegt ein
+     * Cache-Eintrag vor, ist isFinished() sofort true.
+     * @return false wenn die Datei nicht gelesen werden kann
+     */
+    bool start(const juce::File& file, juce::AudioFormatManager& formatManager, double sampleRate)
+    {
+        cancel();
+
+        analysisRate = sampleRate;
+        cacheFile = getCacheFile(file, sampleRate);
+        cachedResult = Result();
+
+        if (cacheFile != juce::File() && loadFromCache(cacheFile, cachedResult)
+            && cachedResult.sampleRate == sampleRate)
+        {
+            state = State::Cached;
+            return true;
+        }
+
+        std::unique_ptr<juce::AudioFormatReader> firstReader(formatManager.createReaderFor(file));
+        if (firstReader == nullptr || firstReader->lengthInSamples <= 0 || firstReader->sampleRate <= 0.0)
+            return false;
+
+        ResampledFileReader probe;
+        probe.prepare(*firstReader, sampleRate);
+        outputLength = probe.getOutputLength();
+
+        // Mindestens ein (ggf. mit Nullen aufgefüllter) Frame
+        totalFrames = outputLength >= FFT_SIZE ? (outputLength - FFT_SIZE) / HOP_SIZE + 1 : 1;
+        loudnessStepLength = juce::jmax(1, juce::roundToInt(sampleRate * LOUDNESS_STEP_SECONDS));
+        kWeighting.prepare(sampleRate);
+
+        const auto numJobs = static_cast<int>(juce::jlimit<juce::int64>(
+            1, getNumWorkers(), totalFrames / MIN_FRAMES_PER_JOB));
+
+        remainingJobs.store(numJobs);
+
+        for (int j = 0; j < numJobs; ++j)
+        {
+            std::unique_ptr<juce::AudioFormatReader> reader = (j == 0)
+                ? std::move(firstReader)
+                : std::unique_ptr<juce::AudioFormatReader>(formatManager.createReaderFor(file));
+
+            if (reader == nullptr)
+            {
+                cancel();
+                return false;
+            }
+
+            const juce::int64 firstFrame = totalFrames * j / numJobs;
+            const juce::int64 endFrame = totalFrames * (j + 1) / numJobs;
+            const juce::int64 loudnessEnd = (j == numJobs - 1) ? outputLength : endFrame * HOP_SIZE;
+
+            jobs.push_back(std::make_unique<ChunkJob>(*this, std::move(reader), firstFrame, endFrame,
+                                                      firstFrame * HOP_SIZE, loudnessEnd));
+        }
+
+        state = State::Running;
+
+        for (auto& job : jobs)
+            pool.addJob(job.get(), false);
+
+        return true;
+    }
+
+    /** Bricht laufende Jobs ab (blockiert, bis alle beendet sind). */
+    void cancel()
+    {
+        releaseJobs(true);
+        state = State::Idle;
+    }
+
+    bool isRunning() const { return state != State::Idle; }
+
+    bool isFinished() const
+    {
+        return state == State::Cached
+            || (state == State::Running && remainingJobs.load(std::memory_order_acquire) == 0);
+    }
+
+    /** Reduziert die Job-Ergebnisse und legt sie im Cache ab (nur wenn isFinished()). */
+    Result takeResult()
+    {
+        jassert(isFinished());
+
+        Result result;
+
+        if (state == State::Cached)
+        {
+            result = std::move(cachedResult);
+        }
+        else if (state == State::Running)
+        {
+            result = reduce();
+
+            if (result.isValid() && cacheFile != juce::File())
+                saveToCache(cacheFile, result);
+        }
+
+        releaseJobs(false);
+        state = State::Idle;
+        return result;
+    }
+
+    //==========================================================================
+    // Cache
+    //==========================================================================
+    static juce::File getCacheDirectory()
+    {
+        return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+            .getChildFile("Aura")
+            .getChildFile("ReferenceCache");
+    }
+
+    /** Cache-Datei für file bei sampleRate (leer, wenn die Datei nicht lesbar ist). */
+    static juce::File getCacheFile(const juce::File& file, double sampleRate)
+    {
+        juce::FileInputStream input(file);
+        if (!input.openedOk())
+            return {};
+
+        // Fingerabdruck: Größe, Änderungszeit, Analyse-Parameter, erstes und letztes
+        // MiB sowie gleichmäßig verteilte Stichproben dazwischen (erfasst auch
+        // Bearbeitungen in der Mitte, die Länge und Ränder unverändert lassen)
+        const juce::int64 size = input.getTotalLength();
+        juce::MemoryOutputStream fingerprint;
+        fingerprint.writeInt64(size);
+        fingerprint.writeInt64(file.getLastModificationTime().toMilliseconds());
+        fingerprint.writeDouble(sampleRate);
+        fingerprint.writeInt(CACHE_VERSION);
+        fingerprint.writeInt(FFT_SIZE);
+
+        const juce::int64 headBytes = std::min(size, FINGERPRINT_BYTES);
+        fingerprint.writeFromInputStream(input, headBytes);
+
+        if (size > headBytes)
+        {
+            const juce::int64 tailStart = std::max(headBytes, size - FINGERPRINT_BYTES);
+            const juce::int64 middleBytes = tailStart - headBytes;
+
+            if (middleBytes > 0)
+            {
+                for (int probe = 0; probe < FINGERPRINT_PROBES; ++probe)
+                {
+                    const juce::int64 offset = headBytes + middleBytes * probe / FINGERPRINT_PROBES;
+                    input.setPosition(offset);
+                    fingerprint.writeFromInputStream(input, std::min(FINGERPRINT_PROBE_BYTES, tailStart - offset));
+                }
+            }
+
+            input.setPosition(tailStart);
+            fingerprint.writeFromInputStream(input, FINGERPRINT_BYTES);
+        }
+
+        const juce::MD5 hash(fingerprint.getData(), fingerprint.getDataSize());
+        return getCacheDirectory().getChildFile(hash.toHexString() + ".spectrum");
+    }
+
+private:
+    static constexpr int CACHE_MAGIC = 0x43535241;  // "ARSC"
+    static constexpr int CACHE_VERSION = 2;
+
+    enum class State
+    {
+        Idle,
+        Running,
+        Cached
+    };
+
+    // Erst aus dem Pool nehmen (wartet auch auf Jobs, die gerade zurückkehren), dann löschen
+    void releaseJobs(bool interrupt)
+    {
+        if (jobs.empty())
+            return;
+
+        pool.removeAllJobs(interrupt, 10000);
+        jobs.clear();
+    }
+
+    static int getNumWorkers()
+    {
+        return juce::jlimit(1, MAX_JOBS, juce::SystemStats::getNumCpus() - 1);
+    }
+
+    //==========================================================================
+    // K-Gewichtung nach BS.1770 (Koeffizienten für beliebige Samplerate)
+    //==========================================================================
+    struct KWeighting
+    {
+        struct Stage
+        {
+            double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+        };
+
+        struct FilterState
+        {
+            double s1[2] {}, s2[2] {};
+
+            double process(const KWeighting& k, double x)
+            {
+                for (int i = 0; i < 2; ++i)
+                {
+                    const auto& c = k.stages[i];
+                    const double y = c.b0 * x + s1[i];
+                    s1[i] = c.b1 * x - c.a1 * y + s2[i];
+                    s2[i] = c.b2 * x - c.a2 * y;
+                    x = y;
+                }
+
+                return x;
+            }
+        };
+
+        void prepare(double sampleRate)
+        {
+            // Stufe 1: Hochregal (Kopf-Modell)
+            {
+                const double f0 = 1681.974450955533;
+                const double gainDb = 3.999843853973347;
+                const double q = 0.7071752369554196;
+                const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+                const double vh = std::pow(10.0, gainDb / 20.0);
+                const double vb = std::pow(vh, 0.4996667741545416);
+                const double a0 = 1.0 + k / q + k * k;
+
+                stages[0].b0 = (vh + vb * k / q + k * k) / a0;
+                stages[0].b1 = 2.0 * (k * k - vh) / a0;
+                stages[0].b2 = (vh - vb * k / q + k * k) / a0;
+                stages[0].a1 = 2.0 * (k * k - 1.0) / a0;
+                stages[0].a2 = (1.0 - k / q + k * k) / a0;
+            }
+
+            // Stufe 2: Hochpass (RLB)
+            {
+                const double f0 = 38.13547087602444;
+                const double q = 0.5003270373238773;
+                const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+                const double a0 = 1.0 + k / q + k * k;
+
+                stages[1].b0 = 1.0;
+                stages[1].b1 = -2.0;
+                stages[1].b2 = 1.0;
+                stages[1].a1 = 2.0 * (k * k - 1.0) / a0;
+                stages[1].a2 = (1.0 - k / q + k * k) / a0;
+            }
+        }
+
+        Stage stages[2];
+    };
+
+    //==========================================================================
+    // Ein Abschnitt der Datei (Frames [firstFrame, endFrame))
+    //==========================================================================
+    class ChunkJob : public juce::ThreadPoolJob
+    {
+    public:
+        ChunkJob(const ReferenceSpectrumAnalysis& analysis, std::unique_ptr<juce::AudioFormatReader> fileReader,
+                 juce::int64 first, juce::int64 end, juce::int64 loudnessFrom, juce::int64 loudnessTo)
+            : juce::ThreadPoolJob("Reference Analysis Chunk"),
+              owner(analysis),
+              reader(std::move(fileReader)),
+              firstFrame(first),
+              endFrame(end),
+              loudnessStart(loudnessFrom),
+              loudnessEnd(loudnessTo)
+        {
+        }
+
+        JobStatus runJob() override
+        {
+            process();
+            owner.remainingJobs.fetch_sub(1, std::memory_order_release);
+            return jobHasFinished;
+        }
+
+        // Ergebnisse (nach Ende des Jobs nur noch gelesen)
+        std::vector<double> powerSum;
+        std::vector<uint32_t> histogram;        // NUM_BINS × HISTOGRAM_SIZE
+        std::vector<double> loudnessEnergy;     // K-gewichtete Energie pro 100-ms-Schritt
+        juce::int64 firstLoudnessStep = 0;
+        juce::int64 numFrames = 0;
+
+    private:
+        void process()
+        {
+            ResampledFileReader source;
+            source.prepare(*reader, owner.analysisRate);
+            const int numChannels = source.getNumChannels();
+
+            powerSum.assign(static_cast<size_t>(NUM_BINS), 0.0);
+            histogram.assign(static_cast<size_t>(NUM_BINS * HISTOGRAM_SIZE), 0u);
+
+            const int stepLength = owner.loudnessStepLength;
+            firstLoudnessStep = loudnessStart / stepLength;
+            const juce::int64 lastLoudnessStep = juce::jmax(firstLoudnessStep, (loudnessEnd - 1) / stepLength);
+            loudnessEnergy.assign(static_cast<size_t>(lastLoudnessStep - firstLoudnessStep + 1), 0.0);
+
+            juce::AudioBuffer<float> block(ResampledFileReader::MAX_CHANNELS, HOP_SIZE);
+            std::array<std::vector<float>, ResampledFileReader::MAX_CHANNELS> history;
+            for (auto& channel : history)
+                channel.assign(static_cast<size_t>(FFT_SIZE), 0.0f);
+
+            fftData.assign(static_cast<size_t>(FFT_SIZE * 2), 0.0f);
+            decibels.assign(static_cast<size_t>(NUM_BINS), 0.0f);
+            juce::dsp::FFT fft(FFT_ORDER);
+            KWeighting::FilterState filterStates[ResampledFileReader::MAX_CHANNELS];
+
+            // Liest bis zum Ende des letzten eigenen Frames bzw. Lautheits-Bereichs
+            // (über das Dateiende hinaus: Nullen, nur bei sehr kurzen Dateien)
+            const juce::int64 start = firstFrame * HOP_SIZE;
+            const juce::int64 readEnd = juce::jmax(loudnessEnd, (endFrame - 1) * HOP_SIZE + FFT_SIZE);
+            juce::int64 position = start;
+            juce::int64 nextFrame = firstFrame;
+
+            source.seek(start);
+
+            while (position < readEnd)
+            {
+                if (shouldExit())
+                    return;
+
+                const int numSamples = static_cast<int>(juce::jmin<juce::int64>(HOP_SIZE, readEnd - position));
+                float* const* samples = block.getArrayOfWritePointers();
+                const int numRead = source.read(samples, numSamples, false);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    juce::FloatVectorOperations::clear(samples[ch] + numRead, numSamples - numRead);
+
+                // Lautheit: nur der eigene Bereich, damit sich die Jobs nicht überlappen
+                const juce::int64 from = juce::jmax(position, loudnessStart);
+                const juce::int64 to = juce::jmin(position + numSamples, loudnessEnd);
+
+                for (int ch = 0; ch < numChannels && from < to; ++ch)
+                    accumulateLoudness(samples[ch], position, from, to, filterStates[ch]);
+
+                // Frame-Historie nachschieben
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    float* channel = history[static_cast<size_t>(ch)].data();
+                    std::memmove(channel, channel + numSamples, sizeof(float) * static_cast<size_t>(FFT_SIZE - numSamples));
+                    juce::FloatVectorOperations::copy(channel + FFT_SIZE - numSamples, samples[ch], numSamples);
+                }
+
+                position += numSamples;
+
+                if (nextFrame < endFrame && position == nextFrame * HOP_SIZE + FFT_SIZE)
+                {
+                    analyzeFrame(history, numChannels, fft);
+                    ++nextFrame;
+                }
+            }
+        }
+
+        void accumulateLoudness(const float* samples, juce::int64 blockStart, juce::int64 from, juce::int64 to,
+                                KWeighting::FilterState& state)
+        {
+            const int stepLength = owner.loudnessStepLength;
+            juce::int64 step = from / stepLength;
+            juce::int64 stepEnd = (step + 1) * stepLength;
+            double energy = 0.0;
+
+            for (juce::int64 s = from; s < to; ++s)
+            {
+                if (s == stepEnd)
+                {
+                    loudnessEnergy[static_cast<size_t>(step - firstLoudnessStep)] += energy;
+                    energy = 0.0;
+                    ++step;
+                    stepEnd += stepLength;
+                }
+
+                const double y = state.process(owner.kWeighting, static_cast<double>(samples[s - blockStart]));
+                energy += y * y;
+            }
+
+            loudnessEnergy[static_cast<size_t>(step - firstLoudnessStep)] += energy;
+        }
+
+        void analyzeFrame(const std::array<std::vector<float>, ResampledFileReader::MAX_CHANNELS>& history,
+                          int numChannels, const juce::dsp::FFT& fft)
+        {
+            // Mono-Mix, Fenster, FFT
+            std::fill(fftData.begin(), fftData.end(), 0.0f);
+            for (int ch = 0; ch < numChannels; ++ch)
+                juce::FloatVectorOperations::add(fftData.data(), history[static_cast<size_t>(ch)].data(), FFT_SIZE);
+
+            juce::FloatVectorOperations::multiply(fftData.data(), 1.0f / static_cast<float>(numChannels), FFT_SIZE);
+            juce::FloatVectorOperations::multiply(fftData.data(), owner.window.data(), FFT_SIZE);
+            fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+            for (int k = 0; k < NUM_BINS; ++k)
+            {
+                const double magnitude = static_cast<double>(fftData[static_cast<size_t>(k)]);
+                powerSum[static_cast<size_t>(k)] += magnitude * magnitude;
+            }
+
+            SpectralKernels::gainToDecibels(fftData.data(), decibels.data(), NUM_BINS, 1.0f, FLOOR_DB);
+
+            uint32_t* counts = histogram.data();
+            for (int k = 0; k < NUM_BINS; ++k)
+            {
+                const int index = static_cast<int>((decibels[static_cast<size_t>(k)] - FLOOR_DB) * HISTOGRAM_STEPS_PER_DB);
+                ++counts[k * HISTOGRAM_SIZE + juce::jlimit(0, HISTOGRAM_SIZE - 1, index)];
+            }
+
+            ++numFrames;
+        }
+
+        const ReferenceSpectrumAnalysis& owner;
+        std::unique_ptr<juce::AudioFormatReader> reader;
+        const juce::int64 firstFrame;
+        const juce::int64 endFrame;
+        const juce::int64 loudnessStart;
+        const juce::int64 loudnessEnd;
+
+        std::vector<float> fftData;
+        std::vector<float> decibels;
+
+        JUCE_DECLARE_NON_COPYABLE(ChunkJob)
+    };
+
+    //==========================================================================
+    // Reduktion
+    //==========================================================================
+    Result reduce() const
+    {
+        Result result;
+        result.sampleRate = analysisRate;
+
+        std::vector<double> powerSum(static_cast<size_t>(NUM_BINS), 0.0);
+        std::vector<uint32_t> histogram(static_cast<size_t>(NUM_BINS * HISTOGRAM_SIZE), 0u);
+
+        const auto numSteps = static_cast<size_t>((outputLength + loudnessStepLength - 1) / loudnessStepLength);
+        std::vector<double> loudnessEnergy(juce::jmax<size_t>(1, numSteps), 0.0);
+
+        for (const auto& job : jobs)
+        {
+            result.numFrames += job->numFrames;
+
+            for (size_t k = 0; k < powerSum.size(); ++k)
+                powerSum[k] += job->powerSum[k];
+
+            for (size_t i = 0; i < histogram.size(); ++i)
+                histogram[i] += job->histogram[i];
+
+            for (size_t i = 0; i < job->loudnessEnergy.size(); ++i)
+            {
+                const auto step = static_cast<size_t>(job->firstLoudnessStep) + i;
+                if (step < loudnessEnergy.size())
+                    loudnessEnergy[step] += job->loudnessEnergy[i];
+            }
+        }
+
+        if (result.numFrames == 0)
+            return result;
+
+        result.average.resize(static_cast<size_t>(NUM_BINS));
+        result.median.resize(static_cast<size_t>(NUM_BINS));
+        result.percentile95.resize(static_cast<size_t>(NUM_BINS));
+
+        const double invFrames = 1.0 / static_cast<double>(result.numFrames);
+
+        for (int k = 0; k < NUM_BINS; ++k)
+        {
+            const auto index = static_cast<size_t>(k);
+            const double meanPower = powerSum[index] * invFrames;
+            result.average[index] = meanPower > 0.0
+                                        ? juce::jmax(FLOOR_DB, static_cast<float>(10.0 * std::log10(meanPower)))
+                                        : FLOOR_DB;
+
+            const uint32_t* counts = histogram.data() + index * static_cast<size_t>(HISTOGRAM_SIZE);
+            result.median[index] = getPercentile(counts, result.numFrames, 0.5);
+            result.percentile95[index] = getPercentile(counts, result.numFrames, 0.95);
+        }
+
+        result.integratedLoudness = computeIntegratedLoudness(loudnessEnergy);
+        return result;
+    }
+
+    // Perzentil aus dem Histogramm (linear innerhalb einer Klasse)
+    static float getPercentile(const uint32_t* counts, juce::int64 total, double fraction)
+    {
+        const double target = fraction * static_cast<double>(total);
+        double cumulative = 0.0;
+
+        for (int i = 0; i < HISTOGRAM_SIZE; ++i)
+        {
+            const auto count = static_cast<double>(counts[i]);
+            if (count > 0.0 && cumulative + count >= target)
+            {
+                const double position = static_cast<double>(i) + (target - cumulative) / count;
+                return juce::jmax(FLOOR_DB, FLOOR_DB + static_cast<float>(position) / HISTOGRAM_STEPS_PER_DB);
+            }
+
+            cumulative += count;
+        }
+
+        return HISTOGRAM_MAX_DB;
+    }
+
+    // BS.1770: 400-ms-Blöcke (4 Schritte à 100 ms), Gates −70 LUFS / −10 LU
+    float computeIntegratedLoudness(const std::vector<double>& stepEnergy) const
+    {
+        constexpr double absoluteGate = -70.0;
+        constexpr int stepsPerBlock = 4;
+
+        auto toLoudness = [](double meanSquare) { return -0.691 + 10.0 * std::log10(meanSquare); };
+
+        // Nur vollständige Schritte; kürzere Dateien als ein Block → ein einziger Block
+        const juce::int64 fullSteps = outputLength / loudnessStepLength;
+        const int numBlocks = static_cast<int>(juce::jmax<juce::int64>(1, fullSteps - stepsPerBlock + 1));
+        const int stepsInBlock = static_cast<int>(juce::jmin<juce::int64>(stepsPerBlock, juce::jmax<juce::int64>(1, fullSteps)));
+
+        std::vector<double> blockMeanSquare(static_cast<size_t>(numBlocks), 0.0);
+        const double samplesPerBlock = static_cast<double>(stepsInBlock) * static_cast<double>(loudnessStepLength);
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            double energy = 0.0;
+            for (int s = 0; s < stepsInBlock && static_cast<size_t>(b + s) < stepEnergy.size(); ++s)
+                energy += stepEnergy[static_cast<size_t>(b + s)];
+
+            blockMeanSquare[static_cast<size_t>(b)] = energy / samplesPerBlock;
+        }
+
+        auto gatedMean = [&](double threshold, double& mean)
+        {
+            double sum = 0.0;
+            int count = 0;
+
+            for (double z : blockMeanSquare)
+            {
+                if (z > 0.0 && toLoudness(z) > threshold)
+                {
+                    sum += z;
+                    ++count;
+                }
+            }
+
+            mean = count > 0 ? sum / static_cast<double>(count) : 0.0;
+            return count > 0;
+        };
+
+        double mean = 0.0;
+        if (!gatedMean(absoluteGate, mean))
+            return static_cast<float>(absoluteGate);
+
+        const double relativeGate = toLoudness(mean) - 10.0;
+        if (!gatedMean(juce::jmax(absoluteGate, relativeGate), mean))
+            return static_cast<float>(absoluteGate);
+
+        return static_cast<float>(toLoudness(mean));
+    }
+
+    //==========================================================================
+    // Cache-Datei
+    //==========================================================================
+    static bool loadFromCache(const juce::File& file, Result& result)
+    {
+        if (!file.existsAsFile())
+            return false;
+
+        juce::FileInputStream input(file);
+        if (!input.openedOk() || input.readInt() != CACHE_MAGIC || input.readInt() != CACHE_VERSION)
+            return false;
+
+        result.sampleRate = input.readDouble();
+        result.numFrames = input.readInt64();
+        result.integratedLoudness = input.readFloat();
+
+        if (input.readInt() != NUM_BINS)
+            return false;
+
+        const auto numBytes = static_cast<int>(sizeof(float) * static_cast<size_t>(NUM_BINS));
+
+        for (auto* curve : { &result.average, &result.median, &result.percentile95 })
+        {
+            curve->resize(static_cast<size_t>(NUM_BINS));
+            if (input.read(curve->data(), numBytes) != numBytes)
+                return false;
+        }
+
+        result.fromCache = true;
+
+        // Zuletzt benutzt → beim Aufräumen zuletzt gelöscht
+        file.setLastModificationTime(juce::Time::getCurrentTime());
+        return true;
+    }
+
+    static bool saveToCache(const juce::File& file, const Result& result)
+    {
+        const auto directory = file.getParentDirectory();
+        if (!directory.createDirectory())
+            return false;
+
+        juce::TemporaryFile temporary(file);
+
+        {
+            juce::FileOutputStream output(temporary.getFile());
+            if (!output.openedOk())
+                return false;
+
+            output.writeInt(CACHE_MAGIC);
+            output.writeInt(CACHE_VERSION);
+            output.writeDouble(result.sampleRate);
+            output.writeInt64(result.numFrames);
+            output.writeFloat(result.integratedLoudness);
+            output.writeInt(NUM_BINS);
+
+            for (const auto* curve : { &result.average, &result.median, &result.percentile95 })
+                output.write(curve->data(), sizeof(float) * static_cast<size_t>(NUM_BINS));
+
+            output.flush();
+            if (output.getStatus().failed())
+                return false;
+        }
+
+        if (!temporary.overwriteTargetFileWithTemporary())
+            return false;
+
+        pruneCache(directory);
+        return true;
+    }
+
+    // Älteste Einträge löschen, wenn mehr als MAX_CACHE_FILES vorhanden sind
+    static void pruneCache(const juce::File& directory)
+    {
+        auto files = directory.findChildFiles(juce::File::findFiles, false, "*.spectrum");
+        if (files.size() <= MAX_CACHE_FILES)
+            return;
+
+        std::sort(files.begin(), files.end(), [](const juce::File& a, const juce::File& b)
+        {
+            return a.getLastModificationTime() > b.getLastModificationTime();
+        });
+
+        for (int i = MAX_CACHE_FILES; i < files.size(); ++i)
+            files.getReference(i).deleteFile();
+    }
+
+    //==========================================================================
+    // Member-Variablen
+    //==========================================================================
+    juce::ThreadPool pool;
+    std::vector<std::unique_ptr<ChunkJob>> jobs;
+    mutable std::atomic<int> remainingJobs { 0 };  // von den Jobs heruntergezählt
+    State state = State::Idle;
+
+    // Gemeinsame, während der Jobs unveränderte Tabellen
+    std::vector<float> window;
+    KWeighting kWeighting;
+    double analysisRate = 44100.0;
+    juce::int64 outputLength = 0;
+    juce::int64 totalFrames = 0;
+    int loudnessStepLength = 4410;
+
+    juce::File cacheFile;
+    Result cachedResult;
+
+    JUCE_DECLARE_NON_COPYABLE(ReferenceSpectrumAnalysis)
+};
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "PolyphaseResampler.h"
+
+/**
+ * ResampledFileReader: Liest eine Audiodatei blockweise in der Plugin-Samplerate.
+ *
+ * - Eigene Lese-Position (seek() in Ausgangs-Samples) und eigener Resampler-Zustand:
+ *   mehrere Instanzen können dieselbe Datei an verschiedenen Stellen lesen
+ *   (je Instanz ein eigener AudioFormatReader, Reader sind nicht thread-safe)
+ * - Seek mit Vorlauf aus der Datei → kein Einschwingen auf Nullen
+ * - Loop ist nahtlos (Resampler-Zustand läuft über das Dateiende weiter)
+ * - Weichen die Raten um höchstens 1 Hz ab, wird direkt kopiert
+ *
+ * prepare() alloziert; read() ist allokationsfrei. Höchstens MAX_CHANNELS Kanäle.
+ */
+class ResampledFileReader
+{
+public:
+    static constexpr int MAX_CHANNELS = PolyphaseResampler::MAX_CHANNELS;
+    static constexpr int READ_CHUNK = 4096;  // Quell-Samples pro Lesevorgang
+
+    void prepare(juce::AudioFormatReader& source, double outputRate)
+    {
+        reader = &source;
+        sourceLength = source.lengthInSamples;
+        numChannels = juce::jlimit(1, MAX_CHANNELS, static_cast<int>(source.numChannels));
+        resampling = std::abs(source.sampleRate - outputRate) > 1.0;
+
+        if (resampling)
+        {
+            resampler.prepare(source.sampleRate, outputRate, numChannels, READ_CHUNK);
+            outputLength = static_cast<juce::int64>(static_cast<double>(sourceLength) / resampler.getStep());
+        }
+        else
+        {
+            outputLength = sourceLength;
+        }
+
+        readBuffer.setSize(MAX_CHANNELS, READ_CHUNK);
+        seek(0);
+    }
+
+    /** Länge der Datei in Ausgangs-Samples. */
+    juce::int64 getOutputLength() const { return outputLength; }
+
+    /** Gelieferte Kanäle (1 oder 2). */
+    int getNumChannels() const { return numChannels; }
+
+    void seek(juce::int64 outputPosition)
+    {
+        tailFlushed = false;
+
+        if (!resampling)
+        {
+            sourcePosition = outputPosition;
+            return;
+        }
+
+        // Mit Vorlauf aus der Datei: kein Einschwingen auf Nullen nach einem Seek
+        const double sourceTime = static_cast<double>(outputPosition) * resampler.getStep();
+        const double sourceSample = std::floor(sourceTime);
+        const auto startSample = static_cast<juce::int64>(sourceSample);
+        const int preroll = static_cast<int>(std::min<juce::int64>(resampler.getPrerollLength(), startSample));
+
+        sourcePosition = startSample - preroll;
+        resampler.reset(sourceTime - sourceSample, preroll);
+    }
+
+    /**
+     * Liest numOutput Samples ab der aktuellen Position.
+     * @param dest  MAX_CHANNELS Zeiger (bei Mono-Dateien bleibt dest[1] unberührt)
+     * @return Anzahl gelieferter Samples (weniger nur am Dateiende ohne Loop)
+     */
+    int read(float* const* dest, int numOutput, bool loop)
+    {
+        int produced = 0;
+
+        while (produced < numOutput)
+        {
+            float* output[MAX_CHANNELS] = { dest[0] + produced, dest[1] + produced };
+            const int remaining = numOutput - produced;
+
+            if (sourcePosition >= sourceLength)
+            {
+                // Loop: Resampler-Zustand bleibt → nahtloser Übergang
+                if (loop)
+                {
+                    sourcePosition = 0;
+                    continue;
+                }
+
+                // Dateiende: Nachlauf des Resamplers ausgeben
+                if (!resampling)
+                    break;
+
+                const int tail = tailFlushed ? 0 : resampler.getTailLength();
+                tailFlushed = true;
+
+                const int flushed = resampler.process(nullptr, tail, output, remaining);
+                if (flushed == 0)
+                    break;
+
+                produced += flushed;
+                continue;
+            }
+
+            // Resampling: genau die Eingangs-Samples für `remaining` Ausgangs-Samples lesen,
+            // sonst wächst der Rest im Resampler-Verlauf bis zur Kapazität und Eingang wird abgeschnitten
+            const int wanted = resampling
+                                   ? std::min(READ_CHUNK, resampler.getInputRequired(remaining))
+                                   : std::min(READ_CHUNK, remaining);
+            const int numToRead = static_cast<int>(std::min<juce::int64>(wanted, sourceLength - sourcePosition));
+
+            if (numToRead > 0)
+            {
+                reader->read(&readBuffer, 0, numToRead, sourcePosition, true, true);
+                sourcePosition += numToRead;
+            }
+
+            if (resampling)
+            {
+                produced += resampler.process(readBuffer.getArrayOfReadPointers(), numToRead, output, remaining);
+                jassert(resampler.getNumBuffered() < resampler.getNumTaps() + static_cast<int>(std::ceil(resampler.getStep())));
+            }
+            else
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                    juce::FloatVectorOperations::copy(output[ch], readBuffer.getReadPointer(ch), numToRead);
+
+                produced += numToRead;
+            }
+        }
+
+        return produced;
+    }
+
+private:
+    juce::AudioFormatReader* reader = nullptr;
+    PolyphaseResampler resampler;
+    juce::AudioBuffer<float> readBuffer;
+
+    juce::int64 sourceLength = 0;
+    juce::int64 outputLength = 0;
+    juce::int64 sourcePosition = 0;
+    int numChannels = 1;
+    bool resampling = false;
+    bool tailFlushed = false;
+};
@@ -3,6 +3,7 @@
 #include <JuceHeader.h>
 #include "../Parameters/ParameterIDs.h"
 #include <cmath>
+#include <complex>
 
 /**
  * SVFFilter: State Variable Filter (Topology-Preserving Transform)
@@ -21,11 +22,20 @@
  * BandPass, Notch, AllPass
  * 
  * Dieses Filter wird primär für Dynamic EQ Bands verwendet, wo sich
- * der Gain auf Basis des Envelope Followers ständig ändert.
+ * der Gain auf Basis des Envelope Followers ständig ändert. Der Dynamic EQ
+ * berechnet Koeffizienten nur an Kontrollpunkten (getCoefficientsForGain) und
+ * interpoliert dazwischen linear pro Sample (processRamped).
  */
 class SVFFilter
 {
 public:
+    // Kern- (a1..a3) und Output-Mix-Koeffizienten (m0..m2)
+    struct Coefficients
+    {
+        double a1 = 1.0, a2 = 0.0, a3 = 0.0;
+        double m0 = 1.0, m1 = 0.0, m2 = 0.0;
+    };
+
     SVFFilter() = default;
     ~SVFFilter() = default;
 
@@ -61,7 +71,7 @@ public:
         cachedG = std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
         double k = 1.0 / static_cast<double>(Q);
         
-        computeMixCoefficients(type, gainDB, Q, cachedG, k);
+        computeMixCoefficients(coeffs, type, gainDB, Q, cachedG, k);
     }
 
     /**
@@ -75,8 +85,57 @@ public:
             return;  // Keine signifikante Änderung
         
         currentGainDB = gainDB;
-        double k = 1.0 / static_cast<double>(currentQ);
-        computeMixCoefficients(currentType, gainDB, currentQ, cachedG, k);
+        coeffs = getCoefficientsForGain(gainDB);
+    }
+
+    /**
+     * Koeffizienten für einen anderen Gain bei gleicher Frequenz/Q/Typ
+     * (kein tan(), ändert den Filter nicht).
+     */
+    Coefficients getCoefficientsForGain(float gainDB) const
+    {
+        Coefficients c;
+        computeMixCoefficients(c, currentType, gainDB, currentQ, cachedG, 1.0 / static_cast<double>(currentQ));
+        return c;
+    }
+
+    /**
+     * Verarbeitet bis zu zwei Kanäle mit gemeinsamen Koeffizienten, die über den
+     * Block linear von den aktuellen Koeffizienten von first auf target laufen.
+     * Danach tragen beide Filter target. second/secondData dürfen nullptr sein.
+     */
+    template <typename SampleType>
+    static void processRamped(SVFFilter& first, SampleType* firstData, SVFFilter* second, SampleType* secondData,
+                              int numSamples, const Coefficients& target) noexcept
+    {
+        if (numSamples <= 0)
+            return;
+
+        Coefficients c = first.coeffs;
+        const double step = 1.0 / static_cast<double>(numSamples);
+        const Coefficients delta { (target.a1 - c.a1) * step, (target.a2 - c.a2) * step, (target.a3 - c.a3) * step,
+                                   (target.m0 - c.m0) * step, (target.m1 - c.m1) * step, (target.m2 - c.m2) * step };
+
+        const bool stereo = second != nullptr && secondData != nullptr;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            c.a1 += delta.a1; c.a2 += delta.a2; c.a3 += delta.a3;
+            c.m0 += delta.m0; c.m1 += delta.m1; c.m2 += delta.m2;
+
+            firstData[i] = static_cast<SampleType>(first.tick(c, firstData[i]));
+            if (stereo)
+                secondData[i] = static_cast<SampleType>(second->tick(c, secondData[i]));
+        }
+
+        first.coeffs = target;
+        first.flushDenormals();
+
+        if (second != nullptr)
+        {
+            second->coeffs = target;
+            second->flushDenormals();
+        }
     }
 
     /**
@@ -96,34 +155,19 @@ public:
      * Topology-Preserving Transform: interne Zustände bleiben
      * auch bei Parameteränderungen zwischen Samples konsistent.
      */
-    float processSample(float input) noexcept
+    template <typename SampleType>
+    SampleType processSample(SampleType input) noexcept
     {
-        double v0 = static_cast<double>(input);
-        
-        // TPT SVF Tick (zero-delay feedback)
-        double v3 = v0 - ic2eq;
-        double v1 = a1 * ic1eq + a2 * v3;
-        double v2 = ic2eq + a2 * ic1eq + a3 * v3;
-        
-        // State Update
-        ic1eq = 2.0 * v1 - ic1eq;
-        ic2eq = 2.0 * v2 - ic2eq;
-        
-        // Output Mix: HP*m0 + BP*m1 + LP*m2
-        // v0 - k*v1 - v2 = HP, v1 = BP, v2 = LP
-        double output = m0 * v0 + m1 * v1 + m2 * v2;
-        
-        // Anti-Denormal Protection
-        if (std::abs(ic1eq) < 1e-15) ic1eq = 0.0;
-        if (std::abs(ic2eq) < 1e-15) ic2eq = 0.0;
-        
-        return static_cast<float>(output);
+        const auto output = static_cast<SampleType>(tick(coeffs, input));
+        flushDenormals();
+        return output;
     }
 
     /**
      * Block-Processing für Effizienz.
      */
-    void processBlock(float* data, int numSamples) noexcept
+    template <typename SampleType>
+    void processBlock(SampleType* data, int numSamples) noexcept
     {
         for (int i = 0; i < numSamples; ++i)
         {
@@ -131,134 +175,116 @@ public:
         }
     }
 
+    /**
+     * Wie processBlock, aber Denormal-Schutz nur einmal am Blockende
+     * (Detektor-Pfad des Dynamic EQ).
+     */
+    template <typename SampleType>
+    void processBlockFast(SampleType* data, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = static_cast<SampleType>(tick(coeffs, data[i]));
+
+        flushDenormals();
+    }
+
     /**
      * Berechnet die Magnitude-Antwort für eine gegebene Frequenz (in dB).
      * Verwendet die analytische Übertragungsfunktion des SVF.
      */
     float getMagnitudeForFrequency(float frequency) const noexcept
     {
-        const double omega = 2.0 * juce::MathConstants<double>::pi * frequency / sampleRate;
-        const double cosw = std::cos(omega);
-        const double sinw = std::sin(omega);
+        // TPT-SVF = bilineare Transformation des Analog-Prototyps:
+        // H(s) = m0 + (m1*s + m2) / (s² + k*s + 1),  s = j*tan(omega/2)/g
+        // g und k lassen sich aus a1 = 1/(1 + g*(g + k)) und a2 = g*a1 zurückrechnen
+        const double g = coeffs.a2 / juce::jmax(coeffs.a1, 1e-12);
+        const double k = (1.0 / juce::jmax(coeffs.a1, 1e-12) - 1.0 - g * g) / juce::jmax(g, 1e-12);
+        const double omega = juce::MathConstants<double>::pi * frequency / sampleRate;
+        const double w = std::tan(juce::jmin(omega, 0.4999 * juce::MathConstants<double>::pi)) / juce::jmax(g, 1e-12);
 
-        // Berechne g und k aus den gespeicherten Koeffizienten
-        // Direkte Z-Domain Analyse des SVF
-        // Nutze die gespeicherten Mix-Koeffizienten m0, m1, m2
-        // H(z) = m0*HP(z) + m1*BP(z) + m2*LP(z) wobei HP+BP+LP = Input
-        
-        // Für die Magnitude-Berechnung verwenden wir die Biquad-äquivalente
-        // Übertragungsfunktion, da SVF und Biquad identische Frequenzgänge haben
-        // Dies ist eine Approximation, die für Anzeigequalität ausreichend ist
-        
-        // Vereinfachte Berechnung über die SVF Koeffizienten
-        double g2 = a3 / (a1 > 1e-10 ? a1 : 1e-10);  // g² = a3/a1 (aus SVF-Struktur)
-        double g = std::sqrt(std::abs(g2));
-        
-        // Analog-Prototyp Frequenz-Antwort evaluieren
-        double s = sinw / (1.0 + cosw);  // tan(omega/2) ≈ Bilinear-Analogie
-        double s2 = s * s;
-        
-        double k_val = a2 / (a1 > 1e-10 ? a1 : 1e-10) / g;  // k = a2/(a1*g)
-        
-        // LP = g²/(1 + k*g*s + g²*s²)  (vereinfacht)
-        // BP = g*s/(...)
-        // HP = s²/(...)
-        double denomReal = 1.0 - g2 * s2;
-        double denomImag = k_val * g * s;
-        double denomMag2 = denomReal * denomReal + denomImag * denomImag;
+        const std::complex<double> sj(0.0, w);
+        const auto h = coeffs.m0 + (coeffs.m1 * sj + coeffs.m2) / (sj * sj + k * sj + 1.0);
+
+        return static_cast<float>(20.0 * std::log10(std::max(std::abs(h), 1e-10)));
+    }
+
+private:
+    // Zustände und Rechnung in double; float- und double-Blöcke teilen denselben Kern
+    double tick(const Coefficients& c, double v0) noexcept
+    {
         
-        if (denomMag2 < 1e-20) denomMag2 = 1e-20;
+        // TPT SVF Tick (zero-delay feedback)
+        double v3 = v0 - ic2eq;
+        double v1 = c.a1 * ic1eq + c.a2 * v3;
+        double v2 = ic2eq + c.a2 * ic1eq + c.a3 * v3;
         
-        // Numerator basierend auf Mix-Koeffizienten
-        double numReal = m0 * s2 + m2 * g2 - m0 * g2 * s2;
-        double numImag = m1 * g * s;
-        double numMag2 = numReal * numReal + numImag * numImag;
+        // State Update
+        ic1eq = 2.0 * v1 - ic1eq;
+        ic2eq = 2.0 * v2 - ic2eq;
         
-        double magnitude = std::sqrt(numMag2 / denomMag2);
-        return static_cast<float>(20.0 * std::log10(std::max(magnitude, 1e-10)));
+        // Output Mix: HP*m0 + BP*m1 + LP*m2
+        // v0 - k*v1 - v2 = HP, v1 = BP, v2 = LP
+        return c.m0 * v0 + c.m1 * v1 + c.m2 * v2;
     }
 
-private:
-    void computeMixCoefficients(ParameterIDs::FilterType type, float gainDB, float Q, double g, double k)
+    // Anti-Denormal Protection
+    void flushDenormals() noexcept
     {
+        if (std::abs(ic1eq) < 1e-15) ic1eq = 0.0;
+        if (std::abs(ic2eq) < 1e-15) ic2eq = 0.0;
+    }
+
+    static void computeMixCoefficients(Coefficients& c, ParameterIDs::FilterType type, float gainDB, float Q,
+                                       double g, double k)
+    {
+        double& a1 = c.a1;
+        double& a2 = c.a2;
+        double& a3 = c.a3;
+        double& m0 = c.m0;
+        double& m1 = c.m1;
+        double& m2 = c.m2;
+
         switch (type)
         {
             case ParameterIDs::FilterType::Bell:
             {
+                // Boost und Cut mit derselben Formel: Mitten-Gain = 1 + m1/kBell = A²
                 double A = std::pow(10.0, static_cast<double>(gainDB) / 40.0);
-                double kBoost = 1.0 / (static_cast<double>(Q) * A);
-                double kCut = 1.0 / (static_cast<double>(Q) / A);
+                double kBell = 1.0 / (static_cast<double>(Q) * A);
                 
-                if (gainDB >= 0.0f)
-                {
-                    a1 = 1.0 / (1.0 + g * kBoost + g * g);
-                    a2 = g * a1;
-                    a3 = g * a2;
-                    m0 = 1.0;
-                    m1 = kBoost * (A * A - 1.0);
-                    m2 = 0.0;
-                }
-                else
-                {
-                    a1 = 1.0 / (1.0 + g * kCut + g * g);
-                    a2 = g * a1;
-                    a3 = g * a2;
-                    m0 = 1.0;
-                    m1 = kCut * (1.0 / (A * A) - 1.0);
-                    m2 = 0.0;
-                }
+                a1 = 1.0 / (1.0 + g * kBell + g * g);
+                a2 = g * a1;
+                a3 = g * a2;
+                m0 = 1.0;
+                m1 = kBell * (A * A - 1.0);
+                m2 = 0.0;
                 break;
             }
             
             case ParameterIDs::FilterType::LowShelf:
             {
+                // Eckfrequenz um sqrt(A) verschoben → halber Gain bei fc (wie RBJ), Boost und Cut
                 double A = std::pow(10.0, static_cast<double>(gainDB) / 40.0);
-                if (gainDB >= 0.0f)
-                {
-                    a1 = 1.0 / (1.0 + g * k + g * g);
-                    a2 = g * a1;
-                    a3 = g * a2;
-                    m0 = 1.0;
-                    m1 = k * (A - 1.0);
-                    m2 = A * A - 1.0;
-                }
-                else
-                {
-                    double invA = 1.0 / A;
-                    double gA = g * std::sqrt(A);
-                    a1 = 1.0 / (1.0 + gA * k + gA * gA);
-                    a2 = gA * a1;
-                    a3 = gA * a2;
-                    m0 = 1.0;
-                    m1 = k * (invA - 1.0);
-                    m2 = (1.0 / (A * A)) - 1.0;
-                }
+                double gA = g / std::sqrt(A);
+                a1 = 1.0 / (1.0 + gA * k + gA * gA);
+                a2 = gA * a1;
+                a3 = gA * a2;
+                m0 = 1.0;
+                m1 = k * (A - 1.0);
+                m2 = A * A - 1.0;
                 break;
             }
             
             case ParameterIDs::FilterType::HighShelf:
             {
                 double A = std::pow(10.0, static_cast<double>(gainDB) / 40.0);
-                if (gainDB >= 0.0f)
-                {
-                    a1 = 1.0 / (1.0 + g * k + g * g);
-                    a2 = g * a1;
-                    a3 = g * a2;
-                    m0 = A * A;
-                    m1 = k * (1.0 - A) * A;
-                    m2 = 1.0 - A * A;
-                }
-                else
-                {
-                    double invA = 1.0 / A;
-                    double gIA = g * std::sqrt(invA);
-                    a1 = 1.0 / (1.0 + gIA * k + gIA * gIA);
-                    a2 = gIA * a1;
-                    a3 = gIA * a2;
-                    m0 = 1.0 / (A * A);
-                    m1 = k * (A - 1.0) / A;
-                    m2 = A * A - 1.0;
-                }
+                double gA = g * std::sqrt(A);
+                a1 = 1.0 / (1.0 + gA * k + gA * gA);
+                a2 = gA * a1;
+                a3 = gA * a2;
+                m0 = A * A;
+                m1 = k * (1.0 - A) * A;
+                m2 = 1.0 - A * A;
                 break;
             }
             
@@ -323,12 +349,8 @@ private:
     float currentFrequency = 1000.0f;
     double cachedG = 0.0;  // tan(pi * fc / fs) — gecacht für updateGainOnly()
     
-    // SVF Koeffizienten
-    double a1 = 1.0, a2 = 0.0, a3 = 0.0;
-    
-    // Output-Mix-Koeffizienten: Output = m0*v0 + m1*v1 + m2*v2
-    // (HP, BP, LP Anteile)
-    double m0 = 1.0, m1 = 0.0, m2 = 0.0;
+    // SVF Koeffizienten; Output = m0*v0 + m1*v1 + m2*v2 (HP, BP, LP Anteile)
+    Coefficients coeffs;
     
     // State Variables (Integrator-Zustände)
     double ic1eq = 0.0;  // 1st Integrator state
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+/**
+ * SeqLockSnapshot: Veröffentlicht eine trivially-copyable Struktur für beliebig
+ * viele Leser-Threads (Seqlock).
+ *
+ * - Schreiber blockieren nie: tryPublish() gibt false zurück, wenn gerade ein
+ *   anderer Schreiber aktiv ist (der Aufrufer versucht es beim nächsten Mal)
+ * - Leser bekommen immer einen konsistenten Stand; kollidiert ein Lesevorgang mit
+ *   einem Schreibvorgang, wird er wiederholt (nur für Nicht-Echtzeit-Leser)
+ * - Die Daten liegen als std::atomic<uint64_t>-Wörter vor (relaxed), dadurch gibt
+ *   es keinen Data-Race im Sinne des C++-Speichermodells
+ */
+template <typename T>
+class SeqLockSnapshot
+{
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "Snapshot muss trivially copyable sein");
+
+    SeqLockSnapshot()
+    {
+        storeWords(staging);
+    }
+
+    /**
+     * Schreiber: fill(T&) füllt den Staging-Stand, danach wird er veröffentlicht.
+     * @return false wenn ein anderer Schreiber aktiv war (nichts veröffentlicht)
+     */
+    template <typename FillFn>
+    bool tryPublish(FillFn&& fill)
+    {
+        uint32_t seq = sequence.load(std::memory_order_relaxed);
+        if ((seq & 1u) != 0u
+            || !sequence.compare_exchange_strong(seq, seq + 1u, std::memory_order_acquire,
+                                                 std::memory_order_relaxed))
+            return false;
+
+        std::atomic_thread_fence(std::memory_order_release);
+
+        fill(staging);
+        storeWords(staging);
+
+        sequence.store(seq + 2u, std::memory_order_release);
+        return true;
+    }
+
+    /** Leser: konsistente Kopie des zuletzt veröffentlichten Stands. */
+    void read(T& dest) const
+    {
+        auto* bytes = reinterpret_cast<unsigned char*>(&dest);
+
+        for (;;)
+        {
+            const uint32_t before = sequence.load(std::memory_order_acquire);
+
+            if ((before & 1u) == 0u)
+            {
+                for (size_t i = 0; i < NUM_WORDS; ++i)
+                {
+                    const uint64_t word = words[i].load(std::memory_order_relaxed);
+                    std::memcpy(bytes + i * sizeof(uint64_t), &word, bytesInWord(i));
+                }
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (sequence.load(std::memory_order_relaxed) == before)
+                    return;
+            }
+
+            std::this_thread::yield();
+        }
+    }
+
+    /** Ändert sich mit jeder Veröffentlichung (Leser können unveränderte Stände überspringen). */
+    uint32_t getSequence() const { return sequence.load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t NUM_WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    static constexpr size_t bytesInWord(size_t wordIndex)
+    {
+        return wordIndex + 1 < NUM_WORDS ? sizeof(uint64_t) : sizeof(T) - wordIndex * sizeof(uint64_t);
+    }
+
+    void storeWords(const T& source)
+    {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&source);
+
+        for (size_t i = 0; i < NUM_WORDS; ++i)
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, bytes + i * sizeof(uint64_t), bytesInWord(i));
+            words[i].store(word, std::memory_order_relaxed);
+        }
+    }
+
+    std::array<std::atomic<uint64_t>, NUM_WORDS> words {};
+    std::atomic<uint32_t> sequence { 0 };
+    T staging {};  // nur der aktive Schreiber
+
+    JUCE_DECLARE_NON_COPYABLE(SeqLockSnapshot)
+};
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "FFTAnalyzer.h"
+#include "SmartAnalyzer.h"
+#include "LiveSmartEQ.h"
+
+/**
+ * SmartAnalysisWorker: Führt SmartAnalyzer- und LiveSmartEQ-Entscheidungen
+ * außerhalb des Audio-Threads aus.
+ *
+ * - Audio-Thread: kopiert nur neue (versionierte) Frames des Post-Analyzers in einen
+ *   lock-freien SPSC-Ring (juce::AbstractFifo, vorallokiert, kein Heap)
+ * - Worker (Low-Priority-Thread): leert den Ring, analysiert den neuesten Frame
+ *   und führt die LiveSmartEQ-Logik aus
+ * - Ergebnisse gehen über den Double-Buffer-Snapshot im SmartAnalyzer an die GUI,
+ *   über die BandModulation direkt an den Audio-Thread und über die Pending-Queue
+ *   im LiveSmartEQ (APVTS-Sync) an den Message-Thread
+ * - Ist der Ring voll, wird der Frame verworfen; Block-Zähler und Transient-Flag
+ *   laufen in den nächsten Frame weiter, damit das Timing stimmt
+ */
+class SmartAnalysisWorker : private juce::Thread
+{
+public:
+    SmartAnalysisWorker(SmartAnalyzer& analyzer, LiveSmartEQ& liveEQ,
+                        juce::AudioProcessorValueTreeState& state)
+        : juce::Thread("Aura Smart Analysis"),
+          smartAnalyzer(analyzer),
+          liveSmartEQ(liveEQ),
+          apvts(state)
+    {
+        frames.resize(static_cast<size_t>(RING_SIZE));
+        latestMagnitudes.reserve(static_cast<size_t>(FFTAnalyzer::MAX_NUM_BINS));
+    }
+
+    ~SmartAnalysisWorker() override
+    {
+        stop();
+    }
+
+    // Wird im Worker vor jeder LiveSmartEQ-Verarbeitung aufgerufen
+    // (Settings aus den APVTS-Parametern übernehmen)
+    std::function<void()> onUpdateLiveSettings;
+
+    void start()
+    {
+        fifo.reset();
+        pendingBlocks = 0;
+        pendingSamples = 0;
+        pendingTransient = false;
+        lastFrameVersion = 0;
+        liveEqWasActive = false;
+
+        if (!isThreadRunning())
+            startThread(juce::Thread::Priority::low);
+    }
+
+    void stop()
+    {
+        stopThread(2000);
+    }
+
+    //==========================================================================
+    // Audio-Thread: einmal pro Block nach postAnalyzer.pushBuffer() aufrufen
+    //==========================================================================
+    void pushBlock(FFTAnalyzer& postAnalyzer, int numSamples,
+                   bool smartModeEnabled, bool liveEqEnabled, bool isTransient)
+    {
+        ++pendingBlocks;
+        pendingSamples += numSamples;
+        pendingTransient = pendingTransient || isTransient;
+
+        // Neuer Frame? (kann vom Audio-Thread oder vom Analyzer-Worker stammen)
+        const uint32_t version = postAnalyzer.getFrameVersion();
+        if (version == lastFrameVersion)
+            return;
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+        if (size1 + size2 == 0)
+            return;  // Worker hängt hinterher → Frame verwerfen, Zähler behalten
+
+        auto& frame = frames[static_cast<size_t>(size1 > 0 ? start1 : start2)];
+        const auto info = postAnalyzer.readLatestFrame(frame.magnitudes.data(), FFTAnalyzer::MAX_NUM_BINS);
+
+        lastFrameVersion = info.version;
+        frame.numBins = info.numBins;
+        frame.fftSize = info.fftSize;
+        frame.sampleRate = postAnalyzer.getSampleRate();
+        frame.numBlocks = pendingBlocks;
+        frame.numSamples = pendingSamples;
+        frame.isTransient = pendingTransient;
+        frame.smartModeEnabled = smartModeEnabled;
+        frame.liveEqEnabled = liveEqEnabled;
+
+        fifo.finishedWrite(1);
+
+        pendingBlocks = 0;
+        pendingSamples = 0;
+        pendingTransient = false;
+    }
+
+    //==========================================================================
+    // Offline-Rendering: Ring synchron leeren, damit jeder Frame analysiert wird
+    //==========================================================================
+    void processPendingFrames()
+    {
+        const juce::ScopedLock sl(processLock);
+
+        // Reset aus dem Message-Thread: Band-Zustand des LiveSmartEQ hier leeren
+        liveSmartEQ.applyPendingStateReset();
+
+        const int numReady = fifo.getNumReady();
+        if (numReady == 0)
+            return;
+
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(numReady, start1, size1, start2, size2);
+
+        // Ältere Frames nur für Timing/Transienten zusammenfassen, den neuesten analysieren
+        int numBlocks = 0;
+        int numSamples = 0;
+        bool isTransient = false;
+
+        auto accumulate = [&](int start, int size)
+        {
+            for (int i = start; i < start + size; ++i)
+            {
+                const auto& frame = frames[static_cast<size_t>(i)];
+                numBlocks += frame.numBlocks;
+                numSamples += frame.numSamples;
+                isTransient = isTransient || frame.isTransient;
+            }
+        };
+
+        accumulate(start1, size1);
+        accumulate(start2, size2);
+
+        const auto& latest = frames[static_cast<size_t>(size2 > 0 ? start2 + size2 - 1
+                                                                  : start1 + size1 - 1)];
+
+        // resize() bleibt innerhalb der reservierten Kapazität → keine Allokation
+        latestMagnitudes.resize(static_cast<size_t>(latest.numBins));
+        std::copy(latest.magnitudes.begin(), latest.magnitudes.begin() + latest.numBins,
+                  latestMagnitudes.begin());
+
+        const int fftSize = latest.fftSize;
+        const double sampleRate = latest.sampleRate;
+        const bool smartModeEnabled = latest.smartModeEnabled;
+        const bool liveEqEnabled = latest.liveEqEnabled;
+
+        fifo.finishedRead(numReady);
+
+        smartAnalyzer.setEnabled(smartModeEnabled);
+        smartAnalyzer.analyzeSpectrum(latestMagnitudes, fftSize, sampleRate, numSamples);
+
+        // Live SmartEQ verarbeiten (NUR wenn Smart Mode UND Live EQ aktiviert sind)
+        if (smartModeEnabled && liveEqEnabled)
+        {
+            liveEqWasActive = true;
+
+            if (onUpdateLiveSettings)
+                onUpdateLiveSettings();
+
+            liveSmartEQ.processFrame(smartAnalyzer, apvts, isTransient, &latestMagnitudes, numBlocks);
+        }
+        else if (liveEqWasActive)
+        {
+            // War aktiv, jetzt nicht mehr - Reset asynchron im Message-Thread
+            liveEqWasActive = false;
+            liveSmartEQ.setEnabled(false);
+            liveSmartEQ.requestReset();
+        }
+    }
+
+private:
+    static constexpr int RING_SIZE = 4;          // AbstractFifo nutzt RING_SIZE - 1 Slots
+    static constexpr int POLL_INTERVAL_MS = 10;
+
+    struct SpectrumFrame
+    {
+        std::array<float, FFTAnalyzer::MAX_NUM_BINS> magnitudes {};
+        int numBins = 0;
+        int fftSize = 2048;
+        double sampleRate = 44100.0;
+        int numBlocks = 0;
+        int numSamples = 0;
+        bool isTransient = false;
+        bool smartModeEnabled = false;
+        bool liveEqEnabled = false;
+    };
+
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            processPendingFrames();
+            wait(POLL_INTERVAL_MS);
+        }
+    }
+
+    SmartAnalyzer& smartAnalyzer;
+    LiveSmartEQ& liveSmartEQ;
+    juce::AudioProcessorValueTreeState& apvts;
+
+    // Lock-freier SPSC-Ring (Audio-Thread → Worker)
+    juce::AbstractFifo fifo { RING_SIZE };
+    std::vector<SpectrumFrame> frames;
+
+    // Nur Audio-Thread: Zähler seit dem letzten veröffentlichten Frame
+    int pendingBlocks = 0;
+    int pendingSamples = 0;
+    bool pendingTransient = false;
+    uint32_t lastFrameVersion = 0;
+
+    // Nur Worker (bzw. Offline-Aufruf unter processLock)
+    juce::CriticalSection processLock;
+    std::vector<float> latestMagnitudes;
+    bool liveEqWasActive = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SmartAnalysisWorker)
+};
@@ -32,35 +32,92 @@ void SmartAnalyzer::reset()
     standardDeviation = 10.0f;
     std::fill(bandAverages.begin(), bandAverages.end(), -60.0f);
     samplesSinceLastAnalysis = 0;
+    
+    // Leeren Snapshot veröffentlichen, damit GUI keine alten Probleme zeigt
+    publishSnapshot();
 }
 
 void SmartAnalyzer::analyze(const FFTAnalyzer& fftAnalyzer)
+{
+    // Direkter Aufruf (ohne Worker): ein Aufruf pro Block ≈ ein FFT-Frame
+    analyzeSpectrum(fftAnalyzer.getMagnitudes(), fftAnalyzer.getCurrentFFTSize(),
+                    fftAnalyzer.getSampleRate(), fftAnalyzer.getCurrentFFTSize());
+}
+
+void SmartAnalyzer::analyzeSpectrum(const std::vector<float>& magnitudes, int newFFTSize,
+                                    double newSampleRate, int samplesElapsed)
 {
     if (!analysisEnabled)
         return;
     
-    // RT-safe Rate-Limiting: Sample-Counter statt juce::Time (keine Systemcalls im Audio-Thread)
-    samplesSinceLastAnalysis += fftAnalyzer.getCurrentFFTSize();  // Approximation pro Aufruf
-    int samplesNeeded = static_cast<int>((settings.analysisIntervalMs / 1000.0) * sampleRate);
+    // Rate-Limiting über die tatsächlich vergangenen Audio-Samples
+    samplesSinceLastAnalysis += samplesElapsed;
+    int samplesNeeded = static_cast<int>((settings.analysisIntervalMs / 1000.0) * newSampleRate);
     if (samplesSinceLastAnalysis < samplesNeeded)
         return;
     samplesSinceLastAnalysis = 0;
     
-    // FFT-Daten holen
-    const auto& magnitudes = fftAnalyzer.getMagnitudes();
-    
     // Wenn keine FFT-Daten, abbrechen
     if (magnitudes.empty())
         return;
     
     // FFT-Parameter aktualisieren
-    fftSize = fftAnalyzer.getCurrentFFTSize();
-    numBins = fftAnalyzer.getCurrentNumBins();
-    sampleRate = fftAnalyzer.getSampleRate();
+    fftSize = newFFTSize;
+    numBins = juce::jmin(newFFTSize / 2 + 1, static_cast<int>(magnitudes.size()));
+    sampleRate = newSampleRate;
     
     if (sampleRate <= 0.0 || numBins <= 0)
         return;
     
+    runDetection(magnitudes);
+    publishSnapshot();
+}
+
+SmartAnalyzer::ResultSnapshot SmartAnalyzer::getResultSnapshot() const
+{
+    ResultSnapshot result;
+    
+    for (;;)
+    {
+        const int index = publishedSnapshot.load(std::memory_order_acquire);
+        const auto& sequence = snapshotSequence[static_cast<size_t>(index)];
+        
+        const uint32_t before = sequence.load(std::memory_order_acquire);
+        if ((before & 1u) != 0)
+            continue;  // Slot wird gerade beschrieben
+        
+        result = snapshots[static_cast<size_t>(index)];
+        
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before)
+            return result;
+    }
+}
+
+void SmartAnalyzer::publishSnapshot()
+{
+    const int index = 1 - publishedSnapshot.load(std::memory_order_relaxed);
+    auto& slot = snapshots[static_cast<size_t>(index)];
+    auto& sequence = snapshotSequence[static_cast<size_t>(index)];
+    
+    const uint32_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    std::copy(detectedProblemsArray.begin(), detectedProblemsArray.begin() + detectedProblemsCount,
+              slot.problems.begin());
+    slot.problemCount = detectedProblemsCount;
+    slot.averageMagnitude = averageMagnitude;
+    slot.standardDeviation = standardDeviation;
+    slot.version = snapshotVersion.load(std::memory_order_relaxed) + 1;
+    
+    sequence.store(seq + 2, std::memory_order_release);
+    publishedSnapshot.store(index, std::memory_order_release);
+    snapshotVersion.store(slot.version, std::memory_order_release);
+}
+
+void SmartAnalyzer::runDetection(const std::vector<float>& magnitudes)
+{
     // OPTIMIERUNG: Vorherige Probleme speichern fÃ¼r Smoothing (Fixed-Size Array Kopie)
     previousProblemsCount = detectedProblemsCount;
     for (int i = 0; i < previousProblemsCount; ++i)
@@ -791,31 +848,6 @@ void SmartAnalyzer::setSensitivity(float globalSensitivity)
     settings.rumbleSensitivity = 0.5f * factor;
 }
 
-std::vector<SmartAnalyzer::FrequencyProblem> SmartAnalyzer::getProblemsInRange(float minFreq, float maxFreq) const
-{
-    // OPTIMIERUNG: Verwendet jetzt Fixed-Size Array
-    std::vector<FrequencyProblem> result;
-    result.reserve(detectedProblemsCount);
-    
-    for (int i = 0; i < detectedProblemsCount; ++i)
-    {
-        const auto& problem = detectedProblemsArray[i];
-        if (problem.frequency >= minFreq && problem.frequency <= maxFreq)
-            result.push_back(problem);
-    }
-    
-    return result;
-}
-
-const SmartAnalyzer::FrequencyProblem* SmartAnalyzer::getMostSevereProblem() const
-{
-    // OPTIMIERUNG: Verwendet jetzt Fixed-Size Array
-    if (detectedProblemsCount == 0)
-        return nullptr;
-    
-    return &detectedProblemsArray[0];  // Bereits nach Schweregrad sortiert
-}
-
 int SmartAnalyzer::frequencyToBin(float frequency) const
 {
     if (sampleRate <= 0.0)
@@ -840,8 +872,9 @@ float SmartAnalyzer::binToFrequency(int bin) const
 void SmartAnalyzer::analyzeWithSpectralFeatures(const std::vector<float>& magnitudes)
 {
     // Spektralanalyse durchfÃ¼hren
+    // prepare() baut die Filterbänke nur bei geänderter Rate/FFT-Größe neu auf
     spectralAnalysis.prepare(sampleRate, fftSize);
-    cachedMetrics = spectralAnalysis.analyze(magnitudes);
+    spectralAnalysis.analyze(magnitudes.data(), numBins, cachedMetrics);
     
     // Timbrale Eigenschaften für erweiterte Erkennung nutzen
     // Hohe Helligkeit + niedrige Wärme = potentiell harsch
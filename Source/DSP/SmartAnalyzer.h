@@ -191,31 +191,47 @@ public:
     void prepare(double sampleRate);
     void reset();
     
+    //==========================================================================
+    // Ergebnis-Snapshot (vom Analyse-Thread veröffentlicht, von GUI/Audio gelesen)
+    //==========================================================================
+    struct ResultSnapshot
+    {
+        std::array<FrequencyProblem, maxDetectedProblems> problems {};
+        int problemCount = 0;
+        float averageMagnitude = -60.0f;
+        float standardDeviation = 10.0f;
+        uint32_t version = 0;           // Zählt jede veröffentlichte Analyse hoch
+    };
+    
     //==========================================================================
     // Analyse durchführen
     //==========================================================================
     void analyze(const FFTAnalyzer& fftAnalyzer);
     
+    // Analyse auf einem kopierten Spektrum-Frame (SmartAnalysisWorker).
+    // samplesElapsed = Audio-Samples seit dem letzten Frame (für das Analyse-Intervall)
+    void analyzeSpectrum(const std::vector<float>& magnitudes, int newFFTSize,
+                         double newSampleRate, int samplesElapsed);
+    
+    // Letzten veröffentlichten Snapshot kopieren (lock-free, aus jedem Thread)
+    ResultSnapshot getResultSnapshot() const;
+    uint32_t getResultVersion() const { return snapshotVersion.load(std::memory_order_acquire); }
+    
     //==========================================================================
     // Ergebnisse abrufen
     // OPTIMIERUNG: Gebe const-Referenz auf Array zurück statt vector-Kopie
     //==========================================================================
+    // HINWEIS: Arbeits-Arrays - nur im Analyse-Thread lesen (LiveSmartEQ im Worker)
     const std::array<FrequencyProblem, maxDetectedProblems>& getDetectedProblemsArray() const { return detectedProblemsArray; }
     int getDetectedProblemsCount() const { return detectedProblemsCount; }
     
     // Kompatibilitätsfunktion - erstellt temporären Vector (nicht im Audio-Thread verwenden!)
+    // Liest den veröffentlichten Snapshot → sicher aus dem Message-Thread
     std::vector<FrequencyProblem> getDetectedProblems() const {
-        return std::vector<FrequencyProblem>(detectedProblemsArray.begin(), 
-                                              detectedProblemsArray.begin() + detectedProblemsCount);
+        const auto snapshot = getResultSnapshot();
+        return std::vector<FrequencyProblem>(snapshot.problems.begin(), 
+                                              snapshot.problems.begin() + snapshot.problemCount);
     }
-    bool hasProblems() const { return detectedProblemsCount > 0; }
-    int getProblemCount() const { return detectedProblemsCount; }
-    
-    // Probleme in einem Frequenzbereich finden
-    std::vector<FrequencyProblem> getProblemsInRange(float minFreq, float maxFreq) const;
-    
-    // Schwerstes Problem finden
-    const FrequencyProblem* getMostSevereProblem() const;
     
     //==========================================================================
     // Einstellungen
@@ -255,6 +271,8 @@ private:
     
     void consolidateProblems();
     void smoothDetections();
+    void runDetection(const std::vector<float>& magnitudes);
+    void publishSnapshot();
     
     // OPTIMIERUNG: Hilfsfunktion zum sicheren Hinzufügen von Problemen (RT-safe)
     inline void addProblem(const FrequencyProblem& problem)
@@ -313,6 +331,14 @@ private:
     // Timing (RT-safe: Sample-Counter statt Systemzeit)
     int samplesSinceLastAnalysis = 0;
     
+    // Double-Buffer für Ergebnisse: Writer (Analyse-Thread) schreibt den inaktiven
+    // Slot, Leser kopieren den aktiven. Pro Slot eine Sequenz (Seqlock) → ein Leser,
+    // der während zwei Veröffentlichungen hängt, erkennt den Überschreiber und liest neu.
+    std::array<ResultSnapshot, 2> snapshots;
+    std::array<std::atomic<uint32_t>, 2> snapshotSequence { { 0, 0 } };
+    std::atomic<int> publishedSnapshot { 0 };
+    std::atomic<uint32_t> snapshotVersion { 0 };
+    
     //==========================================================================
     // Erweiterte DSP-Module
     //==========================================================================
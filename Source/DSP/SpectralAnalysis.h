@@ -1,13 +1,14 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include <vector>
 #include <cmath>
 #include <numeric>
 
 /**
  * SpectralAnalysis: Fortgeschrittene Spektralanalyse mit Timbral Descriptors
- * 
+ *
  * Features:
  * - Mel-Frequency Cepstral Coefficients (MFCC)
  * - Spectral Centroid (Helligkeitsmaß)
@@ -17,10 +18,25 @@
  * - Spectral Crest Factor (Peak-to-Average Ratio)
  * - Spectral Flux (Zeitliche Veränderung)
  * - Zero Crossing Rate
+ *
+ * Filterbänke:
+ * - Mel/Bark werden nur bei geänderter (sampleRate, fftSize) neu aufgebaut
+ * - Sparse: pro Band nur der Bin-Bereich mit Gewichten != 0
+ * - Alle Buffer sind für die maximale FFT-Größe vorreserviert → analyze()
+ *   und ein Neuaufbau allozieren nicht
  */
 class SpectralAnalysis
 {
 public:
+    //==========================================================================
+    // Größen der festen Ergebnis-Buffer
+    //==========================================================================
+    static constexpr int numMelBands = 26;
+    static constexpr int numBarkBands = 24;   // Kritische Bänder
+    static constexpr int numMFCC = 13;
+    static constexpr int maxFFTSize = 8192;
+    static constexpr int maxNumBins = maxFFTSize / 2 + 1;
+    
     //==========================================================================
     // Spektrale Metriken Struktur
     //==========================================================================
@@ -41,14 +57,14 @@ public:
         float tonality = 0.0f;          // Tonalität vs. Rauschen (0-1)
         float dynamicRange = 0.0f;      // Dynamischer Bereich (dB)
         
-        // MFCC Koeffizienten (typisch 13)
-        std::vector<float> mfcc;
+        // MFCC Koeffizienten
+        std::array<float, numMFCC> mfcc {};
         
-        // Mel-Band Energien (typisch 26-40 Bänder)
-        std::vector<float> melBands;
+        // Mel-Band Energien
+        std::array<float, numMelBands> melBands {};
         
         // Bark-Band Energien (24 kritische Bänder)
-        std::vector<float> barkBands;
+        std::array<float, numBarkBands> barkBands {};
     };
     
     //==========================================================================
@@ -56,77 +72,151 @@ public:
     //==========================================================================
     SpectralAnalysis()
     {
-        initializeMelFilterbank();
-        initializeBarkFilterbank();
+        linearMagnitudes.reserve(static_cast<size_t>(maxNumBins));
+        previousMagnitudes.reserve(static_cast<size_t>(maxNumBins));
+        
+        // Jeder Bin liegt in höchstens zwei Mel-Dreiecken
+        melWeights.reserve(static_cast<size_t>(2 * maxNumBins));
+        
+        // DCT-II Tabelle für MFCC (hängt nicht von sampleRate/fftSize ab)
+        for (int i = 0; i < numMFCC; ++i)
+            for (int j = 0; j < numMelBands; ++j)
+                dctTable[static_cast<size_t>(i * numMelBands + j)] = std::cos(
+                    juce::MathConstants<float>::pi * static_cast<float>(i) *
+                    (static_cast<float>(j) + 0.5f) / static_cast<float>(numMelBands));
+        
+        rebuildFilterbanks();
     }
     
+    // Baut die Filterbänke nur bei geänderter Konfiguration neu auf
     void prepare(double newSampleRate, int newFftSize = 2048)
     {
+        newFftSize = juce::jlimit(2, maxFFTSize, newFftSize);
+        
+        if (newSampleRate == sampleRate && newFftSize == fftSize)
+            return;
+        
         sampleRate = newSampleRate;
         fftSize = newFftSize;
         numBins = fftSize / 2 + 1;
         
-        previousMagnitudes.resize(static_cast<size_t>(numBins), 0.0f);
+        // Flux-Historie passt nicht mehr zur neuen Bin-Anzahl
+        previousMagnitudes.clear();
         
-        initializeMelFilterbank();
-        initializeBarkFilterbank();
+        rebuildFilterbanks();
     }
     
     //==========================================================================
-    // Hauptanalyse
+    // Hauptanalyse: Eingang in dB, Ergebnis in den Buffer des Aufrufers
     //==========================================================================
-    SpectralMetrics analyze(const std::vector<float>& magnitudes)
+    void analyze(const float* dbMagnitudes, int numMagnitudes, SpectralMetrics& metrics)
     {
-        SpectralMetrics metrics;
+        metrics = SpectralMetrics();
         
-        if (magnitudes.empty() || magnitudes.size() < 2)
-            return metrics;
+        const int n = juce::jmin(numMagnitudes, numBins);
+        if (dbMagnitudes == nullptr || n < 2)
+            return;
         
-        // Konvertiere zu linearer Energie wenn nötig (Eingang ist dB)
-        std::vector<float> linearMags(magnitudes.size());
-        for (size_t i = 0; i < magnitudes.size(); ++i)
+        // Konvertiere zu linearer Energie (Eingang ist dB); Kapazität ist vorreserviert
+        linearMagnitudes.resize(static_cast<size_t>(n));
+        for (int i = 0; i < n; ++i)
         {
             // dB zu linear: 10^(dB/20)
-            linearMags[i] = std::pow(10.0f, magnitudes[i] / 20.0f);
+            linearMagnitudes[static_cast<size_t>(i)] = std::pow(10.0f, dbMagnitudes[i] / 20.0f);
         }
         
+        const float* mags = linearMagnitudes.data();
+        
         // Spektrale Metriken berechnen
-        metrics.centroid = calculateCentroid(linearMags);
-        metrics.spread = calculateSpread(linearMags, metrics.centroid);
-        metrics.flatness = calculateFlatness(linearMags);
-        metrics.rolloff = calculateRolloff(linearMags, 0.85f);
-        metrics.crestFactor = calculateCrestFactor(linearMags);
-        metrics.flux = calculateFlux(linearMags);
+        metrics.centroid = calculateCentroid(mags, n);
+        metrics.spread = calculateSpread(mags, n, metrics.centroid);
+        metrics.flatness = calculateFlatness(mags, n);
+        metrics.rolloff = calculateRolloff(mags, n, 0.85f);
+        metrics.crestFactor = calculateCrestFactor(mags, n);
+        metrics.flux = calculateFlux(mags, n);
         
         // Frequenzband-Energie-Verhältnisse
-        metrics.brightness = calculateBandRatio(linearMags, 4000.0f, 20000.0f);
-        metrics.warmth = calculateBandRatio(linearMags, 100.0f, 500.0f);
-        metrics.presence = calculateBandRatio(linearMags, 2000.0f, 5000.0f);
-        metrics.airiness = calculateBandRatio(linearMags, 10000.0f, 20000.0f);
-        metrics.muddiness = calculateBandRatio(linearMags, 200.0f, 400.0f);
+        metrics.brightness = calculateBandRatio(mags, n, 4000.0f, 20000.0f);
+        metrics.warmth = calculateBandRatio(mags, n, 100.0f, 500.0f);
+        metrics.presence = calculateBandRatio(mags, n, 2000.0f, 5000.0f);
+        metrics.airiness = calculateBandRatio(mags, n, 10000.0f, 20000.0f);
+        metrics.muddiness = calculateBandRatio(mags, n, 200.0f, 400.0f);
         
         // Tonalität (inverse von Flatness mit Scaling)
         metrics.tonality = 1.0f - metrics.flatness;
         
         // Harshness Detection (Resonanzen im kritischen Bereich)
-        metrics.harshness = detectHarshness(magnitudes);
+        metrics.harshness = detectHarshness(dbMagnitudes, n);
         
         // Dynamischer Bereich
-        metrics.dynamicRange = calculateDynamicRange(magnitudes);
-        
-        // Mel-Band Energien
-        metrics.melBands = calculateMelBands(linearMags);
-        
-        // Bark-Band Energien  
-        metrics.barkBands = calculateBarkBands(linearMags);
+        metrics.dynamicRange = calculateDynamicRange(dbMagnitudes, n);
         
-        // MFCC berechnen
-        metrics.mfcc = calculateMFCC(metrics.melBands);
+        // Mel-/Bark-Band Energien und MFCC
+        calculateMelBands(mags, n, metrics.melBands.data());
+        calculateBarkBands(mags, n, metrics.barkBands.data());
+        calculateMFCC(metrics.melBands.data(), metrics.mfcc.data());
         
-        // Vorherige Magnitudes für Flux-Berechnung speichern
-        previousMagnitudes = linearMags;
+        // Vorherige Magnitudes für Flux-Berechnung speichern (ohne Allokation)
+        previousMagnitudes.assign(linearMagnitudes.begin(), linearMagnitudes.end());
+    }
+    
+    void analyze(const std::vector<float>& dbMagnitudes, SpectralMetrics& metrics)
+    {
+        analyze(dbMagnitudes.data(), static_cast<int>(dbMagnitudes.size()), metrics);
+    }
+    
+    //==========================================================================
+    // Filterbänke (Eingang: lineare Magnitudes, Ausgang: feste Buffer)
+    //==========================================================================
+    void calculateMelBands(const float* mags, int n, float* melEnergies) const
+    {
+        for (int m = 0; m < numMelBands; ++m)
+        {
+            const auto& band = melBands[static_cast<size_t>(m)];
+            const int end = juce::jmin(band.startBin + band.numBins, n);
+            const float* weights = melWeights.data() + band.weightOffset;
+            
+            float energy = 0.0f;
+            for (int k = band.startBin; k < end; ++k)
+                energy += mags[k] * mags[k] * weights[k - band.startBin];
+            
+            melEnergies[m] = energy;
+        }
+    }
+    
+    void calculateBarkBands(const float* mags, int n, float* barkEnergies) const
+    {
+        // Rechteckige Bänder: nur Bin-Bereich, keine Gewichte nötig
+        for (int b = 0; b < numBarkBands; ++b)
+        {
+            const auto& band = barkBands[static_cast<size_t>(b)];
+            const int end = juce::jmin(band.startBin + band.numBins, n);
+            
+            float energy = 0.0f;
+            for (int k = band.startBin; k < end; ++k)
+                energy += mags[k] * mags[k];
+            
+            const int count = end - band.startBin;
+            barkEnergies[b] = count > 0 ? energy / static_cast<float>(count) : 0.0f;
+        }
+    }
+    
+    void calculateMFCC(const float* melEnergies, float* mfcc) const
+    {
+        // Log-Energie der Mel-Bänder
+        std::array<float, numMelBands> logMelEnergies;
+        for (int j = 0; j < numMelBands; ++j)
+            logMelEnergies[static_cast<size_t>(j)] = std::log(std::max(1e-10f, melEnergies[j]));
         
-        return metrics;
+        // DCT (Discrete Cosine Transform) Type-II über die vorberechnete Tabelle
+        for (int i = 0; i < numMFCC; ++i)
+        {
+            const float* row = dctTable.data() + i * numMelBands;
+            float sum = 0.0f;
+            for (int j = 0; j < numMelBands; ++j)
+                sum += logMelEnergies[static_cast<size_t>(j)] * row[j];
+            mfcc[i] = sum;
+        }
     }
     
     //==========================================================================
@@ -135,21 +225,32 @@ public:
     double getSampleRate() const { return sampleRate; }
     int getFFTSize() const { return fftSize; }
     int getNumBins() const { return numBins; }
-    
+
 private:
     double sampleRate = 44100.0;
     int fftSize = 2048;
     int numBins = 1025;
     
+    std::vector<float> linearMagnitudes;
     std::vector<float> previousMagnitudes;
     
-    // Mel-Filterbank
-    static constexpr int numMelBands = 26;
-    std::vector<std::vector<float>> melFilterbank;
+    // Sparse Band: zusammenhängender Bin-Bereich, Gewichte (falls vorhanden) im Pool
+    struct SparseBand
+    {
+        int startBin = 0;
+        int numBins = 0;
+        int weightOffset = 0;
+    };
+    
+    // Mel-Filterbank (Dreiecke)
+    std::array<SparseBand, numMelBands> melBands;
+    std::vector<float> melWeights;
     
-    // Bark-Filterbank (24 kritische Bänder)
-    static constexpr int numBarkBands = 24;
-    std::vector<std::vector<float>> barkFilterbank;
+    // Bark-Filterbank (Rechtecke)
+    std::array<SparseBand, numBarkBands> barkBands;
+    
+    // MFCC DCT-Tabelle [numMFCC x numMelBands]
+    std::array<float, numMFCC * numMelBands> dctTable;
     
     //==========================================================================
     // Hilfsfunktionen
@@ -184,14 +285,14 @@ private:
     //==========================================================================
     // Spektrale Metriken
     //==========================================================================
-    float calculateCentroid(const std::vector<float>& mags) const
+    float calculateCentroid(const float* mags, int n) const
     {
         float weightedSum = 0.0f;
         float totalEnergy = 0.0f;
         
-        for (size_t i = 1; i < mags.size(); ++i)
+        for (int i = 1; i < n; ++i)
         {
-            float freq = binToFrequency(static_cast<int>(i));
+            float freq = binToFrequency(i);
             float energy = mags[i] * mags[i];
             weightedSum += freq * energy;
             totalEnergy += energy;
@@ -200,14 +301,14 @@ private:
         return totalEnergy > 0.0f ? weightedSum / totalEnergy : 0.0f;
     }
     
-    float calculateSpread(const std::vector<float>& mags, float centroid) const
+    float calculateSpread(const float* mags, int n, float centroid) const
     {
         float varianceSum = 0.0f;
         float totalEnergy = 0.0f;
         
-        for (size_t i = 1; i < mags.size(); ++i)
+        for (int i = 1; i < n; ++i)
         {
-            float freq = binToFrequency(static_cast<int>(i));
+            float freq = binToFrequency(i);
             float energy = mags[i] * mags[i];
             float diff = freq - centroid;
             varianceSum += diff * diff * energy;
@@ -217,14 +318,14 @@ private:
         return totalEnergy > 0.0f ? std::sqrt(varianceSum / totalEnergy) : 0.0f;
     }
     
-    float calculateFlatness(const std::vector<float>& mags) const
+    float calculateFlatness(const float* mags, int n) const
     {
         // Geometrischer vs. Arithmetischer Mittelwert
         float logSum = 0.0f;
         float linearSum = 0.0f;
         int count = 0;
         
-        for (size_t i = 1; i < mags.size(); ++i)
+        for (int i = 1; i < n; ++i)
         {
             if (mags[i] > 1e-10f)
             {
@@ -243,37 +344,37 @@ private:
         return juce::jlimit(0.0f, 1.0f, geometricMean / arithmeticMean);
     }
     
-    float calculateRolloff(const std::vector<float>& mags, float percentage) const
+    float calculateRolloff(const float* mags, int n, float percentage) const
     {
         float totalEnergy = 0.0f;
-        for (size_t i = 1; i < mags.size(); ++i)
+        for (int i = 1; i < n; ++i)
             totalEnergy += mags[i] * mags[i];
         
         float threshold = totalEnergy * percentage;
         float cumulativeEnergy = 0.0f;
         
-        for (size_t i = 1; i < mags.size(); ++i)
+        for (int i = 1; i < n; ++i)
         {
             cumulativeEnergy += mags[i] * mags[i];
             if (cumulativeEnergy >= threshold)
-                return binToFrequency(static_cast<int>(i));
+                return binToFrequency(i);
         }
         
-        return binToFrequency(static_cast<int>(mags.size() - 1));
+        return binToFrequency(n - 1);
     }
     
-    float calculateCrestFactor(const std::vector<float>& mags) const
+    float calculateCrestFactor(const float* mags, int n) const
     {
-        if (mags.empty())
+        if (n <= 0)
             return 0.0f;
         
-        float peak = *std::max_element(mags.begin(), mags.end());
+        float peak = *std::max_element(mags, mags + n);
         float rms = 0.0f;
         
-        for (const auto& m : mags)
-            rms += m * m;
+        for (int i = 0; i < n; ++i)
+            rms += mags[i] * mags[i];
         
-        rms = std::sqrt(rms / static_cast<float>(mags.size()));
+        rms = std::sqrt(rms / static_cast<float>(n));
         
         if (rms > 0.0f)
             return 20.0f * std::log10(peak / rms);
@@ -281,15 +382,15 @@ private:
         return 0.0f;
     }
     
-    float calculateFlux(const std::vector<float>& mags) const
+    float calculateFlux(const float* mags, int n) const
     {
-        if (previousMagnitudes.size() != mags.size())
+        if (static_cast<int>(previousMagnitudes.size()) != n)
             return 0.0f;
         
         float flux = 0.0f;
-        for (size_t i = 0; i < mags.size(); ++i)
+        for (int i = 0; i < n; ++i)
         {
-            float diff = mags[i] - previousMagnitudes[i];
+            float diff = mags[i] - previousMagnitudes[static_cast<size_t>(i)];
             // Half-wave rectification (nur positive Änderungen)
             flux += std::max(0.0f, diff) * std::max(0.0f, diff);
         }
@@ -297,7 +398,7 @@ private:
         return std::sqrt(flux);
     }
     
-    float calculateBandRatio(const std::vector<float>& mags, float lowFreq, float highFreq) const
+    float calculateBandRatio(const float* mags, int n, float lowFreq, float highFreq) const
     {
         int lowBin = frequencyToBin(lowFreq);
         int highBin = frequencyToBin(highFreq);
@@ -307,25 +408,25 @@ private:
         float bandEnergy = 0.0f;
         float totalEnergy = 0.0f;
         
-        for (size_t i = 1; i < mags.size(); ++i)
+        for (int i = 1; i < n; ++i)
         {
             float energy = mags[i] * mags[i];
             totalEnergy += energy;
             
-            if (static_cast<int>(i) >= lowBin && static_cast<int>(i) < highBin)
+            if (i >= lowBin && i < highBin)
                 bandEnergy += energy;
         }
         
         return totalEnergy > 0.0f ? bandEnergy / totalEnergy : 0.0f;
     }
     
-    float detectHarshness(const std::vector<float>& dbMags) const
+    float detectHarshness(const float* dbMags, int n) const
     {
         // Suche nach Resonanzen im 2-5 kHz Bereich
         int lowBin = frequencyToBin(2000.0f);
         int highBin = frequencyToBin(5000.0f);
-        lowBin = juce::jlimit(0, numBins - 1, lowBin);
-        highBin = juce::jlimit(lowBin + 1, numBins, highBin);
+        lowBin = juce::jlimit(0, n - 1, lowBin);
+        highBin = juce::jlimit(lowBin + 1, n, highBin);
         
         float maxPeak = -120.0f;
         float avgLevel = 0.0f;
@@ -333,7 +434,7 @@ private:
         
         for (int i = lowBin; i < highBin; ++i)
         {
-            float mag = dbMags[static_cast<size_t>(i)];
+            float mag = dbMags[i];
             maxPeak = std::max(maxPeak, mag);
             avgLevel += mag;
             ++count;
@@ -347,13 +448,14 @@ private:
         return juce::jlimit(0.0f, 1.0f, deviation / 20.0f);
     }
     
-    float calculateDynamicRange(const std::vector<float>& dbMags) const
+    float calculateDynamicRange(const float* dbMags, int n) const
     {
         float maxLevel = -120.0f;
         float minLevel = 0.0f;
         
-        for (const auto& db : dbMags)
+        for (int i = 0; i < n; ++i)
         {
+            const float db = dbMags[i];
             if (db > -100.0f)  // Ignoriere sehr leise Bins
             {
                 maxLevel = std::max(maxLevel, db);
@@ -365,156 +467,73 @@ private:
     }
     
     //==========================================================================
-    // Mel-Filterbank
+    // Filterbank-Aufbau (nur bei geänderter sampleRate/fftSize)
     //==========================================================================
+    void rebuildFilterbanks()
+    {
+        initializeMelFilterbank();
+        initializeBarkFilterbank();
+    }
+    
     void initializeMelFilterbank()
     {
-        melFilterbank.clear();
-        melFilterbank.resize(numMelBands);
+        melWeights.clear();
         
         float melMin = hzToMel(20.0f);
         float melMax = hzToMel(static_cast<float>(sampleRate) / 2.0f);
         
-        std::vector<float> melPoints(numMelBands + 2);
-        for (int i = 0; i <= numMelBands + 1; ++i)
-        {
-            melPoints[static_cast<size_t>(i)] = melMin + static_cast<float>(i) * (melMax - melMin) / static_cast<float>(numMelBands + 1);
-        }
-        
-        std::vector<int> binPoints(numMelBands + 2);
+        std::array<int, numMelBands + 2> binPoints;
         for (int i = 0; i <= numMelBands + 1; ++i)
         {
-            float hz = melToHz(melPoints[static_cast<size_t>(i)]);
-            binPoints[static_cast<size_t>(i)] = frequencyToBin(hz);
+            float mel = melMin + static_cast<float>(i) * (melMax - melMin) / static_cast<float>(numMelBands + 1);
+            binPoints[static_cast<size_t>(i)] = frequencyToBin(melToHz(mel));
         }
         
         for (int m = 0; m < numMelBands; ++m)
         {
-            melFilterbank[static_cast<size_t>(m)].resize(static_cast<size_t>(numBins), 0.0f);
+            const int left = binPoints[static_cast<size_t>(m)];
+            const int centre = binPoints[static_cast<size_t>(m + 1)];
+            const int right = binPoints[static_cast<size_t>(m + 2)];
             
-            for (int k = binPoints[static_cast<size_t>(m)]; k < binPoints[static_cast<size_t>(m + 1)]; ++k)
-            {
-                if (k >= 0 && k < numBins)
-                {
-                    melFilterbank[static_cast<size_t>(m)][static_cast<size_t>(k)] = 
-                        static_cast<float>(k - binPoints[static_cast<size_t>(m)]) / 
-                        static_cast<float>(binPoints[static_cast<size_t>(m + 1)] - binPoints[static_cast<size_t>(m)]);
-                }
-            }
+            // Nur Bins mit Gewicht != 0 speichern: (left, right) exklusive Ränder
+            const int first = juce::jlimit(0, numBins, left + 1);
+            const int last = juce::jlimit(first, numBins, right);
             
-            for (int k = binPoints[static_cast<size_t>(m + 1)]; k < binPoints[static_cast<size_t>(m + 2)]; ++k)
-            {
-                if (k >= 0 && k < numBins)
-                {
-                    melFilterbank[static_cast<size_t>(m)][static_cast<size_t>(k)] = 
-                        static_cast<float>(binPoints[static_cast<size_t>(m + 2)] - k) / 
-                        static_cast<float>(binPoints[static_cast<size_t>(m + 2)] - binPoints[static_cast<size_t>(m + 1)]);
-                }
-            }
-        }
-    }
-    
-    std::vector<float> calculateMelBands(const std::vector<float>& mags) const
-    {
-        std::vector<float> melEnergies(numMelBands, 0.0f);
-        
-        for (int m = 0; m < numMelBands; ++m)
-        {
-            float energy = 0.0f;
-            for (size_t k = 0; k < std::min(mags.size(), melFilterbank[static_cast<size_t>(m)].size()); ++k)
+            auto& band = melBands[static_cast<size_t>(m)];
+            band.startBin = first;
+            band.numBins = last - first;
+            band.weightOffset = static_cast<int>(melWeights.size());
+            
+            for (int k = first; k < last; ++k)
             {
-                energy += mags[k] * mags[k] * melFilterbank[static_cast<size_t>(m)][k];
+                float weight = k < centre
+                    ? static_cast<float>(k - left) / static_cast<float>(centre - left)
+                    : static_cast<float>(right - k) / static_cast<float>(right - centre);
+                melWeights.push_back(weight);
             }
-            melEnergies[static_cast<size_t>(m)] = energy;
         }
-        
-        return melEnergies;
     }
     
-    //==========================================================================
-    // Bark-Filterbank (24 kritische Bänder)
-    //==========================================================================
     void initializeBarkFilterbank()
     {
         // Bark-Band Grenzen (Hz) - basierend auf kritischen Bändern
-        static const float barkEdges[25] = {
+        static const float barkEdges[numBarkBands + 1] = {
             20, 100, 200, 300, 400, 510, 630, 770, 920, 1080,
             1270, 1480, 1720, 2000, 2320, 2700, 3150, 3700, 4400, 5300,
             6400, 7700, 9500, 12000, 15500
         };
         
-        barkFilterbank.clear();
-        barkFilterbank.resize(numBarkBands);
-        
         for (int b = 0; b < numBarkBands; ++b)
         {
-            barkFilterbank[static_cast<size_t>(b)].resize(static_cast<size_t>(numBins), 0.0f);
-            
             int lowBin = frequencyToBin(barkEdges[b]);
             int highBin = frequencyToBin(barkEdges[b + 1]);
             lowBin = juce::jlimit(0, numBins - 1, lowBin);
             highBin = juce::jlimit(lowBin, numBins, highBin);
             
-            for (int k = lowBin; k < highBin; ++k)
-            {
-                barkFilterbank[static_cast<size_t>(b)][static_cast<size_t>(k)] = 1.0f;
-            }
-        }
-    }
-    
-    std::vector<float> calculateBarkBands(const std::vector<float>& mags) const
-    {
-        std::vector<float> barkEnergies(numBarkBands, 0.0f);
-        
-        for (int b = 0; b < numBarkBands; ++b)
-        {
-            float energy = 0.0f;
-            int count = 0;
-            
-            for (size_t k = 0; k < std::min(mags.size(), barkFilterbank[static_cast<size_t>(b)].size()); ++k)
-            {
-                if (barkFilterbank[static_cast<size_t>(b)][k] > 0.0f)
-                {
-                    energy += mags[k] * mags[k];
-                    ++count;
-                }
-            }
-            
-            barkEnergies[static_cast<size_t>(b)] = count > 0 ? energy / static_cast<float>(count) : 0.0f;
+            auto& band = barkBands[static_cast<size_t>(b)];
+            band.startBin = lowBin;
+            band.numBins = highBin - lowBin;
+            band.weightOffset = 0;
         }
-        
-        return barkEnergies;
-    }
-    
-    //==========================================================================
-    // MFCC Berechnung
-    //==========================================================================
-    std::vector<float> calculateMFCC(const std::vector<float>& melEnergies) const
-    {
-        static constexpr int numMFCC = 13;
-        std::vector<float> mfcc(numMFCC, 0.0f);
-        
-        // Log-Energie der Mel-Bänder
-        std::vector<float> logMelEnergies(melEnergies.size());
-        for (size_t i = 0; i < melEnergies.size(); ++i)
-        {
-            logMelEnergies[i] = std::log(std::max(1e-10f, melEnergies[i]));
-        }
-        
-        // DCT (Discrete Cosine Transform) Type-II
-        for (int i = 0; i < numMFCC; ++i)
-        {
-            float sum = 0.0f;
-            for (size_t j = 0; j < logMelEnergies.size(); ++j)
-            {
-                sum += logMelEnergies[j] * std::cos(
-                    juce::MathConstants<float>::pi * static_cast<float>(i) * 
-                    (static_cast<float>(j) + 0.5f) / static_cast<float>(logMelEnergies.size())
-                );
-            }
-            mfcc[static_cast<size_t>(i)] = sum;
-        }
-        
-        return mfcc;
     }
 };
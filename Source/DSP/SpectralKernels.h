@@ -0,0 +1,262 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+/**
+ * SpectralKernels: Gemeinsame Kernels für alle Magnitude-Pfade
+ * (FFTAnalyzer, DynamicResonanceSuppressor, SpectralMatcher,
+ * PsychoAcousticModel, ReferenceAudioPlayer).
+ *
+ * - Arbeiten auf zusammenhängenden float-Arrays, keine Allokation (RT-safe)
+ * - Innere Schleifen sind verzweigungsfrei (Select statt if/else), damit der
+ *   Compiler sie vektorisiert (SSE/NEON über den Auto-Vectorizer)
+ * - dB-Umrechnung über log2 aus Exponent + Mantissen-Reihe statt std::log10
+ *   (Fehler < 1e-5 dB gegenüber exaktem 20 * log10 über -240 … +60 dB,
+ *   geprüft in Tools/DspBenchmarks/SpectralKernelsBenchmark.cpp)
+ */
+namespace SpectralKernels
+{
+    //==========================================================================
+    // Skalare Bausteine
+    //==========================================================================
+
+    /**
+     * log2 für positive, normale floats, getrennt in ganzzahligen Exponenten
+     * und Mantissen-Anteil in [-0.5, 0.5] (atanh-Reihe um 1).
+     * log2(x) = exponent + Rückgabewert.
+     */
+    inline float fastLog2Mantissa(float x, float& exponent) noexcept
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+
+        // Mantisse auf [sqrt(0.5), sqrt(2)) zentrieren → |t| <= 0.1716, Reihe konvergiert schnell.
+        // Ganzzahlig auf den Bits (Mantisse > sqrt(2) ⇔ Bits > 0x3504f3), damit der Compiler
+        // keine Gleitkomma-Operation unter eine Bedingung legt und die Schleife vektorisiert
+        const uint32_t mantissaBits = bits & 0x007fffffu;
+        const uint32_t high = mantissaBits > 0x003504f3u ? 1u : 0u;
+
+        exponent = static_cast<float>(static_cast<int>((bits >> 23) & 0xffu) - 127 + static_cast<int>(high));
+        bits = mantissaBits | (0x3f800000u - (high << 23));
+
+        float mantissa;  // [sqrt(0.5), sqrt(2))
+        std::memcpy(&mantissa, &bits, sizeof(mantissa));
+
+        const float t = (mantissa - 1.0f) / (mantissa + 1.0f);
+        const float t2 = t * t;
+
+        // log2(m) = 2/ln2 * (t + t^3/3 + t^5/5 + t^7/7 + t^9/9 + ...)
+        return t * (2.88539008f + t2 * (0.961796694f + t2 * (0.577078016f
+                     + t2 * (0.412198583f + t2 * 0.320598898f))));
+    }
+
+    /** log2 für positive, normale floats. */
+    inline float fastLog2(float x) noexcept
+    {
+        float exponent;
+        const float mantissaLog2 = fastLog2Mantissa(x, exponent);
+        return exponent + mantissaLog2;
+    }
+
+    /** 2^x, x wird auf den normalen float-Bereich begrenzt. */
+    inline float fastExp2(float x) noexcept
+    {
+        x = std::min(127.0f, std::max(-126.0f, x));
+
+        // Auf nächste Ganzzahl runden → Rest in [-0.5, 0.5]. x + 127.5 ist positiv,
+        // Abschneiden entspricht daher floor (ohne std::floor-Aufruf ohne SSE4.1)
+        const int roundedInt = static_cast<int>(x + 127.5f) - 127;
+        const float rounded = static_cast<float>(roundedInt);
+        const float f = x - rounded;
+
+        // Taylor-Reihe von 2^f (Fehler ~1e-7 auf [-0.5, 0.5])
+        const float poly = 1.0f + f * (0.693147181f + f * (0.240226507f + f * (0.0555041087f
+                         + f * (0.00961812911f + f * (0.00133335581f + f * 0.000154035304f)))));
+
+        const uint32_t bits = static_cast<uint32_t>(roundedInt + 127) << 23;
+        float scale;
+        std::memcpy(&scale, &bits, sizeof(scale));
+
+        return poly * scale;
+    }
+
+    //==========================================================================
+    // dB-Umrechnung
+    //==========================================================================
+
+    /**
+     * dest[i] = gainToDecibels(src[i] * gainScale, floorDb)
+     * Identisch zu juce::Decibels::gainToDecibels: alles unter dem Floor wird zum Floor.
+     * floorDb muss einen normalen float ergeben (> ca. -750 dB). In-place erlaubt.
+     */
+    inline void gainToDecibels(const float* src, float* dest, int numValues,
+                               float gainScale, float floorDb) noexcept
+    {
+        // 20 * log10(2), aufgeteilt: dbPerLog2High hat nur 13 Mantissen-Bits, damit ist
+        // exponent * dbPerLog2High exakt und der große Exponenten-Anteil wird erst in der
+        // letzten Addition gerundet (sonst ~1.5 ulp Fehler bei sehr leisen Pegeln)
+        constexpr float dbPerLog2 = 6.02059991f;
+        constexpr float dbPerLog2High = 6.0205078125f;      // 6165 / 1024
+        constexpr float dbPerLog2Low = 9.21007796e-5f;      // dbPerLog2 - dbPerLog2High
+        const float floorGain = juce::Decibels::decibelsToGain(floorDb, floorDb - 1.0f);
+
+        // Untergrenze erst am Ausgang: positive floats sind als int32 gleich geordnet, negative
+        // Werte (auch -0.0) werden negativ. Eine Begrenzung des Eingangs auf einen konstanten
+        // Floor würde der Compiler per Jump-Threading in einen eigenen Pfad zerlegen (keine
+        // Vektorisierung); Null/Denormals liefern hier Werte um -760 dB, die verworfen werden
+        int32_t floorBits;
+        std::memcpy(&floorBits, &floorGain, sizeof(floorBits));
+
+        for (int i = 0; i < numValues; ++i)
+        {
+            const float gain = src[i] * gainScale;
+            int32_t bits;
+            std::memcpy(&bits, &gain, sizeof(bits));
+
+            float exponent;
+            const float mantissaLog2 = fastLog2Mantissa(gain, exponent);
+            const float db = exponent * dbPerLog2High + (exponent * dbPerLog2Low + mantissaLog2 * dbPerLog2);
+            // Unter dem Floor: Wert sicher unter floorDb schieben (Select auf Konstante statt Zweig)
+            const float belowFloor = bits < floorBits ? -1000.0f : 0.0f;
+            dest[i] = std::max(floorDb, db + belowFloor);
+        }
+    }
+
+    /**
+     * Summe von 10^((db[i] + weightDb[i]) / 10) über alle Bins, deren gewichteter Pegel
+     * über floorDb liegt (dB → Leistung, z.B. für Lautheits-Summen).
+     */
+    inline float sumWeightedPower(const float* db, const float* weightDb, int numValues,
+                                  float floorDb) noexcept
+    {
+        constexpr float log2PerDb = 0.332192809f;  // log2(10) / 10
+        float sum = 0.0f;
+
+        for (int i = 0; i < numValues; ++i)
+        {
+            const float weighted = db[i] + weightDb[i];
+            const float power = fastExp2(weighted * log2PerDb);
+            sum += weighted > floorDb ? power : 0.0f;
+        }
+
+        return sum;
+    }
+
+    //==========================================================================
+    // Zeitliche Glättung
+    //==========================================================================
+
+    /**
+     * Asymmetrischer One-Pole pro Bin (verzweigungsfrei):
+     * state = coeff * state + (1 - coeff) * target,
+     * coeff = riseCoeff wenn target > state, sonst fallCoeff.
+     *
+     * Spektrum-Anzeige: rise = Attack. Gain-Reduktion (negativ): fall = Attack.
+     */
+    inline void smoothAsymmetric(const float* target, float* state, int numValues,
+                                 float riseCoeff, float fallCoeff) noexcept
+    {
+        for (int i = 0; i < numValues; ++i)
+        {
+            const float current = state[i];
+            const float coeff = target[i] > current ? riseCoeff : fallCoeff;
+            state[i] = target[i] + coeff * (current - target[i]);
+        }
+    }
+
+    //==========================================================================
+    // Glättung über Nachbar-Bins
+    //==========================================================================
+
+    /**
+     * Mittelwert der Nachbarn in [i - halfWindow, i + halfWindow] OHNE den Bin selbst.
+     * Prefix-Summe in scratch (mind. numValues floats), O(n) unabhängig von der Fensterbreite.
+     * Fenster werden an den Rändern abgeschnitten; emptyValue wenn keine Nachbarn existieren.
+     */
+    inline void localAverageExcludingCentre(const float* src, float* dest, float* scratch,
+                                            int numValues, int halfWindow, float emptyValue) noexcept
+    {
+        if (numValues <= 0)
+            return;
+
+        halfWindow = std::max(0, halfWindow);
+
+        float* prefix = scratch;
+        prefix[0] = src[0];
+        for (int i = 1; i < numValues; ++i)
+            prefix[i] = prefix[i - 1] + src[i];
+
+        auto edgeAverage = [&](int i)
+        {
+            const int start = std::max(0, i - halfWindow);
+            const int end = std::min(numValues - 1, i + halfWindow);
+            const float windowSum = prefix[end] - (start > 0 ? prefix[start - 1] : 0.0f);
+            const int count = end - start;
+            dest[i] = count > 0 ? (windowSum - src[i]) / static_cast<float>(count) : emptyValue;
+        };
+
+        // Innenbereich: volles Fenster, konstante Anzahl → ohne Clamping/Verzweigung
+        const int interiorStart = halfWindow + 1;
+        const int interiorEnd = numValues - halfWindow;  // exklusiv
+
+        if (interiorStart >= interiorEnd || halfWindow == 0)
+        {
+            for (int i = 0; i < numValues; ++i)
+                edgeAverage(i);
+            return;
+        }
+
+        for (int i = 0; i < interiorStart; ++i)
+            edgeAverage(i);
+
+        const float invCount = 1.0f / static_cast<float>(2 * halfWindow);
+        for (int i = interiorStart; i < interiorEnd; ++i)
+            dest[i] = (prefix[i + halfWindow] - prefix[i - halfWindow - 1] - src[i]) * invCount;
+
+        for (int i = interiorEnd; i < numValues; ++i)
+            edgeAverage(i);
+    }
+
+    /**
+     * Gleitender Mittelwert über ein Fenster von `octaves` Oktaven Breite
+     * (Bin k: [k * 2^(-octaves/2), k * 2^(octaves/2)]), mindestens ±minHalfWidth Bins.
+     * Bin-Abstand ist linear, die Fensterbreite wächst daher proportional zur Frequenz;
+     * die Samplerate wird nicht benötigt. Prefix-Summe in double (scratch, mind. numValues),
+     * damit lange Fenster bei hohen Bins keine Auslöschung zeigen. src != dest.
+     */
+    inline void fractionalOctaveSmooth(const float* src, float* dest, double* scratch,
+                                       int numValues, float octaves, int minHalfWidth) noexcept
+    {
+        if (numValues <= 0)
+            return;
+
+        double* prefix = scratch;
+        double running = 0.0;
+        for (int i = 0; i < numValues; ++i)
+        {
+            running += static_cast<double>(src[i]);
+            prefix[i] = running;
+        }
+
+        const float lowRatio = std::pow(2.0f, -0.5f * octaves);
+        const float highRatio = std::pow(2.0f, 0.5f * octaves);
+        const int lastIndex = numValues - 1;
+
+        for (int k = 0; k < numValues; ++k)
+        {
+            const float bin = static_cast<float>(k);
+            int start = static_cast<int>(std::floor(bin * lowRatio));
+            int end = static_cast<int>(std::ceil(bin * highRatio));
+
+            start = std::max(0, std::min(start, k - minHalfWidth));
+            end = std::min(lastIndex, std::max(end, k + minHalfWidth));
+
+            const double windowSum = prefix[end] - (start > 0 ? prefix[start - 1] : 0.0);
+            dest[k] = static_cast<float>(windowSum / static_cast<double>(end - start + 1));
+        }
+    }
+}
@@ -4,6 +4,7 @@
 #include <vector>
 #include <array>
 #include <cmath>
+#include "SpectralKernels.h"
 
 /**
  * SpectralMatcher: Reference Track EQ-Matching System
@@ -56,10 +57,7 @@ public:
     //==========================================================================
     // Konstruktor
     //==========================================================================
-    SpectralMatcher()
-    {
-        initializeSmoothingWeights();
-    }
+    SpectralMatcher() = default;
     
     void prepare(double newSampleRate, int newFftSize = 4096)
     {
@@ -75,9 +73,6 @@ public:
                 static_cast<float>(i) * static_cast<float>(sampleRate) / static_cast<float>(fftSize);
         }
         
-        // Smoothing-Gewichte neu berechnen
-        initializeSmoothingWeights();
-        
         // WICHTIG: Reference-Spektrum NICHT löschen wenn schon vorhanden!
         // Nur temporäre Buffer zurücksetzen
         inputSpectrum.clear();
@@ -178,13 +173,11 @@ public:
         }
         else
         {
-            // Exponentielles Moving Average für zeitliche Glättung
+            // Exponentielles Moving Average für zeitliche Glättung (symmetrisch)
             constexpr float temporalSmooth = 0.85f;
-            for (size_t i = 0; i < inputSpectrum.size(); ++i)
-            {
-                inputSpectrum[i] = temporalSmooth * inputSpectrum[i] + 
-                                   (1.0f - temporalSmooth) * (*spectrumToUse)[i];
-            }
+            SpectralKernels::smoothAsymmetric(spectrumToUse->data(), inputSpectrum.data(),
+                                              static_cast<int>(inputSpectrum.size()),
+                                              temporalSmooth, temporalSmooth);
         }
         
         // Räumliche Glättung nur auf frisches Spektrum, nicht kumulativ auf EMA
@@ -352,54 +345,20 @@ private:
     // Private Hilfsfunktionen
     //==========================================================================
     
-    void initializeSmoothingWeights()
-    {
-        // Smoothing Gewichte basierend auf smoothingOctaves-Setting
-        smoothingWeights.clear();
-        
-        // halfWidth skaliert mit Oktav-Breite: 0.1 Oct -> 2 Bins, 0.33 Oct -> 5, 1.0 Oct -> 15
-        int halfWidth = juce::jlimit(2, 15, static_cast<int>(settings.smoothingOctaves * 15.0f));
-        float sigma = static_cast<float>(halfWidth) / 2.0f;
-        
-        for (int i = -halfWidth; i <= halfWidth; ++i)
-        {
-            float weight = std::exp(-static_cast<float>(i * i) / (2.0f * sigma * sigma));
-            smoothingWeights.push_back(weight);
-        }
-        
-        // Normalisieren
-        float sum = 0.0f;
-        for (float w : smoothingWeights) sum += w;
-        for (float& w : smoothingWeights) w /= sum;
-    }
-    
     void smoothSpectrum(std::vector<float>& spectrum)
     {
         if (spectrum.size() < 3)
             return;
         
-        // Wiederverwendbaren Member-Buffer nutzen statt lokaler Allokation
+        // Wiederverwendbare Member-Buffer nutzen statt lokaler Allokation
         smoothingBuffer.resize(spectrum.size());
-        int halfWidth = static_cast<int>(smoothingWeights.size()) / 2;
+        smoothingPrefix.resize(spectrum.size());
         
-        for (size_t i = 0; i < spectrum.size(); ++i)
-        {
-            float sum = 0.0f;
-            float weightSum = 0.0f;
-            
-            for (int j = -halfWidth; j <= halfWidth; ++j)
-            {
-                int idx = static_cast<int>(i) + j;
-                if (idx >= 0 && idx < static_cast<int>(spectrum.size()))
-                {
-                    float weight = smoothingWeights[static_cast<size_t>(j + halfWidth)];
-                    sum += spectrum[static_cast<size_t>(idx)] * weight;
-                    weightSum += weight;
-                }
-            }
-            
-            smoothingBuffer[i] = (weightSum > 0.0f) ? sum / weightSum : spectrum[i];
-        }
+        // Echte Bruchteil-Oktav-Glättung (Fenster wächst mit der Frequenz),
+        // mindestens ±2 Bins damit der Bassbereich nicht ungeglättet bleibt
+        SpectralKernels::fractionalOctaveSmooth(spectrum.data(), smoothingBuffer.data(), smoothingPrefix.data(),
+                                                static_cast<int>(spectrum.size()),
+                                                settings.smoothingOctaves, 2);
         
         std::copy(smoothingBuffer.begin(), smoothingBuffer.begin() + static_cast<std::ptrdiff_t>(spectrum.size()), spectrum.begin());
     }
@@ -595,9 +554,9 @@ private:
     std::vector<float> referenceSpectrum;
     std::vector<float> inputSpectrum;
     std::vector<float> correctionCurve;
-    std::vector<float> smoothingWeights;
     std::vector<MatchPoint> matchPoints;
     std::vector<float> smoothingBuffer;  // Wiederverwendbar für smoothSpectrum()
+    std::vector<double> smoothingPrefix;  // Prefix-Summe für smoothSpectrum()
     std::vector<float> resampledSpectrum_;  // Pre-allokiert für updateInputSpectrum() (vermeidet Heap-Allok im RT-Pfad)
     
     bool hasReference = false;
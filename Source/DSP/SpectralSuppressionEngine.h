@@ -0,0 +1,209 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "SpectralKernels.h"
+#include <vector>
+#include <memory>
+#include <cmath>
+
+/**
+ * SpectralSuppressionEngine: Wendet eine per-Bin Gain-Maske direkt im STFT-Bereich an
+ * (hochauflösende Alternative zur SVF-Filterbank des DynamicResonanceSuppressor).
+ *
+ * - Overlap-Add mit 75% Überlappung, sqrt-Hann als Analyse- und Synthese-Fenster
+ *   (Produkt = Hann → perfekte Rekonstruktion bei Einheits-Maske)
+ * - Fensterlänge ~23 ms unabhängig von der Samplerate:
+ *   1024 @ 44.1/48 kHz, 2048 @ 88.2/96 kHz, 4096 @ 176.4/192 kHz
+ * - Feste Latenz von fftSize Samples (getLatencyInSamples)
+ * - Einheits-Maske (keine Reduktion) überspringt FFT/IFFT: der Frame wird nur
+ *   gefenstert aufaddiert → reine Verzögerung, Latenz bleibt konstant
+ * - Alle Buffer werden in prepare() alloziert, process() ist RT-safe
+ */
+class SpectralSuppressionEngine
+{
+public:
+    static constexpr int MAX_CHANNELS = 2;
+    static constexpr int OVERLAP = 4;
+    static constexpr int MAX_FFT_SIZE = 4096;  // = maximale Latenz
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+
+        const int order = sampleRate > 150000.0 ? 12 : (sampleRate > 75000.0 ? 11 : 10);
+        fftSize = 1 << order;
+        hopSize = fftSize / OVERLAP;
+        numBins = fftSize / 2 + 1;
+
+        fft = std::make_unique<juce::dsp::FFT>(order);
+
+        // Periodisches sqrt-Hann: Σ w_a·w_s über alle Hops = OVERLAP / 2
+        window.resize(static_cast<size_t>(fftSize));
+        for (int i = 0; i < fftSize; ++i)
+        {
+            const double hann = 0.5 - 0.5 * std::cos(2.0 * juce::MathConstants<double>::pi
+                                                     * static_cast<double>(i) / static_cast<double>(fftSize));
+            window[static_cast<size_t>(i)] = static_cast<float>(std::sqrt(hann));
+        }
+        outputScale = 2.0f / static_cast<float>(OVERLAP);
+
+        for (int ch = 0; ch < MAX_CHANNELS; ++ch)
+        {
+            inputRing[ch].assign(static_cast<size_t>(fftSize), 0.0f);
+            outputRing[ch].assign(static_cast<size_t>(fftSize), 0.0f);
+        }
+
+        frame.assign(static_cast<size_t>(fftSize * 2), 0.0f);
+        mask.assign(static_cast<size_t>(numBins), 1.0f);
+        maskIsUnity = true;
+
+        reset();
+    }
+
+    void reset()
+    {
+        for (int ch = 0; ch < MAX_CHANNELS; ++ch)
+        {
+            std::fill(inputRing[ch].begin(), inputRing[ch].end(), 0.0f);
+            std::fill(outputRing[ch].begin(), outputRing[ch].end(), 0.0f);
+        }
+        writePos = 0;
+        hopCounter = 0;
+    }
+
+    int getLatencyInSamples() const { return fftSize; }
+    int getFFTSize() const { return fftSize; }
+    int getNumBins() const { return numBins; }
+
+    /**
+     * Übernimmt Gain-Reduktionen (dB, ≤ 0) aus einem beliebigen Bin-Raster gleicher
+     * Samplerate (sourceFftSize) und interpoliert sie linear auf das eigene Raster.
+     */
+    void setGainReductions(const float* gainReductionsDb, int sourceNumBins, int sourceFftSize)
+    {
+        if (mask.empty() || sourceNumBins < 2 || sourceFftSize <= 0)
+        {
+            setUnityMask();
+            return;
+        }
+
+        constexpr float log2PerDb = 0.166096405f;  // log2(10) / 20
+        const float binRatio = static_cast<float>(sourceFftSize) / static_cast<float>(fftSize);
+        const int lastSourceBin = sourceNumBins - 1;
+
+        float minReduction = 0.0f;
+        for (int k = 0; k < numBins; ++k)
+        {
+            const float position = std::min(static_cast<float>(k) * binRatio, static_cast<float>(lastSourceBin));
+            const int index = std::min(static_cast<int>(position), lastSourceBin - 1);
+            const float frac = position - static_cast<float>(index);
+
+            const float reductionDb = gainReductionsDb[index]
+                                    + frac * (gainReductionsDb[index + 1] - gainReductionsDb[index]);
+            minReduction = std::min(minReduction, reductionDb);
+            mask[static_cast<size_t>(k)] = SpectralKernels::fastExp2(std::min(0.0f, reductionDb) * log2PerDb);
+        }
+
+        maskIsUnity = minReduction > -0.01f;
+    }
+
+    void setUnityMask()
+    {
+        if (!maskIsUnity)
+        {
+            std::fill(mask.begin(), mask.end(), 1.0f);
+            maskIsUnity = true;
+        }
+    }
+
+    /** Verarbeitet bis zu MAX_CHANNELS Kanäle in-place (um getLatencyInSamples() verzögert). */
+    void process(juce::AudioBuffer<float>& buffer)
+    {
+        if (fft == nullptr)
+            return;
+
+        const int numChannels = juce::jmin(buffer.getNumChannels(), MAX_CHANNELS);
+        const int numSamples = buffer.getNumSamples();
+
+        int position = 0;
+        while (position < numSamples)
+        {
+            // Bis zur nächsten Hop-Grenze: writePos läuft dabei nie über das Ring-Ende,
+            // da fftSize ein Vielfaches von hopSize ist
+            const int chunk = juce::jmin(numSamples - position, hopSize - hopCounter);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                float* data = buffer.getWritePointer(ch) + position;
+                float* input = inputRing[ch].data() + writePos;
+                float* output = outputRing[ch].data() + writePos;
+
+                juce::FloatVectorOperations::copy(input, data, chunk);
+                juce::FloatVectorOperations::copy(data, output, chunk);
+                juce::FloatVectorOperations::clear(output, chunk);
+            }
+
+            writePos = (writePos + chunk) & (fftSize - 1);
+            hopCounter += chunk;
+            position += chunk;
+
+            if (hopCounter == hopSize)
+            {
+                hopCounter = 0;
+                for (int ch = 0; ch < numChannels; ++ch)
+                    processFrame(ch);
+            }
+        }
+    }
+
+private:
+    void processFrame(int channel)
+    {
+        // Ältestes Sample liegt bei writePos → Ring in zeitlicher Reihenfolge auspacken
+        const auto& input = inputRing[channel];
+        const int firstPart = fftSize - writePos;
+        std::copy(input.begin() + writePos, input.end(), frame.begin());
+        std::copy(input.begin(), input.begin() + writePos, frame.begin() + firstPart);
+
+        juce::FloatVectorOperations::multiply(frame.data(), window.data(), fftSize);
+
+        if (!maskIsUnity)
+        {
+            fft->performRealOnlyForwardTransform(frame.data(), true);
+
+            for (int k = 0; k < numBins; ++k)
+            {
+                const float gain = mask[static_cast<size_t>(k)];
+                frame[static_cast<size_t>(2 * k)] *= gain;
+                frame[static_cast<size_t>(2 * k + 1)] *= gain;
+            }
+
+            fft->performRealOnlyInverseTransform(frame.data());
+        }
+
+        // Synthese-Fenster + Normierung, dann Overlap-Add an der zeitlich passenden Ring-Position
+        juce::FloatVectorOperations::multiply(frame.data(), window.data(), fftSize);
+
+        auto& output = outputRing[channel];
+        juce::FloatVectorOperations::addWithMultiply(output.data() + writePos, frame.data(), outputScale, firstPart);
+        juce::FloatVectorOperations::addWithMultiply(output.data(), frame.data() + firstPart, outputScale, writePos);
+    }
+
+    double sampleRate = 44100.0;
+    int fftSize = 1024;
+    int hopSize = 256;
+    int numBins = 513;
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> window;
+    float outputScale = 0.5f;
+
+    std::vector<float> inputRing[MAX_CHANNELS];
+    std::vector<float> outputRing[MAX_CHANNELS];
+    std::vector<float> frame;
+    int writePos = 0;
+    int hopCounter = 0;
+
+    std::vector<float> mask;
+    bool maskIsUnity = true;
+};
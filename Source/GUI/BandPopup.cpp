@@ -100,6 +100,10 @@ BandPopup::BandPopup()
     dynEnabledButton.onClick = [this]() { updateDynControlsVisibility(); };
     addAndMakeVisible(dynEnabledButton);
 
+    dynSidechainButton.setButtonText("Ext SC");
+    dynSidechainButton.setTooltip("Externe Sidechain\nDer Detektor hoert den Sidechain-Eingang des Plugins statt des Bandsignals.\nOhne verbundene Sidechain wird das Eingangssignal verwendet.");
+    addAndMakeVisible(dynSidechainButton);
+
     auto setupDynSlider = [this](juce::Slider& slider, juce::Label& label, const juce::String& labelText) {
         slider.setSliderStyle(juce::Slider::LinearHorizontal);
         slider.setTextBoxStyle(juce::Slider::TextBoxRight, false, 55, 18);
@@ -207,6 +211,7 @@ void BandPopup::resized()
     // Trennlinie + Titel
     dynLabel.setBounds(bounds.removeFromTop(18));
     auto dynEnableRow = bounds.removeFromTop(24);
+    dynSidechainButton.setBounds(dynEnableRow.removeFromRight(dynEnableRow.getWidth() / 2).reduced(2));
     dynEnabledButton.setBounds(dynEnableRow.reduced(2));
     bounds.removeFromTop(4);
 
@@ -309,6 +314,8 @@ void BandPopup::setAttachments(juce::AudioProcessorValueTreeState& apvts, int ba
     // Dynamic EQ Attachments
     dynEnabledAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
         apvts, ParameterIDs::getBandDynEnabledID(bandIndex), dynEnabledButton);
+    dynSidechainAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        apvts, ParameterIDs::getBandDynSidechainID(bandIndex), dynSidechainButton);
     dynThresholdAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
         apvts, ParameterIDs::getBandDynThresholdID(bandIndex), dynThresholdSlider);
     dynRatioAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
@@ -332,6 +339,7 @@ void BandPopup::clearAttachments()
     slopeAttachment.reset();
     bypassAttachment.reset();
     dynEnabledAttachment.reset();
+    dynSidechainAttachment.reset();
     dynThresholdAttachment.reset();
     dynRatioAttachment.reset();
     dynAttackAttachment.reset();
@@ -391,11 +399,13 @@ void BandPopup::updateDynControlsVisibility()
     dynRatioSlider.setEnabled(dynEnabled);
     dynAttackSlider.setEnabled(dynEnabled);
     dynReleaseSlider.setEnabled(dynEnabled);
+    dynSidechainButton.setEnabled(dynEnabled);
     
     dynThresholdSlider.setAlpha(alpha);
     dynRatioSlider.setAlpha(alpha);
     dynAttackSlider.setAlpha(alpha);
     dynReleaseSlider.setAlpha(alpha);
+    dynSidechainButton.setAlpha(alpha);
     autoThresholdButton.setEnabled(dynEnabled);
     autoThresholdButton.setAlpha(alpha);
     dynThresholdLabel.setAlpha(alpha);
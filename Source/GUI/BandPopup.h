@@ -67,6 +67,7 @@ private:
 
     // Dynamic EQ Controls
     juce::ToggleButton dynEnabledButton;
+    juce::ToggleButton dynSidechainButton;
     juce::Slider dynThresholdSlider;
     juce::Slider dynRatioSlider;
     juce::Slider dynAttackSlider;
@@ -89,6 +90,7 @@ private:
 
     // Dynamic EQ Attachments
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> dynEnabledAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> dynSidechainAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> dynThresholdAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> dynRatioAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> dynAttackAttachment;
@@ -3,8 +3,7 @@
 EQCurveComponent::EQCurveComponent()
 {
     setOpaque(false);
-    // Timer wird NICHT im Konstruktor gestartet!
-    // Erst nach vollständiger Initialisierung via startCurveUpdates()
+    // Frames kommen vom RenderClock des Editors (kein eigener Timer)
     
     // Band-Handles initialisieren
     for (int i = 0; i < ParameterIDs::MAX_BANDS; ++i)
@@ -18,12 +17,9 @@ EQCurveComponent::EQCurveComponent()
     }
 }
 
-EQCurveComponent::~EQCurveComponent()
-{
-    stopTimer();
-}
+EQCurveComponent::~EQCurveComponent() = default;
 
-void EQCurveComponent::setEQProcessor(EQProcessor* processor)
+void EQCurveComponent::setEQProcessor(const EQProcessor* processor)
 {
     eqProcessor = processor;
     updateCurvePath();
@@ -37,6 +33,12 @@ void EQCurveComponent::setBandParameters(int bandIndex, float frequency, float g
         return;
 
     auto& handle = bandHandles[static_cast<size_t>(bandIndex)];
+    
+    // Editor synchronisiert alle Bänder pro Tick → nur echte Änderungen zählen
+    if (handle.frequency == frequency && handle.gain == gain && handle.q == q && handle.type == type
+        && handle.bypassed == bypassed && handle.active == active)
+        return;
+    
     handle.frequency = frequency;
     handle.gain = gain;
     handle.q = q;
@@ -83,10 +85,9 @@ juce::Point<int> EQCurveComponent::getBandScreenPosition(int bandIndex) const
     // Bei Dynamic EQ: Position zum effektiven Gain verschieben
     if (eqProcessor != nullptr && !handle.bypassed)
     {
-        const auto& band = eqProcessor->getBand(bandIndex);
-        if (band.isDynamicMode())
+        if (getSnapshotBand(bandIndex).dynamicMode)
         {
-            float gr = band.getDynamicGainReduction();
+            float gr = eqProcessor->getBand(bandIndex).getDynamicGainReduction();
             if (gr > 0.05f)
                 y = dbToY(calcEffectiveGain(handle.gain, gr));
         }
@@ -182,35 +183,59 @@ void EQCurveComponent::resized()
     freqTable.resize(static_cast<size_t>(w > 0 ? w : 1));
     for (int i = 0; i < w; ++i)
         freqTable[static_cast<size_t>(i)] = xToFrequency(static_cast<float>(i));
+    responseEngine.setFrequencies(freqTable.data(), w > 0 ? w : 0);
     
     curvesDirty = true;
     updateCurvePath();
     updateBandPaths();
 }
 
-void EQCurveComponent::timerCallback()
+void EQCurveComponent::renderFrame(double /*timestampMs*/)
 {
-    // Immer dirty setzen wenn Dynamic EQ aktiv ist (Gain-Reduction ändert sich kontinuierlich)
-    // Sonst nur bei echten Parameter-Änderungen
+    // Kurven-Pfade nur bei echten Parameter-Änderungen neu berechnen (Snapshot-Version).
+    // Dynamic EQ: Gain-Reduction, Pegel und Threshold werden in paint() gezeichnet →
+    // bei Änderung nur neu zeichnen, die gecachten Pfade bleiben gültig
+    bool needsRepaint = false;
+    
     if (eqProcessor != nullptr)
     {
+        // Neuer Snapshot vom Audio-Thread → Kurven neu berechnen
+        if (responseEngine.update(*eqProcessor))
+            curvesDirty = true;
+        
         for (int i = 0; i < ParameterIDs::MAX_BANDS; ++i)
         {
-            if (eqProcessor->getBand(i).isDynamicMode())
+            auto& drawn = drawnDynamicStates[static_cast<size_t>(i)];
+            DynamicDisplayState state;
+            
+            if (getSnapshotBand(i).dynamicMode)
             {
-                curvesDirty = true;
-                break;
+                const auto& band = eqProcessor->getBand(i);
+                state.gainReduction = band.getDynamicGainReduction();
+                state.levelDB = band.getEnvelopeLevelDB();
+                state.thresholdDB = getSnapshotBand(i).threshold;
+                state.dynamic = true;
+            }
+            
+            if (state.differsFrom(drawn))
+            {
+                drawn = state;
+                needsRepaint = true;
             }
         }
     }
     
+    // Ohne Änderung kein Repaint (Maus-Interaktion repaintet selbst)
     if (curvesDirty)
     {
         updateCurvePath();
         updateBandPaths();
         curvesDirty = false;
+        needsRepaint = true;
     }
-    repaint();
+    
+    if (needsRepaint)
+        repaint();
 }
 
 void EQCurveComponent::mouseDown(const juce::MouseEvent& e)
@@ -345,13 +370,7 @@ void EQCurveComponent::mouseDrag(const juce::MouseEvent& e)
     handle.x = frequencyToX(newFreq);
     handle.y = dbToY(newGain);
     
-    // EQ-Processor aktualisieren
-    if (eqProcessor != nullptr)
-    {
-        eqProcessor->getBand(selectedBand).setFrequency(newFreq);
-        eqProcessor->getBand(selectedBand).setGain(newGain);
-    }
-    
+    // Nur über die Listener (APVTS → ParameterRouter → Audio-Thread), nie direkt ins Band
     notifyBandChanged(selectedBand);
     repaint();
 }
@@ -408,15 +427,6 @@ void EQCurveComponent::mouseDoubleClick(const juce::MouseEvent& e)
                 handle.x = frequencyToX(freq);
                 handle.y = dbToY(0.0f);
                 
-                if (eqProcessor != nullptr)
-                {
-                    auto& band = eqProcessor->getBand(i);
-                    band.setParameters(freq, 0.0f, ParameterIDs::DEFAULT_Q,
-                                       ParameterIDs::FilterType::Bell,
-                                       ParameterIDs::ChannelMode::Stereo, false);
-                    band.setActive(true);
-                }
-                
                 setSelectedBand(i);
                 
                 listeners.call([i, freq](Listener& l) { l.bandCreated(i, freq); });
@@ -452,11 +462,6 @@ void EQCurveComponent::mouseWheelMove(const juce::MouseEvent& e, const juce::Mou
         
         handle.q = newQ;
         
-        if (eqProcessor != nullptr)
-        {
-            eqProcessor->getBand(bandAtPos).setQ(newQ);
-        }
-        
         notifyBandChanged(bandAtPos);
         repaint();
     }
@@ -470,16 +475,17 @@ void EQCurveComponent::updateCurvePath()
         return;
 
     const int numPoints = getWidth();
-    if (static_cast<size_t>(numPoints) > freqTable.size())
+    if (numPoints > responseEngine.getNumPoints())
         return;  // freqTable nicht initialisiert
     
+    responseEngine.update(*eqProcessor);
+    const float* magnitudes = responseEngine.getTotalResponse();
+    
     bool started = false;
 
     for (int i = 0; i < numPoints; ++i)
     {
-        float freq = freqTable[static_cast<size_t>(i)];
-        float magnitude = eqProcessor->getTotalMagnitudeForFrequency(freq);
-        float y = dbToY(magnitude);
+        float y = dbToY(magnitudes[i]);
         
         y = juce::jlimit(0.0f, static_cast<float>(getHeight()), y);
 
@@ -501,9 +507,11 @@ void EQCurveComponent::updateBandPaths()
         return;
 
     const int numPoints = getWidth();
-    if (static_cast<size_t>(numPoints) > freqTable.size())
+    if (numPoints > responseEngine.getNumPoints())
         return;  // freqTable nicht initialisiert
 
+    responseEngine.update(*eqProcessor);
+
     for (int bandIdx = 0; bandIdx < ParameterIDs::MAX_BANDS; ++bandIdx)
     {
         bandPaths[static_cast<size_t>(bandIdx)].clear();
@@ -512,14 +520,12 @@ void EQCurveComponent::updateBandPaths()
         if (!handle.active || handle.bypassed)
             continue;
 
-        const auto& band = eqProcessor->getBand(bandIdx);
+        const float* magnitudes = responseEngine.getBandResponse(bandIdx);
         bool started = false;
 
         for (int i = 0; i < numPoints; ++i)
         {
-            float freq = freqTable[static_cast<size_t>(i)];
-            float magnitude = band.getMagnitudeForFrequency(freq);
-            float y = dbToY(magnitude);
+            float y = dbToY(magnitudes[i]);
             
             y = juce::jlimit(0.0f, static_cast<float>(getHeight()), y);
 
@@ -629,11 +635,10 @@ void EQCurveComponent::drawBandHandles(juce::Graphics& g)
 
         if (eqProcessor != nullptr && !handle.bypassed)
         {
-            const auto& band = eqProcessor->getBand(i);
-            isDynamic = band.isDynamicMode();
+            isDynamic = getSnapshotBand(i).dynamicMode;
             if (isDynamic)
             {
-                gr = band.getDynamicGainReduction();
+                gr = eqProcessor->getBand(i).getDynamicGainReduction();
                 if (gr > 0.05f)
                 {
                     hasDynamicGR = true;
@@ -726,9 +731,8 @@ void EQCurveComponent::drawBandHandles(juce::Graphics& g)
         // Dynamic EQ: Signal-Level + Threshold Indikatoren (Pro-Q Style)
         if (isDynamic && (isSelected || isHovered))
         {
-            const auto& band = eqProcessor->getBand(i);
-            float signalLevelDB = band.getEnvelopeLevelDB();
-            float thresholdDB = band.getThreshold();
+            float signalLevelDB = eqProcessor->getBand(i).getEnvelopeLevelDB();
+            float thresholdDB = getSnapshotBand(i).threshold;
             
             // Vertikaler Bereich: Kleine Skala neben dem Handle
             float barX = x + radius + 6.0f;
@@ -777,9 +781,8 @@ void EQCurveComponent::drawBandHandles(juce::Graphics& g)
         else if (isDynamic && !isSelected && !isHovered)
         {
             // Kompakter Threshold-Tick auch ohne Hover (nur kleiner Strich)
-            const auto& band = eqProcessor->getBand(i);
-            float signalLevelDB = band.getEnvelopeLevelDB();
-            float thresholdDB = band.getThreshold();
+            float signalLevelDB = eqProcessor->getBand(i).getEnvelopeLevelDB();
+            float thresholdDB = getSnapshotBand(i).threshold;
             
             // Kleiner Signal-Punkt rechts vom Handle
             if (signalLevelDB > -60.0f)
@@ -827,10 +830,9 @@ int EQCurveComponent::getBandAtPosition(juce::Point<float> pos) const
         // Bei Dynamic EQ: Auch die effektive (gezeichnete) Position prüfen
         if (eqProcessor != nullptr && !handle.bypassed)
         {
-            const auto& band = eqProcessor->getBand(i);
-            if (band.isDynamicMode())
+            if (getSnapshotBand(i).dynamicMode)
             {
-                float gr = band.getDynamicGainReduction();
+                float gr = eqProcessor->getBand(i).getDynamicGainReduction();
                 if (gr > 0.05f)
                 {
                     float dynY = dbToY(calcEffectiveGain(handle.gain, gr));
@@ -881,10 +883,9 @@ void EQCurveComponent::drawParameterDisplay(juce::Graphics& g, int bandIndex)
     float gr = 0.0f;
     if (eqProcessor != nullptr)
     {
-        const auto& band = eqProcessor->getBand(bandIndex);
-        isDynamic = band.isDynamicMode();
+        isDynamic = getSnapshotBand(bandIndex).dynamicMode;
         if (isDynamic)
-            gr = band.getDynamicGainReduction();
+            gr = eqProcessor->getBand(bandIndex).getDynamicGainReduction();
     }
     bool hasDynamicGR = isDynamic && gr > 0.05f;
     
@@ -1074,21 +1075,8 @@ void EQCurveComponent::showFilterTypeMenu(int bandIndex, juce::Point<int> screen
         {
             if (result == 100)
             {
-                // Band löschen (deaktivieren)
-                bandHandles[static_cast<size_t>(bandIndex)].active = false;
-                bandHandles[static_cast<size_t>(bandIndex)].gain = 0.0f;
-                
-                if (eqProcessor != nullptr)
-                {
-                    eqProcessor->getBand(bandIndex).setActive(false);
-                    eqProcessor->getBand(bandIndex).setGain(0.0f);
-                }
-                
-                if (selectedBand == bandIndex)
-                    setSelectedBand(-1);
-                    
-                // Listener informieren für Gain = 0 und Active = false
-                notifyBandChanged(bandIndex);
+                // Band löschen (Listener setzen Active/Gain/... im APVTS zurück)
+                deleteBand(bandIndex);
             }
             else if (result == 101)
             {
@@ -1096,17 +1084,13 @@ void EQCurveComponent::showFilterTypeMenu(int bandIndex, juce::Point<int> screen
                 bool newBypass = !bandHandles[static_cast<size_t>(bandIndex)].bypassed;
                 bandHandles[static_cast<size_t>(bandIndex)].bypassed = newBypass;
                 
-                if (eqProcessor != nullptr)
-                    eqProcessor->getBand(bandIndex).setBypassed(newBypass);
+                listeners.call([bandIndex, newBypass](Listener& l) { l.bandBypassChanged(bandIndex, newBypass); });
             }
             else if (result > 0 && result <= static_cast<int>(ParameterIDs::FilterType::NumTypes))
             {
                 auto newType = static_cast<ParameterIDs::FilterType>(result - 1);
                 bandHandles[static_cast<size_t>(bandIndex)].type = newType;
                 
-                if (eqProcessor != nullptr)
-                    eqProcessor->getBand(bandIndex).setType(newType);
-                
                 notifyFilterTypeChanged(bandIndex, newType);
             }
             repaint();
@@ -1136,23 +1120,13 @@ void EQCurveComponent::deleteBand(int bandIndex)
     handle.bypassed = false;
     handle.type = ParameterIDs::FilterType::Bell;
 
-    // Im Processor auch deaktivieren und Parameter zurücksetzen
-    if (eqProcessor != nullptr)
-    {
-        auto& band = eqProcessor->getBand(bandIndex);
-        band.setActive(false);
-        // Parameter auf Standard zurücksetzen
-        band.setParameters(1000.0f, 0.0f, ParameterIDs::DEFAULT_Q,
-                          ParameterIDs::FilterType::Bell);
-    }
-
     // Selection aufräumen
     if (selectedBand == bandIndex)
         setSelectedBand(-1);
     if (hoveredBand == bandIndex)
         hoveredBand = -1;
 
-    // Benachrichtige alle Listener über Band-Löschung
+    // Benachrichtige alle Listener über Band-Löschung (setzen den APVTS zurück)
     listeners.call([bandIndex](Listener& l) { l.bandDeleted(bandIndex); });
 
     // Repaint
@@ -1170,11 +1144,10 @@ void EQCurveComponent::drawDynamicEQCurves(juce::Graphics& g)
         if (!handle.active || handle.bypassed)
             continue;
         
-        const auto& band = eqProcessor->getBand(bandIdx);
-        if (!band.isDynamicMode())
+        if (!getSnapshotBand(bandIdx).dynamicMode)
             continue;
         
-        float gr = band.getDynamicGainReduction();
+        float gr = eqProcessor->getBand(bandIdx).getDynamicGainReduction();
         if (gr < 0.1f)
             continue;
         
@@ -1182,16 +1155,16 @@ void EQCurveComponent::drawDynamicEQCurves(juce::Graphics& g)
         float grFactor = juce::jlimit(0.0f, 1.0f, 1.0f - (gr / (std::abs(handle.gain) + 0.01f)));
         
         juce::Path dynamicPath;
-        const int numPoints = getWidth() / 2; // Weniger Punkte fuer Performance
+        const int numPoints = juce::jmin(getWidth(), responseEngine.getNumPoints()) / 2; // Weniger Punkte fuer Performance
+        const float* bandMagnitudes = responseEngine.getBandResponse(bandIdx);  // pro Pixel, aus dem Cache
         bool started = false;
         
         for (int i = 0; i < numPoints; ++i)
         {
             float xPos = static_cast<float>(i * 2);
-            float freq = xToFrequency(xPos);
             
             // Magnitude dieses Bands bei der Frequenz holen
-            float bandMag = band.getMagnitudeForFrequency(freq);
+            float bandMag = bandMagnitudes[i * 2];
             
             // Skalieren um die Gain Reduction zu zeigen
             float dynamicMag = bandMag * grFactor;
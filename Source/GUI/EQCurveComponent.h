@@ -2,14 +2,16 @@
 
 #include <JuceHeader.h>
 #include "../DSP/EQProcessor.h"
+#include "../DSP/FrequencyResponseEngine.h"
 #include "SpectrumAnalyzer.h"
 #include "CustomLookAndFeel.h"
+#include "RenderClock.h"
 
 /**
  * EQCurveComponent: Zeichnet die EQ-Kurve und ermöglicht interaktive Band-Steuerung.
  */
 class EQCurveComponent : public juce::Component,
-                         public juce::Timer
+                         public RenderClock::Client
 {
 public:
     // Callback für Parameter-Änderungen
@@ -22,19 +24,18 @@ public:
         virtual void bandCreated(int bandIndex, float frequency) = 0;
         virtual void filterTypeChanged(int bandIndex, ParameterIDs::FilterType type) = 0;
         virtual void bandDeleted(int /*bandIndex*/) {}
+        virtual void bandBypassChanged(int /*bandIndex*/, bool /*bypassed*/) {}
         virtual void bandRightClicked(int /*bandIndex*/) {}  // Rechtsklick auf Band-Point
     };
 
     EQCurveComponent();
     ~EQCurveComponent() override;
     
-    // Timer-Kontrolle - muss nach vollständiger Initialisierung aufgerufen werden
-    void startCurveUpdates() { startTimerHz(30); }
-    void stopCurveUpdates() { stopTimer(); }
-
     void paint(juce::Graphics& g) override;
     void resized() override;
-    void timerCallback() override;
+
+    // RenderClock::Client: Kurven nur bei neuen Daten neu berechnen und zeichnen
+    void renderFrame(double timestampMs) override;
 
     // Maus-Interaktion
     void mouseDown(const juce::MouseEvent& e) override;
@@ -44,8 +45,8 @@ public:
     void mouseDoubleClick(const juce::MouseEvent& e) override;
     void mouseWheelMove(const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel) override;
 
-    // EQ-Processor setzen
-    void setEQProcessor(EQProcessor* processor);
+    // EQ-Processor setzen (nur lesend; Änderungen gehen über die Listener an den APVTS)
+    void setEQProcessor(const EQProcessor* processor);
 
     // Band-Parameter direkt setzen (für Synchronisation mit APVTS)
     void setBandParameters(int bandIndex, float frequency, float gain, float q, 
@@ -78,7 +79,7 @@ public:
     void setEQDecibelRange(float minDB, float maxDB);
 
 private:
-    EQProcessor* eqProcessor = nullptr;
+    const EQProcessor* eqProcessor = nullptr;
     juce::ListenerList<Listener> listeners;
 
     // Band-Positionen (für Hit-Testing)
@@ -111,9 +112,37 @@ private:
     // Vorberechnete Frequenz-Tabelle (ein Eintrag pro Pixel, berechnet in resized())
     std::vector<float> freqTable;
     
+    // Frequenzgang auf freqTable, Cache pro Band (nur geänderte Bänder neu)
+    FrequencyResponseEngine responseEngine;
+    
     // Dirty-Flag: nur bei Parameter-Änderung neu berechnen
     bool curvesDirty = true;
     void markCurvesDirty() { curvesDirty = true; }
+    
+    // Band-Status aus dem zuletzt gelesenen Snapshot (Dynamic-Modus, Threshold) —
+    // kein Zugriff auf die Bänder des Audio-Threads
+    const EQProcessor::ResponseSnapshot::Band& getSnapshotBand(int index) const
+    {
+        return responseEngine.getSnapshot().bands[static_cast<size_t>(index)];
+    }
+    
+    // Zuletzt gezeichnete Dynamic-EQ-Anzeige pro Band (Repaint nur bei Änderung)
+    struct DynamicDisplayState
+    {
+        bool dynamic = false;
+        float gainReduction = 0.0f;
+        float levelDB = -100.0f;
+        float thresholdDB = 0.0f;
+        
+        bool differsFrom(const DynamicDisplayState& other) const
+        {
+            return dynamic != other.dynamic
+                || std::abs(gainReduction - other.gainReduction) > 0.01f
+                || std::abs(levelDB - other.levelDB) > 0.1f
+                || thresholdDB != other.thresholdDB;
+        }
+    };
+    std::array<DynamicDisplayState, ParameterIDs::MAX_BANDS> drawnDynamicStates {};
 
     // Frequenz/dB-Bereiche
     float minFreq = 20.0f;
@@ -168,6 +168,13 @@ public:
             repaint();
         };
         
+        audioPlayer.onLoadFailed = [this](const juce::File& file)
+        {
+            fileNameLabel.setText("Nicht lesbar: " + file.getFileName(), juce::dontSendNotification);
+            fileNameLabel.setColour(juce::Label::textColourId, CustomLookAndFeel::getTextColor().withAlpha(0.6f));
+            repaint();
+        };
+        
         audioPlayer.onThumbnailChanged = [this]()
         {
             repaint();
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <vector>
+
+/**
+ * RenderClock: Gemeinsamer Frame-Takt für alle animierten GUI-Komponenten.
+ *
+ * - Ein einziger VBlank-Callback pro Editor statt eigener Timer pro Komponente:
+ *   alle Updates eines Frames laufen direkt hintereinander, die Repaints landen
+ *   im selben Bildschirm-Frame
+ * - Jeder Client hat eine eigene Maximalrate (Spektrum 60 Hz, Kurve 30 Hz, ...)
+ * - Ohne sichtbares Fenster kommt kein VBlank → keine GUI-Last
+ * - Frame-Statistik (Dauer aller Client-Updates pro Frame) für Profiling
+ *
+ * Nur im Message-Thread verwenden.
+ */
+class RenderClock
+{
+public:
+    //==========================================================================
+    // Client-Interface
+    //==========================================================================
+    class Client
+    {
+    public:
+        virtual ~Client() = default;
+
+        /** Wird im Message-Thread aufgerufen, wenn der Client fällig ist. */
+        virtual void renderFrame(double timestampMs) = 0;
+    };
+
+    //==========================================================================
+    // Laufzeit-Statistik (geglättet, Peak mit langsamem Abfall)
+    //==========================================================================
+    struct FrameTiming
+    {
+        double lastMs = 0.0;
+        double averageMs = 0.0;
+        double peakMs = 0.0;
+        uint32_t numFrames = 0;
+
+        void addFrame(double durationMs)
+        {
+            lastMs = durationMs;
+            averageMs = (numFrames == 0) ? durationMs : averageMs + SMOOTHING * (durationMs - averageMs);
+            peakMs = juce::jmax(durationMs, peakMs * PEAK_DECAY);
+            ++numFrames;
+        }
+
+        static constexpr double SMOOTHING = 0.05;
+        static constexpr double PEAK_DECAY = 0.995;
+    };
+
+    explicit RenderClock(juce::Component& hostComponent) : host(hostComponent) {}
+    ~RenderClock() { stop(); }
+
+    /** Registriert einen Client mit seiner maximalen Bildrate. */
+    void addClient(Client& client, int maxFramesPerSecond)
+    {
+        removeClient(client);
+
+        Entry entry;
+        entry.client = &client;
+        entry.intervalMs = 1000.0 / static_cast<double>(juce::jlimit(1, 240, maxFramesPerSecond));
+        clients.push_back(entry);
+    }
+
+    void removeClient(Client& client)
+    {
+        clients.erase(std::remove_if(clients.begin(), clients.end(),
+                                     [&client](const Entry& e) { return e.client == &client; }),
+                      clients.end());
+    }
+
+    // Erst nach vollständiger Initialisierung des Editors starten
+    void start()
+    {
+        if (vblank == nullptr)
+            vblank = std::make_unique<juce::VBlankAttachment>(&host, [this] { onVBlank(); });
+    }
+
+    void stop() { vblank.reset(); }
+
+    bool isRunning() const { return vblank != nullptr; }
+
+    /** Dauer aller Client-Updates pro Frame (ohne das eigentliche Painting). */
+    const FrameTiming& getFrameTiming() const { return frameTiming; }
+
+    /** Tatsächliche VBlank-Rate des Hosts (0 bis zum zweiten Frame). */
+    double getVBlankRate() const { return vblankRate; }
+
+private:
+    struct Entry
+    {
+        Client* client = nullptr;
+        double intervalMs = 1000.0 / 30.0;
+        double nextDueMs = 0.0;
+    };
+
+    void onVBlank()
+    {
+        const double now = juce::Time::getMillisecondCounterHiRes();
+
+        if (lastVBlankMs > 0.0 && now > lastVBlankMs)
+        {
+            const double rate = 1000.0 / (now - lastVBlankMs);
+            vblankRate = (vblankRate > 0.0) ? vblankRate + 0.05 * (rate - vblankRate) : rate;
+        }
+        lastVBlankMs = now;
+
+        bool anyRendered = false;
+
+        for (auto& entry : clients)
+        {
+            // Toleranz von einem Viertel-Intervall: VBlank-Jitter soll bei
+            // gleicher Bildschirm- und Zielrate keine Frames auslassen
+            if (now + 0.25 * entry.intervalMs < entry.nextDueMs)
+                continue;
+
+            // Raster halten; nach Aussetzern (Fenster verdeckt, Drag) neu aufsetzen
+            entry.nextDueMs += entry.intervalMs;
+            if (entry.nextDueMs < now)
+                entry.nextDueMs = now + entry.intervalMs;
+
+            entry.client->renderFrame(now);
+            anyRendered = true;
+        }
+
+        if (anyRendered)
+            frameTiming.addFrame(juce::Time::getMillisecondCounterHiRes() - now);
+    }
+
+    juce::Component& host;
+    std::unique_ptr<juce::VBlankAttachment> vblank;
+    std::vector<Entry> clients;
+
+    FrameTiming frameTiming;
+    double lastVBlankMs = 0.0;
+    double vblankRate = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE(RenderClock)
+};
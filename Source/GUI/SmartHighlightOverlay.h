@@ -3,6 +3,7 @@
 #include <JuceHeader.h>
 #include "../DSP/SmartAnalyzer.h"
 #include "ThemeManager.h"
+#include "RenderClock.h"
 
 /**
  * SmartHighlightOverlay: Visualisiert erkannte Frequenzprobleme als farbige Overlays.
@@ -15,7 +16,7 @@
  * - Integration mit ThemeManager
  */
 class SmartHighlightOverlay : public juce::Component,
-                               public juce::Timer
+                               public RenderClock::Client
 {
 public:
     //==========================================================================
@@ -32,7 +33,6 @@ public:
     SmartHighlightOverlay()
     {
         setInterceptsMouseClicks(false, false);  // Grundsaetzlich transparent
-        startTimerHz(30);
     }
     
     // hitTest: Nur true wenn ein Problem an dieser Position vorliegt
@@ -57,11 +57,6 @@ public:
         return false;  // Kein Problem -> Klick durchlassen
     }
     
-    ~SmartHighlightOverlay() override
-    {
-        stopTimer();
-    }
-    
     void paint(juce::Graphics& g) override
     {
         if (!enabled || problems.empty() || !showLabels)
@@ -82,14 +77,15 @@ public:
         }
     }
     
-    void timerCallback() override
+    // RenderClock::Client (30 Hz)
+    void renderFrame(double /*timestampMs*/) override
     {
         // Animation für pulsierende Highlights
         pulsePhase += 0.1f;
         if (pulsePhase > juce::MathConstants<float>::twoPi)
             pulsePhase -= juce::MathConstants<float>::twoPi;
         
-        if (enabled && !problems.empty())
+        if (enabled && showLabels && !problems.empty())
             repaint();
     }
     
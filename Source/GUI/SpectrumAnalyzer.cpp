@@ -7,15 +7,24 @@ SpectrumAnalyzer::SpectrumAnalyzer()
     // Standard: 90 dB Range (wie Pro-Q)
     setDBRange(DBRange::Range90dB);
 
-    // Timer wird NICHT im Konstruktor gestartet!
-    // Erst nach vollständiger Initialisierung via startAnalyzer()
-}
+    // Gauss-Gewichte einmal berechnen (vorher exp() pro Punkt und Tap)
+    float weightSum = 0.0f;
+    for (int j = -SMOOTHING_RADIUS; j <= SMOOTHING_RADIUS; ++j)
+    {
+        const float weight = std::exp(-static_cast<float>(j * j) / 8.0f);
+        smoothingWeights[static_cast<size_t>(j + SMOOTHING_RADIUS)] = weight;
+        weightSum += weight;
+    }
+    for (auto& weight : smoothingWeights)
+        weight /= weightSum;
 
-SpectrumAnalyzer::~SpectrumAnalyzer()
-{
-    stopTimer();
+    localPeaks.reserve(PEAK_SEARCH_POINTS);
+
+    // Frames kommen vom RenderClock des Editors (kein eigener Timer)
 }
 
+SpectrumAnalyzer::~SpectrumAnalyzer() = default;
+
 void SpectrumAnalyzer::setAnalyzer(FFTAnalyzer* preAnalyzer, FFTAnalyzer* postAnalyzer)
 {
     preFFT = preAnalyzer;
@@ -24,12 +33,44 @@ void SpectrumAnalyzer::setAnalyzer(FFTAnalyzer* preAnalyzer, FFTAnalyzer* postAn
 
 void SpectrumAnalyzer::setEnabled(bool enabled)
 {
+    if (isEnabled == enabled)
+        return;
+
     isEnabled = enabled;
     if (!enabled)
     {
         preSpectrumPath.clear();
         postSpectrumPath.clear();
     }
+    spectrumDirty = true;
+    backgroundLayer.dirty = true;
+    repaint();
+}
+
+void SpectrumAnalyzer::setShowPre(bool show)
+{
+    if (showPre == show)
+        return;
+
+    showPre = show;
+    spectrumDirty = true;
+    legendLayer.dirty = true;
+}
+
+void SpectrumAnalyzer::setShowPost(bool show)
+{
+    if (showPost == show)
+        return;
+
+    showPost = show;
+    spectrumDirty = true;
+    legendLayer.dirty = true;
+}
+
+void SpectrumAnalyzer::invalidateCachedLayers()
+{
+    backgroundLayer.dirty = true;
+    legendLayer.dirty = true;
     repaint();
 }
 
@@ -51,6 +92,7 @@ void SpectrumAnalyzer::setDBRange(DBRange range)
     }
     spectrumMaxDB = 0.0f;
 
+    invalidateGeometry();
     repaint();
 }
 
@@ -64,6 +106,7 @@ void SpectrumAnalyzer::setFrequencyRange(float minHz, float maxHz)
 {
     minFreq = minHz;
     maxFreq = maxHz;
+    invalidateGeometry();
     repaint();
 }
 
@@ -71,6 +114,7 @@ void SpectrumAnalyzer::setEQDecibelRange(float minDB, float maxDB)
 {
     eqMinDB = minDB;
     eqMaxDB = maxDB;
+    invalidateGeometry();
     repaint();
 }
 
@@ -181,28 +225,16 @@ void SpectrumAnalyzer::allocateBuffers(int width)
 
 void SpectrumAnalyzer::paint(juce::Graphics& g)
 {
-    // Hintergrund
-    g.fillAll(CustomLookAndFeel::getBackgroundDark());
+    const double paintStartMs = juce::Time::getMillisecondCounterHiRes();
 
-    // Grid und Skalen zeichnen
-    if (settings.showGrid)
-    {
-        drawGrid(g);
-    }
-    drawDualScales(g);
+    // Hintergrund, Grid, Skalen und Reference-Kurve aus dem Cache
+    drawCachedLayer(g, backgroundLayer, getLocalBounds(),
+                    [this](juce::Graphics& lg) { renderBackgroundLayer(lg); });
 
     if (!isEnabled)
-        return;
-    
-    // Reference-Spektrum (falls aktiviert) - Türkis/Cyan gestrichelt
-    if (showReferenceSpectrum && !referenceSpectrumPath.isEmpty())
     {
-        juce::PathStrokeType strokeType(1.5f);
-        float dashLengths[] = { 4.0f, 4.0f };
-        strokeType.createDashedStroke(referenceSpectrumPath, referenceSpectrumPath, 
-                                       dashLengths, 2);
-        g.setColour(juce::Colour(0xff00dddd).withAlpha(0.7f));  // Türkis
-        g.strokePath(referenceSpectrumPath, strokeType);
+        paintTiming.addFrame(juce::Time::getMillisecondCounterHiRes() - paintStartMs);
+        return;
     }
 
     // Pre-Spektrum (Input) - Grau, gestrichelt
@@ -242,10 +274,13 @@ void SpectrumAnalyzer::paint(juce::Graphics& g)
     }
 
     // Legende (PRE/POST)
-    if (showPre || showPost)
+    if (showPre && showPost)
     {
-        drawLegend(g);
+        drawCachedLayer(g, legendLayer, { 0, 0, 60, 36 },
+                        [this](juce::Graphics& lg) { drawLegend(lg); });
     }
+
+    paintTiming.addFrame(juce::Time::getMillisecondCounterHiRes() - paintStartMs);
 }
 
 void SpectrumAnalyzer::resized()
@@ -255,20 +290,189 @@ void SpectrumAnalyzer::resized()
     {
         allocateBuffers(width);
     }
+
+    invalidateGeometry();
 }
 
-void SpectrumAnalyzer::timerCallback()
+void SpectrumAnalyzer::renderFrame(double /*timestampMs*/)
 {
+    if (geometryDirty)
+        updateGeometry();
+
+    bool needsRepaint = false;
+
     if (isEnabled && (preFFT != nullptr || postFFT != nullptr))
     {
-        updatePaths();
+        // Neueste veröffentlichte Frames übernehmen (einmal pro Frame, konsistent für alle Punkte)
+        if (preFFT != nullptr)
+            preFFT->updateDisplayFrame();
+        if (postFFT != nullptr)
+            postFFT->updateDisplayFrame();
 
-        if (settings.showPeakLabels)
+        const uint32_t preVersion = (preFFT != nullptr) ? preFFT->getDisplayFrameVersion() : 0;
+        const uint32_t postVersion = (postFFT != nullptr) ? postFFT->getDisplayFrameVersion() : 0;
+
+        // Nur bei neuem Frame (oder geänderten Einstellungen) Pfade neu bauen
+        if (spectrumDirty || preVersion != renderedPreVersion || postVersion != renderedPostVersion)
         {
-            detectPeaks();
+            updatePaths();
+
+            if (settings.showPeakLabels)
+            {
+                detectPeaks();
+            }
+
+            renderedPreVersion = preVersion;
+            renderedPostVersion = postVersion;
+            spectrumDirty = false;
+            needsRepaint = true;
         }
+    }
 
+    // Reference-Kurve hängt von der Samplerate der Analyzer ab
+    const double sampleRate = getDisplaySampleRate();
+    if (sampleRate != referenceSampleRate)
+    {
+        referenceSampleRate = sampleRate;
+        backgroundLayer.dirty = true;
+    }
+
+    if (matchCurveDirty)
+    {
+        updateMatchCurvePath();
+        matchCurveDirty = false;
+        needsRepaint = true;
+    }
+
+    if (sootheDirty)
+    {
+        sootheDirty = false;
+        needsRepaint = true;
+    }
+
+    if (needsRepaint || backgroundLayer.dirty || legendLayer.dirty)
         repaint();
+}
+
+//==============================================================================
+// Geometrie: Frequenzraster und Tabellen (nur bei Größen-/Bereichsänderung)
+//==============================================================================
+
+void SpectrumAnalyzer::invalidateGeometry()
+{
+    geometryDirty = true;
+    spectrumDirty = true;
+    matchCurveDirty = true;
+    backgroundLayer.dirty = true;
+}
+
+void SpectrumAnalyzer::updateGeometry()
+{
+    geometryDirty = false;
+
+    const int width = getWidth() - rightMargin;
+    if (width <= 0 || getHeight() <= 0)
+    {
+        preTable.setFrequencies(nullptr, 0);
+        postTable.setFrequencies(nullptr, 0);
+        pixelFrequencies.clear();
+        return;
+    }
+
+    allocateBuffers(getWidth());
+
+    // Spektrum: OVERSAMPLE Punkte pro Pixel
+    const int totalPoints = width * OVERSAMPLE;
+    std::vector<float> frequencies(static_cast<size_t>(totalPoints));
+    for (int i = 0; i < totalPoints; ++i)
+        frequencies[static_cast<size_t>(i)] = xToFrequency(static_cast<float>(i) / static_cast<float>(OVERSAMPLE));
+
+    preTable.setFrequencies(frequencies.data(), totalPoints);
+    postTable.setFrequencies(frequencies.data(), totalPoints);
+
+    // Ein Punkt pro Pixel (Reference, Match, Soothe)
+    pixelFrequencies.resize(static_cast<size_t>(width));
+    for (int px = 0; px < width; ++px)
+        pixelFrequencies[static_cast<size_t>(px)] = xToFrequency(static_cast<float>(px));
+
+    sootheCurvePoints.assign(static_cast<size_t>(width), 0.0f);
+    sootheSmoothed.assign(static_cast<size_t>(width), 0.0f);
+
+    // Peak-Suche: feste logarithmische Stützstellen
+    frequencies.resize(static_cast<size_t>(PEAK_SEARCH_POINTS));
+    for (int i = 0; i < PEAK_SEARCH_POINTS; ++i)
+        frequencies[static_cast<size_t>(i)] = minFreq * std::pow(maxFreq / minFreq,
+                                                                 static_cast<float>(i) / static_cast<float>(PEAK_SEARCH_POINTS - 1));
+
+    peakTable.setFrequencies(frequencies.data(), PEAK_SEARCH_POINTS);
+    peakSearchDb.resize(static_cast<size_t>(PEAK_SEARCH_POINTS));
+}
+
+double SpectrumAnalyzer::getDisplaySampleRate() const
+{
+    return (preFFT != nullptr) ? preFFT->getSampleRate()
+         : (postFFT != nullptr) ? postFFT->getSampleRate()
+         : 44100.0;
+}
+
+//==============================================================================
+// Gecachte Ebenen
+//==============================================================================
+
+template <typename RenderFn>
+void SpectrumAnalyzer::drawCachedLayer(juce::Graphics& g, CachedLayer& layer,
+                                       juce::Rectangle<int> area, RenderFn&& render)
+{
+    if (area.isEmpty())
+        return;
+
+    // In physikalischer Auflösung cachen (HiDPI bleibt scharf)
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    const int imageWidth = juce::roundToInt(static_cast<float>(area.getWidth()) * scale);
+    const int imageHeight = juce::roundToInt(static_cast<float>(area.getHeight()) * scale);
+
+    if (layer.dirty || layer.scale != scale
+        || layer.image.getWidth() != imageWidth || layer.image.getHeight() != imageHeight)
+    {
+        layer.image = juce::Image(juce::Image::ARGB, juce::jmax(1, imageWidth), juce::jmax(1, imageHeight), true);
+
+        juce::Graphics lg(layer.image);
+        lg.addTransform(juce::AffineTransform::scale(scale));
+        lg.setOrigin(-area.getPosition());
+        render(lg);
+
+        layer.scale = scale;
+        layer.dirty = false;
+    }
+
+    g.drawImage(layer.image, area.toFloat());
+}
+
+void SpectrumAnalyzer::renderBackgroundLayer(juce::Graphics& g)
+{
+    g.fillAll(CustomLookAndFeel::getBackgroundDark());
+
+    // Grid und Skalen zeichnen
+    if (settings.showGrid)
+    {
+        drawGrid(g);
+    }
+    drawDualScales(g);
+
+    // Reference-Spektrum (falls aktiviert) - Türkis/Cyan gestrichelt
+    if (isEnabled && showReferenceSpectrum && !referenceSpectrumData.empty())
+    {
+        updateReferenceSpectrumPath();
+
+        if (!referenceSpectrumPath.isEmpty())
+        {
+            juce::Path dashedPath;
+            juce::PathStrokeType strokeType(1.5f);
+            const float dashLengths[] = { 4.0f, 4.0f };
+            strokeType.createDashedStroke(dashedPath, referenceSpectrumPath, dashLengths, 2);
+            g.setColour(juce::Colour(0xff00dddd).withAlpha(0.7f));  // Türkis
+            g.strokePath(dashedPath, strokeType);
+        }
     }
 }
 
@@ -284,13 +488,10 @@ void SpectrumAnalyzer::updatePaths()
     if (width <= 0 || height <= 0)
         return;
 
-    // Buffers sicherstellen
-    allocateBuffers(width);
-
     // Pre-Spektrum
     if (preFFT != nullptr && showPre)
     {
-        updateSinglePath(preFFT, preSpectrumPath, preYValues);
+        updateSinglePath(preFFT, preTable, preSpectrumPath, preYValues);
     }
     else
     {
@@ -300,39 +501,20 @@ void SpectrumAnalyzer::updatePaths()
     // Post-Spektrum
     if (postFFT != nullptr && showPost)
     {
-        updateSinglePath(postFFT, postSpectrumPath, postYValues);
+        updateSinglePath(postFFT, postTable, postSpectrumPath, postYValues);
     }
     else
     {
         postSpectrumPath.clear();
     }
-    
-    // Reference-Spektrum (aus geladener Audio-Datei)
-    if (showReferenceSpectrum && !referenceSpectrumData.empty())
-    {
-        updateReferenceSpectrumPath();
-    }
-    else
-    {
-        referenceSpectrumPath.clear();
-    }
-    
-    // NEU: Match-Kurve (Korrektur vom SpectralMatcher)
-    if (showMatchCurve && !matchCurveData.empty())
-    {
-        updateMatchCurvePath();
-    }
-    else
-    {
-        matchCurvePath.clear();
-    }
 }
 
-void SpectrumAnalyzer::updateSinglePath(FFTAnalyzer* fft, juce::Path& path, std::vector<float>& yValues)
+void SpectrumAnalyzer::updateSinglePath(FFTAnalyzer* fft, SpectrumPixelTable& table,
+                                        juce::Path& path, std::vector<float>& yValues)
 {
     const int width = getWidth() - rightMargin;
     const int height = getHeight();
-    const int totalPoints = width * OVERSAMPLE;
+    const int totalPoints = table.getNumPoints();
 
     if (width <= 0 || height <= 0 || totalPoints <= 0)
         return;
@@ -340,70 +522,87 @@ void SpectrumAnalyzer::updateSinglePath(FFTAnalyzer* fft, juce::Path& path, std:
     // KRITISCH: Buffer-Groesse pruefen
     const size_t requiredSize = static_cast<size_t>(totalPoints);
     if (yValues.size() < requiredSize || smoothingTemp.size() < requiredSize)
-    {
-        allocateBuffers(getWidth());
-        if (yValues.size() < requiredSize || smoothingTemp.size() < requiredSize)
-            return;
-    }
+        return;
 
     path.clear();
-    float maxDbSeen = -200.0f;
 
-    // Y-Werte berechnen (verwendet pre-allozierte Buffers!)
-    for (int i = 0; i < totalPoints; ++i)
+    // dB-Werte (inkl. Tilt) aus der Tabelle, ohne pow/log2 pro Punkt
+    float* values = yValues.data();
+    if (!table.evaluate(*fft, values))
+        return;
+
+    const float maxDbSeen = juce::FloatVectorOperations::findMaximum(values, totalPoints);
+    if (maxDbSeen <= spectrumMinDB)
+        return;
+
+    // Auf sichtbaren Bereich clippen und in Y umrechnen (y = db * scale + offset)
+    const float pixelsPerDb = static_cast<float>(height) / (spectrumMaxDB - spectrumMinDB);
+    juce::FloatVectorOperations::clip(values, values, spectrumMinDB, spectrumMaxDB, totalPoints);
+    juce::FloatVectorOperations::multiply(values, -pixelsPerDb, totalPoints);
+    juce::FloatVectorOperations::add(values, spectrumMaxDB * pixelsPerDb, totalPoints);
+
+    // Gaussian-Glättung (2 Durchläufe)
+    for (int pass = 0; pass < 2; ++pass)
+        smoothSpectrum(yValues, totalPoints);
+
+    // Pfad erstellen
+    path.preallocateSpace(3 * (totalPoints + 3));
+    path.startNewSubPath(0.0f, yValues[0]);
+
+    const float xStep = 1.0f / static_cast<float>(OVERSAMPLE);
+    for (int i = 1; i < totalPoints; ++i)
     {
-        float x = static_cast<float>(i) / static_cast<float>(OVERSAMPLE);
-        float freq = xToFrequency(x);
-        float dbRaw = fft->getMagnitudeForFrequency(freq);
-        maxDbSeen = juce::jmax(maxDbSeen, dbRaw);
+        path.lineTo(static_cast<float>(i) * xStep, yValues[static_cast<size_t>(i)]);
+    }
 
-        // Auf sichtbaren Bereich clippen
-        float db = juce::jlimit(spectrumMinDB, spectrumMaxDB, dbRaw);
-        float y = spectrumDbToY(db);
-        y = juce::jlimit(0.0f, static_cast<float>(height), y);
-        yValues[static_cast<size_t>(i)] = y;
+    // Zum unteren Rand für Füllung
+    path.lineTo(static_cast<float>(width), static_cast<float>(height));
+    path.lineTo(0.0f, static_cast<float>(height));
+    path.closeSubPath();
+}
+
+void SpectrumAnalyzer::smoothSpectrum(std::vector<float>& yValues, int numPoints)
+{
+    // 7-Punkt Moving Average mit Gaussian-Gewichtung
+    const int radius = SMOOTHING_RADIUS;
+    const float* source = yValues.data();
+    float* dest = smoothingTemp.data();
+
+    // Innenbereich: ein Vektor-Multiply-Add pro Tap (Gewichte sind normiert)
+    const int interior = numPoints - 2 * radius;
+    if (interior > 0)
+    {
+        juce::FloatVectorOperations::copyWithMultiply(dest + radius, source, smoothingWeights[0], interior);
+        for (int tap = 1; tap <= 2 * radius; ++tap)
+            juce::FloatVectorOperations::addWithMultiply(dest + radius, source + tap,
+                                                         smoothingWeights[static_cast<size_t>(tap)], interior);
     }
 
-    // Gaussian-Glättung (2 Durchläufe)
-    if (maxDbSeen > spectrumMinDB && !yValues.empty())
+    // Ränder: nur vorhandene Nachbarn, Gewichte neu normieren
+    for (int i = 0; i < numPoints; ++i)
     {
-        for (int pass = 0; pass < 2; ++pass)
-        {
-            for (size_t i = 0; i < static_cast<size_t>(totalPoints); ++i)
-            {
-                float sum = 0.0f;
-                float weightSum = 0.0f;
-
-                // 7-Punkt Moving Average mit Gaussian-Gewichtung
-                for (int j = -3; j <= 3; ++j)
-                {
-                    int idx = static_cast<int>(i) + j;
-                    if (idx >= 0 && idx < totalPoints)
-                    {
-                        float weight = std::exp(-static_cast<float>(j * j) / 8.0f);
-                        sum += yValues[static_cast<size_t>(idx)] * weight;
-                        weightSum += weight;
-                    }
-                }
-                smoothingTemp[i] = sum / weightSum;
-            }
-            std::copy(smoothingTemp.begin(), smoothingTemp.begin() + totalPoints, yValues.begin());
-        }
+        if (i == radius && interior > 0)
+            i = numPoints - radius;
+        if (i >= numPoints)
+            break;
 
-        // Pfad erstellen
-        path.startNewSubPath(0.0f, yValues[0]);
+        float sum = 0.0f;
+        float weightSum = 0.0f;
 
-        for (int i = 1; i < totalPoints; ++i)
+        for (int j = -radius; j <= radius; ++j)
         {
-            float x = static_cast<float>(i) / static_cast<float>(OVERSAMPLE);
-            path.lineTo(x, yValues[static_cast<size_t>(i)]);
+            const int idx = i + j;
+            if (idx >= 0 && idx < numPoints)
+            {
+                const float weight = smoothingWeights[static_cast<size_t>(j + radius)];
+                sum += source[idx] * weight;
+                weightSum += weight;
+            }
         }
-
-        // Zum unteren Rand für Füllung
-        path.lineTo(static_cast<float>(width), static_cast<float>(height));
-        path.lineTo(0.0f, static_cast<float>(height));
-        path.closeSubPath();
+        dest[i] = sum / weightSum;
     }
+
+    std::copy(smoothingTemp.begin(), smoothingTemp.begin() + numPoints, yValues.begin());
 }
 
 //==============================================================================
@@ -412,22 +611,16 @@ void SpectrumAnalyzer::updateSinglePath(FFTAnalyzer* fft, juce::Path& path, std:
 
 void SpectrumAnalyzer::updateReferenceSpectrumPath()
 {
-    const int width = getWidth() - rightMargin;
-    const int height = getHeight();
-    
-    if (width <= 0 || height <= 0 || referenceSpectrumData.empty())
-    {
-        referenceSpectrumPath.clear();
-        return;
-    }
+    const int width = static_cast<int>(pixelFrequencies.size());
     
     referenceSpectrumPath.clear();
+
+    if (width <= 0 || getHeight() <= 0 || referenceSpectrumData.empty())
+        return;
     
     const size_t numBins = referenceSpectrumData.size();
-    const float sampleRate = (preFFT != nullptr) ? static_cast<float>(preFFT->getSampleRate()) 
-                           : (postFFT != nullptr) ? static_cast<float>(postFFT->getSampleRate()) 
-                           : 44100.0f;
-    const float binWidth = sampleRate / (2.0f * static_cast<float>(numBins));
+    const float sampleRate = static_cast<float>(getDisplaySampleRate());
+    const float binsPerHz = (2.0f * static_cast<float>(numBins)) / sampleRate;
     
     // Offset um das Reference-Spektrum auf ähnliche Höhe wie Live-Spektrum zu bringen
     // FFT-Magnitudes aus Datei sind typischerweise höher als Echtzeit-FFT
@@ -437,10 +630,8 @@ void SpectrumAnalyzer::updateReferenceSpectrumPath()
     
     for (int pixelX = 0; pixelX < width; ++pixelX)
     {
-        float freq = xToFrequency(static_cast<float>(pixelX));
-        
         // Bin-Index für diese Frequenz finden
-        int binIndex = static_cast<int>(freq / binWidth);
+        int binIndex = static_cast<int>(pixelFrequencies[static_cast<size_t>(pixelX)] * binsPerHz);
         if (binIndex < 0 || binIndex >= static_cast<int>(numBins))
             continue;
         
@@ -465,22 +656,18 @@ void SpectrumAnalyzer::updateReferenceSpectrumPath()
 
 void SpectrumAnalyzer::updateMatchCurvePath()
 {
-    const int width = getWidth() - rightMargin;
+    const int width = static_cast<int>(pixelFrequencies.size());
     const int height = getHeight();
     
-    if (width <= 0 || height <= 0 || matchCurveData.empty())
-    {
-        matchCurvePath.clear();
-        return;
-    }
-    
     matchCurvePath.clear();
+    matchCurveStroke.clear();
+
+    if (!showMatchCurve || width <= 0 || height <= 0 || matchCurveData.empty())
+        return;
     
     const size_t numBins = matchCurveData.size();
-    const float sampleRate = (preFFT != nullptr) ? static_cast<float>(preFFT->getSampleRate()) 
-                           : (postFFT != nullptr) ? static_cast<float>(postFFT->getSampleRate()) 
-                           : 44100.0f;
-    const float binWidth = sampleRate / (2.0f * static_cast<float>(numBins));
+    const float sampleRate = static_cast<float>(getDisplaySampleRate());
+    const float binsPerHz = (2.0f * static_cast<float>(numBins)) / sampleRate;
     
     // Für Match-Kurve: 0 dB = Mitte, ±12 dB sichtbar
     const float centerY = static_cast<float>(height) / 2.0f;
@@ -491,10 +678,8 @@ void SpectrumAnalyzer::updateMatchCurvePath()
     
     for (int pixelX = 0; pixelX < width; ++pixelX)
     {
-        float freq = xToFrequency(static_cast<float>(pixelX));
-        
         // Bin-Index für diese Frequenz finden
-        int binIndex = static_cast<int>(freq / binWidth);
+        int binIndex = static_cast<int>(pixelFrequencies[static_cast<size_t>(pixelX)] * binsPerHz);
         if (binIndex < 0 || binIndex >= static_cast<int>(numBins))
             continue;
         
@@ -516,6 +701,11 @@ void SpectrumAnalyzer::updateMatchCurvePath()
             matchCurvePath.lineTo(static_cast<float>(pixelX), y);
         }
     }
+
+    // Gestrichelte Kontur einmal pro Datenänderung (nicht pro Paint)
+    juce::PathStrokeType stroke(2.0f, juce::PathStrokeType::curved);
+    const float dashes[] = { 6.0f, 4.0f };
+    stroke.createDashedStroke(matchCurveStroke, matchCurvePath, dashes, 2);
 }
 
 void SpectrumAnalyzer::drawMatchCurve(juce::Graphics& g)
@@ -526,16 +716,9 @@ void SpectrumAnalyzer::drawMatchCurve(juce::Graphics& g)
     // Farbe: Gelb/Gold für Match-Kurve (unterscheidet sich von Reference=Cyan)
     juce::Colour matchColour(0xffddaa00);  // Gold
     
-    // Gestrichelte Linie
-    juce::Path strokedPath;
-    juce::PathStrokeType stroke(2.0f, juce::PathStrokeType::curved);
-    
-    float dashes[] = { 6.0f, 4.0f };
-    stroke.createDashedStroke(strokedPath, matchCurvePath, dashes, 2);
-    
-    // Zeichnen mit Semi-Transparenz
+    // Gestrichelte Linie (vorberechnet in updateMatchCurvePath), mit Semi-Transparenz
     g.setColour(matchColour.withAlpha(0.8f));
-    g.fillPath(strokedPath);
+    g.fillPath(matchCurveStroke);
     
     // Beschriftung "MATCH" oben links
     g.setFont(10.0f);
@@ -556,37 +739,26 @@ void SpectrumAnalyzer::detectPeaks()
     }
 
     FFTAnalyzer* fft = (showPost && postFFT != nullptr) ? postFFT : preFFT;
-    if (fft == nullptr)
+    if (fft == nullptr || peakSearchDb.size() < static_cast<size_t>(PEAK_SEARCH_POINTS))
         return;
 
-    const int numSamples = 256;  // Anzahl der Samples für Peak-Detection
     const float minPeakDb = spectrumMinDB + 20.0f;  // Mindestens 20 dB über Floor
 
-    struct LocalPeak {
-        float frequency;
-        float magnitude;
-    };
-    std::vector<LocalPeak> localPeaks;
+    // Stützstellen aus der Tabelle (ohne pow/log2 pro Punkt)
+    if (!peakTable.evaluate(*fft, peakSearchDb.data()))
+        return;
 
-    // Lokale Maxima finden
-    float prevDb = fft->getMagnitudeForFrequency(minFreq);
-    float currDb = prevDb;
+    const float* db = peakSearchDb.data();
+    const float* frequencies = peakTable.getFrequencies();
+    localPeaks.clear();
 
-    for (int i = 1; i < numSamples - 1; ++i)
+    // Lokale Maxima finden
+    for (int i = 1; i < PEAK_SEARCH_POINTS - 1; ++i)
     {
-        float freq = minFreq * std::pow(maxFreq / minFreq, static_cast<float>(i) / static_cast<float>(numSamples - 1));
-        float nextFreq = minFreq * std::pow(maxFreq / minFreq, static_cast<float>(i + 1) / static_cast<float>(numSamples - 1));
-
-        float nextDb = fft->getMagnitudeForFrequency(nextFreq);
-
-        // Lokales Maximum?
-        if (currDb > prevDb && currDb > nextDb && currDb > minPeakDb)
+        if (db[i] > db[i - 1] && db[i] > db[i + 1] && db[i] > minPeakDb)
         {
-            localPeaks.push_back({ freq, currDb });
+            localPeaks.push_back({ frequencies[i], db[i] });
         }
-
-        prevDb = currDb;
-        currDb = nextDb;
     }
 
     // Nach Magnitude sortieren (größte zuerst)
@@ -784,28 +956,34 @@ void SpectrumAnalyzer::drawSpectrum(juce::Graphics& g, const juce::Path& path, j
 
 void SpectrumAnalyzer::setSootheCurveData(const float* gainReductions, int numBins, double sr, int fftSz)
 {
-    if (gainReductions == nullptr || numBins <= 0 || getWidth() <= 0 || fftSz <= 0 || sr <= 0.0)
+    sootheDirty = true;
+
+    const int numPixels = static_cast<int>(pixelFrequencies.size());
+    if (gainReductions == nullptr || numBins <= 0 || numPixels <= 0 || fftSz <= 0 || sr <= 0.0
+        || sootheCurvePoints.size() < pixelFrequencies.size() || sootheSmoothed.size() < pixelFrequencies.size())
     {
         sootheCurvePath.clear();
         return;
     }
 
     const float height = static_cast<float>(getHeight());
-    const float width = static_cast<float>(getWidth() - rightMargin);
     const float zeroY = eqDbToY(0.0f);  // 0 dB Linie (EQ-Skala)
+    const float binsPerHz = static_cast<float>(fftSz) / static_cast<float>(sr);
     
-    // Schritt 1: Rohdaten pro Pixel sammeln
-    const int numPixels = static_cast<int>(width);
-    std::vector<float> rawGr(numPixels, 0.0f);
+    // Schritt 1: Rohdaten pro Pixel sammeln (Frequenzen aus dem Pixel-Raster)
+    float* rawGr = sootheCurvePoints.data();
+    float* smoothedGr = sootheSmoothed.data();
     
     for (int px = 0; px < numPixels; ++px)
     {
-        float freq = xToFrequency(static_cast<float>(px));
+        rawGr[px] = 0.0f;
+
+        const float freq = pixelFrequencies[static_cast<size_t>(px)];
         if (freq < 20.0f || freq > 20000.0f)
             continue;
         
         // Frequenz zu FFT-Bin (mit Interpolation zwischen benachbarten Bins)
-        float exactBin = freq * static_cast<float>(fftSz) / static_cast<float>(sr);
+        float exactBin = freq * binsPerHz;
         int bin0 = static_cast<int>(exactBin);
         int bin1 = bin0 + 1;
         float frac = exactBin - static_cast<float>(bin0);
@@ -814,13 +992,11 @@ void SpectrumAnalyzer::setSootheCurveData(const float* gainReductions, int numBi
             continue;
         
         // Interpolierter Gain-Reduction Wert
-        float gr = gainReductions[bin0] * (1.0f - frac) + gainReductions[bin1] * frac;
-        rawGr[px] = gr;
+        rawGr[px] = gainReductions[bin0] * (1.0f - frac) + gainReductions[bin1] * frac;
     }
     
     // Schritt 2: Glättung über benachbarte Pixel (Gauss-artig)
-    std::vector<float> smoothedGr(numPixels, 0.0f);
-    const int smoothRadius = 4;  // Pixel-Radius für Glättung
+    constexpr int smoothRadius = 4;  // Pixel-Radius für Glättung
     for (int px = 0; px < numPixels; ++px)
     {
         float sum = 0.0f;
@@ -840,21 +1016,13 @@ void SpectrumAnalyzer::setSootheCurveData(const float* gainReductions, int numBi
     
     // Schritt 3: Schwellwert anwenden — unter -0.5 dB zählt als "keine Reduktion"
     const float displayThreshold = -0.5f;
+    bool hasReduction = false;
     for (int px = 0; px < numPixels; ++px)
     {
         if (smoothedGr[px] > displayThreshold)
             smoothedGr[px] = 0.0f;
-    }
-    
-    // Prüfen ob überhaupt irgendwo Reduktion stattfindet
-    bool hasReduction = false;
-    for (int px = 0; px < numPixels; ++px)
-    {
-        if (smoothedGr[px] < displayThreshold)
-        {
+        else
             hasReduction = true;
-            break;
-        }
     }
     
     if (!hasReduction)
@@ -865,6 +1033,7 @@ void SpectrumAnalyzer::setSootheCurveData(const float* gainReductions, int numBi
     
     // Schritt 4: Pfad aufbauen
     sootheCurvePath.clear();
+    sootheCurvePath.preallocateSpace(3 * (numPixels + 3));
     sootheCurvePath.startNewSubPath(0.0f, zeroY);
     
     for (int px = 0; px < numPixels; ++px)
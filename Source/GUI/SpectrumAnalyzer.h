@@ -3,6 +3,8 @@
 #include <JuceHeader.h>
 #include "../DSP/FFTAnalyzer.h"
 #include "CustomLookAndFeel.h"
+#include "RenderClock.h"
+#include "SpectrumPixelTable.h"
 
 /**
  * SpectrumAnalyzer: Pro-Q3/Pro-Q4 Style Spektrum-Visualisierung.
@@ -14,9 +16,18 @@
  * - Hover-Frequenzanzeige
  * - Peak-Detection und Labels
  * - Pre-allozierte Buffers für Performance
+ *
+ * Rendering (Retained Mode, getaktet vom RenderClock des Editors):
+ * - Pfade werden nur neu gebaut, wenn ein neuer FFT-Frame vorliegt oder sich
+ *   Geometrie/Einstellungen geändert haben; ohne Änderung kein Repaint
+ * - Bin/Interpolation/Tilt pro Punkt sind tabelliert (SpectrumPixelTable),
+ *   Skalierung und Glättung laufen als Vektor-Operationen
+ * - Statische Ebenen (Hintergrund, Grid, Skalen, Reference-Kurve, Legende) liegen
+ *   als Images in physikalischer Auflösung vor und werden nur bei Änderungen neu
+ *   gezeichnet; gestrichelte Kurven werden einmal pro Datenänderung erzeugt
  */
 class SpectrumAnalyzer : public juce::Component,
-                         public juce::Timer
+                         public RenderClock::Client
 {
 public:
     //==========================================================================
@@ -56,13 +67,11 @@ public:
     SpectrumAnalyzer();
     ~SpectrumAnalyzer() override;
     
-    // Timer-Kontrolle - muss nach vollständiger Initialisierung aufgerufen werden
-    void startAnalyzer() { startTimerHz(60); }
-    void stopAnalyzer() { stopTimer(); }
-
     void paint(juce::Graphics& g) override;
     void resized() override;
-    void timerCallback() override;
+
+    // RenderClock::Client (Aufruf pro fälligem Frame, Message-Thread)
+    void renderFrame(double timestampMs) override;
 
     //==========================================================================
     // Mouse-Events für Hover-Anzeige
@@ -79,10 +88,10 @@ public:
     //==========================================================================
     // Anzeige-Einstellungen
     //==========================================================================
-    void setShowPre(bool show) { showPre = show; }
+    void setShowPre(bool show);
     bool getShowPre() const { return showPre; }
 
-    void setShowPost(bool show) { showPost = show; }
+    void setShowPost(bool show);
     bool getShowPost() const { return showPost; }
 
     void setEnabled(bool enabled);
@@ -100,29 +109,46 @@ public:
     void setSettings(const Settings& newSettings);
     const Settings& getSettings() const { return settings; }
 
-    void setShowPeakLabels(bool show) { settings.showPeakLabels = show; }
+    void setShowPeakLabels(bool show) { settings.showPeakLabels = show; spectrumDirty = true; }
     void setShowHoverInfo(bool show) { settings.showHoverInfo = show; }
-    void setShowGrid(bool show) { settings.showGrid = show; }
+    void setShowGrid(bool show) { settings.showGrid = show; backgroundLayer.dirty = true; }
+
+    // Analyzer-Einstellungen ohne neuen Frame geändert (z.B. Tilt im Freeze-Modus)
+    void invalidateSpectrum() { spectrumDirty = true; }
+
+    // Farben geändert (Theme/Farbschema): gecachte Ebenen neu zeichnen
+    void invalidateCachedLayers();
+
+    // Paint-Dauer pro Frame (ms), ergänzt RenderClock::getFrameTiming()
+    const RenderClock::FrameTiming& getPaintTiming() const { return paintTiming; }
     
     //==========================================================================
     // Reference Spectrum (für Vergleich mit geladenen Audio-Dateien)
     //==========================================================================
-    void setReferenceSpectrumEnabled(bool enabled) { showReferenceSpectrum = enabled; }
+    void setReferenceSpectrumEnabled(bool enabled) { showReferenceSpectrum = enabled; backgroundLayer.dirty = true; }
     bool isReferenceSpectrumEnabled() const { return showReferenceSpectrum; }
-    void setReferenceSpectrum(const std::vector<float>& magnitudes) { referenceSpectrumData = magnitudes; }
+    void setReferenceSpectrum(const std::vector<float>& magnitudes)
+    {
+        referenceSpectrumData = magnitudes;
+        backgroundLayer.dirty = true;
+    }
     
     //==========================================================================
     // NEU: Match Curve Overlay (Korrektur-Kurve vom SpectralMatcher)
     //==========================================================================
-    void setMatchCurveEnabled(bool enabled) { showMatchCurve = enabled; }
+    void setMatchCurveEnabled(bool enabled) { showMatchCurve = enabled; matchCurveDirty = true; }
     bool isMatchCurveEnabled() const { return showMatchCurve; }
-    void setMatchCurve(const std::vector<float>& correctionDb) { matchCurveData = correctionDb; }
-    void clearMatchCurve() { matchCurveData.clear(); showMatchCurve = false; }
+    void setMatchCurve(const std::vector<float>& correctionDb) { matchCurveData = correctionDb; matchCurveDirty = true; }
+    void clearMatchCurve() { matchCurveData.clear(); showMatchCurve = false; matchCurveDirty = true; }
 
     //==========================================================================
     // Soothe/Suppressor Visualization
     //==========================================================================
-    void setSootheCurveEnabled(bool enabled) { showSootheCurve = enabled; }
+    void setSootheCurveEnabled(bool enabled)
+    {
+        sootheDirty = sootheDirty || (showSootheCurve != enabled);
+        showSootheCurve = enabled;
+    }
     bool isSootheCurveEnabled() const { return showSootheCurve; }
     void setSootheCurveData(const float* gainReductions, int numBins, double sampleRate, int fftSize);
 
@@ -197,8 +223,17 @@ private:
     // Peak-Detection
     //==========================================================================
     static constexpr int MAX_PEAKS = 5;
+    static constexpr int PEAK_SEARCH_POINTS = 256;
     std::array<PeakInfo, MAX_PEAKS> detectedPeaks;
 
+    struct LocalPeak
+    {
+        float frequency;
+        float magnitude;
+    };
+    std::vector<LocalPeak> localPeaks;   // reserviert, keine Allokation pro Frame
+    std::vector<float> peakSearchDb;
+
     //==========================================================================
     // Pre-allozierte Buffers für Performance (WICHTIG!)
     //==========================================================================
@@ -208,6 +243,39 @@ private:
     int lastWidth = 0;
     static constexpr int OVERSAMPLE = 4;
 
+    //==========================================================================
+    // Tabellierte Frequenzraster (neu nur bei Größen-/Bereichsänderung)
+    //==========================================================================
+    SpectrumPixelTable preTable;             // OVERSAMPLE Punkte pro Pixel
+    SpectrumPixelTable postTable;
+    SpectrumPixelTable peakTable;            // PEAK_SEARCH_POINTS log. verteilt
+    std::vector<float> pixelFrequencies;     // ein Eintrag pro Pixel (Reference/Match/Soothe)
+    bool geometryDirty = true;
+
+    // Gauss-Kern der Spektrum-Glättung (7 Punkte, normiert)
+    static constexpr int SMOOTHING_RADIUS = 3;
+    std::array<float, 2 * SMOOTHING_RADIUS + 1> smoothingWeights {};
+
+    // Zuletzt gerenderte Frame-Versionen → ohne neuen Frame kein Neuaufbau
+    uint32_t renderedPreVersion = 0;
+    uint32_t renderedPostVersion = 0;
+    bool spectrumDirty = true;
+
+    //==========================================================================
+    // Gecachte Ebenen (Images in physikalischer Auflösung)
+    //==========================================================================
+    struct CachedLayer
+    {
+        juce::Image image;
+        float scale = 0.0f;
+        bool dirty = true;
+    };
+    CachedLayer backgroundLayer;   // Hintergrund, Grid, Skalen, Reference-Kurve
+    CachedLayer legendLayer;       // IN/OUT-Legende
+    double referenceSampleRate = 0.0;
+
+    RenderClock::FrameTiming paintTiming;
+
     //==========================================================================
     // Spektrum-Pfade
     //==========================================================================
@@ -229,6 +297,8 @@ private:
     std::vector<float> matchCurveData;
     std::vector<float> matchCurveYValues;
     juce::Path matchCurvePath;
+    juce::Path matchCurveStroke;   // gestrichelt, nur bei Datenänderung neu
+    bool matchCurveDirty = true;
 
     //==========================================================================
     // Soothe/Suppressor Visualization
@@ -236,16 +306,26 @@ private:
     bool showSootheCurve = false;
     juce::Path sootheCurvePath;
     std::vector<float> sootheCurvePoints;  // x -> gainReduction in dB
+    std::vector<float> sootheSmoothed;
+    bool sootheDirty = false;
 
     //==========================================================================
     // Interne Methoden
     //==========================================================================
     void allocateBuffers(int width);
+    void invalidateGeometry();
+    void updateGeometry();
     void updatePaths();
-    void updateSinglePath(FFTAnalyzer* fft, juce::Path& path, std::vector<float>& yValues);
+    void updateSinglePath(FFTAnalyzer* fft, SpectrumPixelTable& table, juce::Path& path, std::vector<float>& yValues);
+    void smoothSpectrum(std::vector<float>& yValues, int numPoints);
     void updateReferenceSpectrumPath();
     void updateMatchCurvePath();  // NEU
     void detectPeaks();
+    double getDisplaySampleRate() const;
+
+    template <typename RenderFn>
+    void drawCachedLayer(juce::Graphics& g, CachedLayer& layer, juce::Rectangle<int> area, RenderFn&& render);
+    void renderBackgroundLayer(juce::Graphics& g);
 
     void drawGrid(juce::Graphics& g);
     void drawSpectrum(juce::Graphics& g, const juce::Path& path, juce::Colour colour, bool isPre = false);
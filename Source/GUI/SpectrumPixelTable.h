@@ -0,0 +1,131 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../DSP/FFTAnalyzer.h"
+#include <cmath>
+#include <vector>
+
+/**
+ * SpectrumPixelTable: Abbildung eines festen Frequenzrasters (Pixel des Analyzers)
+ * auf die Bins eines FFTAnalyzer-Frames.
+ *
+ * - Pro Rasterpunkt werden unterer Bin, Interpolationsanteil und Tilt (dB) einmal
+ *   vorberechnet — neu nur bei Größenänderung, anderer FFT-Größe/Samplerate oder
+ *   geänderten Tilt-Einstellungen
+ * - evaluate() ist danach nur noch ein Gather + Lerp + Vektor-Add, ohne pow/log2
+ *   pro Punkt (identisch zu FFTAnalyzer::getMagnitudeForFrequency())
+ */
+class SpectrumPixelTable
+{
+public:
+    /** Setzt das Frequenzraster in Hz (alloziert; invalidiert die Bin-Tabelle). */
+    void setFrequencies(const float* frequencies, int numFrequencies)
+    {
+        numPoints = juce::jmax(0, numFrequencies);
+        pointFrequencies.assign(frequencies, frequencies + numPoints);
+        lowerBins.assign(static_cast<size_t>(numPoints), 0);
+        fractions.assign(static_cast<size_t>(numPoints), 0.0f);
+        tiltDb.assign(static_cast<size_t>(numPoints), 0.0f);
+        valid = false;
+    }
+
+    int getNumPoints() const { return numPoints; }
+    const float* getFrequencies() const { return pointFrequencies.data(); }
+
+    /**
+     * Interpolierte dB-Werte (inkl. Tilt) des aktuellen Display-Frames nach dest.
+     * @return false wenn noch kein Frame vorliegt (dest bleibt unverändert)
+     */
+    bool evaluate(const FFTAnalyzer& fft, float* dest)
+    {
+        const auto& magnitudes = fft.getDisplayMagnitudes();
+        const int numBins = static_cast<int>(magnitudes.size());
+
+        if (numPoints == 0 || numBins < 2 || fft.getDisplayFftSize() <= 0 || fft.getSampleRate() <= 0.0)
+            return false;
+
+        rebuildIfNeeded(fft, numBins);
+
+        const float* mags = magnitudes.data();
+        const int* bins = lowerBins.data();
+        const float* frac = fractions.data();
+
+        for (int i = 0; i < numPoints; ++i)
+        {
+            const float lower = mags[bins[i]];
+            dest[i] = lower + frac[i] * (mags[bins[i] + 1] - lower);
+        }
+
+        if (tiltActive)
+            juce::FloatVectorOperations::add(dest, tiltDb.data(), numPoints);
+
+        return true;
+    }
+
+private:
+    void rebuildIfNeeded(const FFTAnalyzer& fft, int numBins)
+    {
+        const int fftSize = fft.getDisplayFftSize();
+        const double sampleRate = fft.getSampleRate();
+        const bool tiltEnabled = fft.isTiltEnabled();
+        const float tiltSlope = fft.getTiltSlope();
+        const float tiltCenter = fft.getTiltCenterFrequency();
+
+        if (valid && fftSize == keyFftSize && numBins == keyNumBins && sampleRate == keySampleRate
+            && tiltEnabled == keyTiltEnabled && tiltSlope == keyTiltSlope && tiltCenter == keyTiltCenter)
+            return;
+
+        const float binsPerHz = static_cast<float>(fftSize) / static_cast<float>(sampleRate);
+
+        for (size_t i = 0; i < static_cast<size_t>(numPoints); ++i)
+        {
+            const float frequency = pointFrequencies[i];
+            const float exactBin = frequency * binsPerHz;
+            int lower = static_cast<int>(exactBin);
+            float fraction = exactBin - static_cast<float>(lower);
+
+            // Randfälle wie in getRawMagnitudeForFrequency(): erster bzw. letzter Bin
+            if (exactBin < 0.0f)
+            {
+                lower = 0;
+                fraction = 0.0f;
+            }
+            else if (lower + 1 >= numBins)
+            {
+                lower = numBins - 2;
+                fraction = 1.0f;
+            }
+
+            lowerBins[i] = lower;
+            fractions[i] = fraction;
+            tiltDb[i] = (tiltEnabled && frequency > 0.0f)
+                            ? std::log2(frequency / tiltCenter) * tiltSlope
+                            : 0.0f;
+        }
+
+        tiltActive = tiltEnabled;
+        keyFftSize = fftSize;
+        keyNumBins = numBins;
+        keySampleRate = sampleRate;
+        keyTiltEnabled = tiltEnabled;
+        keyTiltSlope = tiltSlope;
+        keyTiltCenter = tiltCenter;
+        valid = true;
+    }
+
+    int numPoints = 0;
+    std::vector<float> pointFrequencies;
+    std::vector<int> lowerBins;
+    std::vector<float> fractions;
+    std::vector<float> tiltDb;
+    bool tiltActive = false;
+
+    // Schlüssel der aktuellen Tabelle
+    bool valid = false;
+    int keyFftSize = 0;
+    int keyNumBins = 0;
+    double keySampleRate = 0.0;
+    bool keyTiltEnabled = false;
+    float keyTiltSlope = 0.0f;
+    float keyTiltCenter = 0.0f;
+};
@@ -23,11 +23,13 @@ namespace ParameterIDs
     inline juce::String getBandDynRatioID(int bandIndex) { return "band" + juce::String(bandIndex) + "_dyn_ratio"; }
     inline juce::String getBandDynAttackID(int bandIndex) { return "band" + juce::String(bandIndex) + "_dyn_attack"; }
     inline juce::String getBandDynReleaseID(int bandIndex) { return "band" + juce::String(bandIndex) + "_dyn_release"; }
+    inline juce::String getBandDynSidechainID(int bandIndex) { return "band" + juce::String(bandIndex) + "_dyn_sidechain"; }
 
     // Globale Parameter
     const juce::String OUTPUT_GAIN = "output_gain";
     const juce::String INPUT_GAIN = "input_gain";
     const juce::String LINEAR_PHASE_MODE = "linear_phase";
+    const juce::String LINEAR_PHASE_LATENCY = "linear_phase_latency";
     const juce::String MID_SIDE_MODE = "mid_side";
     const juce::String ANALYZER_PRE_POST = "analyzer_prepost";
     const juce::String ANALYZER_ON = "analyzer_on";
@@ -37,13 +39,30 @@ namespace ParameterIDs
     //==========================================================================
     const juce::String WET_DRY_MIX = "wet_dry_mix";
     const juce::String OVERSAMPLING_FACTOR = "oversampling_factor";
+    const juce::String OVERSAMPLING_QUALITY = "oversampling_quality";
+    const juce::String FILTER_DESIGN = "filter_design";
+    
+    // Bänder mit oberer Flanke unter diesem Anteil der Nyquist-Frequenz (in %)
+    // laufen ohne Oversampling auf der Basisrate
+    const juce::String OVERSAMPLING_THRESHOLD = "oversampling_threshold";
     const juce::String DELTA_MODE = "delta_mode";
     
+    // Dynamic EQ Lookahead (global, alle dynamischen Bänder; als Latenz gemeldet)
+    const juce::String DYNAMIC_LOOKAHEAD = "dyn_lookahead";
+    constexpr float MAX_DYNAMIC_LOOKAHEAD_MS = 20.0f;
+    
     // Resonance Suppressor (Soothe-Style)
     const juce::String SUPPRESSOR_ENABLED = "suppressor_enabled";
     const juce::String SUPPRESSOR_DEPTH = "suppressor_depth";
     const juce::String SUPPRESSOR_SPEED = "suppressor_speed";
     const juce::String SUPPRESSOR_SELECTIVITY = "suppressor_selectivity";
+    const juce::String SUPPRESSOR_QUALITY = "suppressor_quality";
+    
+    // Suppressor-Engine (Filterbank = latenzfrei, Spectral = volle Bin-Auflösung mit Latenz)
+    inline juce::StringArray getSuppressorQualityNames()
+    {
+        return { "Filterbank", "Spectral" };
+    }
     
     // Per-Band Solo
     inline juce::String getBandSoloID(int bandIndex) { return "band" + juce::String(bandIndex) + "_solo"; }
@@ -108,6 +127,12 @@ namespace ParameterIDs
         return { "Very Slow", "Slow", "Medium", "Fast", "Very Fast" };
     }
 
+    // Analyzer-Overlap-Optionen (Off = FFT im Audio-Thread)
+    inline juce::StringArray getAnalyzerOverlapNames()
+    {
+        return { "Overlap Off", "Overlap 50%", "Overlap 75%", "Overlap 87.5%" };
+    }
+
     // Standard-Tilt (Pro-Q Style: 4.5 dB/Oktave)
     constexpr float DEFAULT_ANALYZER_TILT = 4.5f;
     constexpr float MIN_ANALYZER_TILT = -6.0f;
@@ -188,6 +188,13 @@ namespace ParameterLayout
                     })
             ));
 
+            // Detektor hört den Sidechain-Eingang statt des Bandsignals
+            params.push_back(std::make_unique<juce::AudioParameterBool>(
+                juce::ParameterID(ParameterIDs::getBandDynSidechainID(i), 1),
+                "Band " + juce::String(i + 1) + " Dyn Sidechain",
+                false
+            ));
+
             // ===== Per-Band Solo =====
             params.push_back(std::make_unique<juce::AudioParameterBool>(
                 juce::ParameterID(ParameterIDs::getBandSoloID(i), 1),
@@ -229,6 +236,14 @@ namespace ParameterLayout
             false
         ));
 
+        // Linear Phase Latenz (FIR-Länge) — sortiert von niedrig nach hoch
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID(ParameterIDs::LINEAR_PHASE_LATENCY, 1),
+            "Linear Phase Latency",
+            juce::StringArray { "Ultra Low", "Very Low", "Low", "Medium", "High" },
+            3  // Default: Medium
+        ));
+
         // Mid/Side Mode
         params.push_back(std::make_unique<juce::AudioParameterBool>(
             juce::ParameterID(ParameterIDs::MID_SIDE_MODE, 1),
@@ -325,10 +340,39 @@ namespace ParameterLayout
         params.push_back(std::make_unique<juce::AudioParameterChoice>(
             juce::ParameterID(ParameterIDs::OVERSAMPLING_FACTOR, 1),
             "Oversampling",
-            juce::StringArray { "Off", "2x", "4x" },
+            juce::StringArray { "Off", "2x", "4x", "8x", "16x" },
             0  // Default: Off
         ));
 
+        // Oversampling-Filter: FIR (linearphasig) vs. IIR (minimalphasig, geringe Latenz)
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID(ParameterIDs::OVERSAMPLING_QUALITY, 1),
+            "Oversampling Filter",
+            juce::StringArray { "Linear Phase", "Minimum Phase" },
+            0  // Default: Linear Phase
+        ));
+
+        // Filter-Design: RBJ (bilinear) vs. Analog Matched (unverzerrt bis Nyquist ohne Oversampling)
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID(ParameterIDs::FILTER_DESIGN, 1),
+            "Filter Design",
+            juce::StringArray { "Cookbook", "Analog Matched" },
+            0  // Default: Cookbook (bisheriger Klang)
+        ));
+
+        // Selektives Oversampling: nur Bänder nahe Nyquist laufen auf der hohen Rate
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(ParameterIDs::OVERSAMPLING_THRESHOLD, 1),
+            "Oversampling Threshold",
+            juce::NormalisableRange<float>(0.0f, 100.0f, 1.0f),
+            25.0f,  // Default: Bänder unter ~6 kHz (bei 48 kHz) ohne Oversampling
+            juce::AudioParameterFloatAttributes()
+                .withLabel("%")
+                .withStringFromValueFunction([](float value, int) {
+                    return juce::String(juce::roundToInt(value)) + " %";
+                })
+        ));
+
         //==========================================================================
         // Delta Mode (nur EQ-Änderung hören)
         //==========================================================================
@@ -338,6 +382,21 @@ namespace ParameterLayout
             false
         ));
 
+        //==========================================================================
+        // Dynamic EQ Lookahead (verzögert das Audio gegenüber den Detektoren)
+        //==========================================================================
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(ParameterIDs::DYNAMIC_LOOKAHEAD, 1),
+            "Dynamic Lookahead",
+            juce::NormalisableRange<float>(0.0f, ParameterIDs::MAX_DYNAMIC_LOOKAHEAD_MS, 0.1f),
+            0.0f,
+            juce::AudioParameterFloatAttributes()
+                .withLabel("ms")
+                .withStringFromValueFunction([](float value, int) {
+                    return juce::String(value, 1) + " ms";
+                })
+        ));
+
         //==========================================================================
         // Resonance Suppressor (Soothe-Style)
         //==========================================================================
@@ -383,6 +442,13 @@ namespace ParameterLayout
                 })
         ));
 
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID(ParameterIDs::SUPPRESSOR_QUALITY, 1),
+            "Suppressor Quality",
+            ParameterIDs::getSuppressorQualityNames(),
+            0  // Default: Filterbank (keine Latenz)
+        ));
+
         //==========================================================================
         // Smart EQ Analyzer Parameter
         //==========================================================================
@@ -0,0 +1,142 @@
+#include "ParameterRouter.h"
+
+ParameterRouter::ParameterRouter(juce::AudioProcessorValueTreeState& apvts)
+{
+    routesByIndex.resize(static_cast<size_t>(apvts.processor.getParameters().size()));
+
+    // Band-Parameter: IDs nur hier einmal zusammenbauen
+    for (int band = 0; band < ParameterIDs::MAX_BANDS; ++band)
+    {
+        const std::array<juce::String, NUM_BAND_FIELDS> ids {
+            ParameterIDs::getBandFreqID(band),
+            ParameterIDs::getBandGainID(band),
+            ParameterIDs::getBandQID(band),
+            ParameterIDs::getBandTypeID(band),
+            ParameterIDs::getBandBypassID(band),
+            ParameterIDs::getBandChannelID(band),
+            ParameterIDs::getBandSlopeID(band),
+            ParameterIDs::getBandDynEnabledID(band),
+            ParameterIDs::getBandDynThresholdID(band),
+            ParameterIDs::getBandDynRatioID(band),
+            ParameterIDs::getBandDynAttackID(band),
+            ParameterIDs::getBandDynReleaseID(band),
+            ParameterIDs::getBandDynSidechainID(band),
+            ParameterIDs::getBandSoloID(band),
+            ParameterIDs::getBandActiveID(band)
+        };
+
+        for (int field = 0; field < NUM_BAND_FIELDS; ++field)
+        {
+            const auto& id = ids[static_cast<size_t>(field)];
+            bandHandles[static_cast<size_t>(band)][static_cast<size_t>(field)] = apvts.getRawParameterValue(id);
+
+            Route route;
+            route.bandIndex = static_cast<int8_t>(band);
+            route.field = static_cast<int8_t>(field);
+            addRoute(apvts.getParameter(id), route);
+        }
+    }
+
+    // Globale Parameter (notify = Processor wird synchron benachrichtigt)
+    struct GlobalEntry
+    {
+        GlobalParam param;
+        juce::String id;
+        bool notify;
+    };
+
+    const GlobalEntry globals[] = {
+        { GlobalParam::InputGain,                   ParameterIDs::INPUT_GAIN,                      false },
+        { GlobalParam::OutputGain,                  ParameterIDs::OUTPUT_GAIN,                     true  },
+        { GlobalParam::WetDryMix,                   ParameterIDs::WET_DRY_MIX,                     false },
+        { GlobalParam::MidSideMode,                 ParameterIDs::MID_SIDE_MODE,                   false },
+        { GlobalParam::AnalyzerOn,                  ParameterIDs::ANALYZER_ON,                     false },
+        { GlobalParam::LinearPhaseMode,             ParameterIDs::LINEAR_PHASE_MODE,               false },
+        { GlobalParam::LinearPhaseLatency,          ParameterIDs::LINEAR_PHASE_LATENCY,            true  },
+        { GlobalParam::OversamplingFactor,          ParameterIDs::OVERSAMPLING_FACTOR,             true  },
+        { GlobalParam::OversamplingQuality,         ParameterIDs::OVERSAMPLING_QUALITY,            true  },
+        { GlobalParam::FilterDesign,                ParameterIDs::FILTER_DESIGN,                   true  },
+        { GlobalParam::OversamplingThreshold,       ParameterIDs::OVERSAMPLING_THRESHOLD,          false },
+        { GlobalParam::DeltaMode,                   ParameterIDs::DELTA_MODE,                      false },
+        { GlobalParam::DynamicLookahead,            ParameterIDs::DYNAMIC_LOOKAHEAD,               true  },
+        { GlobalParam::SuppressorEnabled,           ParameterIDs::SUPPRESSOR_ENABLED,              false },
+        { GlobalParam::SuppressorDepth,             ParameterIDs::SUPPRESSOR_DEPTH,                false },
+        { GlobalParam::SuppressorSpeed,             ParameterIDs::SUPPRESSOR_SPEED,                false },
+        { GlobalParam::SuppressorSelectivity,       ParameterIDs::SUPPRESSOR_SELECTIVITY,          false },
+        { GlobalParam::SuppressorQuality,           ParameterIDs::SUPPRESSOR_QUALITY,              false },
+        { GlobalParam::SmartModeEnabled,            ParameterIDs::SMART_MODE_ENABLED,              false },
+        { GlobalParam::LiveSmartEqEnabled,          ParameterIDs::LIVE_SMART_EQ_ENABLED,           false },
+        { GlobalParam::LiveSmartEqDepth,            ParameterIDs::LIVE_SMART_EQ_DEPTH,             false },
+        { GlobalParam::LiveSmartEqAttack,           ParameterIDs::LIVE_SMART_EQ_ATTACK,            false },
+        { GlobalParam::LiveSmartEqRelease,          ParameterIDs::LIVE_SMART_EQ_RELEASE,           false },
+        { GlobalParam::LiveSmartEqThreshold,        ParameterIDs::LIVE_SMART_EQ_THRESHOLD,         false },
+        { GlobalParam::LiveSmartEqMode,             ParameterIDs::LIVE_SMART_EQ_MODE,              false },
+        { GlobalParam::LiveSmartEqMaxReduction,     ParameterIDs::LIVE_SMART_EQ_MAX_REDUCTION,     false },
+        { GlobalParam::LiveSmartEqTransientProtect, ParameterIDs::LIVE_SMART_EQ_TRANSIENT_PROTECT, false },
+        { GlobalParam::LiveSmartEqMsMode,           ParameterIDs::LIVE_SMART_EQ_MS_MODE,           false },
+        { GlobalParam::LiveSmartEqProfile,          ParameterIDs::LIVE_SMART_EQ_PROFILE,           false }
+    };
+
+    for (const auto& entry : globals)
+    {
+        const auto index = static_cast<size_t>(entry.param);
+        globalHandles[index] = apvts.getRawParameterValue(entry.id);
+        globalParameters[index] = apvts.getParameter(entry.id);
+
+        if (entry.notify)
+        {
+            Route route;
+            route.field = static_cast<int8_t>(entry.param);
+            route.notifiesGlobal = true;
+            addRoute(globalParameters[index], route);
+        }
+    }
+}
+
+ParameterRouter::~ParameterRouter()
+{
+    for (auto* parameter : listenedParameters)
+        parameter->removeListener(this);
+}
+
+void ParameterRouter::addRoute(juce::RangedAudioParameter* parameter, const Route& route)
+{
+    if (parameter == nullptr)
+        return;
+
+    const int index = parameter->getParameterIndex();
+    if (index < 0 || index >= static_cast<int>(routesByIndex.size()))
+        return;
+
+    auto& entry = routesByIndex[static_cast<size_t>(index)];
+    entry = route;
+    entry.parameter = parameter;
+
+    parameter->addListener(this);
+    listenedParameters.push_back(parameter);
+}
+
+void ParameterRouter::parameterValueChanged(int parameterIndex, float newValue)
+{
+    if (parameterIndex < 0 || parameterIndex >= static_cast<int>(routesByIndex.size()))
+        return;
+
+    const auto& route = routesByIndex[static_cast<size_t>(parameterIndex)];
+
+    if (route.bandIndex >= 0)
+    {
+        // Wert nicht übergeben: der Audio-Thread liest beim Anwenden den aktuellen
+        // Stand aus dem Handle (dichte Automation → nur der letzte Wert zählt)
+        markBandDirty(route.bandIndex, 1u << static_cast<uint32_t>(route.field));
+
+        if (onBandChangeQueued)
+            onBandChangeQueued();
+        return;
+    }
+
+    // Listener können vor dem APVTS-Adapter aufgerufen werden (Handle evtl. noch alt)
+    // → Wert selbst denormalisieren
+    if (route.notifiesGlobal && onGlobalParameterChanged)
+        onGlobalParameterChanged(static_cast<GlobalParam>(route.field),
+                                 route.parameter->convertFrom0to1(newValue));
+}
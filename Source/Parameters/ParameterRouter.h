@@ -0,0 +1,209 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "ParameterIDs.h"
+#include <array>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+/**
+ * ParameterRouter: Allokationsfreies Parameter-Routing ohne String-Lookups zur Laufzeit.
+ *
+ * - Alle Parameter-IDs werden EINMAL im Konstruktor zu std::atomic<float>*-Handles
+ *   aufgelöst (Band × Feld bzw. globaler Parameter)
+ * - Änderungs-Callbacks kommen als AudioProcessorParameter::Listener mit dem
+ *   Parameter-Index; eine vorberechnete Tabelle Index → (Band, Feld) ersetzt die
+ *   String-Vergleiche im bisherigen parameterChanged()
+ * - Band-Änderungen laufen über eine lock-freie Dirty-Maske pro Band
+ *   (fetch_or, beliebig viele Producer-Threads): O(1) pro Automations-Event,
+ *   dichte Automation wird bis zum nächsten Block zusammengefasst
+ * - Der Audio-Thread holt die Änderungen am Blockanfang mit drainBandChanges() ab
+ * - Globale Parameter mit Seiteneffekten (Oversampling, Latenz, Output Gain)
+ *   werden wie bisher synchron über onGlobalParameterChanged gemeldet
+ */
+class ParameterRouter : private juce::AudioProcessorParameter::Listener
+{
+public:
+    // Felder eines EQ-Bands (Bit-Position in der Dirty-Maske)
+    enum class BandField
+    {
+        Frequency = 0,
+        Gain,
+        Q,
+        Type,
+        Bypass,
+        Channel,
+        Slope,
+        DynEnabled,
+        DynThreshold,
+        DynRatio,
+        DynAttack,
+        DynRelease,
+        DynSidechain,
+        Solo,
+        Active,
+        NumFields
+    };
+
+    // Globale Parameter, die im Audio- oder Worker-Thread gelesen werden
+    enum class GlobalParam
+    {
+        InputGain = 0,
+        OutputGain,
+        WetDryMix,
+        MidSideMode,
+        AnalyzerOn,
+        LinearPhaseMode,
+        LinearPhaseLatency,
+        OversamplingFactor,
+        OversamplingQuality,
+        FilterDesign,
+        OversamplingThreshold,
+        DeltaMode,
+        DynamicLookahead,
+        SuppressorEnabled,
+        SuppressorDepth,
+        SuppressorSpeed,
+        SuppressorSelectivity,
+        SuppressorQuality,
+        SmartModeEnabled,
+        LiveSmartEqEnabled,
+        LiveSmartEqDepth,
+        LiveSmartEqAttack,
+        LiveSmartEqRelease,
+        LiveSmartEqThreshold,
+        LiveSmartEqMode,
+        LiveSmartEqMaxReduction,
+        LiveSmartEqTransientProtect,
+        LiveSmartEqMsMode,
+        LiveSmartEqProfile,
+        NumParams
+    };
+
+    static constexpr int NUM_BAND_FIELDS = static_cast<int>(BandField::NumFields);
+    static constexpr int NUM_GLOBAL_PARAMS = static_cast<int>(GlobalParam::NumParams);
+
+    static constexpr uint32_t fieldBit(BandField field) { return 1u << static_cast<uint32_t>(field); }
+    static constexpr uint32_t ALL_BAND_FIELDS = (1u << NUM_BAND_FIELDS) - 1u;
+
+    static_assert(ParameterIDs::MAX_BANDS <= 32, "Dirty-Maske der Bänder ist 32 Bit breit");
+    static_assert(NUM_BAND_FIELDS <= 32, "Dirty-Maske der Felder ist 32 Bit breit");
+
+    explicit ParameterRouter(juce::AudioProcessorValueTreeState& apvts);
+    ~ParameterRouter() override;
+
+    //==========================================================================
+    // Gecachte Handles (nie nullptr für existierende Parameter)
+    //==========================================================================
+    std::atomic<float>* getBandHandle(int bandIndex, BandField field) const
+    {
+        return bandHandles[static_cast<size_t>(bandIndex)][static_cast<size_t>(field)];
+    }
+
+    float getBandValue(int bandIndex, BandField field) const
+    {
+        auto* handle = getBandHandle(bandIndex, field);
+        return handle != nullptr ? handle->load(std::memory_order_relaxed) : 0.0f;
+    }
+
+    std::atomic<float>* getHandle(GlobalParam param) const
+    {
+        return globalHandles[static_cast<size_t>(param)];
+    }
+
+    float getValue(GlobalParam param, float fallback = 0.0f) const
+    {
+        auto* handle = getHandle(param);
+        return handle != nullptr ? handle->load(std::memory_order_relaxed) : fallback;
+    }
+
+    bool isOn(GlobalParam param) const { return getValue(param) > 0.5f; }
+
+    juce::RangedAudioParameter* getParameter(GlobalParam param) const
+    {
+        return globalParameters[static_cast<size_t>(param)];
+    }
+
+    //==========================================================================
+    // Band-Änderungen (lock-free, Multi-Producer → Audio-Thread)
+    //==========================================================================
+
+    /** Markiert Felder eines Bands als geändert (z.B. nach State-Load). */
+    void markBandDirty(int bandIndex, uint32_t fieldMask = ALL_BAND_FIELDS)
+    {
+        dirtyFields[static_cast<size_t>(bandIndex)].fetch_or(fieldMask, std::memory_order_release);
+        dirtyBands.fetch_or(1u << static_cast<uint32_t>(bandIndex), std::memory_order_release);
+    }
+
+    bool hasPendingBandChanges() const { return dirtyBands.load(std::memory_order_relaxed) != 0; }
+
+    /**
+     * Ruft applyBand(bandIndex, fieldMask) für jedes geänderte Band auf.
+     * Die Maske wird vor dem Aufruf atomar geleert → Änderungen während des
+     * Anwendens landen im nächsten Durchlauf. RT-safe, keine Allokation.
+     */
+    template <typename ApplyFn>
+    void drainBandChanges(ApplyFn&& applyBand)
+    {
+        uint32_t bands = dirtyBands.exchange(0, std::memory_order_acquire);
+
+        while (bands != 0)
+        {
+            const int bandIndex = countTrailingZeros(bands);
+            bands &= bands - 1u;
+
+            const uint32_t fields = dirtyFields[static_cast<size_t>(bandIndex)].exchange(0, std::memory_order_acquire);
+            if (fields != 0)
+                applyBand(bandIndex, fields);
+        }
+    }
+
+    /**
+     * Wird nach jedem markierten Band-Event aufgerufen (auf dem Thread des Events,
+     * evtl. bevor das Handle aktualisiert ist). Der Processor stößt darüber ein
+     * asynchrones Anwenden an, solange kein Audio-Callback läuft.
+     */
+    std::function<void()> onBandChangeQueued;
+
+    /** Synchroner Callback für globale Parameter mit Seiteneffekten (Wert denormalisiert). */
+    std::function<void(GlobalParam, float)> onGlobalParameterChanged;
+
+private:
+    struct Route
+    {
+        int8_t bandIndex = -1;        // >= 0 → Band-Parameter
+        int8_t field = -1;            // BandField bzw. GlobalParam
+        bool notifiesGlobal = false;  // globaler Parameter mit Callback
+        juce::RangedAudioParameter* parameter = nullptr;
+    };
+
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+    void parameterGestureChanged(int, bool) override {}
+
+    void addRoute(juce::RangedAudioParameter* parameter, const Route& route);
+
+    static int countTrailingZeros(uint32_t value)
+    {
+        int count = 0;
+        while ((value & 1u) == 0u)
+        {
+            value >>= 1;
+            ++count;
+        }
+        return count;
+    }
+
+    std::array<std::array<std::atomic<float>*, NUM_BAND_FIELDS>, ParameterIDs::MAX_BANDS> bandHandles {};
+    std::array<std::atomic<float>*, NUM_GLOBAL_PARAMS> globalHandles {};
+    std::array<juce::RangedAudioParameter*, NUM_GLOBAL_PARAMS> globalParameters {};
+
+    // Parameter-Index → Route (Größe = Anzahl Processor-Parameter)
+    std::vector<Route> routesByIndex;
+    std::vector<juce::RangedAudioParameter*> listenedParameters;
+
+    std::array<std::atomic<uint32_t>, ParameterIDs::MAX_BANDS> dirtyFields {};
+    std::atomic<uint32_t> dirtyBands { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterRouter)
+};
@@ -4,7 +4,7 @@
 AuraAudioProcessorEditor::AuraAudioProcessorEditor(AuraAudioProcessor& p)
     : AudioProcessorEditor(&p),
       audioProcessor(p),
-      updateTimer(*this),
+      processorUpdates(*this),
       spectrumGrabTool(audioProcessor.getEQProcessor())
 {
     // GPU-beschleunigtes Rendering aktivieren (beschleunigt Spektrum-Darstellung erheblich)
@@ -106,6 +106,7 @@ AuraAudioProcessorEditor::AuraAudioProcessorEditor(AuraAudioProcessor& p)
         ThemeManager::getInstance().onThemeChanged = [this](ThemeManager::ThemeID /*id*/)
         {
             customLookAndFeel.updateColors();
+            spectrumAnalyzer.invalidateCachedLayers();
             repaint();
             
             // Trigger repaint für alle sichtbaren Komponenten
@@ -183,12 +184,14 @@ AuraAudioProcessorEditor::AuraAudioProcessorEditor(AuraAudioProcessor& p)
     
     // Resizing aktivieren
     setResizable(true, true);
-    setResizeLimits(1000, 550, 1800, 1000);  // Mindestbreite erhöht für Smart EQ Panel
+    setResizeLimits(1050, 550, 1800, 1000);  // Mindestbreite: Smart EQ Panel + Toolbar (Filter-Design)
     
-    // Timer NACH vollständiger Initialisierung starten!
-    spectrumAnalyzer.startAnalyzer();
-    eqCurve.startCurveUpdates();
-    updateTimer.startTimerHz(25);  // 25 FPS - reduziert für bessere Performance
+    // Frame-Takt NACH vollständiger Initialisierung starten!
+    renderClock.addClient(processorUpdates, 25);
+    renderClock.addClient(spectrumAnalyzer, 60);
+    renderClock.addClient(eqCurve, 30);
+    renderClock.addClient(smartHighlightOverlay, 30);
+    renderClock.start();
     
     // ===== NEU: Trial-Banner am unteren Rand =====
     trialBannerLabel.setJustificationType(juce::Justification::centred);
@@ -253,10 +256,8 @@ AuraAudioProcessorEditor::~AuraAudioProcessorEditor()
 {
     // Update-Checker Listener entfernen
     updateChecker.removeListener(this);
-    // Timer zuerst stoppen!
-    updateTimer.stopTimer();
-    spectrumAnalyzer.stopAnalyzer();
-    eqCurve.stopCurveUpdates();
+    // Frame-Takt zuerst stoppen!
+    renderClock.stop();
     
     // OpenGL-Context VOR allen Komponenten detachen (wichtig!)
     openGLContext.detach();
@@ -423,22 +424,51 @@ void AuraAudioProcessorEditor::setupOutputControls()
     oversamplingCombo.addItem("OS: Off", 1);
     oversamplingCombo.addItem("OS: 2x", 2);
     oversamplingCombo.addItem("OS: 4x", 3);
-    oversamplingCombo.setTooltip("Oversampling-Faktor\nOff = Kein Oversampling (niedrigste CPU-Last)\n2x = Doppelte Samplerate (gute Qualitaet)\n4x = Vierfache Samplerate (beste Qualitaet)\n\nReduziert Aliasing-Artefakte bei hohen Frequenzen.\nHoehere Werte = bessere Klangqualitaet, aber mehr CPU-Last.");
+    oversamplingCombo.addItem("OS: 8x", 4);
+    oversamplingCombo.addItem("OS: 16x", 5);
+    oversamplingCombo.setTooltip("Oversampling-Faktor\nOff = Kein Oversampling (niedrigste CPU-Last)\n2x = Doppelte Samplerate (gute Qualitaet)\n4x = Vierfache Samplerate (sehr gute Qualitaet)\n8x/16x = Maximale Qualitaet (hohe CPU-Last)\n\nReduziert Aliasing-Artefakte bei hohen Frequenzen.\nHoehere Werte = bessere Klangqualitaet, aber mehr CPU-Last.");
     addAndMakeVisible(oversamplingCombo);
     
     oversamplingAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
         audioProcessor.getAPVTS(), ParameterIDs::OVERSAMPLING_FACTOR, oversamplingCombo);
     
+    // NEU: Oversampling-Filterqualität
+    oversamplingQualityCombo.addItem("FIR", 1);
+    oversamplingQualityCombo.addItem("IIR", 2);
+    oversamplingQualityCombo.setTooltip("Oversampling-Filter\nFIR = Linearphasig (hoehere Latenz, kein Phasenversatz)\nIIR = Minimalphasig (nur wenige Samples Latenz)\n\nIIR spart Latenz in grossen Sessions, FIR ist fuer Mastering gedacht.");
+    addAndMakeVisible(oversamplingQualityCombo);
+    
+    oversamplingQualityAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getAPVTS(), ParameterIDs::OVERSAMPLING_QUALITY, oversamplingQualityCombo);
+    
+    // Filter-Design (Bell/Shelf/BandPass/Notch)
+    filterDesignCombo.addItem("RBJ", 1);
+    filterDesignCombo.addItem("Analog", 2);
+    filterDesignCombo.setTooltip("Filter-Design\nRBJ = Klassisches Cookbook (Kurven werden Richtung Nyquist gestaucht)\nAnalog = Analog Matched (Betrag folgt dem Analog-Vorbild bis Nyquist)\n\nAnalog liefert ohne Oversampling offene Hoehen-Baender und spart so die CPU-Last des Oversamplings.");
+    addAndMakeVisible(filterDesignCombo);
+    
+    filterDesignAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getAPVTS(), ParameterIDs::FILTER_DESIGN, filterDesignCombo);
+    
     // NEU: Resonance Suppressor Button
     suppressorButton.setButtonText("Soothe");
     suppressorButton.setClickingTogglesState(true);
-    suppressorButton.setTooltip("Resonance Suppressor (Soothe-aehnlich)\nErkennt und unterdrueckt automatisch stoerende Resonanzen\nim Frequenzspektrum. Arbeitet dynamisch in 16 Baendern.\n\nIdeal gegen harsche Vocals, nervige Raumresonanzen\noder unangenehme Spitzen in Instrumenten.");
+    suppressorButton.setTooltip("Resonance Suppressor (Soothe-aehnlich)\nErkennt und unterdrueckt automatisch stoerende Resonanzen\nim Frequenzspektrum. Arbeitet dynamisch in 16 Baendern\noder per FFT-Bin (HiRes).\n\nIdeal gegen harsche Vocals, nervige Raumresonanzen\noder unangenehme Spitzen in Instrumenten.");
     suppressorButton.setColour(juce::TextButton::buttonOnColourId, juce::Colour(0xff8844cc));
     addAndMakeVisible(suppressorButton);
     
     suppressorAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
         audioProcessor.getAPVTS(), ParameterIDs::SUPPRESSOR_ENABLED, suppressorButton);
     
+    // NEU: Suppressor-Qualität (Filterbank vs. STFT)
+    suppressorQualityCombo.addItem("Bands", 1);
+    suppressorQualityCombo.addItem("HiRes", 2);
+    suppressorQualityCombo.setTooltip("Suppressor-Engine\nBands = 16-Band Filterbank (keine Latenz)\nHiRes = Per-Bin Maske im FFT-Bereich (volle Aufloesung, ~23 ms Latenz)");
+    addAndMakeVisible(suppressorQualityCombo);
+    
+    suppressorQualityAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getAPVTS(), ParameterIDs::SUPPRESSOR_QUALITY, suppressorQualityCombo);
+    
     // NEU: Piano Roll Overlay
     addAndMakeVisible(pianoRollOverlay);
     pianoRollOverlay.setEnabled(false);
@@ -585,12 +615,21 @@ void AuraAudioProcessorEditor::resized()
     oversamplingCombo.setBounds(row2.removeFromLeft(72).reduced(0, 2));
     row2.removeFromLeft(gap);
     
+    oversamplingQualityCombo.setBounds(row2.removeFromLeft(52).reduced(0, 2));
+    row2.removeFromLeft(gap);
+    
+    filterDesignCombo.setBounds(row2.removeFromLeft(62).reduced(0, 2));
+    row2.removeFromLeft(gap);
+    
     deltaButton.setBounds(row2.removeFromLeft(58).reduced(0, 2));
     row2.removeFromLeft(gap);
     
     suppressorButton.setBounds(row2.removeFromLeft(62).reduced(0, 2));
     row2.removeFromLeft(gap);
     
+    suppressorQualityCombo.setBounds(row2.removeFromLeft(60).reduced(0, 2));
+    row2.removeFromLeft(gap);
+    
     smartModeButton.setBounds(row2.removeFromLeft(78).reduced(0, 2));
     row2.removeFromLeft(gap);
     
@@ -628,6 +667,9 @@ void AuraAudioProcessorEditor::resized()
     analyzerSpeedCombo.setBounds(settingsRow.removeFromLeft(90));
     settingsRow.removeFromLeft(8);
 
+    analyzerOverlapCombo.setBounds(settingsRow.removeFromLeft(110));
+    settingsRow.removeFromLeft(8);
+
     eqScaleCombo.setBounds(settingsRow.removeFromLeft(85));
     settingsRow.removeFromLeft(15);
 
@@ -718,24 +760,6 @@ void AuraAudioProcessorEditor::updateFromProcessor()
         }
     }
     
-    // Live Smart EQ: Pending Parameter-Änderungen im Message-Thread anwenden (RT-safe)
-    auto& liveSmartEQ = audioProcessor.getLiveSmartEQ();
-    liveSmartEQ.applyPendingParameterChanges(apvts);
-    
-    // Linear Phase EQ: Magnitude-Response aktualisieren (vom GUI-Thread)
-    auto& linearPhaseEQ = audioProcessor.getLinearPhaseEQ();
-    if (linearPhaseEQ.isEnabled())
-    {
-        linearPhaseEQ.updateMagnitudeResponse(audioProcessor.getEQProcessor());
-    }
-    
-    // Live Smart EQ Reset im Message-Thread ausführen (falls angefordert)
-    if (liveSmartEQ.shouldReset())
-    {
-        liveSmartEQ.resetEQBands(apvts);
-        liveSmartEQ.clearResetFlag();
-    }
-
     // Band-Daten zur EQ-Kurve synchronisieren
     for (int i = 0; i < ParameterIDs::MAX_BANDS; ++i)
     {
@@ -778,7 +802,10 @@ void AuraAudioProcessorEditor::updateFromProcessor()
     // Grab-Tool: Spektrum-Daten vom PostAnalyzer fuettern
     if (spectrumGrabTool.isGrabModeActive())
     {
-        const auto& magnitudes = audioProcessor.getPostAnalyzer().getMagnitudes();
+        auto& postAnalyzer = audioProcessor.getPostAnalyzer();
+        postAnalyzer.updateDisplayFrame();
+        
+        const auto& magnitudes = postAnalyzer.getDisplayMagnitudes();
         if (!magnitudes.empty())
         {
             spectrumGrabTool.updateSpectrumData(magnitudes, 20.0f, 20000.0f);
@@ -811,7 +838,7 @@ void AuraAudioProcessorEditor::updateFromProcessor()
                     suppressor.getGainReductions(),
                     numBins,
                     audioProcessor.getSampleRate(),
-                    audioProcessor.getPostAnalyzer().getCurrentFFTSize());
+                    suppressor.getAnalysisFftSize());
             }
         }
     }
@@ -1022,6 +1049,12 @@ void AuraAudioProcessorEditor::bandPopupDeleteRequested(int bandIndex)
     bandPopup.setVisible(false);
 }
 
+// Bypass umgeschaltet (über Kontextmenü der Kurve)
+void AuraAudioProcessorEditor::bandBypassChanged(int bandIndex, bool bypassed)
+{
+    bandPopupBypassChanged(bandIndex, bypassed);
+}
+
 void AuraAudioProcessorEditor::bandPopupBypassChanged(int bandIndex, bool bypassed)
 {
     auto& apvts = audioProcessor.getAPVTS();
@@ -1202,6 +1235,33 @@ void AuraAudioProcessorEditor::setupAnalyzerControls()
     // Setze nach dem onChange Handler
     analyzerSpeedCombo.setSelectedId(3, juce::dontSendNotification);
 
+    // Overlap ComboBox
+    analyzerOverlapCombo.addItemList(ParameterIDs::getAnalyzerOverlapNames(), 1);
+    analyzerOverlapCombo.setTooltip("Analyzer-Ueberlappung
+Off = FFT im Audio-Thread, ein Frame pro FFT-Laenge
+50-87.5% = FFT in eigenem Thread, 2-8x mehr Frames pro Sekunde
+(fluessigere Anzeige, schnellere Reaktion des Smart EQ)");
+    addAndMakeVisible(analyzerOverlapCombo);
+
+    analyzerOverlapCombo.onChange = [this]()
+    {
+        int idx = analyzerOverlapCombo.getSelectedId() - 1;
+        FFTAnalyzer::AnalyzerOverlap overlap;
+        switch (idx)
+        {
+            case 1: overlap = FFTAnalyzer::AnalyzerOverlap::Half; break;
+            case 2: overlap = FFTAnalyzer::AnalyzerOverlap::ThreeQuarter; break;
+            case 3: overlap = FFTAnalyzer::AnalyzerOverlap::SevenEighths; break;
+            default: overlap = FFTAnalyzer::AnalyzerOverlap::None; break;
+        }
+        audioProcessor.getPreAnalyzer().setOverlap(overlap);
+        audioProcessor.getPostAnalyzer().setOverlap(overlap);
+    };
+    
+    // Aktuellen Zustand des Analyzers übernehmen (Editor kann neu geöffnet werden)
+    analyzerOverlapCombo.setSelectedId(static_cast<int>(audioProcessor.getPostAnalyzer().getOverlap()) + 1,
+                                       juce::dontSendNotification);
+
     // EQ Scale ComboBox (±6, ±12, ±24, ±36 dB)
     eqScaleCombo.addItem(juce::CharPointer_UTF8("+/-6 dB"), 1);
     eqScaleCombo.addItem(juce::CharPointer_UTF8("+/-12 dB"), 2);
@@ -1244,6 +1304,7 @@ void AuraAudioProcessorEditor::setupAnalyzerControls()
         float tilt = static_cast<float>(analyzerTiltSlider.getValue());
         audioProcessor.getPreAnalyzer().setTiltSlope(tilt);
         audioProcessor.getPostAnalyzer().setTiltSlope(tilt);
+        spectrumAnalyzer.invalidateSpectrum();
     };
 
     // Tilt Enable Button (Standard: OFF)
@@ -1257,6 +1318,7 @@ void AuraAudioProcessorEditor::setupAnalyzerControls()
         bool enabled = analyzerTiltButton.getToggleState();
         audioProcessor.getPreAnalyzer().setTiltEnabled(enabled);
         audioProcessor.getPostAnalyzer().setTiltEnabled(enabled);
+        spectrumAnalyzer.invalidateSpectrum();
         analyzerTiltSlider.setEnabled(enabled);
     };
     
@@ -1313,7 +1375,7 @@ void AuraAudioProcessorEditor::setupAnalyzerControls()
         int idx = spectrumColorCombo.getSelectedId() - 1;
         auto scheme = static_cast<CustomLookAndFeel::SpectrumColorScheme>(idx);
         CustomLookAndFeel::setSpectrumColorScheme(scheme);
-        spectrumAnalyzer.repaint();
+        spectrumAnalyzer.invalidateCachedLayers();
         
         // Speichere Auswahl
         juce::PropertiesFile::Options opts;
@@ -1696,8 +1758,8 @@ void AuraAudioProcessorEditor::updateSmartAnalysis()
     
     auto& smartAnalyzer = audioProcessor.getSmartAnalyzer();
     
-    // HINWEIS: analyze() wird bereits im Audio-Thread (processBlock) aufgerufen.
-    // Hier nur die Ergebnisse lesen - kein doppelter Aufruf!
+    // HINWEIS: analyze() läuft im SmartAnalysisWorker. Hier nur den
+    // veröffentlichten Snapshot lesen - kein doppelter Aufruf!
     
     // Overlay aktualisieren
     smartHighlightOverlay.updateProblems(smartAnalyzer.getDetectedProblems());
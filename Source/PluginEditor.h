@@ -18,6 +18,7 @@
 #include "GUI/ReferenceTrackPanel.h"
 #include "GUI/AudioSourceSelector.h"
 #include "GUI/PianoRollOverlay.h"
+#include "GUI/RenderClock.h"
 #include "DSP/SmartEQRecommendation.h"
 #include "Licensing/LicenseManager.h"
 #include "Licensing/LicenseDialog.h"
@@ -49,6 +50,7 @@ public:
     void bandCreated(int bandIndex, float frequency) override;
     void filterTypeChanged(int bandIndex, ParameterIDs::FilterType type) override;
     void bandDeleted(int bandIndex) override;
+    void bandBypassChanged(int bandIndex, bool bypassed) override;
     void bandRightClicked(int bandIndex) override;  // Rechtsklick -> Popup zeigen
 
     // BandControls::Listener
@@ -118,9 +120,12 @@ private:
     
     // NEU: Oversampling ComboBox
     juce::ComboBox oversamplingCombo;
+    juce::ComboBox oversamplingQualityCombo;
+    juce::ComboBox filterDesignCombo;
     
     // NEU: Resonance Suppressor Controls
     juce::ToggleButton suppressorButton;
+    juce::ComboBox suppressorQualityCombo;
     
     // NEU: Piano Roll Overlay
     PianoRollOverlay pianoRollOverlay;
@@ -151,6 +156,7 @@ private:
     juce::ComboBox analyzerResolutionCombo;
     juce::ComboBox analyzerRangeCombo;
     juce::ComboBox analyzerSpeedCombo;
+    juce::ComboBox analyzerOverlapCombo;
     juce::ComboBox eqScaleCombo;  // EQ Gain Scale Selector
     juce::Slider analyzerTiltSlider;
     juce::ToggleButton analyzerTiltButton;
@@ -174,22 +180,25 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> wetDryAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> deltaAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> oversamplingAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> oversamplingQualityAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> filterDesignAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> suppressorAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> suppressorQualityAttachment;
 
     // Analyzer-Settings Helper
     void setupAnalyzerControls();
     void updateAnalyzerSettings();
 
-    // Timer für GUI-Updates
-    class UpdateTimer : public juce::Timer
+    // GUI-Updates aus dem Processor (25 Hz, über den RenderClock)
+    class ProcessorUpdates : public RenderClock::Client
     {
     public:
-        UpdateTimer(AuraAudioProcessorEditor& e) : editor(e) {}
-        void timerCallback() override { editor.updateFromProcessor(); }
+        ProcessorUpdates(AuraAudioProcessorEditor& e) : editor(e) {}
+        void renderFrame(double /*timestampMs*/) override { editor.updateFromProcessor(); }
     private:
         AuraAudioProcessorEditor& editor;
     };
-    UpdateTimer updateTimer;
+    ProcessorUpdates processorUpdates;
 
     void updateFromProcessor();
     void setupOutputControls();
@@ -228,6 +237,10 @@ private:
     
     // GPU-beschleunigtes Rendering (reduziert CPU-Last des Spektrum-Renderings erheblich)
     juce::OpenGLContext openGLContext;
+    
+    // Gemeinsamer VBlank-Takt für Analyzer, Kurve, Overlays und Processor-Updates
+    // (zuletzt deklariert → wird vor den Clients zerstört)
+    RenderClock renderClock { *this };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AuraAudioProcessorEditor)
 };
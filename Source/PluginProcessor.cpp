@@ -1,70 +1,48 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+using GlobalParam = ParameterRouter::GlobalParam;
+using BandField = ParameterRouter::BandField;
+
 AuraAudioProcessor::AuraAudioProcessor()
     : AudioProcessor(BusesProperties()
                      .withInput("Input", juce::AudioChannelSet::stereo(), true)
+                     .withInput("Sidechain", juce::AudioChannelSet::stereo(), false)
                      .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
       apvts(*this, &undoManager, "Parameters", ParameterLayout::createParameterLayout())
 {
-    // Parameter-Listener für alle Band-Parameter registrieren
-    for (int i = 0; i < ParameterIDs::MAX_BANDS; ++i)
+    // Band-Änderungen kommen über die Dirty-Maske des Routers und werden am
+    // Blockanfang im Audio-Thread angewendet. Ohne laufenden Audio-Callback
+    // (oder wenn der Host keine Blöcke mehr liefert) übernimmt der Message-Thread.
+    parameterRouter.onBandChangeQueued = [this]
     {
-        apvts.addParameterListener(ParameterIDs::getBandFreqID(i), this);
-        apvts.addParameterListener(ParameterIDs::getBandGainID(i), this);
-        apvts.addParameterListener(ParameterIDs::getBandQID(i), this);
-        apvts.addParameterListener(ParameterIDs::getBandTypeID(i), this);
-        apvts.addParameterListener(ParameterIDs::getBandBypassID(i), this);
-        apvts.addParameterListener(ParameterIDs::getBandChannelID(i), this);
-        apvts.addParameterListener(ParameterIDs::getBandSlopeID(i), this);
-        // Dynamic EQ Parameter
-        apvts.addParameterListener(ParameterIDs::getBandDynEnabledID(i), this);
-        apvts.addParameterListener(ParameterIDs::getBandDynThresholdID(i), this);
-        apvts.addParameterListener(ParameterIDs::getBandDynRatioID(i), this);
-        apvts.addParameterListener(ParameterIDs::getBandDynAttackID(i), this);
-        apvts.addParameterListener(ParameterIDs::getBandDynReleaseID(i), this);
-        apvts.addParameterListener(ParameterIDs::getBandSoloID(i), this);
-    }
-    
-    apvts.addParameterListener(ParameterIDs::OUTPUT_GAIN, this);
-    apvts.addParameterListener(ParameterIDs::WET_DRY_MIX, this);
-    apvts.addParameterListener(ParameterIDs::OVERSAMPLING_FACTOR, this);
-    apvts.addParameterListener(ParameterIDs::DELTA_MODE, this);
-    apvts.addParameterListener(ParameterIDs::SUPPRESSOR_ENABLED, this);
-    apvts.addParameterListener(ParameterIDs::SUPPRESSOR_DEPTH, this);
-    apvts.addParameterListener(ParameterIDs::SUPPRESSOR_SPEED, this);
-    apvts.addParameterListener(ParameterIDs::SUPPRESSOR_SELECTIVITY, this);
+        if (isAudioThreadIdle())
+            triggerAsyncUpdate();
+    };
+    
+    parameterRouter.onGlobalParameterChanged = [this](GlobalParam param, float newValue)
+    {
+        handleGlobalParameterChange(param, newValue);
+    };
+    
+    linearPhaseWorker.setModeParameter(parameterRouter.getHandle(GlobalParam::LinearPhaseMode));
+    smartAnalysisWorker.onUpdateLiveSettings = [this] { updateLiveSmartEQFromParameters(); };
+    
+    // Live Smart EQ: APVTS nachziehen und übernommene Bänder freigeben. Gehört dem
+    // Processor, damit Freigabe und Reset auch headless bzw. bei geschlossenem Editor laufen
+    startTimer(LIVE_EQ_SYNC_INTERVAL_MS);
 }
 
 AuraAudioProcessor::~AuraAudioProcessor()
 {
-    // Parameter-Listener entfernen
-    for (int i = 0; i < ParameterIDs::MAX_BANDS; ++i)
-    {
-        apvts.removeParameterListener(ParameterIDs::getBandFreqID(i), this);
-        apvts.removeParameterListener(ParameterIDs::getBandGainID(i), this);
-        apvts.removeParameterListener(ParameterIDs::getBandQID(i), this);
-        apvts.removeParameterListener(ParameterIDs::getBandTypeID(i), this);
-        apvts.removeParameterListener(ParameterIDs::getBandBypassID(i), this);
-        apvts.removeParameterListener(ParameterIDs::getBandChannelID(i), this);
-        apvts.removeParameterListener(ParameterIDs::getBandSlopeID(i), this);  // FIX: Slope-Parameter
-        // Dynamic EQ Parameter
-        apvts.removeParameterListener(ParameterIDs::getBandDynEnabledID(i), this);
-        apvts.removeParameterListener(ParameterIDs::getBandDynThresholdID(i), this);
-        apvts.removeParameterListener(ParameterIDs::getBandDynRatioID(i), this);
-        apvts.removeParameterListener(ParameterIDs::getBandDynAttackID(i), this);
-        apvts.removeParameterListener(ParameterIDs::getBandDynReleaseID(i), this);
-        apvts.removeParameterListener(ParameterIDs::getBandSoloID(i), this);
-    }
-    
-    apvts.removeParameterListener(ParameterIDs::OUTPUT_GAIN, this);
-    apvts.removeParameterListener(ParameterIDs::WET_DRY_MIX, this);
-    apvts.removeParameterListener(ParameterIDs::OVERSAMPLING_FACTOR, this);
-    apvts.removeParameterListener(ParameterIDs::DELTA_MODE, this);
-    apvts.removeParameterListener(ParameterIDs::SUPPRESSOR_ENABLED, this);
-    apvts.removeParameterListener(ParameterIDs::SUPPRESSOR_DEPTH, this);
-    apvts.removeParameterListener(ParameterIDs::SUPPRESSOR_SPEED, this);
-    apvts.removeParameterListener(ParameterIDs::SUPPRESSOR_SELECTIVITY, this);
+    stopTimer();
+    linearPhaseWorker.stop();
+    smartAnalysisWorker.stop();
+    
+    // Router-Callbacks nicht mehr in einen halb abgebauten Processor laufen lassen
+    parameterRouter.onBandChangeQueued = nullptr;
+    parameterRouter.onGlobalParameterChanged = nullptr;
+    cancelPendingUpdate();
 }
 
 const juce::String AuraAudioProcessor::getName() const
@@ -91,7 +69,7 @@ double AuraAudioProcessor::getTailLengthSeconds() const
 {
     // Tail-Länge berücksichtigt:
     // 1. Linear Phase EQ FFT-Latenz (wenn aktiviert)
-    // 2. Oversampler FIR-Filter-Latenz
+    // 2. Oversampler FIR-Filter-Latenz (+ STFT-Suppressor)
     // 3. Zusätzliche Nachklingzeit der IIR-Filter (~50ms konservativ)
     
     double tailSeconds = 0.0;
@@ -99,8 +77,7 @@ double AuraAudioProcessor::getTailLengthSeconds() const
     if (baseSampleRate > 0.0)
     {
         // Linear Phase EQ Latenz
-        auto* linearPhaseParam = apvts.getRawParameterValue(ParameterIDs::LINEAR_PHASE_MODE);
-        if (linearPhaseParam != nullptr && linearPhaseParam->load() > 0.5f)
+        if (parameterRouter.isOn(GlobalParam::LinearPhaseMode))
         {
             tailSeconds += static_cast<double>(linearPhaseEQ.getLatencyInSamples()) / baseSampleRate;
         }
@@ -110,8 +87,11 @@ double AuraAudioProcessor::getTailLengthSeconds() const
             tailSeconds += 0.05;
         }
         
-        // Oversampler Latenz
-        tailSeconds += static_cast<double>(oversampler.getLatencyInSamples()) / baseSampleRate;
+        // Oversampler Latenz + Dynamic-EQ-Lookahead
+        tailSeconds += static_cast<double>(getIIRStageLatency()) / baseSampleRate;
+        
+        // STFT-Suppressor (Quality "Spectral")
+        tailSeconds += static_cast<double>(resonanceSuppressor.getLatencyInSamples()) / baseSampleRate;
     }
     
     return tailSeconds;
@@ -146,10 +126,14 @@ void AuraAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
     baseSampleRate = sampleRate;
     baseBlockSize = samplesPerBlock;
     
-    // EQ-Processor mit oversampled Rate vorbereiten
-    double osSampleRate = sampleRate * static_cast<double>(oversampler.getFactorAsInt());
-    int osBlockSize = samplesPerBlock * oversampler.getFactorAsInt();
-    eqProcessor.prepare(osSampleRate, osBlockSize);
+    // Oversampling-Stufen vorbereiten (alle Faktoren vorab alloziert, Einstellung sofort übernommen)
+    oversamplingStage.prepare(sampleRate, samplesPerBlock);
+    oversamplingStageDouble.prepare(sampleRate, samplesPerBlock);
+    
+    // EQ-Processor mit oversampled Rate vorbereiten (Gruppen nach der aktuellen Schwelle)
+    eqProcessor.setOversamplingThreshold(parameterRouter.getValue(GlobalParam::OversamplingThreshold, 25.0f) / 100.0f);
+    const int osFactor = oversamplingStage.getActiveFactorAsInt();
+    eqProcessor.prepare(sampleRate * static_cast<double>(osFactor), samplesPerBlock * osFactor, osFactor);
     
     // FFT-Analyzer vorbereiten (immer bei Basis-Rate)
     preAnalyzer.prepare(sampleRate);
@@ -160,9 +144,8 @@ void AuraAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
     
     // Live SmartEQ vorbereiten
     liveSmartEQ.prepare(sampleRate, samplesPerBlock);
-    liveSmartEqWasActive.store(false);  // Reset tracking
     
-    // Reset anfordern - wird im Message-Thread vom Editor ausgeführt
+    // Reset anfordern - APVTS-Reset übernimmt timerCallback() im Message-Thread (auch ohne Editor)
     liveSmartEQ.requestReset();
     
     // A/B-Vergleich initialisieren
@@ -174,18 +157,38 @@ void AuraAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
     // Reference-Player vorbereiten
     referencePlayer.prepare(sampleRate, samplesPerBlock);
     
-    // NEU: Oversampler vorbereiten
-    oversampler.prepare(sampleRate, samplesPerBlock, 2);
-    
     // NEU: Resonance Suppressor vorbereiten
     resonanceSuppressor.prepare(sampleRate, samplesPerBlock);
     
-    // NEU: Linear Phase EQ vorbereiten
+    // NEU: Linear Phase EQ vorbereiten (Engines aller Latenz-Stufen, angefragte Stufe aktiv)
+    linearPhaseEQ.setLatencyMode(getLinearPhaseLatencyMode(
+        static_cast<int>(parameterRouter.getValue(GlobalParam::LinearPhaseLatency, 3.0f))));
     linearPhaseEQ.prepare(sampleRate, samplesPerBlock, 2);
     
-    // NEU: Dry-Buffer für Wet/Dry Mix allokieren
+    // Kurve sofort berechnen, damit der erste Block nicht mit Unity läuft
+    if (parameterRouter.isOn(GlobalParam::LinearPhaseMode))
+        linearPhaseEQ.updateMagnitudeResponseIfNeeded(eqProcessor);
+    
+    linearPhaseWorker.start();
+    smartAnalysisWorker.start();
+    
+    // Dry-Abgriffe: Delay-Kapazität für die größte Latenz aller Modi → Umschalten ohne Allokation
+    dryDelay.prepare(getMaxCompensatedLatency(), samplesPerBlock);
+    lookaheadDelay.prepare(MAX_DYNAMIC_LOOKAHEAD_SAMPLES, samplesPerBlock);
     dryBuffer.setSize(2, samplesPerBlock);
     dryBuffer.clear();
+    compareBuffer.setSize(2, samplesPerBlock);
+    compareBuffer.clear();
+    dryBufferDouble.setSize(2, samplesPerBlock);
+    dryBufferDouble.clear();
+    compareBufferDouble.setSize(2, samplesPerBlock);
+    compareBufferDouble.clear();
+    floatStageBuffer.setSize(2, samplesPerBlock);
+    floatStageBuffer.clear();
+    
+    // Stille-Erkennung: Stufen gelten erst nach voller Haltezeit als ausgeschwungen
+    for (auto& gate : silenceGates)
+        gate.reset();
     
     // NEU: Preset-Crossfade Buffer allokieren (~20ms)
     presetFadeTotalSamples = static_cast<int>(sampleRate * 0.02);  // 20ms
@@ -208,10 +211,19 @@ void AuraAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
     
     // Alle Bänder mit aktuellen Parametern initialisieren
     updateAllBandsFromParameters();
+    
+    // Heartbeat neu starten: bis zum ersten Timer-Tick ohne Block gilt der Audio-Thread als aktiv
+    lastSeenAudioBlock = audioBlockCounter.load(std::memory_order_relaxed);
+    quietTimerTicks = 0;
+    audioThreadQuiet.store(false);
+    audioCallbackActive.store(true);
 }
 
 void AuraAudioProcessor::releaseResources()
 {
+    audioCallbackActive.store(false);
+    linearPhaseWorker.stop();
+    smartAnalysisWorker.stop();
     eqProcessor.reset();
     preAnalyzer.reset();
     postAnalyzer.reset();
@@ -230,70 +242,202 @@ bool AuraAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) cons
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
         return false;
 
+    // Sidechain (Dynamic EQ): deaktiviert, Mono oder Stereo
+    if (layouts.inputBuses.size() > 1)
+    {
+        const auto sidechain = layouts.getChannelSet(true, 1);
+        if (!sidechain.isDisabled()
+            && sidechain != juce::AudioChannelSet::mono()
+            && sidechain != juce::AudioChannelSet::stereo())
+            return false;
+    }
+
     return true;
 }
 
-void AuraAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& /*midiMessages*/)
+void AuraAudioProcessor::processBlock(juce::AudioBuffer<float>& hostBuffer, juce::MidiBuffer& /*midiMessages*/)
+{
+    processInPreparedBlocks(hostBuffer);
+}
+
+void AuraAudioProcessor::processBlock(juce::AudioBuffer<double>& hostBuffer, juce::MidiBuffer& /*midiMessages*/)
+{
+    processInPreparedBlocks(hostBuffer);
+}
+
+template <typename SampleType>
+void AuraAudioProcessor::processInPreparedBlocks(juce::AudioBuffer<SampleType>& hostBuffer)
+{
+    const int numSamples = hostBuffer.getNumSamples();
+    
+    if (numSamples <= baseBlockSize)
+    {
+        processBlockInternal(hostBuffer);
+        return;
+    }
+    
+    // Host liefert größere Blöcke als in prepareToPlay angekündigt (Ausnahmefall):
+    // in Teilblöcken der angekündigten Größe verarbeiten, alle Stufen und Puffer
+    // bleiben so groß wie alloziert (keine Allokation im Audio-Thread)
+    for (int start = 0; start < numSamples; start += baseBlockSize)
+    {
+        juce::AudioBuffer<SampleType> chunk(hostBuffer.getArrayOfWritePointers(), hostBuffer.getNumChannels(),
+                                            start, juce::jmin(baseBlockSize, numSamples - start));
+        processBlockInternal(chunk);
+    }
+}
+
+template <typename SampleType>
+void AuraAudioProcessor::readDryTap(juce::AudioBuffer<SampleType>& dest, juce::AudioBuffer<SampleType>& scratch,
+                                    int eqStageLatency, int extraLatency, bool linearPhaseEnabled, int numSamples)
+{
+    auto& stage = getOversamplingStage(SampleType());
+    
+    if (linearPhaseEnabled || !stage.wasCrossfading())
+    {
+        dryDelay.read(dest, eqStageLatency + extraLatency);
+        return;
+    }
+    
+    // Der Ausgang mischt in diesem Block alten und neuen Oversampling-Pfad →
+    // Dry ebenso auf beide Latenzen legen, sonst Kammfilter im Mix/Vergleich
+    const int baseLatency = getDynamicLookaheadSamples() + extraLatency;
+    dryDelay.read(dest, baseLatency + stage.getBlockFadeLatency(false));
+    dryDelay.read(scratch, baseLatency + stage.getBlockFadeLatency(true));
+    stage.alignTaps(dest, scratch, LatencyCompensationDelay::MAX_CHANNELS, numSamples);
+}
+
+template <typename Stage>
+void AuraAudioProcessor::runFloatStage(juce::AudioBuffer<float>& buffer, bool /*writeBack*/, Stage&& stage)
+{
+    stage(buffer);
+}
+
+template <typename Stage>
+void AuraAudioProcessor::runFloatStage(juce::AudioBuffer<double>& buffer, bool writeBack, Stage&& stage)
+{
+    const int numChannels = juce::jmin(buffer.getNumChannels(), floatStageBuffer.getNumChannels());
+    const int numSamples = buffer.getNumSamples();
+    jassert(numSamples <= floatStageBuffer.getNumSamples());
+    
+    // Ansicht auf die Blocklänge (floatStageBuffer kann größer sein)
+    juce::AudioBuffer<float> block(floatStageBuffer.getArrayOfWritePointers(), numChannels, numSamples);
+    
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const double* source = buffer.getReadPointer(ch);
+        float* dest = block.getWritePointer(ch);
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = static_cast<float>(source[i]);
+    }
+    
+    stage(block);
+    
+    if (!writeBack)
+        return;
+    
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const float* source = block.getReadPointer(ch);
+        double* dest = buffer.getWritePointer(ch);
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = static_cast<double>(source[i]);
+    }
+}
+
+template <typename SampleType>
+void AuraAudioProcessor::processBlockInternal(juce::AudioBuffer<SampleType>& hostBuffer)
 {
     juce::ScopedNoDenormals noDenormals;
 
-    const int totalNumInputChannels = getTotalNumInputChannels();
-    const int totalNumOutputChannels = getTotalNumOutputChannels();
+    // Hauptbus wird bearbeitet, der Sidechain-Bus nur von den Dynamic-EQ-Detektoren gelesen
+    auto buffer = getBusBuffer(hostBuffer, true, 0);
+    const auto sidechain = getBusBuffer(hostBuffer, true, 1);
+
+    const int totalNumInputChannels = getMainBusNumInputChannels();
+    const int totalNumOutputChannels = getMainBusNumOutputChannels();
 
     // Unbenutzte Output-Kanäle löschen
     for (int i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
-    // Input Gain anwenden
-    auto* inputGainParam = apvts.getRawParameterValue(ParameterIDs::INPUT_GAIN);
-    if (inputGainParam != nullptr)
+    // Heartbeat für den Timer (erkennt einen Host, der keine Blöcke mehr liefert)
+    audioBlockCounter.fetch_add(1, std::memory_order_relaxed);
+
+    // Band-Änderungen seit dem letzten Block anwenden (nur geänderte Bänder/Felder).
+    // Übernimmt gerade der Message-Thread (Audio-Thread galt als still), bleiben
+    // die Änderungen für den nächsten Block liegen.
+    if (!bandChangesBusy.exchange(true, std::memory_order_acquire))
     {
-        float inputGainDB = inputGainParam->load();
-        if (std::abs(inputGainDB) > 0.01f)
+        parameterRouter.drainBandChanges([this](int bandIndex, uint32_t fieldMask)
         {
-            float inputGainLinear = juce::Decibels::decibelsToGain(inputGainDB);
-            buffer.applyGain(inputGainLinear);
-        }
+            applyBandChanges(bandIndex, fieldMask);
+        });
+        
+        // Live Smart EQ: direkte Band-Modulation aus dem Worker (ohne APVTS-Umweg)
+        liveSmartEQ.getBandModulation().drainChanges([this](int bandIndex)
+        {
+            applyBandModulation(bandIndex);
+        });
+
+        // Koeffizienten-Snapshot für Kurve/LinearPhase-Design (auch wenn der
+        // IIR-Pfad in diesem Block nicht läuft, z.B. im Linear Phase Mode)
+        eqProcessor.publishSnapshot();
+        bandChangesBusy.store(false, std::memory_order_release);
+    }
+
+    // Input Gain anwenden
+    const float inputGainDB = parameterRouter.getValue(GlobalParam::InputGain);
+    if (std::abs(inputGainDB) > 0.01f)
+    {
+        const auto inputGainLinear = juce::Decibels::decibelsToGain(static_cast<SampleType>(inputGainDB));
+        buffer.applyGain(inputGainLinear);
     }
     
     // NEU: System Audio Capture (nur wenn aktiviert - für Standalone)
     // Ersetzt den normalen Input mit dem System-Audio-Output
     if (systemAudioCapture.isCapturing())
     {
-        int numSamples = systemAudioCapture.getLatestSamples(buffer);
-        (void)numSamples;  // Für Debug-Zwecke
+        runFloatStage(buffer, true, [this](juce::AudioBuffer<float>& block)
+        {
+            int numSamples = systemAudioCapture.getLatestSamples(block);
+            (void)numSamples;  // Für Debug-Zwecke
+        });
     }
 
-    // Pre-EQ Analyse (für Spektrum-Anzeige)
-    auto* analyzerOnParam = apvts.getRawParameterValue(ParameterIDs::ANALYZER_ON);
-    bool analyzerOn = analyzerOnParam != nullptr && analyzerOnParam->load() > 0.5f;
+    // Digitale Stille am jeweiligen Stufeneingang (SilenceGate): Stufen mit leeren
+    // Delay-Leitungen und abgeklungenen Zuständen entfallen, bis wieder Signal kommt
+    bool signalSilent = SilenceGate::isSilent(buffer);
+    
+    // Pre-EQ Analyse (für Spektrum-Anzeige), bei Stille bis das Spektrum am Floor steht
+    bool analyzerOn = parameterRouter.isOn(GlobalParam::AnalyzerOn);
     
     if (analyzerOn)
     {
-        preAnalyzer.pushBuffer(buffer);
+        auto& gate = getSilenceGate(IdleStage::PreAnalyzer);
+        if (!gate.shouldSkip(signalSilent, preAnalyzer.getSilenceSettleSamples()))
+        {
+            runFloatStage(buffer, false, [this](juce::AudioBuffer<float>& block) { preAnalyzer.pushBuffer(block); });
+            gate.update(signalSilent, signalSilent, buffer.getNumSamples());
+        }
     }
     
-    // A/B-Vergleich: Original-Signal speichern für Delta-Listen
-    abComparison.captureOriginal(buffer);
+    // Dry-Signal vor dem EQ in die gemeinsame Latenz-Ausgleichs-Leitung schreiben.
+    // Wet/Dry-Mix, A/B/Delta und Auto-Gain lesen es weiter unten passend verzögert.
+    auto& pathDryBuffer = getDryBuffer(SampleType());
+    auto& pathCompareBuffer = getCompareBuffer(SampleType());
     
-    // Auto-Gain: Input-Level messen
-    autoGain.measureInput(buffer);
-
-    // ===== NEU: Wet/Dry Mix - Dry-Signal vor EQ kopieren =====
-    auto* wetDryParam = apvts.getRawParameterValue(ParameterIDs::WET_DRY_MIX);
-    float wetDryMix = (wetDryParam != nullptr) ? wetDryParam->load() / 100.0f : 1.0f;
+    // Blocklänge ≤ angekündigter Größe (s. processInPreparedBlocks)
+    jassert(dryDelay.canProcess(buffer.getNumSamples()) && pathDryBuffer.getNumSamples() >= buffer.getNumSamples());
+    dryDelay.push(buffer);
+    
+    // Lookahead-Leitung ebenso in jedem Block schreiben (auch bei Linear Phase und
+    // A/B-Bypass), damit der IIR-Pfad beim Zurückschalten keinen veralteten Ring liest
+    lookaheadDelay.push(buffer);
     
+    float wetDryMix = parameterRouter.getValue(GlobalParam::WetDryMix, 100.0f) / 100.0f;
     bool needsDryBlend = wetDryMix < 0.99f;
-    if (needsDryBlend)
-    {
-        // Dry-Signal kopieren bevor EQ angewendet wird
-        if (dryBuffer.getNumSamples() < buffer.getNumSamples())
-            dryBuffer.setSize(buffer.getNumChannels(), buffer.getNumSamples(), false, false, true);
-        
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-            dryBuffer.copyFrom(ch, 0, buffer, ch, 0, buffer.getNumSamples());
-    }
-
+    
     // EQ-Verarbeitung (abhängig vom A/B-Modus)
     ABComparison::CompareMode mode = abComparison.getMode();
     bool shouldProcess = (mode == ABComparison::CompareMode::Normal || 
@@ -302,38 +446,57 @@ void AuraAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::Mi
                           mode == ABComparison::CompareMode::B);
     
     // ===== Global Mid/Side Encoding =====
-    auto* midSideParam = apvts.getRawParameterValue(ParameterIDs::MID_SIDE_MODE);
-    bool globalMidSide = (midSideParam != nullptr && midSideParam->load() > 0.5f);
+    bool globalMidSide = parameterRouter.isOn(GlobalParam::MidSideMode);
     
-    if (globalMidSide && buffer.getNumChannels() >= 2 && shouldProcess)
+    auto encodeMidSide = [](juce::AudioBuffer<SampleType>& block)
     {
         // L/R → M/S: Mid = (L+R)/2, Side = (L-R)/2
-        auto* leftData = buffer.getWritePointer(0);
-        auto* rightData = buffer.getWritePointer(1);
-        const int numSamples = buffer.getNumSamples();
+        auto* leftData = block.getWritePointer(0);
+        auto* rightData = block.getWritePointer(1);
+        const int numSamples = block.getNumSamples();
         
         for (int i = 0; i < numSamples; ++i)
         {
-            const float mid  = (leftData[i] + rightData[i]) * 0.5f;
-            const float side = (leftData[i] - rightData[i]) * 0.5f;
+            const SampleType mid  = (leftData[i] + rightData[i]) * static_cast<SampleType>(0.5);
+            const SampleType side = (leftData[i] - rightData[i]) * static_cast<SampleType>(0.5);
             leftData[i] = mid;
             rightData[i] = side;
         }
-    }
+    };
+    
+    if (globalMidSide && buffer.getNumChannels() >= 2 && shouldProcess)
+        encodeMidSide(buffer);
+    
+    // Suppressor-Engine vor der Latenz-Meldung wählen (Spectral bringt eigene Latenz mit)
+    resonanceSuppressor.setEngine(static_cast<DynamicResonanceSuppressor::Engine>(
+        static_cast<int>(parameterRouter.getValue(GlobalParam::SuppressorQuality))));
+    
+    // ===== Linear Phase Mode Check =====
+    const bool linearPhaseEnabled = parameterRouter.isOn(GlobalParam::LinearPhaseMode);
     
     if (shouldProcess)
     {
-        // ===== Linear Phase Mode Check =====
-        auto* linearPhaseParam = apvts.getRawParameterValue(ParameterIDs::LINEAR_PHASE_MODE);
-        bool linearPhaseEnabled = (linearPhaseParam != nullptr && linearPhaseParam->load() > 0.5f);
-        
         if (linearPhaseEnabled)
         {
             // ===== Linear Phase EQ (FFT-basiert, Zero-Phase) =====
             linearPhaseEQ.setEnabled(true);
-            linearPhaseEQ.processBlock(buffer);
-            // Latenz melden
-            setLatencySamples(linearPhaseEQ.getLatencyInSamples());
+            
+            // Offline-Bounce: Kurve synchron aktualisieren (Worker-Latenz wäre
+            // bei schneller-als-Echtzeit-Rendering hörbar)
+            if (isNonRealtime())
+                linearPhaseEQ.updateMagnitudeResponseIfNeeded(eqProcessor);
+            
+            // Stille: Overlap-Save-Fenster und Partitionen (2 x Latenz) leer → Stufe entfällt
+            auto& gate = getSilenceGate(IdleStage::LinearPhaseEQ);
+            if (gate.shouldSkip(signalSilent, 2 * linearPhaseEQ.getLatencyInSamples() + SilenceGate::DECAY_HOLD_SAMPLES))
+            {
+                buffer.clear();
+            }
+            else
+            {
+                runFloatStage(buffer, true, [this](juce::AudioBuffer<float>& block) { linearPhaseEQ.processBlock(block); });
+                gate.update(signalSilent, signalSilent && SilenceGate::isSilent(buffer), buffer.getNumSamples());
+            }
         }
         else
         {
@@ -342,92 +505,108 @@ void AuraAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::Mi
             // ===== NEU: Per-Band Solo Check =====
             // FIX: Unterstützt nun mehrere gleichzeitig gesolote Bänder
             anyBandSoloed.store(false);
-            std::array<bool, ParameterIDs::MAX_BANDS> soloedBands{};
-            int soloCount = 0;
+            uint32_t soloMask = 0;
             for (int i = 0; i < ParameterIDs::MAX_BANDS; ++i)
             {
-                auto* soloParam = apvts.getRawParameterValue(ParameterIDs::getBandSoloID(i));
-                if (soloParam != nullptr && soloParam->load() > 0.5f)
-                {
-                    soloedBands[i] = true;
-                    ++soloCount;
-                }
+                if (parameterRouter.getBandValue(i, BandField::Solo) > 0.5f)
+                    soloMask |= (1u << i);
             }
-            if (soloCount > 0)
+            if (soloMask != 0)
                 anyBandSoloed.store(true);
             
-            // ===== Oversampling-Wrapper um EQ =====
-            auto osFactor = oversampler.getOversamplingFactor();
-            bool useOversampling = (osFactor != HighQualityOversampler::Factor::x1);
+            // ===== Dynamic EQ: Detektoren auf Basis-Rate, vor Lookahead und Oversampling =====
+            eqProcessor.analyzeDynamics(buffer, sidechain.getNumChannels() > 0 ? &sidechain : nullptr);
             
-            if (useOversampling)
+            // Lookahead: das Audio läuft den Detektoren um die gemeldete Latenz hinterher.
+            // Die Leitung hält den Eingang in L/R (oben geschrieben) → danach neu kodieren
+            const int lookahead = getDynamicLookaheadSamples();
+            if (lookahead > 0)
             {
-                const int numSamples = buffer.getNumSamples();
-                const int numCh = juce::jmin(buffer.getNumChannels(), 2);  // Max Stereo für Oversampler
-                
-                // Upsample alle Kanäle
-                for (int ch = 0; ch < numCh; ++ch)
-                    oversampler.upsample(buffer.getReadPointer(ch), numSamples, ch);
-                
-                // Oversampled Buffer in temporären AudioBuffer wrappen
-                int osSize = oversampler.getOversampledSize();
-                // Nutze float* direkt aus dem Oversampler (zero-copy)
-                float* osChannels[2] = { nullptr, nullptr };
-                for (int ch = 0; ch < numCh && ch < 2; ++ch)
-                    osChannels[ch] = oversampler.getOversampledBuffer(ch);
-                
-                juce::AudioBuffer<float> osBuffer(osChannels, numCh, osSize);
-                
-                // EQ bei oversampled Rate verarbeiten
-                if (anyBandSoloed.load())
-                {
-                    // Mehrere Solo-Bänder gleichzeitig verarbeiten
-                    for (int b = 0; b < ParameterIDs::MAX_BANDS; ++b)
-                    {
-                        if (soloedBands[b])
-                        {
-                            auto& band = eqProcessor.getBand(b);
-                            if (band.isActive() && !band.isBypassed())
-                                band.processBlock(osBuffer);
-                        }
-                    }
-                }
-                else
-                {
-                    eqProcessor.processBlock(osBuffer);
-                }
+                lookaheadDelay.read(buffer, lookahead);
                 
-                // Downsample zurück in Original-Buffer
-                for (int ch = 0; ch < numCh; ++ch)
-                    oversampler.downsample(buffer.getWritePointer(ch), numSamples, ch);
+                if (globalMidSide && buffer.getNumChannels() >= 2)
+                    encodeMidSide(buffer);
+            }
+            
+            const bool eqInputSilent = lookahead > 0 ? SilenceGate::isSilent(buffer) : signalSilent;
+            
+            // ===== Oversampling-Wrapper um EQ =====
+            auto& activeStage = getOversamplingStage(SampleType());
+            
+            // Ausstehender Faktor-/Qualitätswechsel: EQ wechselt mit (Crossfade, ohne Allokation)
+            if (activeStage.applyPendingChange())
+                eqProcessor.beginOversamplingTransition(activeStage.getActiveFactorAsInt());
+            
+            // Gruppenwechsel in die oversampelte Gruppe blenden erst auf dem hörbaren Pfad ein
+            eqProcessor.setOversampledPathLive(activeStage.isOversampledPathLive());
+            
+            // Schwelle in % der Nyquist-Frequenz (Bänder darunter laufen auf Basisrate)
+            eqProcessor.setOversamplingThreshold(
+                parameterRouter.getValue(GlobalParam::OversamplingThreshold, 25.0f) / 100.0f);
+            
+            // Solo: nur die gesoloten Bänder der jeweiligen Gruppe
+            const bool soloActive = soloMask != 0;
+            
+            // Stille: Bänder und Oversampler entfallen, sobald Ausgang und Filterzustände
+            // unter -200 dB liegen. Haltezeit mit der größten Oversampler-Latenz, damit
+            // auch ein Faktorwechsel nach der Pause nur stille Delay-Inhalte liest.
+            // Die Dynamic-Detektoren laufen weiter (Release), Zustände bleiben erhalten
+            auto& eqGate = getSilenceGate(IdleStage::EQ);
+            const int eqHold = HighQualityOversamplerBase::MAX_LATENCY_SAMPLES + SilenceGate::DECAY_HOLD_SAMPLES;
+            
+            if (!activeStage.isFading() && eqGate.shouldSkip(eqInputSilent, eqHold))
+            {
+                buffer.clear();
             }
             else
             {
-                // Kein Oversampling - direkter EQ
-                if (anyBandSoloed.load())
-                {
-                    // Mehrere Solo-Bänder gleichzeitig verarbeiten
-                    for (int b = 0; b < ParameterIDs::MAX_BANDS; ++b)
+                // Basisraten-Gruppe vor dem Upsampling (Reihenschaltung → exakt, kein Ausgleich nötig)
+                if (soloActive)
+                    eqProcessor.processSoloedBlock(buffer, EQProcessor::BandGroup::BaseRate, soloMask);
+                else
+                    eqProcessor.processBlock(buffer, EQProcessor::BandGroup::BaseRate);
+                
+                // Oversampelte Gruppe: Up → EQ → Down (zero-copy), bei Faktor 1 direkt; ohne
+                // oversampelte Bänder bei FIR-Qualität nur ein gleich langes Delay
+                const int numCh = juce::jmin(buffer.getNumChannels(), 2);  // Max Stereo für Oversampler
+                activeStage.process(buffer, numCh, eqProcessor.hasOversampledBands(),
+                    [&](juce::AudioBuffer<SampleType>& block, bool frozenChain)
                     {
-                        if (soloedBands[b])
+                        if (frozenChain)
                         {
-                            auto& band = eqProcessor.getBand(b);
-                            if (band.isActive() && !band.isBypassed())
-                                band.processBlock(buffer);
+                            // Ausblendender Pfad eines Wechsels (Solo: die gesoloten Bänder)
+                            eqProcessor.processFadingBlock(block, soloMask);
                         }
-                    }
-                }
-                else
-                {
-                    eqProcessor.processBlock(buffer);
-                }
+                        else if (soloActive)
+                        {
+                            eqProcessor.processSoloedBlock(block, EQProcessor::BandGroup::Oversampled, soloMask);
+                        }
+                        else
+                        {
+                            eqProcessor.processBlock(block, EQProcessor::BandGroup::Oversampled);
+                        }
+                    });
+                
+                eqGate.update(eqInputSilent, eqInputSilent && SilenceGate::isSilent(buffer), buffer.getNumSamples());
             }
-            
-            // Latenz für IIR-Modus: nur Oversampler-Latenz
-            setLatencySamples(oversampler.getLatencyInSamples());
         }
     }
     
+    // IIR-Pfad lief nicht: Oversampling-Stufe leert beim Zurückschalten Delay und Filter
+    if (!shouldProcess || linearPhaseEnabled)
+        getOversamplingStage(SampleType()).markIdle();
+    
+    // Latenz der EQ-Stufe aus dem aktiven Modus (Linear Phase bzw. Oversampler + Lookahead),
+    // auch wenn der EQ nicht läuft (A/B-Bypass): die gemeldete Latenz bleibt gleich und
+    // Original/Dry bleiben darauf ausgerichtet. Beim Oversampling zählt der hörbare Pfad:
+    // ein Faktor-/Qualitätswechsel meldet die neue Latenz erst nach seinem Crossfade
+    const int eqStageLatency = linearPhaseEnabled
+        ? linearPhaseEQ.getLatencyInSamples()
+        : getOversamplingStage(SampleType()).getPlayingLatency() + getDynamicLookaheadSamples();
+    
+    // Latenz melden: EQ-Stufe + ggf. Spectral-Suppressor
+    setLatencySamples(eqStageLatency + resonanceSuppressor.getLatencyInSamples());
+    
     // ===== Global Mid/Side Decoding =====
     if (globalMidSide && buffer.getNumChannels() >= 2 && shouldProcess)
     {
@@ -438,107 +617,153 @@ void AuraAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::Mi
         
         for (int i = 0; i < numSamples; ++i)
         {
-            const float left  = leftData[i] + rightData[i];
-            const float right = leftData[i] - rightData[i];
+            const SampleType left  = leftData[i] + rightData[i];
+            const SampleType right = leftData[i] - rightData[i];
             leftData[i] = left;
             rightData[i] = right;
         }
     }
     
-    // ===== NEU: Wet/Dry Mix anwenden =====
+    // ===== NEU: Wet/Dry Mix anwenden (Dry auf die EQ-Latenz ausgerichtet) =====
     if (needsDryBlend)
     {
+        readDryTap(pathDryBuffer, pathCompareBuffer, eqStageLatency, 0, linearPhaseEnabled, buffer.getNumSamples());
+        
         for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
         {
-            float* wet = buffer.getWritePointer(ch);
-            const float* dry = dryBuffer.getReadPointer(ch);
+            SampleType* wet = buffer.getWritePointer(ch);
+            const SampleType* dry = pathDryBuffer.getReadPointer(ch);
             const int numSamples = buffer.getNumSamples();
             
             // SIMD-optimiert: wet = dry * (1-mix) + wet * mix
-            juce::FloatVectorOperations::multiply(wet, wetDryMix, numSamples);
-            juce::FloatVectorOperations::addWithMultiply(wet, dry, 1.0f - wetDryMix, numSamples);
+            juce::FloatVectorOperations::multiply(wet, static_cast<SampleType>(wetDryMix), numSamples);
+            juce::FloatVectorOperations::addWithMultiply(wet, dry, static_cast<SampleType>(1.0f - wetDryMix), numSamples);
         }
     }
 
-    // Post-EQ Analyse - VOR dem Suppressor ausfuehren, damit der Suppressor
-    // das aktuelle Post-EQ Signal analysiert (kein Feedback-Loop!)
-    postAnalyzer.pushBuffer(buffer);
+    // Eingang von Post-Analyzer und Suppressor (nach EQ und Wet/Dry)
+    signalSilent = SilenceGate::isSilent(buffer);
+    
+    // Post-EQ Analyse (Anzeige) - VOR dem Suppressor, zeigt das Signal ohne Suppression
+    {
+        auto& gate = getSilenceGate(IdleStage::PostAnalyzer);
+        if (!gate.shouldSkip(signalSilent, postAnalyzer.getSilenceSettleSamples()))
+        {
+            runFloatStage(buffer, false, [this](juce::AudioBuffer<float>& block) { postAnalyzer.pushBuffer(block); });
+            gate.update(signalSilent, signalSilent, buffer.getNumSamples());
+        }
+    }
 
     // ===== NEU: Resonance Suppressor (Soothe-Style) =====
-    auto* suppressorEnabledParam = apvts.getRawParameterValue(ParameterIDs::SUPPRESSOR_ENABLED);
-    bool suppressorEnabled = (suppressorEnabledParam != nullptr && suppressorEnabledParam->load() > 0.5f);
+    bool suppressorEnabled = parameterRouter.isOn(GlobalParam::SuppressorEnabled);
+    
+    // Stille: Detektions-Ring und STFT-Ein-/Ausgang (2 x Latenz) geleert, Filterbank
+    // ausgeklungen und (eingeschaltet) keine Gain-Reduktion mehr aktiv
+    auto& suppressorGate = getSilenceGate(IdleStage::Suppressor);
+    const int suppressorHold = resonanceSuppressor.getAnalysisFftSize() + 2 * resonanceSuppressor.getLatencyInSamples()
+                             + SilenceGate::DECAY_HOLD_SAMPLES;
+    const bool suppressorInputSilent = signalSilent;
     
     if (suppressorEnabled)
     {
         // Suppressor-Einstellungen aktualisieren
-        auto* depthParam = apvts.getRawParameterValue(ParameterIDs::SUPPRESSOR_DEPTH);
-        auto* speedParam = apvts.getRawParameterValue(ParameterIDs::SUPPRESSOR_SPEED);
-        auto* selectivityParam = apvts.getRawParameterValue(ParameterIDs::SUPPRESSOR_SELECTIVITY);
+        resonanceSuppressor.setDepth(parameterRouter.getValue(GlobalParam::SuppressorDepth, 0.5f));
+        resonanceSuppressor.setSpeed(parameterRouter.getValue(GlobalParam::SuppressorSpeed, 0.5f));
+        resonanceSuppressor.setSelectivity(parameterRouter.getValue(GlobalParam::SuppressorSelectivity, 0.5f));
         
-        if (depthParam) resonanceSuppressor.setDepth(depthParam->load());
-        if (speedParam) resonanceSuppressor.setSpeed(speedParam->load());
-        if (selectivityParam) resonanceSuppressor.setSelectivity(selectivityParam->load());
-        
-        // Spektrum-Daten vom Post-Analyzer fuer Suppressor nutzen (jetzt aktuell!)
-        const auto& magnitudes = postAnalyzer.getMagnitudes();
-        if (!magnitudes.empty())
+        // Eigene Sidechain-Detektion (unabhängig von Analyzer-Auflösung und ANALYZER_ON),
+        // dann per-Frequenz gewichtete Gain-Reduktion anwenden. Die Spectral-Engine
+        // läuft auch ohne Analyse-Frame weiter, damit die Latenz stimmt
+        if (suppressorGate.shouldSkip(suppressorInputSilent, suppressorHold,
+                                      suppressorInputSilent && resonanceSuppressor.isIdle()))
         {
-            // Analyse: berechnet per-Bin Gain-Reduktionen (RT-safe, kein Heap)
-            resonanceSuppressor.process(magnitudes);
-            
-            // Per-Frequenz gewichtete Gain-Reduktion anwenden
-            resonanceSuppressor.applyToBuffer(buffer, postAnalyzer.getCurrentFFTSize());
+            buffer.clear();
+        }
+        else
+        {
+            runFloatStage(buffer, true, [this](juce::AudioBuffer<float>& block)
+            {
+                resonanceSuppressor.analyzeBlock(block);
+                resonanceSuppressor.applyToBuffer(block);
+            });
+            signalSilent = suppressorInputSilent && SilenceGate::isSilent(buffer);
+            suppressorGate.update(suppressorInputSilent, signalSilent, buffer.getNumSamples());
         }
     }
-    
-    // Reference Track EQ-Matching: Input-Spektrum wird jetzt in LiveSmartEQ.process() aktualisiert
-    // (nicht mehr hier, da es sonst doppelt aktualisiert wird)
-    
-    // SmartAnalyzer Enabled-Status aus Parameter lesen
-    auto* smartModeParam = apvts.getRawParameterValue(ParameterIDs::SMART_MODE_ENABLED);
-    bool smartModeEnabled = (smartModeParam != nullptr && smartModeParam->load() > 0.5f);
-    smartAnalyzer.setEnabled(smartModeEnabled);
-    
-    // SmartAnalyzer aktualisieren (für Live SmartEQ und Smart Mode)
-    smartAnalyzer.analyze(postAnalyzer);
-    
-    // Live SmartEQ verarbeiten (NUR wenn Smart Mode UND Live EQ aktiviert sind)
-    auto* liveEqEnabledParam = apvts.getRawParameterValue(ParameterIDs::LIVE_SMART_EQ_ENABLED);
-    bool liveEqEnabled = (liveEqEnabledParam != nullptr && liveEqEnabledParam->load() > 0.5f);
-    
-    // Prüfe ob Live EQ aktiv sein soll
-    bool shouldBeActive = smartModeEnabled && liveEqEnabled;
-    
-    if (shouldBeActive)
+    else if (resonanceSuppressor.getLatencyInSamples() > 0)
     {
-        liveSmartEqWasActive.store(true);
-        // Einstellungen aus Parametern aktualisieren
-        updateLiveSmartEQFromParameters();
-        
-        // Live SmartEQ verarbeiten
-        liveSmartEQ.process(smartAnalyzer, eqProcessor, apvts, buffer, &postAnalyzer);
+        // Spectral-Engine: Latenz auch im ausgeschalteten Zustand halten
+        if (suppressorGate.shouldSkip(suppressorInputSilent, suppressorHold))
+        {
+            buffer.clear();
+        }
+        else
+        {
+            runFloatStage(buffer, true, [this](juce::AudioBuffer<float>& block) { resonanceSuppressor.processBypassed(block); });
+            signalSilent = suppressorInputSilent && SilenceGate::isSilent(buffer);
+            suppressorGate.update(suppressorInputSilent, signalSilent, buffer.getNumSamples());
+        }
     }
-    else if (liveSmartEqWasActive.load())
+    else
     {
-        // War aktiv, jetzt nicht mehr - Flag setzen für asynchrones Zurücksetzen
-        liveSmartEqWasActive.store(false);
-        liveSmartEQ.setEnabled(false);
-        liveSmartEQ.requestReset();  // Asynchrones Reset anfordern
+        // Ohne Latenz fasst der ausgeschaltete Suppressor den Block nicht an
+        resonanceSuppressor.notifyBypassed();
     }
     
-    // Asynchrones Reset im Message-Thread ausführen (falls angefordert)
-    if (liveSmartEQ.shouldReset())
+    // Reference Track EQ-Matching: Input-Spektrum wird in LiveSmartEQ::processFrame() (Worker) aktualisiert
+    // (nicht mehr hier, da es sonst doppelt aktualisiert wird)
+    
+    // SmartAnalyzer / Live SmartEQ: Entscheidungslogik läuft im SmartAnalysisWorker.
+    // Der Audio-Thread übergibt nur neue Spektrum-Frames (+ Transient-Flag).
+    bool smartModeEnabled = parameterRouter.isOn(GlobalParam::SmartModeEnabled);
+    bool liveEqEnabled = parameterRouter.isOn(GlobalParam::LiveSmartEqEnabled);
+    
+    const bool liveEqActive = smartModeEnabled && liveEqEnabled;
+    bool isTransient = false;
+    if (liveEqActive)
     {
-        // Nur ausführen wenn wir NICHT im Audio-Thread sind
-        // (Dies wird vom Timer im Editor aufgerufen)
+        // Stille mit Envelope am Floor: Erkennung liefert sicher false (Ruhezustand statt Haltezeit)
+        auto& gate = getSilenceGate(IdleStage::TransientDetection);
+        if (!gate.shouldSkip(signalSilent, 0, signalSilent && liveSmartEQ.isTransientDetectionIdle()))
+        {
+            runFloatStage(buffer, false, [this, &isTransient](juce::AudioBuffer<float>& block)
+            {
+                isTransient = liveSmartEQ.updateTransientDetection(block);
+            });
+        }
     }
     
+    smartAnalysisWorker.pushBlock(postAnalyzer, buffer.getNumSamples(),
+                                  smartModeEnabled, liveEqEnabled, isTransient);
+    
+    // Offline-Bounce: jeden Frame sofort auswerten (Worker läuft nicht in Echtzeit mit)
+    if (isNonRealtime())
+        smartAnalysisWorker.processPendingFrames();
+    
     // Pre-EQ Analyse nur wenn visueller Analyzer an ist
     if (analyzerOn)
     {
         // Pre-analyzer ist bereits oben gefüttert
     }
     
+    // Original für Auto-Gain und A/B/Delta: auf die Gesamtlatenz ausgerichtet
+    // (der Suppressor verzögert im Spectral-Modus auch ausgeschaltet)
+    const bool needsCompareSignal = autoGain.isEnabled()
+                                 || abComparison.getMode() != ABComparison::CompareMode::Normal
+                                 || parameterRouter.isOn(GlobalParam::DeltaMode);
+    if (needsCompareSignal)
+    {
+        // pathDryBuffer ist hier frei (Wet/Dry-Mix ist durch) → zweiter Abgriff beim Crossfade
+        readDryTap(pathCompareBuffer, pathDryBuffer, eqStageLatency, resonanceSuppressor.getLatencyInSamples(),
+                   linearPhaseEnabled, buffer.getNumSamples());
+        
+        // pathCompareBuffer kann größer als der Block sein → Ansicht auf die Blocklänge
+        juce::AudioBuffer<SampleType> original(pathCompareBuffer.getArrayOfWritePointers(),
+                                               buffer.getNumChannels(), buffer.getNumSamples());
+        abComparison.captureOriginal(original);
+        autoGain.measureInput(original);
+    }
+    
     // Auto-Gain anwenden (wenn aktiviert)
     if (autoGain.isEnabled())
     {
@@ -547,10 +772,8 @@ void AuraAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::Mi
     
     // A/B-Vergleich: Modus anwenden (Bypass, Delta)
     // NEU: Delta-Modus aus Parameter lesen
-    auto* deltaModeParam = apvts.getRawParameterValue(ParameterIDs::DELTA_MODE);
-    if (deltaModeParam != nullptr)
     {
-        bool deltaEnabled = deltaModeParam->load() > 0.5f;
+        bool deltaEnabled = parameterRouter.isOn(GlobalParam::DeltaMode);
         if (deltaEnabled && abComparison.getMode() != ABComparison::CompareMode::Delta)
             abComparison.setMode(ABComparison::CompareMode::Delta);
         else if (!deltaEnabled && abComparison.getMode() == ABComparison::CompareMode::Delta)
@@ -658,7 +881,7 @@ void AuraAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::Mi
             const float invQuantStep = 1.0f / quantStep;  // Division einmal statt pro Sample
             for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
             {
-                float* data = buffer.getWritePointer(ch);
+                SampleType* data = buffer.getWritePointer(ch);
                 for (int i = 0; i < buffer.getNumSamples(); ++i)
                     data[i] = std::round(data[i] * invQuantStep) * quantStep;
             }
@@ -686,22 +909,26 @@ void AuraAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::Mi
     }
     
     // Output-Level für Level Meter berechnen (getrennt für L/R)
+    // Bei Stille liegt der RMS sicher unter dem Floor (1e-10) → Messung entfällt
     float leftLevel = 0.0f;
     float rightLevel = 0.0f;
     
-    if (buffer.getNumChannels() >= 1)
-    {
-        leftLevel = buffer.getRMSLevel(0, 0, buffer.getNumSamples());
-    }
-    
-    if (buffer.getNumChannels() >= 2)
-    {
-        rightLevel = buffer.getRMSLevel(1, 0, buffer.getNumSamples());
-    }
-    else
+    if (!getSilenceGate(IdleStage::Meters).shouldSkip(SilenceGate::isSilent(buffer), 0))
     {
-        // Mono: Beide Kanäle zeigen dasselbe
-        rightLevel = leftLevel;
+        if (buffer.getNumChannels() >= 1)
+        {
+            leftLevel = static_cast<float>(buffer.getRMSLevel(0, 0, buffer.getNumSamples()));
+        }
+        
+        if (buffer.getNumChannels() >= 2)
+        {
+            rightLevel = static_cast<float>(buffer.getRMSLevel(1, 0, buffer.getNumSamples()));
+        }
+        else
+        {
+            // Mono: Beide Kanäle zeigen dasselbe
+            rightLevel = leftLevel;
+        }
     }
     
     lastOutputLevelLeft.store(20.0f * std::log10(std::max(leftLevel, 1e-10f)));
@@ -745,138 +972,251 @@ void AuraAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
     }
 }
 
-void AuraAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
+void AuraAudioProcessor::handleGlobalParameterChange(GlobalParam param, float newValue)
 {
-    // Output Gain
-    if (parameterID == ParameterIDs::OUTPUT_GAIN)
+    switch (param)
     {
-        eqProcessor.setOutputGain(newValue);
-        return;
-    }
-    
-    // NEU: Oversampling-Faktor ändern
-    if (parameterID == ParameterIDs::OVERSAMPLING_FACTOR)
-    {
-        int factorIdx = static_cast<int>(newValue);
-        switch (factorIdx)
+        // Output Gain
+        case GlobalParam::OutputGain:
+            eqProcessor.setOutputGain(newValue);
+            if (isAudioThreadIdle())
+                applyBandChangesWhileIdle();
+            break;
+        
+        // NEU: Oversampling-Faktor ändern
+        case GlobalParam::OversamplingFactor:
         {
-            case 0: oversampler.setOversamplingFactor(HighQualityOversampler::Factor::x1); break;
-            case 1: oversampler.setOversamplingFactor(HighQualityOversampler::Factor::x2); break;
-            case 2: oversampler.setOversamplingFactor(HighQualityOversampler::Factor::x4); break;
-            default: break;
+            using Factor = HighQualityOversamplerBase::Factor;
+            int factorIdx = static_cast<int>(newValue);
+            Factor factor = oversamplingStage.getOversamplingFactor();
+            switch (factorIdx)
+            {
+                case 0: factor = Factor::x1; break;
+                case 1: factor = Factor::x2; break;
+                case 2: factor = Factor::x4; break;
+                case 3: factor = Factor::x8; break;
+                case 4: factor = Factor::x16; break;
+                default: break;
+            }
+            
+            // Übernahme am nächsten Blockanfang im Audio-Thread (EQ wechselt mit,
+            // Crossfade statt Re-Prepare). Die neue Latenz meldet processBlock, sobald
+            // der neue Pfad hörbar ist; hier nur ohne laufenden Audio-Thread (im
+            // Linear Phase Mode meldet der Block die LP-Latenz)
+            oversamplingStage.setOversamplingFactor(factor);
+            oversamplingStageDouble.setOversamplingFactor(factor);
+            if (isAudioThreadIdle() && !parameterRouter.isOn(GlobalParam::LinearPhaseMode))
+                setLatencySamples(getIIRStageLatency() + resonanceSuppressor.getLatencyInSamples());
+            break;
         }
-        setLatencySamples(oversampler.getLatencyInSamples());
         
-        // EQ-Processor mit neuer oversampled Rate re-preparen
-        double osSampleRate = baseSampleRate * static_cast<double>(oversampler.getFactorAsInt());
-        int osBlockSize = baseBlockSize * oversampler.getFactorAsInt();
-        eqProcessor.prepare(osSampleRate, osBlockSize);
-        return;
+        // Oversampling-Filterqualität (Latenz ändert sich mit, Wechsel wie beim Faktor)
+        case GlobalParam::OversamplingQuality:
+        {
+            const auto quality = newValue > 0.5f ? HighQualityOversamplerBase::FilterQuality::MinimumPhase
+                                                 : HighQualityOversamplerBase::FilterQuality::LinearPhase;
+            oversamplingStage.setFilterQuality(quality);
+            oversamplingStageDouble.setFilterQuality(quality);
+            if (isAudioThreadIdle() && !parameterRouter.isOn(GlobalParam::LinearPhaseMode))
+                setLatencySamples(getIIRStageLatency() + resonanceSuppressor.getLatencyInSamples());
+            break;
+        }
+        
+        // Filter-Design (Wechsel wird am nächsten Blockanfang übernommen)
+        case GlobalParam::FilterDesign:
+            eqProcessor.setFilterDesign(getFilterDesign(newValue));
+            if (isAudioThreadIdle())
+                applyBandChangesWhileIdle();
+            break;
+        
+        // Dynamic-EQ-Lookahead (Latenz des IIR-Pfads ändert sich mit; bei laufendem
+        // Audio-Thread meldet processBlock sie zusammen mit dem hörbaren Oversampling-Pfad)
+        case GlobalParam::DynamicLookahead:
+            if (isAudioThreadIdle() && !parameterRouter.isOn(GlobalParam::LinearPhaseMode))
+                setLatencySamples(getIIRStageLatency() + resonanceSuppressor.getLatencyInSamples());
+            break;
+        
+        // Linear Phase Latenz: alle Stufen sind in prepareToPlay alloziert, hier nur
+        // die Anfrage speichern (Listener kann im Audio-Thread laufen); der Wechsel
+        // passiert am Anfang des nächsten LinearPhaseEQ::processBlock()
+        case GlobalParam::LinearPhaseLatency:
+            linearPhaseEQ.setLatencyMode(getLinearPhaseLatencyMode(static_cast<int>(newValue)));
+            if (parameterRouter.isOn(GlobalParam::LinearPhaseMode))
+                setLatencySamples(linearPhaseEQ.getLatencyInSamples() + resonanceSuppressor.getLatencyInSamples());
+            break;
+        
+        // Alle anderen globalen Parameter werden direkt in processBlock gelesen
+        default:
+            break;
     }
+}
+
+void AuraAudioProcessor::handleAsyncUpdate()
+{
+    // Kein Audio-Callback aktiv (z.B. vor prepareToPlay oder Host pausiert):
+    // Band-Änderungen hier anwenden, damit Kurve und Band-Status im Editor stimmen
+    if (isAudioThreadIdle())
+        applyBandChangesWhileIdle();
+}
+
+void AuraAudioProcessor::applyBandChangesWhileIdle()
+{
+    // Läuft der Audio-Thread gerade wieder an, übernimmt er selbst
+    if (bandChangesBusy.exchange(true, std::memory_order_acquire))
+        return;
     
-    // NEU: Wet/Dry, Delta, Suppressor Parameter werden direkt in processBlock gelesen
-    if (parameterID == ParameterIDs::WET_DRY_MIX ||
-        parameterID == ParameterIDs::DELTA_MODE ||
-        parameterID == ParameterIDs::SUPPRESSOR_ENABLED ||
-        parameterID == ParameterIDs::SUPPRESSOR_DEPTH ||
-        parameterID == ParameterIDs::SUPPRESSOR_SPEED ||
-        parameterID == ParameterIDs::SUPPRESSOR_SELECTIVITY)
+    parameterRouter.drainBandChanges([this](int bandIndex, uint32_t fieldMask)
     {
-        return;  // Direkt in processBlock gelesen
-    }
+        applyBandChanges(bandIndex, fieldMask);
+    });
+    
+    eqProcessor.publishSnapshot();
+    bandChangesBusy.store(false, std::memory_order_release);
+}
 
-    // Band-Parameter identifizieren
-    for (int i = 0; i < ParameterIDs::MAX_BANDS; ++i)
-    {
-        if (parameterID == ParameterIDs::getBandFreqID(i) ||
-            parameterID == ParameterIDs::getBandGainID(i) ||
-            parameterID == ParameterIDs::getBandQID(i) ||
-            parameterID == ParameterIDs::getBandTypeID(i) ||
-            parameterID == ParameterIDs::getBandBypassID(i) ||
-            parameterID == ParameterIDs::getBandChannelID(i) ||
-            parameterID == ParameterIDs::getBandSlopeID(i) ||
-            parameterID == ParameterIDs::getBandDynEnabledID(i) ||
-            parameterID == ParameterIDs::getBandDynThresholdID(i) ||
-            parameterID == ParameterIDs::getBandDynRatioID(i) ||
-            parameterID == ParameterIDs::getBandDynAttackID(i) ||
-            parameterID == ParameterIDs::getBandDynReleaseID(i) ||
-            parameterID == ParameterIDs::getBandSoloID(i))  // Dynamic EQ + Solo Parameter
-        {
-            updateBandFromParameters(i);
-            return;
-        }
-    }
+void AuraAudioProcessor::timerCallback()
+{
+    // Heartbeat prüfen: bleibt der Blockzähler mehrere Ticks stehen, liefert der
+    // Host keine Blöcke mehr (Plugin bleibt aber vorbereitet) → Message-Thread
+    // übernimmt Band-Änderungen und Snapshot
+    const uint32_t blocks = audioBlockCounter.load(std::memory_order_relaxed);
+    quietTimerTicks = (blocks == lastSeenAudioBlock) ? quietTimerTicks + 1 : 0;
+    lastSeenAudioBlock = blocks;
+    audioThreadQuiet.store(quietTimerTicks >= AUDIO_QUIET_TICKS, std::memory_order_relaxed);
+    
+    if (isAudioThreadIdle())
+        applyBandChangesWhileIdle();
+    
+    // Live Smart EQ: APVTS für Anzeige/Automation nachziehen (hörbar ist die
+    // Änderung bereits über die direkte Band-Modulation); deaktivierte Bänder
+    // werden dabei wieder dem APVTS überlassen
+    liveSmartEQ.applyPendingParameterChanges(apvts);
+    
+    // Live Smart EQ Reset (falls angefordert; bei Rate-Limiting bleibt das Flag
+    // für den nächsten Tick stehen)
+    if (liveSmartEQ.shouldReset() && liveSmartEQ.resetEQBands(apvts))
+        liveSmartEQ.clearResetFlag();
 }
 
-void AuraAudioProcessor::updateBandFromParameters(int bandIndex)
+void AuraAudioProcessor::applyBandChanges(int bandIndex, uint32_t fieldMask)
 {
+    // Von LiveSmartEQ übernommene Bänder ignorieren den APVTS bis zur Freigabe
+    // (bei der Freigabe wird der komplette APVTS-Stand neu übernommen)
+    if (liveSmartEQ.getBandModulation().isEngaged(bandIndex))
+        return;
+    
     auto& band = eqProcessor.getBand(bandIndex);
     
-    // Sichere Parameter-Zugriffe
-    auto* freqParam = apvts.getRawParameterValue(ParameterIDs::getBandFreqID(bandIndex));
-    auto* gainParam = apvts.getRawParameterValue(ParameterIDs::getBandGainID(bandIndex));
-    auto* qParam = apvts.getRawParameterValue(ParameterIDs::getBandQID(bandIndex));
-    auto* typeParam = apvts.getRawParameterValue(ParameterIDs::getBandTypeID(bandIndex));
-    auto* bypassParam = apvts.getRawParameterValue(ParameterIDs::getBandBypassID(bandIndex));
-    auto* channelParam = apvts.getRawParameterValue(ParameterIDs::getBandChannelID(bandIndex));
-    auto* slopeParam = apvts.getRawParameterValue(ParameterIDs::getBandSlopeID(bandIndex));
-    
-    if (freqParam == nullptr || gainParam == nullptr || qParam == nullptr ||
-        typeParam == nullptr || bypassParam == nullptr || channelParam == nullptr ||
-        slopeParam == nullptr)
-        return;
+    auto value = [this, bandIndex](BandField field) { return parameterRouter.getBandValue(bandIndex, field); };
+    auto changed = [fieldMask](BandField field) { return (fieldMask & ParameterRouter::fieldBit(field)) != 0; };
+    
+    const float gain = value(BandField::Gain);
+    const int type = static_cast<int>(value(BandField::Type));
     
-    float freq = freqParam->load();
-    float gain = gainParam->load();
-    float q = qParam->load();
-    int type = static_cast<int>(typeParam->load());
-    bool bypass = bypassParam->load() > 0.5f;
-    int channel = static_cast<int>(channelParam->load());
-    float slopeValue = slopeParam->load();
+    // Filter-Parameter gemeinsam setzen → nur eine Koeffizienten-Berechnung pro Block
+    constexpr uint32_t filterFields = ParameterRouter::fieldBit(BandField::Frequency)
+                                    | ParameterRouter::fieldBit(BandField::Gain)
+                                    | ParameterRouter::fieldBit(BandField::Q)
+                                    | ParameterRouter::fieldBit(BandField::Type)
+                                    | ParameterRouter::fieldBit(BandField::Bypass)
+                                    | ParameterRouter::fieldBit(BandField::Channel);
     
-    band.setParameters(freq, gain, q,
-                       static_cast<ParameterIDs::FilterType>(type),
-                       static_cast<ParameterIDs::ChannelMode>(channel),
-                       bypass);
+    if ((fieldMask & filterFields) != 0)
+    {
+        band.setParameters(value(BandField::Frequency), gain, value(BandField::Q),
+                           static_cast<ParameterIDs::FilterType>(type),
+                           static_cast<ParameterIDs::ChannelMode>(static_cast<int>(value(BandField::Channel))),
+                           value(BandField::Bypass) > 0.5f);
+    }
     
     // Slope direkt setzen (der Wert ist bereits 6, 12, 18, 24, 36, 48, 72 oder 96)
-    band.setSlope(static_cast<int>(slopeValue));
+    if (changed(BandField::Slope))
+        band.setSlope(static_cast<int>(value(BandField::Slope)));
     
     // Dynamic EQ Parameter setzen
-    auto* dynEnabledParam = apvts.getRawParameterValue(ParameterIDs::getBandDynEnabledID(bandIndex));
-    auto* dynThresholdParam = apvts.getRawParameterValue(ParameterIDs::getBandDynThresholdID(bandIndex));
-    auto* dynRatioParam = apvts.getRawParameterValue(ParameterIDs::getBandDynRatioID(bandIndex));
-    auto* dynAttackParam = apvts.getRawParameterValue(ParameterIDs::getBandDynAttackID(bandIndex));
-    auto* dynReleaseParam = apvts.getRawParameterValue(ParameterIDs::getBandDynReleaseID(bandIndex));
-    
-    if (dynEnabledParam) band.setDynamicMode(dynEnabledParam->load() > 0.5f);
-    if (dynThresholdParam) band.setThreshold(dynThresholdParam->load());
-    if (dynRatioParam) band.setRatio(dynRatioParam->load());
-    if (dynAttackParam) band.setAttack(dynAttackParam->load());
-    if (dynReleaseParam) band.setRelease(dynReleaseParam->load());
+    if (changed(BandField::DynEnabled))   band.setDynamicMode(value(BandField::DynEnabled) > 0.5f);
+    if (changed(BandField::DynThreshold)) band.setThreshold(value(BandField::DynThreshold));
+    if (changed(BandField::DynRatio))     band.setRatio(value(BandField::DynRatio));
+    if (changed(BandField::DynAttack))    band.setAttack(value(BandField::DynAttack));
+    if (changed(BandField::DynRelease))   band.setRelease(value(BandField::DynRelease));
+    if (changed(BandField::DynSidechain)) band.setExternalSidechain(value(BandField::DynSidechain) > 0.5f);
+    
+    // Solo wird pro Block direkt in processBlock gelesen
     
     // Band aktivieren: APVTS Active-Flag ODER Gain/Filtertyp beruecksichtigen
-    auto* activeParam = apvts.getRawParameterValue(ParameterIDs::getBandActiveID(bandIndex));
-    bool activeFlag = (activeParam != nullptr && activeParam->load() > 0.5f);
-    bool hasSignificantSettings = std::abs(gain) > 0.01f || 
-                                  type == static_cast<int>(ParameterIDs::FilterType::LowCut) ||
-                                  type == static_cast<int>(ParameterIDs::FilterType::HighCut) ||
-                                  type == static_cast<int>(ParameterIDs::FilterType::Notch);
-    band.setActive(activeFlag || hasSignificantSettings);
+    if (changed(BandField::Active) || changed(BandField::Gain) || changed(BandField::Type))
+    {
+        bool activeFlag = value(BandField::Active) > 0.5f;
+        bool hasSignificantSettings = std::abs(gain) > 0.01f || 
+                                      type == static_cast<int>(ParameterIDs::FilterType::LowCut) ||
+                                      type == static_cast<int>(ParameterIDs::FilterType::HighCut) ||
+                                      type == static_cast<int>(ParameterIDs::FilterType::Notch);
+        band.setActive(activeFlag || hasSignificantSettings);
+    }
+}
+
+void AuraAudioProcessor::applyBandModulation(int bandIndex)
+{
+    auto& modulation = liveSmartEQ.getBandModulation();
+    auto& band = eqProcessor.getBand(bandIndex);
+    
+    switch (modulation.getState(bandIndex))
+    {
+        case BandModulation::State::Active:
+        {
+            // Koeffizienten-Smoothing der Biquads interpoliert zwischen den Frames
+            const auto values = modulation.getValues(bandIndex);
+            band.setParameters(values.frequency, values.gainDb, values.q,
+                               ParameterIDs::FilterType::Bell,
+                               static_cast<ParameterIDs::ChannelMode>(values.channelMode),
+                               false);
+            band.setDynamicMode(false);  // Smart EQ hat eigenes Envelope-Processing
+            band.setActive(true);
+            break;
+        }
+        
+        case BandModulation::State::Inactive:
+            band.setActive(false);
+            break;
+        
+        case BandModulation::State::Released:
+            applyBandChanges(bandIndex, ParameterRouter::ALL_BAND_FIELDS);
+            break;
+    }
 }
 
 void AuraAudioProcessor::updateAllBandsFromParameters()
 {
     for (int i = 0; i < ParameterIDs::MAX_BANDS; ++i)
     {
-        updateBandFromParameters(i);
+        applyBandChanges(i, ParameterRouter::ALL_BAND_FIELDS);
     }
     
-    auto* outputGainParam = apvts.getRawParameterValue(ParameterIDs::OUTPUT_GAIN);
-    if (outputGainParam != nullptr)
+    eqProcessor.setOutputGain(parameterRouter.getValue(GlobalParam::OutputGain));
+    eqProcessor.setFilterDesign(getFilterDesign(parameterRouter.getValue(GlobalParam::FilterDesign)));
+    
+    // Ohne Audio-Callback veröffentlicht niemand sonst den neuen Stand
+    if (isAudioThreadIdle())
+        applyBandChangesWhileIdle();
+}
+
+BiquadFilter::DesignMode AuraAudioProcessor::getFilterDesign(float choiceValue)
+{
+    // Reihenfolge der Choice-Einträge: Cookbook, Analog Matched
+    return choiceValue > 0.5f ? BiquadFilter::DesignMode::AnalogMatched
+                              : BiquadFilter::DesignMode::Cookbook;
+}
+
+LinearPhaseEQ::LatencyMode AuraAudioProcessor::getLinearPhaseLatencyMode(int choiceIndex)
+{
+    // Reihenfolge der Choice-Einträge: Ultra Low, Very Low, Low, Medium, High
+    switch (choiceIndex)
     {
-        float outputGain = outputGainParam->load();
-        eqProcessor.setOutputGain(outputGain);
+        case 0:  return LinearPhaseEQ::LatencyMode::UltraLow;
+        case 1:  return LinearPhaseEQ::LatencyMode::VeryLow;
+        case 2:  return LinearPhaseEQ::LatencyMode::Low;
+        case 4:  return LinearPhaseEQ::LatencyMode::High;
+        default: return LinearPhaseEQ::LatencyMode::Medium;
     }
 }
 
@@ -886,41 +1226,27 @@ void AuraAudioProcessor::updateLiveSmartEQFromParameters()
     LiveSmartEQ::Settings settings = liveSmartEQ.getSettings();
     
     // Prüfe zuerst ob Smart Mode überhaupt aktiviert ist
-    auto* smartModeParam = apvts.getRawParameterValue(ParameterIDs::SMART_MODE_ENABLED);
-    bool smartModeEnabled = (smartModeParam != nullptr && smartModeParam->load() > 0.5f);
-    
-    auto* enabledParam = apvts.getRawParameterValue(ParameterIDs::LIVE_SMART_EQ_ENABLED);
-    auto* depthParam = apvts.getRawParameterValue(ParameterIDs::LIVE_SMART_EQ_DEPTH);
-    auto* attackParam = apvts.getRawParameterValue(ParameterIDs::LIVE_SMART_EQ_ATTACK);
-    auto* releaseParam = apvts.getRawParameterValue(ParameterIDs::LIVE_SMART_EQ_RELEASE);
-    auto* thresholdParam = apvts.getRawParameterValue(ParameterIDs::LIVE_SMART_EQ_THRESHOLD);
-    auto* modeParam = apvts.getRawParameterValue(ParameterIDs::LIVE_SMART_EQ_MODE);
-    auto* maxReductionParam = apvts.getRawParameterValue(ParameterIDs::LIVE_SMART_EQ_MAX_REDUCTION);
-    auto* transientParam = apvts.getRawParameterValue(ParameterIDs::LIVE_SMART_EQ_TRANSIENT_PROTECT);
-    auto* msModeParam = apvts.getRawParameterValue(ParameterIDs::LIVE_SMART_EQ_MS_MODE);
-    auto* profileParam = apvts.getRawParameterValue(ParameterIDs::LIVE_SMART_EQ_PROFILE);
+    bool smartModeEnabled = parameterRouter.isOn(GlobalParam::SmartModeEnabled);
     
     // Live EQ ist nur aktiviert wenn BEIDE Checkboxen aktiv sind
-    if (enabledParam) settings.enabled = smartModeEnabled && (enabledParam->load() > 0.5f);
-    if (depthParam) settings.depth = depthParam->load();
-    if (attackParam) settings.attackMs = attackParam->load();
-    if (releaseParam) settings.releaseMs = releaseParam->load();
+    settings.enabled = smartModeEnabled && parameterRouter.isOn(GlobalParam::LiveSmartEqEnabled);
+    settings.depth = parameterRouter.getValue(GlobalParam::LiveSmartEqDepth, settings.depth);
+    settings.attackMs = parameterRouter.getValue(GlobalParam::LiveSmartEqAttack, settings.attackMs);
+    settings.releaseMs = parameterRouter.getValue(GlobalParam::LiveSmartEqRelease, settings.releaseMs);
     // Threshold wird NUR bei Custom-Mode vom Knob gelesen.
     // Bei Gentle/Normal/Aggressive setzt setMode() den richtigen Wert.
-    if (maxReductionParam) settings.maxGainReduction = maxReductionParam->load();
-    if (transientParam) settings.transientProtection = transientParam->load() > 0.5f;
-    if (msModeParam) settings.midSideMode = static_cast<int>(msModeParam->load());
-    
-    // Profil-Name aus Index ermitteln
-    if (profileParam)
+    settings.maxGainReduction = parameterRouter.getValue(GlobalParam::LiveSmartEqMaxReduction, settings.maxGainReduction);
+    settings.transientProtection = parameterRouter.getValue(GlobalParam::LiveSmartEqTransientProtect,
+                                                            settings.transientProtection ? 1.0f : 0.0f) > 0.5f;
+    settings.midSideMode = static_cast<int>(parameterRouter.getValue(GlobalParam::LiveSmartEqMsMode,
+                                                                     static_cast<float>(settings.midSideMode)));
+    
+    // Profil-Namen direkt aus dem Parameter-Choice holen
+    if (auto* choiceParam = dynamic_cast<juce::AudioParameterChoice*>(parameterRouter.getParameter(GlobalParam::LiveSmartEqProfile)))
     {
-        // Profil-Namen direkt aus dem Parameter-Choice holen
-        if (auto* choiceParam = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(ParameterIDs::LIVE_SMART_EQ_PROFILE)))
-        {
-            settings.profileName = choiceParam->getCurrentChoiceName();
-            if (settings.profileName == "Default")
-                settings.profileName = "";  // Leerer Name = kein Profil
-        }
+        settings.profileName = choiceParam->getCurrentChoiceName();
+        if (settings.profileName == "Default")
+            settings.profileName = "";  // Leerer Name = kein Profil
     }
     
     // HINWEIS: useReferenceAsTarget wird NICHT überschrieben, weil wir die bestehenden Settings behalten!
@@ -928,7 +1254,7 @@ void AuraAudioProcessor::updateLiveSmartEQFromParameters()
     liveSmartEQ.setSettings(settings);
     
     // Modus setzen (wenn nicht Custom) — setzt automatisch den korrekten Threshold
-    if (modeParam)
+    if (auto* modeParam = parameterRouter.getHandle(GlobalParam::LiveSmartEqMode))
     {
         int modeIndex = static_cast<int>(modeParam->load());
         auto mode = static_cast<LiveSmartEQ::Mode>(modeIndex);
@@ -939,7 +1265,7 @@ void AuraAudioProcessor::updateLiveSmartEQFromParameters()
         else
         {
             // Custom Mode: Threshold vom Knob lesen
-            if (thresholdParam) 
+            if (auto* thresholdParam = parameterRouter.getHandle(GlobalParam::LiveSmartEqThreshold))
             {
                 auto s = liveSmartEQ.getSettings();
                 s.threshold = thresholdParam->load();
@@ -11,18 +11,25 @@
 #include "DSP/ReferenceAudioPlayer.h"
 #include "DSP/SpectralMatcher.h"
 #include "DSP/HighQualityOversampler.h"
+#include "DSP/LatencyCompensationDelay.h"
+#include "DSP/OversamplingStage.h"
 #include "DSP/DynamicResonanceSuppressor.h"
 #include "DSP/LinearPhaseEQ.h"
+#include "DSP/LinearPhaseResponseWorker.h"
+#include "DSP/SmartAnalysisWorker.h"
+#include "Utils/SilenceGate.h"
 #include "Utils/WASAPILoopbackCapture.h"
 #include "Parameters/ParameterLayout.h"
 #include "Parameters/ParameterIDs.h"
+#include "Parameters/ParameterRouter.h"
 #include "Licensing/LicenseManager.h"
 
 /**
  * AuraAudioProcessor: Hauptklasse für die Audio-Verarbeitung.
  */
 class AuraAudioProcessor : public juce::AudioProcessor,
-                             public juce::AudioProcessorValueTreeState::Listener
+                             private juce::AsyncUpdater,
+                             private juce::Timer
 {
 public:
     AuraAudioProcessor();
@@ -34,6 +41,10 @@ public:
     bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
 
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    
+    // Filter, Oversampler und Dry-Pfad rechnen nativ im Sample-Typ des Hosts
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override;
@@ -54,9 +65,6 @@ public:
     void getStateInformation(juce::MemoryBlock& destData) override;
     void setStateInformation(const void* data, int sizeInBytes) override;
 
-    // Parameter-Listener
-    void parameterChanged(const juce::String& parameterID, float newValue) override;
-
     // Zugriff auf Komponenten
     EQProcessor& getEQProcessor() { return eqProcessor; }
     FFTAnalyzer& getPreAnalyzer() { return preAnalyzer; }
@@ -131,6 +139,25 @@ public:
     
     // NEU: Per-Band Solo Status
     bool isAnyBandSoloed() const { return anyBandSoloed.load(); }
+    
+    // Stufen, die bei digitaler Stille entfallen dürfen (SilenceGate)
+    enum class IdleStage
+    {
+        EQ = 0,              // IIR-Bänder + Oversampling
+        LinearPhaseEQ,
+        PreAnalyzer,
+        PostAnalyzer,
+        Suppressor,          // auch die Spectral-Verzögerung im ausgeschalteten Zustand
+        TransientDetection,  // Live SmartEQ
+        Meters,
+        NumStages
+    };
+    
+    // Übersprungene Blöcke der Stufe seit prepareToPlay (beliebiger Thread)
+    uint64_t getSkippedBlocks(IdleStage stage) const
+    {
+        return silenceGates[static_cast<size_t>(stage)].getSkippedBlocks();
+    }
 
 private:
     // NEU: Undo/Redo Manager (muss vor apvts deklariert werden!)
@@ -138,6 +165,28 @@ private:
     
     // Parameter Value Tree State
     juce::AudioProcessorValueTreeState apvts;
+    
+    // Parameter-Routing: gecachte Handles + lock-freie Band-Änderungen (nach apvts!)
+    ParameterRouter parameterRouter { apvts };
+    std::atomic<bool> audioCallbackActive { false };
+    
+    // Heartbeat des Audio-Threads: processBlock zählt hoch, der Timer erkennt daran
+    // einen Host, der das Plugin vorbereitet lässt, aber keine Blöcke mehr liefert
+    std::atomic<uint32_t> audioBlockCounter { 0 };
+    std::atomic<bool> audioThreadQuiet { true };
+    uint32_t lastSeenAudioBlock = 0;   // nur Message-Thread
+    int quietTimerTicks = 0;           // nur Message-Thread
+    
+    // Band-Änderungen/Snapshot werden entweder vom Audio-Thread oder (bei stillem
+    // Audio-Thread) vom Message-Thread übernommen - nie von beiden gleichzeitig
+    std::atomic<bool> bandChangesBusy { false };
+    
+    // Live Smart EQ: APVTS-Nachzug und Band-Freigabe im Message-Thread (auch ohne Editor)
+    static constexpr int LIVE_EQ_SYNC_INTERVAL_MS = 40;
+    
+    // Ticks ohne neuen Block, ab denen der Audio-Thread als still gilt (~200 ms,
+    // länger als ein Block bei großen Host-Puffern)
+    static constexpr int AUDIO_QUIET_TICKS = 5;
 
     // DSP
     EQProcessor eqProcessor;
@@ -152,8 +201,11 @@ private:
     // NEU: System Audio Capture (WASAPI Loopback für Standalone)
     SystemAudioCapture systemAudioCapture;
     
-    // NEU: Oversampler (HQ-Filter bei hohen Frequenzen)
-    HighQualityOversampler oversampler;
+    // NEU: Oversampling der oversampelten EQ-Gruppe, je eine Stufe pro Host-Pfad
+    // (Faktor und Qualität werden immer für beide angefragt; Wechsel mit Crossfade,
+    // Bypass solange kein Band die hohe Rate braucht)
+    OversamplingStage<float> oversamplingStage;
+    OversamplingStage<double> oversamplingStageDouble;
     double baseSampleRate = 44100.0;
     int baseBlockSize = 512;
     
@@ -163,8 +215,47 @@ private:
     // NEU: Linear Phase EQ (FFT-basiert für Mastering)
     LinearPhaseEQ linearPhaseEQ;
     
-    // NEU: Dry-Buffer für Wet/Dry-Mix
-    juce::AudioBuffer<float> dryBuffer;
+    // Hält die Linear-Phase-Kurve auch ohne offenen Editor aktuell
+    // (nach eqProcessor/linearPhaseEQ deklariert → wird vor ihnen gestoppt)
+    LinearPhaseResponseWorker linearPhaseWorker { linearPhaseEQ, eqProcessor };
+    
+    // SmartAnalyzer + Live SmartEQ außerhalb des Audio-Threads
+    SmartAnalysisWorker smartAnalysisWorker { smartAnalyzer, liveSmartEQ, apvts };
+    
+    // Latenz-Ausgleich für alle Dry-Abgriffe (Wet/Dry, A/B, Delta, Auto-Gain)
+    LatencyCompensationDelay dryDelay;
+    juce::AudioBuffer<float> dryBuffer;       // Dry auf EQ-Latenz ausgerichtet (Wet/Dry-Mix)
+    juce::AudioBuffer<float> compareBuffer;   // Dry auf Gesamtlatenz ausgerichtet (A/B, Delta, Auto-Gain)
+    juce::AudioBuffer<double> dryBufferDouble;
+    juce::AudioBuffer<double> compareBufferDouble;
+    
+    // double-Pfad: Block für Stufen, die nur float verarbeiten (FFT/Analyse,
+    // Linear Phase, Suppressor) — gewandelt wird nur, wenn die Stufe läuft
+    juce::AudioBuffer<float> floatStageBuffer;
+    
+    // Dynamic-EQ-Lookahead auf Basis-Rate (20 ms bis 384 kHz)
+    static constexpr int MAX_DYNAMIC_LOOKAHEAD_SAMPLES = 8192;
+    LatencyCompensationDelay lookaheadDelay;
+    
+    int getDynamicLookaheadSamples() const
+    {
+        const double ms = parameterRouter.getValue(ParameterRouter::GlobalParam::DynamicLookahead);
+        return juce::jlimit(0, MAX_DYNAMIC_LOOKAHEAD_SAMPLES, juce::roundToInt(ms * baseSampleRate / 1000.0));
+    }
+    
+    // Latenz des IIR-Pfads: Oversampler + Dynamic-EQ-Lookahead (angefragte Einstellung;
+    // im Audio-Thread meldet processBlock die des hörbaren Oversampling-Pfads)
+    int getIIRStageLatency() const
+    {
+        return oversamplingStage.getLatencyInSamples() + getDynamicLookaheadSamples();
+    }
+    
+    static int getMaxCompensatedLatency()
+    {
+        // Linear Phase und Oversampling schließen sich aus, beide zusammen ist eine sichere Obergrenze
+        return LinearPhaseEQ::MAX_FFT_SIZE / 2 + HighQualityOversamplerBase::MAX_LATENCY_SAMPLES
+             + MAX_DYNAMIC_LOOKAHEAD_SAMPLES + SpectralSuppressionEngine::MAX_FFT_SIZE;
+    }
     
     // NEU: Smooth Preset-Wechsel (Crossfade)
     juce::AudioBuffer<float> presetFadeBuffer;
@@ -174,13 +265,14 @@ private:
     // NEU: Per-Band Solo Tracking (atomic für Audio→GUI Thread-Safety)
     std::atomic<bool> anyBandSoloed { false };
     
+    // Stille-Erkennung pro Stufe (Index = IdleStage)
+    std::array<SilenceGate, static_cast<size_t>(IdleStage::NumStages)> silenceGates;
+    SilenceGate& getSilenceGate(IdleStage stage) { return silenceGates[static_cast<size_t>(stage)]; }
+    
     // Level-Messung (Stereo) - atomic für Audio→GUI Thread-Safety
     std::atomic<float> lastOutputLevelLeft { -60.0f };
     std::atomic<float> lastOutputLevelRight { -60.0f };
     
-    // Tracking für Live Smart EQ (atomic für Safety bei prepareToPlay)
-    std::atomic<bool> liveSmartEqWasActive { false };
-    
     // NEU: EQ Matching aktiviert (atomic für GUI↔Audio Thread-Safety)
     std::atomic<bool> matchingEnabled { false };
     
@@ -202,10 +294,56 @@ private:
     float compensationPhase = 0.0f;
     float compensationRate = 0.0f;   // Phase-Increment pro Sample
 
+    // Gemeinsamer Rumpf beider processBlock()-Überladungen; Host-Blöcke über der in
+    // prepareToPlay angekündigten Größe laufen in Teilblöcken (processInPreparedBlocks)
+    template <typename SampleType>
+    void processInPreparedBlocks(juce::AudioBuffer<SampleType>& hostBuffer);
+    template <typename SampleType>
+    void processBlockInternal(juce::AudioBuffer<SampleType>& hostBuffer);
+    
+    // Zustand/Puffer des jeweiligen Host-Pfads
+    OversamplingStage<float>& getOversamplingStage(float) { return oversamplingStage; }
+    OversamplingStage<double>& getOversamplingStage(double) { return oversamplingStageDouble; }
+    juce::AudioBuffer<float>& getDryBuffer(float) { return dryBuffer; }
+    juce::AudioBuffer<double>& getDryBuffer(double) { return dryBufferDouble; }
+    juce::AudioBuffer<float>& getCompareBuffer(float) { return compareBuffer; }
+    juce::AudioBuffer<double>& getCompareBuffer(double) { return compareBufferDouble; }
+    
+    // Dry-Abgriff (unbearbeitetes Signal) auf die Latenz der EQ-Stufe + extraLatency.
+    // Während eines Oversampling-Crossfades werden alte und neue Latenz mit den
+    // Gewichten der Stufe gemischt (scratch nimmt den zweiten Abgriff auf)
+    template <typename SampleType>
+    void readDryTap(juce::AudioBuffer<SampleType>& dest, juce::AudioBuffer<SampleType>& scratch,
+                    int eqStageLatency, int extraLatency, bool linearPhaseEnabled, int numSamples);
+    
+    // Nur-float-Stufe auf den Block anwenden: float direkt, double über
+    // floatStageBuffer (writeBack == false: Stufe liest nur)
+    template <typename Stage>
+    void runFloatStage(juce::AudioBuffer<float>& buffer, bool writeBack, Stage&& stage);
+    template <typename Stage>
+    void runFloatStage(juce::AudioBuffer<double>& buffer, bool writeBack, Stage&& stage);
+    
     // Hilfsfunktionen
-    void updateBandFromParameters(int bandIndex);
+    void applyBandChanges(int bandIndex, uint32_t fieldMask);
+    
+    // Kein Audio-Callback vorbereitet oder Host liefert keine Blöcke mehr
+    bool isAudioThreadIdle() const
+    {
+        return !audioCallbackActive.load(std::memory_order_relaxed)
+            || audioThreadQuiet.load(std::memory_order_relaxed);
+    }
+    
+    // Bei stillem Audio-Thread: Band-Änderungen im Message-Thread anwenden und
+    // den Snapshot veröffentlichen (Kurve/Band-Status im Editor bleiben aktuell)
+    void applyBandChangesWhileIdle();
+    void applyBandModulation(int bandIndex);
+    void handleGlobalParameterChange(ParameterRouter::GlobalParam param, float newValue);
+    void handleAsyncUpdate() override;
+    void timerCallback() override;
     void updateAllBandsFromParameters();
     void updateLiveSmartEQFromParameters();
+    static LinearPhaseEQ::LatencyMode getLinearPhaseLatencyMode(int choiceIndex);
+    static BiquadFilter::DesignMode getFilterDesign(float choiceValue);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AuraAudioProcessor)
 };
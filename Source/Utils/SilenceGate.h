@@ -0,0 +1,91 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * SilenceGate: Überspringt eine Verarbeitungsstufe bei digitaler Stille.
+ *
+ * - Stille = alle Samples unter SILENCE_THRESHOLD (-200 dB), vektorisiert über
+ *   FloatVectorOperations::findMinAndMax (float und double)
+ * - Ausschwingen: gezählt werden aufeinanderfolgende Samples, in denen Eingang
+ *   UND Ausgang der Stufe still waren. Erst ab holdSamples (Latenz + Zustands-
+ *   Historie der Stufe) sind Delay-Leitungen geleert und Filterzustände unter
+ *   -200 dB — dann liefert die Stufe bei stillem Eingang nur noch Stille und
+ *   darf entfallen. Zustände bleiben unangetastet, die Stufe läuft beim ersten
+ *   nicht-stillen Block ohne Reset weiter (Tail und Latenz bleiben exakt)
+ * - Zähler übersprungener Blöcke, aus jedem Thread lesbar (getSkippedBlocks)
+ */
+class SilenceGate
+{
+public:
+    static constexpr float SILENCE_THRESHOLD = 1.0e-10f;   // -200 dB
+
+    // Mindestdauer stiller Ausgabe, bevor eine Stufe als ausgeschwungen gilt
+    static constexpr int DECAY_HOLD_SAMPLES = 4096;
+
+    /** true, wenn alle Samples der ersten numChannels Kanäle unter SILENCE_THRESHOLD liegen. */
+    template <typename SampleType>
+    static bool isSilent(const juce::AudioBuffer<SampleType>& buffer, int numChannels) noexcept
+    {
+        const int numSamples = buffer.getNumSamples();
+        const auto threshold = static_cast<SampleType>(SILENCE_THRESHOLD);
+        numChannels = juce::jmin(numChannels, buffer.getNumChannels());
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const auto range = juce::FloatVectorOperations::findMinAndMax(buffer.getReadPointer(ch), numSamples);
+            if (range.getStart() <= -threshold || range.getEnd() >= threshold)
+                return false;
+        }
+
+        return true;
+    }
+
+    template <typename SampleType>
+    static bool isSilent(const juce::AudioBuffer<SampleType>& buffer) noexcept
+    {
+        return isSilent(buffer, buffer.getNumChannels());
+    }
+
+    void reset() noexcept
+    {
+        silentSamples = 0;
+        skippedBlocks.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Vor der Stufe (Audio-Thread): true = Stufe diesen Block überspringen.
+     * @param inputSilent   Eingang der Stufe still (isSilent)
+     * @param holdSamples   Latenz + Ausschwingzeit der Stufe in Samples
+     * @param stateIdle     zusätzliche Ruhebedingung der Stufe (z.B. Gain-Reduktion entspannt)
+     */
+    bool shouldSkip(bool inputSilent, int holdSamples, bool stateIdle = true) noexcept
+    {
+        if (!inputSilent || !stateIdle || silentSamples < juce::jmax(0, holdSamples))
+            return false;
+
+        skippedBlocks.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /** Nach der Stufe, wenn sie gelaufen ist (Audio-Thread). */
+    void update(bool inputSilent, bool outputSilent, int numSamples) noexcept
+    {
+        if (inputSilent && outputSilent)
+            silentSamples = static_cast<int>(juce::jmin<int64_t>(static_cast<int64_t>(silentSamples) + numSamples,
+                                                                 MAX_SILENT_SAMPLES));
+        else
+            silentSamples = 0;
+    }
+
+    // Übersprungene Blöcke seit prepare (beliebiger Thread)
+    uint64_t getSkippedBlocks() const { return skippedBlocks.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr int64_t MAX_SILENT_SAMPLES = 1 << 30;   // Sättigung statt Überlauf
+
+    int silentSamples = 0;                          // nur Audio-Thread
+    std::atomic<uint64_t> skippedBlocks { 0 };      // für Leser
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+/**
+ * StageCpuMeter: Leichtgewichtige CPU-Messung pro Verarbeitungsstufe.
+ *
+ * - Audio-Thread: ScopedStage misst die Dauer einer Stufe mit
+ *   juce::Time::getHighResolutionTicks() (ein Tick-Paar pro Aufruf, keine Locks)
+ * - Last = Rechenzeit / Echtzeit-Dauer der verarbeiteten Samples
+ *   (0.01 = 1% eines Kerns), exponentiell geglättet
+ * - Lesen aus jedem Thread (GUI, Tests) über getLoad()
+ */
+class StageCpuMeter
+{
+public:
+    static constexpr int MAX_STAGES = 8;
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        reset();
+    }
+
+    void reset()
+    {
+        smoothedLoads.fill(0.0f);
+        for (auto& load : loads)
+            load.store(0.0f, std::memory_order_relaxed);
+    }
+
+    /** Misst eine Stufe für numSamples Samples Echtzeit (RAII). */
+    class ScopedStage
+    {
+    public:
+        ScopedStage(StageCpuMeter& meterToUse, int stageIndex, int numSamplesToMeasure) noexcept
+            : meter(meterToUse), stage(stageIndex), numSamples(numSamplesToMeasure),
+              startTicks(juce::Time::getHighResolutionTicks())
+        {
+        }
+
+        ~ScopedStage()
+        {
+            meter.addMeasurement(stage, juce::Time::getHighResolutionTicks() - startTicks, numSamples);
+        }
+
+    private:
+        StageCpuMeter& meter;
+        const int stage;
+        const int numSamples;
+        const juce::int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedStage)
+    };
+
+    void addMeasurement(int stage, juce::int64 elapsedTicks, int numSamples) noexcept
+    {
+        if (stage < 0 || stage >= MAX_STAGES || numSamples <= 0 || sampleRate <= 0.0)
+            return;
+
+        const double seconds = juce::Time::highResolutionTicksToSeconds(elapsedTicks);
+        const double realTimeSeconds = static_cast<double>(numSamples) / sampleRate;
+        const float load = static_cast<float>(seconds / realTimeSeconds);
+
+        auto& smoothed = smoothedLoads[static_cast<size_t>(stage)];
+        smoothed += (load - smoothed) * SMOOTHING;
+        loads[static_cast<size_t>(stage)].store(smoothed, std::memory_order_relaxed);
+    }
+
+    /** Geglättete Last der Stufe (Anteil eines Kerns). */
+    float getLoad(int stage) const
+    {
+        if (stage < 0 || stage >= MAX_STAGES)
+            return 0.0f;
+        return loads[static_cast<size_t>(stage)].load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr float SMOOTHING = 0.05f;
+
+    double sampleRate = 44100.0;
+    std::array<float, MAX_STAGES> smoothedLoads {};             // nur Audio-Thread
+    std::array<std::atomic<float>, MAX_STAGES> loads {};        // für Leser
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <cstdio>
+
+/**
+ * Gemeinsame Helfer der DSP-Benchmarks (AuraDspBenchmarks).
+ * Jeder Benchmark liegt in einer eigenen .cpp, gibt eine Tabelle aus und
+ * liefert false, wenn seine Ergebnisprüfung fehlschlägt.
+ */
+namespace Benchmarks
+{
+    // Mittlere Laufzeit pro Aufruf in Mikrosekunden (ein Warmlauf vorab)
+    template <typename Function>
+    double timePerCallMicroseconds(int numCalls, Function&& function)
+    {
+        function();
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        for (int i = 0; i < numCalls; ++i)
+            function();
+        const auto ticks = juce::Time::getHighResolutionTicks() - start;
+
+        return 1.0e6 * juce::Time::highResolutionTicksToSeconds(ticks) / numCalls;
+    }
+
+    // Verhindert, dass der Optimierer Ergebnisse verwirft
+    inline volatile float sink = 0.0f;
+
+    bool runFilterbank();
+    bool runSpectralKernels();
+    bool runSuppressorEngines();
+}
@@ -0,0 +1,241 @@
+/**
+ * Filterbank-Benchmark: Mel/Bark-Energien + MFCC pro Analyse-Frame.
+ *
+ * Alt:  SmartAnalyzer rief pro Frame prepare() auf → dichte Mel- und Bark-
+ *       Filterbänke (numBins breit) neu aufgebaut, Ergebnisse als neue Vektoren,
+ *       DCT-Kosinus pro Koeffizient (Nachbau der vorherigen SpectralAnalysis)
+ * Neu:  SpectralAnalysis::prepare() ohne Änderung = No-Op, Sparse-Bänder,
+ *       DCT-Tabelle, feste Ergebnis-Buffer
+ *
+ * Zusätzlich: maximale Abweichung der Ergebnisse (muss ~0 sein, sonst false).
+ */
+
+#include "Benchmarks.h"
+#include "DSP/SpectralAnalysis.h"
+
+#include <vector>
+
+namespace
+{
+    constexpr double SAMPLE_RATE = 44100.0;
+    constexpr int NUM_FRAMES = 2000;
+    constexpr float MAX_RELATIVE_DIFFERENCE = 1.0e-5f;
+
+    // Vorherige Implementierung: Neuaufbau pro Frame, dichte Bänder
+    class LegacyFilterbank
+    {
+    public:
+        void prepare(double newSampleRate, int newFftSize)
+        {
+            sampleRate = newSampleRate;
+            fftSize = newFftSize;
+            numBins = fftSize / 2 + 1;
+
+            initializeMelFilterbank();
+            initializeBarkFilterbank();
+        }
+
+        std::vector<float> calculateMelBands(const std::vector<float>& mags) const
+        {
+            std::vector<float> melEnergies(numMelBands, 0.0f);
+
+            for (int m = 0; m < numMelBands; ++m)
+            {
+                float energy = 0.0f;
+                const auto& band = melFilterbank[static_cast<size_t>(m)];
+                for (size_t k = 0; k < std::min(mags.size(), band.size()); ++k)
+                    energy += mags[k] * mags[k] * band[k];
+                melEnergies[static_cast<size_t>(m)] = energy;
+            }
+
+            return melEnergies;
+        }
+
+        std::vector<float> calculateBarkBands(const std::vector<float>& mags) const
+        {
+            std::vector<float> barkEnergies(numBarkBands, 0.0f);
+
+            for (int b = 0; b < numBarkBands; ++b)
+            {
+                float energy = 0.0f;
+                int count = 0;
+                const auto& band = barkFilterbank[static_cast<size_t>(b)];
+
+                for (size_t k = 0; k < std::min(mags.size(), band.size()); ++k)
+                {
+                    if (band[k] > 0.0f)
+                    {
+                        energy += mags[k] * mags[k];
+                        ++count;
+                    }
+                }
+
+                barkEnergies[static_cast<size_t>(b)] = count > 0 ? energy / static_cast<float>(count) : 0.0f;
+            }
+
+            return barkEnergies;
+        }
+
+        std::vector<float> calculateMFCC(const std::vector<float>& melEnergies) const
+        {
+            std::vector<float> mfcc(numMFCC, 0.0f);
+
+            std::vector<float> logMelEnergies(melEnergies.size());
+            for (size_t i = 0; i < melEnergies.size(); ++i)
+                logMelEnergies[i] = std::log(std::max(1e-10f, melEnergies[i]));
+
+            for (int i = 0; i < numMFCC; ++i)
+            {
+                float sum = 0.0f;
+                for (size_t j = 0; j < logMelEnergies.size(); ++j)
+                    sum += logMelEnergies[j] * std::cos(juce::MathConstants<float>::pi * static_cast<float>(i)
+                                                        * (static_cast<float>(j) + 0.5f)
+                                                        / static_cast<float>(logMelEnergies.size()));
+                mfcc[static_cast<size_t>(i)] = sum;
+            }
+
+            return mfcc;
+        }
+
+    private:
+        static constexpr int numMelBands = SpectralAnalysis::numMelBands;
+        static constexpr int numBarkBands = SpectralAnalysis::numBarkBands;
+        static constexpr int numMFCC = SpectralAnalysis::numMFCC;
+
+        int frequencyToBin(float freq) const
+        {
+            return static_cast<int>(std::round(freq * static_cast<float>(fftSize) / static_cast<float>(sampleRate)));
+        }
+
+        static float hzToMel(float hz) { return 2595.0f * std::log10(1.0f + hz / 700.0f); }
+        static float melToHz(float mel) { return 700.0f * (std::pow(10.0f, mel / 2595.0f) - 1.0f); }
+
+        void initializeMelFilterbank()
+        {
+            melFilterbank.clear();
+            melFilterbank.resize(numMelBands);
+
+            const float melMin = hzToMel(20.0f);
+            const float melMax = hzToMel(static_cast<float>(sampleRate) / 2.0f);
+
+            std::vector<int> binPoints(numMelBands + 2);
+            for (int i = 0; i <= numMelBands + 1; ++i)
+            {
+                const float mel = melMin + static_cast<float>(i) * (melMax - melMin) / static_cast<float>(numMelBands + 1);
+                binPoints[static_cast<size_t>(i)] = frequencyToBin(melToHz(mel));
+            }
+
+            for (int m = 0; m < numMelBands; ++m)
+            {
+                auto& band = melFilterbank[static_cast<size_t>(m)];
+                band.resize(static_cast<size_t>(numBins), 0.0f);
+
+                const int lower = binPoints[static_cast<size_t>(m)];
+                const int centre = binPoints[static_cast<size_t>(m + 1)];
+                const int upper = binPoints[static_cast<size_t>(m + 2)];
+
+                for (int k = lower; k < centre; ++k)
+                    if (k >= 0 && k < numBins)
+                        band[static_cast<size_t>(k)] = static_cast<float>(k - lower) / static_cast<float>(centre - lower);
+
+                for (int k = centre; k < upper; ++k)
+                    if (k >= 0 && k < numBins)
+                        band[static_cast<size_t>(k)] = static_cast<float>(upper - k) / static_cast<float>(upper - centre);
+            }
+        }
+
+        void initializeBarkFilterbank()
+        {
+            static const float barkEdges[25] = {
+                20, 100, 200, 300, 400, 510, 630, 770, 920, 1080,
+                1270, 1480, 1720, 2000, 2320, 2700, 3150, 3700, 4400, 5300,
+                6400, 7700, 9500, 12000, 15500
+            };
+
+            barkFilterbank.clear();
+            barkFilterbank.resize(numBarkBands);
+
+            for (int b = 0; b < numBarkBands; ++b)
+            {
+                auto& band = barkFilterbank[static_cast<size_t>(b)];
+                band.resize(static_cast<size_t>(numBins), 0.0f);
+
+                const int lowBin = juce::jlimit(0, numBins - 1, frequencyToBin(barkEdges[b]));
+                const int highBin = juce::jlimit(lowBin, numBins, frequencyToBin(barkEdges[b + 1]));
+
+                for (int k = lowBin; k < highBin; ++k)
+                    band[static_cast<size_t>(k)] = 1.0f;
+            }
+        }
+
+        double sampleRate = 44100.0;
+        int fftSize = 2048;
+        int numBins = 1025;
+        std::vector<std::vector<float>> melFilterbank;
+        std::vector<std::vector<float>> barkFilterbank;
+    };
+
+    float maxDifference(const float* a, const float* b, int n)
+    {
+        float maxDiff = 0.0f;
+        for (int i = 0; i < n; ++i)
+            maxDiff = std::max(maxDiff, std::abs(a[i] - b[i]) / std::max(1.0f, std::abs(b[i])));
+        return maxDiff;
+    }
+}
+
+bool Benchmarks::runFilterbank()
+{
+    bool passed = true;
+
+    std::printf("Filterbank: Mel + Bark + MFCC pro Frame bei %.0f Hz, %d Frames\n", SAMPLE_RATE, NUM_FRAMES);
+    std::printf("%-8s %14s %14s %10s %14s\n", "FFT", "alt (us)", "neu (us)", "Faktor", "max. rel. Diff");
+
+    for (int fftSize : { 1024, 2048, 4096, 8192 })
+    {
+        const int numBins = fftSize / 2 + 1;
+
+        // Lineare Magnitudes (Rauschen mit 1/f-Tendenz)
+        std::vector<float> mags(static_cast<size_t>(numBins));
+        juce::Random random(42);
+        for (int k = 0; k < numBins; ++k)
+            mags[static_cast<size_t>(k)] = (0.1f + random.nextFloat()) / std::sqrt(1.0f + static_cast<float>(k));
+
+        LegacyFilterbank legacy;
+        std::vector<float> legacyMel, legacyBark, legacyMfcc;
+
+        const double legacyMicros = Benchmarks::timePerCallMicroseconds(NUM_FRAMES, [&]
+        {
+            legacy.prepare(SAMPLE_RATE, fftSize);
+            legacyMel = legacy.calculateMelBands(mags);
+            legacyBark = legacy.calculateBarkBands(mags);
+            legacyMfcc = legacy.calculateMFCC(legacyMel);
+            Benchmarks::sink = legacyMfcc[1];
+        });
+
+        SpectralAnalysis analysis;
+        std::array<float, SpectralAnalysis::numMelBands> mel {};
+        std::array<float, SpectralAnalysis::numBarkBands> bark {};
+        std::array<float, SpectralAnalysis::numMFCC> mfcc {};
+
+        const double cachedMicros = Benchmarks::timePerCallMicroseconds(NUM_FRAMES, [&]
+        {
+            analysis.prepare(SAMPLE_RATE, fftSize);
+            analysis.calculateMelBands(mags.data(), numBins, mel.data());
+            analysis.calculateBarkBands(mags.data(), numBins, bark.data());
+            analysis.calculateMFCC(mel.data(), mfcc.data());
+            Benchmarks::sink = mfcc[1];
+        });
+
+        const float diff = std::max({ maxDifference(mel.data(), legacyMel.data(), SpectralAnalysis::numMelBands),
+                                      maxDifference(bark.data(), legacyBark.data(), SpectralAnalysis::numBarkBands),
+                                      maxDifference(mfcc.data(), legacyMfcc.data(), SpectralAnalysis::numMFCC) });
+
+        std::printf("%-8d %14.2f %14.2f %9.1fx %14.2e\n", fftSize, legacyMicros, cachedMicros,
+                    legacyMicros / cachedMicros, static_cast<double>(diff));
+
+        passed = passed && diff < MAX_RELATIVE_DIFFERENCE;
+    }
+
+    return passed;
+}
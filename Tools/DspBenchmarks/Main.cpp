@@ -0,0 +1,47 @@
+/**
+ * AuraDspBenchmarks: Mikrobenchmarks der Analyse- und Suppressor-Kerne
+ * gegenüber den vorherigen Implementierungen.
+ *
+ * Build:  cmake -B build -DAURA_BUILD_TOOLS=ON  →  Target AuraDspBenchmarks
+ * Aufruf: AuraDspBenchmarks [Name]   (ohne Name: alle)
+ *         filterbank  Mel/Bark/MFCC: gecachte Sparse-Filterbank vs. Neuaufbau pro Frame
+ *         spectral    SpectralKernels vs. skalare Schleifen, inkl. dB-Genauigkeitsprüfung
+ *         suppressor  Resonanz-Suppressor: CPU Filterbank vs. Spectral bei 44.1/96/192 kHz
+ * Exit-Code 1, wenn ein Benchmark seine Ergebnisprüfung nicht besteht.
+ */
+
+#include "Benchmarks.h"
+
+#include <cstring>
+
+int main(int argc, char* argv[])
+{
+    struct Entry { const char* name; bool (*run)(); };
+    const Entry entries[] = {
+        { "filterbank", Benchmarks::runFilterbank },
+        { "spectral",   Benchmarks::runSpectralKernels },
+        { "suppressor", Benchmarks::runSuppressorEngines }
+    };
+
+    const char* selected = argc > 1 ? argv[1] : nullptr;
+    bool found = false;
+    bool passed = true;
+
+    for (const auto& entry : entries)
+    {
+        if (selected == nullptr || std::strcmp(selected, entry.name) == 0)
+        {
+            passed = entry.run() && passed;
+            std::printf("\n");
+            found = true;
+        }
+    }
+
+    if (!found)
+    {
+        std::printf("Unbekannter Benchmark: %s\n", selected);
+        return 1;
+    }
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,206 @@
+/**
+ * SpectralKernels-Benchmark: Kernels gegenüber den vorherigen skalaren Schleifen
+ * über alle FFTResolution-Größen (1024 … 8192).
+ *
+ * - dB + Glättung:   FFTAnalyzer (Decibels::gainToDecibels + if/else-Attack/Release)
+ * - lokaler Schnitt:  DynamicResonanceSuppressor (Prefix-Summe mit Clamping pro Bin)
+ * - Leistungssumme:  PsychoAcousticModel (std::pow pro Bin)
+ *
+ * Zusätzlich wird die Genauigkeitsangabe von SpectralKernels::gainToDecibels
+ * (< 1e-5 dB gegenüber exaktem 20 * log10) über -240 … +60 dB geprüft.
+ * Rückgabe false, wenn sie verletzt ist.
+ */
+
+#include "Benchmarks.h"
+#include "DSP/SpectralKernels.h"
+
+#include <vector>
+
+namespace
+{
+    constexpr int NUM_FRAMES = 5000;
+    constexpr float FLOOR_DB = -100.0f;
+    constexpr float ATTACK = 0.3f;
+    constexpr float RELEASE = 0.9f;
+    constexpr int HALF_WINDOW = 18;   // windowSize 37 (Selektivität 0.5)
+
+    constexpr float MAX_DB_ERROR = 1.0e-5f;
+
+    //==========================================================================
+    // Vorherige Implementierungen
+    //==========================================================================
+
+    void legacyDecibelsAndSmoothing(const float* fftData, float* magnitudes, float* smoothed,
+                                    int numBins, int fftSize)
+    {
+        for (int i = 0; i < numBins; ++i)
+        {
+            float magnitude = fftData[i];
+            magnitude /= static_cast<float>(fftSize);
+
+            const float magnitudeDB = juce::Decibels::gainToDecibels(magnitude, FLOOR_DB);
+            const float currentValue = smoothed[i];
+
+            if (magnitudeDB > currentValue)
+                smoothed[i] = ATTACK * currentValue + (1.0f - ATTACK) * magnitudeDB;
+            else
+                smoothed[i] = RELEASE * currentValue + (1.0f - RELEASE) * magnitudeDB;
+
+            magnitudes[i] = magnitudeDB;
+        }
+    }
+
+    void legacyLocalAverage(const float* mags, float* averages, float* prefix, int numBins, int halfWindow)
+    {
+        prefix[0] = mags[0];
+        for (int i = 1; i < numBins; ++i)
+            prefix[i] = prefix[i - 1] + mags[i];
+
+        for (int i = 0; i < numBins; ++i)
+        {
+            const int start = std::max(0, i - halfWindow);
+            const int end = std::min(numBins - 1, i + halfWindow);
+            const float windowSum = prefix[end] - (start > 0 ? prefix[start - 1] : 0.0f);
+            const int count = end - start;
+            averages[i] = count > 0 ? (windowSum - mags[i]) / static_cast<float>(count) : -60.0f;
+        }
+    }
+
+    float legacyWeightedPower(const float* db, const float* weightDb, int numBins, float floorDb)
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < numBins; ++i)
+        {
+            const float weighted = db[i] + weightDb[i];
+            if (weighted > floorDb)
+                sum += std::pow(10.0f, weighted / 10.0f);
+        }
+        return sum;
+    }
+
+    //==========================================================================
+
+    float maxAbsDifference(const float* a, const float* b, int n)
+    {
+        float maxDiff = 0.0f;
+        for (int i = 0; i < n; ++i)
+            maxDiff = std::max(maxDiff, std::abs(a[i] - b[i]));
+        return maxDiff;
+    }
+
+    // Maximaler Fehler von SpectralKernels::gainToDecibels über -240 … +60 dB
+    double measureDecibelError()
+    {
+        constexpr int numValues = 1 << 20;
+        std::vector<float> gains(numValues), decibels(numValues);
+
+        for (int i = 0; i < numValues; ++i)
+            gains[static_cast<size_t>(i)] = static_cast<float>(std::pow(10.0, (-240.0 + 300.0 * i / (numValues - 1)) / 20.0));
+
+        SpectralKernels::gainToDecibels(gains.data(), decibels.data(), numValues, 1.0f, -300.0f);
+
+        double maxError = 0.0;
+        for (int i = 0; i < numValues; ++i)
+        {
+            const double exact = 20.0 * std::log10(static_cast<double>(gains[static_cast<size_t>(i)]));
+            maxError = std::max(maxError, std::abs(static_cast<double>(decibels[static_cast<size_t>(i)]) - exact));
+        }
+
+        return maxError;
+    }
+}
+
+bool Benchmarks::runSpectralKernels()
+{
+    std::printf("SpectralKernels: Kernel vs. skalare Schleife, %d Frames\n", NUM_FRAMES);
+    std::printf("%-8s %-16s %12s %12s %9s %14s\n", "FFT", "Pass", "alt (us)", "neu (us)", "Faktor", "max. Diff");
+
+    auto printRow = [](int fftSize, const char* pass, double legacyMicros, double kernelMicros, float diff)
+    {
+        std::printf("%-8d %-16s %12.2f %12.2f %8.1fx %14.2e\n", fftSize, pass, legacyMicros, kernelMicros,
+                    legacyMicros / kernelMicros, static_cast<double>(diff));
+    };
+
+    for (int order : { 10, 11, 12, 13 })   // FFTResolution::Low … Maximum
+    {
+        const int fftSize = 1 << order;
+        const int numBins = fftSize / 2 + 1;
+        const auto size = static_cast<size_t>(numBins);
+
+        // FFT-Magnituden (unnormalisiert, 1/f-Tendenz, teils unter dem Floor)
+        std::vector<float> fftData(size), weightDb(size);
+        juce::Random random(42);
+        for (size_t k = 0; k < size; ++k)
+        {
+            fftData[k] = static_cast<float>(fftSize) * (1.0e-6f + random.nextFloat()) / (1.0f + static_cast<float>(k));
+            weightDb[k] = -20.0f + 20.0f * random.nextFloat();
+        }
+
+        // dB + Attack/Release
+        std::vector<float> legacyDb(size), legacySmoothed(size, FLOOR_DB);
+        std::vector<float> kernelDb(size), kernelSmoothed(size, FLOOR_DB);
+
+        const double legacyDbMicros = Benchmarks::timePerCallMicroseconds(NUM_FRAMES, [&]
+        {
+            legacyDecibelsAndSmoothing(fftData.data(), legacyDb.data(), legacySmoothed.data(), numBins, fftSize);
+            Benchmarks::sink = legacySmoothed[1];
+        });
+
+        const double kernelDbMicros = Benchmarks::timePerCallMicroseconds(NUM_FRAMES, [&]
+        {
+            SpectralKernels::gainToDecibels(fftData.data(), kernelDb.data(), numBins,
+                                            1.0f / static_cast<float>(fftSize), FLOOR_DB);
+            SpectralKernels::smoothAsymmetric(kernelDb.data(), kernelSmoothed.data(), numBins, ATTACK, RELEASE);
+            Benchmarks::sink = kernelSmoothed[1];
+        });
+
+        printRow(fftSize, "dB + Glaettung", legacyDbMicros, kernelDbMicros,
+                 std::max(maxAbsDifference(kernelDb.data(), legacyDb.data(), numBins),
+                          maxAbsDifference(kernelSmoothed.data(), legacySmoothed.data(), numBins)));
+
+        // Lokaler Mittelwert ohne Centre-Bin
+        std::vector<float> legacyAverage(size), kernelAverage(size), scratch(size);
+
+        const double legacyAverageMicros = Benchmarks::timePerCallMicroseconds(NUM_FRAMES, [&]
+        {
+            legacyLocalAverage(kernelDb.data(), legacyAverage.data(), scratch.data(), numBins, HALF_WINDOW);
+            Benchmarks::sink = legacyAverage[1];
+        });
+
+        const double kernelAverageMicros = Benchmarks::timePerCallMicroseconds(NUM_FRAMES, [&]
+        {
+            SpectralKernels::localAverageExcludingCentre(kernelDb.data(), kernelAverage.data(), scratch.data(),
+                                                         numBins, HALF_WINDOW, -60.0f);
+            Benchmarks::sink = kernelAverage[1];
+        });
+
+        printRow(fftSize, "lokaler Schnitt", legacyAverageMicros, kernelAverageMicros,
+                 maxAbsDifference(kernelAverage.data(), legacyAverage.data(), numBins));
+
+        // Gewichtete Leistungssumme (relativer Fehler)
+        float legacyPower = 0.0f, kernelPower = 0.0f;
+
+        const double legacyPowerMicros = Benchmarks::timePerCallMicroseconds(NUM_FRAMES, [&]
+        {
+            legacyPower = legacyWeightedPower(kernelDb.data(), weightDb.data(), numBins, FLOOR_DB);
+            Benchmarks::sink = legacyPower;
+        });
+
+        const double kernelPowerMicros = Benchmarks::timePerCallMicroseconds(NUM_FRAMES, [&]
+        {
+            kernelPower = SpectralKernels::sumWeightedPower(kernelDb.data(), weightDb.data(), numBins, FLOOR_DB);
+            Benchmarks::sink = kernelPower;
+        });
+
+        printRow(fftSize, "Leistungssumme", legacyPowerMicros, kernelPowerMicros,
+                 std::abs(kernelPower - legacyPower) / std::max(1.0e-30f, std::abs(legacyPower)));
+    }
+
+    const double maxError = measureDecibelError();
+    const bool passed = maxError < static_cast<double>(MAX_DB_ERROR);
+
+    std::printf("gainToDecibels: max. Fehler %.2e dB (-240 ... +60 dB), Grenze %.0e dB: %s\n",
+                maxError, static_cast<double>(MAX_DB_ERROR), passed ? "OK" : "FEHLER");
+
+    return passed;
+}
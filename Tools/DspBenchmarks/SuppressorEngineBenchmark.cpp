@@ -0,0 +1,144 @@
+/**
+ * Suppressor-Benchmark: CPU-Last der beiden Anwendungs-Engines des
+ * DynamicResonanceSuppressor bei 44.1 / 96 / 192 kHz.
+ *
+ * - Filterbank: 16 SVF-Bells, keine Latenz
+ * - Spectral:   per-Bin Maske im STFT (Latenz = STFT-Fensterlänge)
+ *
+ * Pro Block wie im Plugin: analyzeBlock (Detektion + Gain-Computer, für beide
+ * Engines identisch) und applyToBuffer. Signal: Stereo-Rauschen mit drei
+ * stehenden Resonanzen, damit die Engines tatsächlich reduzieren.
+ * Ausgabe in us pro Block und in % Echtzeit (Anteil an der Blockdauer).
+ *
+ * Ergebnisprüfung: beide Engines müssen reduzieren und endliche Samples liefern.
+ */
+
+#include "Benchmarks.h"
+#include "DSP/DynamicResonanceSuppressor.h"
+
+#include <vector>
+
+namespace
+{
+    using Engine = DynamicResonanceSuppressor::Engine;
+
+    constexpr int BLOCK_SIZE = 512;
+    constexpr int NUM_CHANNELS = 2;
+    constexpr double BENCH_SECONDS = 10.0;
+
+    struct EngineResult
+    {
+        double analyzeMicros = 0.0;   // pro Block
+        double applyMicros = 0.0;     // pro Block
+        int latencySamples = 0;
+        float maxReductionDb = 0.0f;
+        bool finite = true;
+    };
+
+    // Stereo-Testsignal: Rauschen + Resonanzen bei 450 Hz, 2.2 kHz und 5.1 kHz
+    juce::AudioBuffer<float> makeSignal(double sampleRate, int numSamples)
+    {
+        juce::AudioBuffer<float> signal(NUM_CHANNELS, numSamples);
+        juce::Random random(7);
+        const double resonances[] = { 450.0, 2200.0, 5100.0 };
+
+        for (int ch = 0; ch < NUM_CHANNELS; ++ch)
+        {
+            float* data = signal.getWritePointer(ch);
+            for (int i = 0; i < numSamples; ++i)
+            {
+                double sample = 0.1 * (random.nextFloat() * 2.0f - 1.0f);
+                for (double frequency : resonances)
+                    sample += 0.2 * std::sin(juce::MathConstants<double>::twoPi * frequency * i / sampleRate);
+                data[i] = static_cast<float>(sample);
+            }
+        }
+
+        return signal;
+    }
+
+    EngineResult runEngine(Engine engine, double sampleRate, const juce::AudioBuffer<float>& signal)
+    {
+        DynamicResonanceSuppressor suppressor;
+        suppressor.prepare(sampleRate, BLOCK_SIZE);
+        suppressor.setEngine(engine);
+        suppressor.setDepth(0.8f);
+
+        juce::AudioBuffer<float> block(NUM_CHANNELS, BLOCK_SIZE);
+        const int numBlocks = signal.getNumSamples() / BLOCK_SIZE;
+
+        // Einschwingen (Envelopes, STFT-Latenz) vor der Messung
+        const int warmupBlocks = juce::jmax(1, numBlocks / 10);
+
+        juce::int64 analyzeTicks = 0, applyTicks = 0;
+        EngineResult result;
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            for (int ch = 0; ch < NUM_CHANNELS; ++ch)
+                juce::FloatVectorOperations::copy(block.getWritePointer(ch),
+                                                  signal.getReadPointer(ch) + b * BLOCK_SIZE, BLOCK_SIZE);
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            suppressor.analyzeBlock(block);
+            const auto applyStart = juce::Time::getHighResolutionTicks();
+            suppressor.applyToBuffer(block);
+            const auto end = juce::Time::getHighResolutionTicks();
+
+            if (b >= warmupBlocks)
+            {
+                analyzeTicks += applyStart - start;
+                applyTicks += end - applyStart;
+            }
+
+            for (int ch = 0; ch < NUM_CHANNELS; ++ch)
+                for (int i = 0; i < BLOCK_SIZE; ++i)
+                    result.finite = result.finite && std::isfinite(block.getSample(ch, i));
+
+            Benchmarks::sink = block.getSample(0, 0);
+        }
+
+        const int measuredBlocks = numBlocks - warmupBlocks;
+        result.analyzeMicros = 1.0e6 * juce::Time::highResolutionTicksToSeconds(analyzeTicks) / measuredBlocks;
+        result.applyMicros = 1.0e6 * juce::Time::highResolutionTicksToSeconds(applyTicks) / measuredBlocks;
+
+        result.latencySamples = suppressor.getLatencyInSamples();
+
+        const float* reductions = suppressor.getGainReductions();
+        for (int i = 0; i < suppressor.getNumBins(); ++i)
+            result.maxReductionDb = std::min(result.maxReductionDb, reductions[i]);
+
+        return result;
+    }
+}
+
+bool Benchmarks::runSuppressorEngines()
+{
+    std::printf("Suppressor-Engines: Stereo, Block %d, %.0f s Signal pro Samplerate\n", BLOCK_SIZE, BENCH_SECONDS);
+    std::printf("%-9s %-11s %8s %13s %11s %11s %9s %9s\n",
+                "Rate", "Engine", "Latenz", "Analyse (us)", "Anw. (us)", "Summe (us)", "Last %", "max. GR");
+
+    bool passed = true;
+
+    for (double sampleRate : { 44100.0, 96000.0, 192000.0 })
+    {
+        const auto signal = makeSignal(sampleRate, static_cast<int>(sampleRate * BENCH_SECONDS));
+        const double blockMicros = 1.0e6 * BLOCK_SIZE / sampleRate;
+
+        for (auto engine : { Engine::Filterbank, Engine::Spectral })
+        {
+            const auto result = runEngine(engine, sampleRate, signal);
+            const double totalMicros = result.analyzeMicros + result.applyMicros;
+
+            std::printf("%-9.0f %-11s %8d %13.2f %11.2f %11.2f %8.2f%% %8.1f dB\n",
+                        sampleRate, engine == Engine::Filterbank ? "Filterbank" : "Spectral",
+                        result.latencySamples, result.analyzeMicros, result.applyMicros,
+                        totalMicros, 100.0 * totalMicros / blockMicros,
+                        static_cast<double>(result.maxReductionDb));
+
+            passed = passed && result.finite && result.maxReductionDb < -0.1f;
+        }
+    }
+
+    return passed;
+}
@@ -0,0 +1,243 @@
+/**
+ * FilterDesignComparison: Vergleich Cookbook (RBJ) vs. Analog Matched.
+ *
+ * 1. Betragsfehler gegenüber dem Analog-Prototyp (20 Hz .. 20 kHz, in dB) über
+ *    ein Parameterraster je Filtertyp: Cookbook bei 1x / 2x / 4x Filter-Rate und
+ *    Analog Matched bei 1x (nur der EQ, ohne die Oversampling-Filter)
+ * 2. CPU-Zeit der EQ-Kette: Analog Matched bei 1x vs. Cookbook mit Oversampling
+ *    (Up → EQ auf der oversampelten Rate → Down, wie im Plugin)
+ *
+ * Build:  cmake -B build -DAURA_BUILD_TOOLS=ON  →  Target AuraFilterDesignComparison
+ * Aufruf: AuraFilterDesignComparison [Samplerate]   (Default 48000)
+ */
+
+#include <JuceHeader.h>
+#include "DSP/BiquadFilter.h"
+#include "DSP/EQProcessor.h"
+#include "DSP/HighQualityOversampler.h"
+
+#include <complex>
+#include <cstdio>
+
+namespace
+{
+    using FilterType = ParameterIDs::FilterType;
+    using DesignMode = BiquadFilter::DesignMode;
+
+    constexpr int NUM_POINTS = 256;      // log. Frequenzraster 20 Hz .. 20 kHz
+    constexpr double FLOOR_DB = -60.0;   // Notch-Tiefe nicht überbewerten
+    constexpr int BLOCK_SIZE = 512;
+    constexpr double BENCH_SECONDS = 20.0;
+
+    struct ErrorStats
+    {
+        double maxDB = 0.0;
+        double sumSquares = 0.0;
+        int count = 0;
+
+        void add(double errorDB)
+        {
+            maxDB = std::max(maxDB, std::abs(errorDB));
+            sumSquares += errorDB * errorDB;
+            ++count;
+        }
+
+        double rmsDB() const { return count > 0 ? std::sqrt(sumSquares / count) : 0.0; }
+    };
+
+    // Exakter Betrag der normierten Koeffizienten (ohne die GUI-Begrenzung des Nenners)
+    double digitalMagnitudeDB(const BiquadFilter::Coefficients& c, double sampleRate, double frequency)
+    {
+        const auto z = std::polar(1.0, -2.0 * juce::MathConstants<double>::pi * frequency / sampleRate);
+        const auto h = (c.b0 + c.b1 * z + c.b2 * z * z) / (1.0 + c.a1 * z + c.a2 * z * z);
+        return std::max(FLOOR_DB, 20.0 * std::log10(std::max(std::abs(h), 1e-10)));
+    }
+
+    double analogMagnitudeDB(FilterType type, double f0, double gainDB, double q, double frequency)
+    {
+        const double magnitude = BiquadFilter::getAnalogMagnitude(type, f0, gainDB, q, frequency);
+        return std::max(FLOOR_DB, 20.0 * std::log10(std::max(magnitude, 1e-10)));
+    }
+
+    void accumulateError(ErrorStats& stats, FilterType type, DesignMode mode, double filterRate,
+                         double baseRate, float f0, float gainDB, float q)
+    {
+        BiquadFilter filter;
+        filter.prepare(filterRate, BLOCK_SIZE);
+        filter.setDesignMode(mode);
+        filter.updateCoefficients(type, f0, gainDB, q);
+        const auto coefficients = filter.getCoefficients();
+
+        const double maxFrequency = std::min(20000.0, 0.49 * baseRate);
+        for (int i = 0; i < NUM_POINTS; ++i)
+        {
+            const double frequency = 20.0 * std::pow(maxFrequency / 20.0, i / static_cast<double>(NUM_POINTS - 1));
+            stats.add(digitalMagnitudeDB(coefficients, filterRate, frequency)
+                      - analogMagnitudeDB(type, f0, gainDB, q, frequency));
+        }
+    }
+
+    void printMagnitudeErrors(double sampleRate)
+    {
+        struct TypeEntry { FilterType type; const char* name; bool usesGain; };
+        const TypeEntry types[] = {
+            { FilterType::Bell,      "Bell",      true  },
+            { FilterType::LowShelf,  "LowShelf",  true  },
+            { FilterType::HighShelf, "HighShelf", true  },
+            { FilterType::BandPass,  "BandPass",  false },
+            { FilterType::Notch,     "Notch",     false }
+        };
+
+        const float frequencies[] = { 1000.0f, 4000.0f, 8000.0f, 12000.0f, 16000.0f, 19000.0f };
+        const float gains[] = { -12.0f, -6.0f, 6.0f, 12.0f };
+        const float qs[] = { 0.5f, 0.71f, 2.0f, 4.0f };
+
+        std::printf("Betragsfehler vs. Analog-Prototyp bei %.0f Hz (max / rms in dB)\n", sampleRate);
+        std::printf("%-10s %16s %16s %16s %16s\n", "Typ", "Cookbook 1x", "Cookbook 2x", "Cookbook 4x", "Matched 1x");
+
+        for (const auto& entry : types)
+        {
+            ErrorStats cookbook[3], matched;
+
+            for (float f0 : frequencies)
+            {
+                if (f0 >= 0.49 * sampleRate)
+                    continue;
+
+                for (float gainDB : gains)
+                {
+                    if (!entry.usesGain && gainDB != gains[0])
+                        continue;
+
+                    for (float q : qs)
+                    {
+                        for (int k = 0; k < 3; ++k)
+                            accumulateError(cookbook[k], entry.type, DesignMode::Cookbook,
+                                            sampleRate * (1 << k), sampleRate, f0, gainDB, q);
+
+                        accumulateError(matched, entry.type, DesignMode::AnalogMatched,
+                                        sampleRate, sampleRate, f0, gainDB, q);
+                    }
+                }
+            }
+
+            std::printf("%-10s %7.2f / %6.2f %7.2f / %6.2f %7.2f / %6.2f %7.2f / %6.2f\n", entry.name,
+                        cookbook[0].maxDB, cookbook[0].rmsDB(), cookbook[1].maxDB, cookbook[1].rmsDB(),
+                        cookbook[2].maxDB, cookbook[2].rmsDB(), matched.maxDB, matched.rmsDB());
+        }
+    }
+
+    // Typisches Mastering-Setup mit Höhen-Bändern (dort wirkt die Stauchung)
+    void setupBands(EQProcessor& eq)
+    {
+        struct BandSetup { float frequency, gainDB, q; FilterType type; };
+        const BandSetup setups[] = {
+            { 60.0f,    2.0f, 0.71f, FilterType::LowShelf  },
+            { 250.0f,  -2.5f, 1.2f,  FilterType::Bell      },
+            { 1200.0f,  1.5f, 0.8f,  FilterType::Bell      },
+            { 3500.0f, -3.0f, 2.5f,  FilterType::Bell      },
+            { 7500.0f,  2.0f, 1.0f,  FilterType::Bell      },
+            { 12000.0f, 3.0f, 0.71f, FilterType::HighShelf },
+            { 16000.0f, 2.5f, 0.7f,  FilterType::Bell      },
+            { 18500.0f, 0.0f, 4.0f,  FilterType::Notch     }
+        };
+
+        for (int i = 0; i < static_cast<int>(std::size(setups)); ++i)
+        {
+            const auto& s = setups[i];
+            eq.getBand(i).setParameters(s.frequency, s.gainDB, s.q, s.type);
+            eq.getBand(i).setActive(true);
+        }
+    }
+
+    void fillNoise(juce::AudioBuffer<float>& buffer, juce::Random& random)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto* data = buffer.getWritePointer(ch);
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                data[i] = random.nextFloat() * 0.5f - 0.25f;
+        }
+    }
+
+    /** Laufzeit in ms für BENCH_SECONDS Audio (factor 1 = ohne Oversampler). */
+    double benchmark(double sampleRate, DesignMode mode, HighQualityOversamplerBase::Factor factor,
+                     HighQualityOversamplerBase::FilterQuality quality)
+    {
+        HighQualityOversampler<float> oversampler;
+        oversampler.prepare(sampleRate, BLOCK_SIZE, 2);
+        oversampler.setOversamplingFactor(factor);
+        oversampler.setFilterQuality(quality);
+
+        const int osFactor = oversampler.getFactorAsInt();
+        EQProcessor eq;
+        setupBands(eq);
+        eq.prepare(sampleRate * osFactor, BLOCK_SIZE * osFactor, osFactor);
+        eq.setFilterDesign(mode);
+
+        juce::AudioBuffer<float> buffer(2, BLOCK_SIZE);
+        juce::Random random(1234);
+        const int numBlocks = static_cast<int>(BENCH_SECONDS * sampleRate / BLOCK_SIZE);
+
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            fillNoise(buffer, random);
+
+            if (osFactor > 1)
+            {
+                float* const* osChannels = oversampler.upsampleBlock(buffer, 2);
+                juce::AudioBuffer<float> osBuffer(osChannels, 2, oversampler.getOversampledSize());
+                eq.processBlock(osBuffer);
+                oversampler.downsampleBlock(buffer, 2);
+            }
+            else
+            {
+                eq.processBlock(buffer);
+            }
+        }
+
+        const auto ticks = juce::Time::getHighResolutionTicks() - start;
+        return 1000.0 * juce::Time::highResolutionTicksToSeconds(ticks);
+    }
+
+    void printCpuComparison(double sampleRate)
+    {
+        using Factor = HighQualityOversamplerBase::Factor;
+        using Quality = HighQualityOversamplerBase::FilterQuality;
+
+        struct Config { const char* name; DesignMode mode; Factor factor; Quality quality; };
+        const Config configs[] = {
+            { "Matched 1x",        DesignMode::AnalogMatched, Factor::x1, Quality::LinearPhase  },
+            { "Cookbook 1x",       DesignMode::Cookbook,      Factor::x1, Quality::LinearPhase  },
+            { "Cookbook 2x (FIR)", DesignMode::Cookbook,      Factor::x2, Quality::LinearPhase  },
+            { "Cookbook 2x (IIR)", DesignMode::Cookbook,      Factor::x2, Quality::MinimumPhase },
+            { "Cookbook 4x (FIR)", DesignMode::Cookbook,      Factor::x4, Quality::LinearPhase  },
+            { "Cookbook 4x (IIR)", DesignMode::Cookbook,      Factor::x4, Quality::MinimumPhase }
+        };
+
+        std::printf("\nCPU: 8 Bänder, Stereo, %.0f s Audio bei %.0f Hz, Block %d\n", BENCH_SECONDS, sampleRate, BLOCK_SIZE);
+        std::printf("%-20s %10s %12s %10s\n", "Pfad", "ms", "% Echtzeit", "relativ");
+
+        double reference = 0.0;
+        for (const auto& config : configs)
+        {
+            const double ms = benchmark(sampleRate, config.mode, config.factor, config.quality);
+            if (reference <= 0.0)
+                reference = ms;
+
+            std::printf("%-20s %10.1f %12.3f %9.2fx\n", config.name, ms,
+                        100.0 * ms / (1000.0 * BENCH_SECONDS), ms / reference);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const double sampleRate = argc > 1 ? juce::jlimit(22050.0, 192000.0, std::atof(argv[1])) : 48000.0;
+
+    printMagnitudeErrors(sampleRate);
+    printCpuComparison(sampleRate);
+    return 0;
+}